@@ -9,10 +9,13 @@
 
 #include "common/Constants.h"
 #include "common/ExitCodes.h"
+#include "common/IpcFrame.h"
 #include "common/Settings.h"
 #include "common/VersionInfo.h"
 #include "deskflow/ProtocolTypes.h"
 
+#include <QFile>
+
 const QString CoreArgParser::s_headerText = QStringLiteral("%1: %2\n").arg(kCoreBinName, kDisplayVersion);
 
 CoreArgParser::CoreArgParser(const QStringList &args)
@@ -102,3 +105,18 @@ bool CoreArgParser::singleInstanceOnly() const
 {
   return m_singleInstance;
 }
+
+int CoreArgParser::statusPort() const
+{
+  return m_parser.value(CoreArgs::statusPortOption).toInt();
+}
+
+QString CoreArgParser::statusToken() const
+{
+  // never on the command line, which other users can read
+  if (m_parser.isSet(CoreArgs::statusTokenFileOption)) {
+    QFile file(m_parser.value(CoreArgs::statusTokenFileOption));
+    return file.open(QFile::ReadOnly) ? QString::fromUtf8(file.readAll()).trimmed() : QString();
+  }
+  return qEnvironmentVariable(deskflow::ipc::kStatusTokenVariable);
+}
@@ -35,6 +35,17 @@ public:
   bool clientMode() const;
   bool singleInstanceOnly() const;
 
+  /**
+   * @brief The port the GUI listens on for status, or 0 if it doesn't
+   */
+  int statusPort() const;
+
+  /**
+   * @brief The token the GUI expects on the status port
+   * Read from the file given on the command line, otherwise the environment.
+   */
+  QString statusToken() const;
+
 private:
   [[noreturn]] void showHelpText() const;
   QCommandLineParser m_parser;
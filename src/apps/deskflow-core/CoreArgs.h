@@ -19,6 +19,12 @@ struct CoreArgs
       QCommandLineOption("new-instance", "Skip the check for a running instance, always makes a new instance");
   inline static const auto configOption =
       QCommandLineOption({"s", "settings"}, "override configuration file to use", "configFile");
+  inline static const auto statusPortOption =
+      QCommandLineOption("status-port", "Publish the core status to the GUI listening on this local port", "port");
+  inline static const auto statusTokenFileOption =
+      QCommandLineOption("status-token-file", "File holding the token the GUI expects on the status port", "file");
 
-  inline static const auto options = {helpOption, versionOption, multiInstanceOption, configOption};
+  inline static const auto options = {
+      helpOption, versionOption, multiInstanceOption, configOption, statusPortOption, statusTokenFileOption
+  };
 };
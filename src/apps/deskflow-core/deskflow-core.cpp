@@ -88,9 +88,11 @@ int main(int argc, char **argv)
 
   if (parser.serverMode()) {
     ServerApp app(&events, processName);
+    app.setStatusTarget(parser.statusPort(), parser.statusToken());
     return app.run();
   } else if (parser.clientMode()) {
     ClientApp app(&events, processName);
+    app.setStatusTarget(parser.statusPort(), parser.statusToken());
     return app.run();
   }
 
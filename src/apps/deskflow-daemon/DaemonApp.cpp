@@ -146,7 +146,7 @@ void DaemonApp::run(QThread &daemonThread)
   });
 
 #if SYSAPI_WIN32
-  m_pWatchdog = std::make_unique<MSWindowsWatchdog>(m_foreground, *m_pFileLogOutputter);
+  m_pWatchdog = std::make_unique<MSWindowsWatchdog>(m_foreground, *m_pFileLogOutputter, m_pLogQueue);
 
   auto command = Settings::value(Settings::Daemon::Command).toString().toStdString();
   bool elevate = Settings::value(Settings::Daemon::Elevate).toBool();
@@ -239,6 +239,10 @@ void DaemonApp::initLogging()
 
   m_pFileLogOutputter = new FileLogOutputter(qPrintable(logFilename())); // NOSONAR - Adopted by `Log`
   CLOG->insert(m_pFileLogOutputter);
+
+  // the gui gets the log over ipc rather than by tailing the file
+  m_pLogQueue = new QueueLogOutputter(); // NOSONAR - Adopted by `Log`
+  CLOG->insert(m_pLogQueue);
 }
 
 void DaemonApp::showConsole()
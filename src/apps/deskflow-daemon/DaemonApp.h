@@ -14,6 +14,7 @@
 class Event;
 class IEventQueue;
 class FileLogOutputter;
+class QueueLogOutputter;
 class QLocalServer;
 class QCoreApplication;
 
@@ -51,6 +52,11 @@ public:
   void initLogging();
   void connectIpcServer(const deskflow::core::ipc::DaemonIpcServer *ipcServer) const;
 
+  QueueLogOutputter *logQueue() const
+  {
+    return m_pLogQueue;
+  }
+
   static QString logFilename();
 
 private:
@@ -73,6 +79,7 @@ private:
 
   IEventQueue &m_events;
   FileLogOutputter *m_pFileLogOutputter = nullptr;
+  QueueLogOutputter *m_pLogQueue = nullptr;
   deskflow::core::ipc::DaemonIpcServer *m_ipcServer = nullptr;
   std::string m_command = "";
   bool m_elevate = false;
@@ -92,7 +92,8 @@ int main(int argc, char **argv)
     }
 #endif
 
-    const auto ipcServer = new ipc::DaemonIpcServer(&app, qPrintable(DaemonApp::logFilename())); // NOSONAR - Qt managed
+    const auto ipcServer = // NOSONAR - Qt managed
+        new ipc::DaemonIpcServer(&app, qPrintable(DaemonApp::logFilename()), daemon.logQueue());
     ipcServer->listen();
     daemon.connectIpcServer(ipcServer);
 
@@ -0,0 +1,118 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "common/Constants.h"
+#include "common/ExitCodes.h"
+#include "common/Settings.h"
+#include "common/VersionInfo.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTcpSocket>
+#include <QTextStream>
+#include <QThread>
+
+namespace {
+
+const int kTimeout = 3000;
+
+//! Send one request and wait for its reply line, returns a null array on failure
+QByteArray request(QTcpSocket &socket, const QByteArray &line)
+{
+  socket.write(line + '\n');
+  if (!socket.waitForBytesWritten(kTimeout)) {
+    return {};
+  }
+
+  while (!socket.canReadLine()) {
+    if (!socket.waitForReadyRead(kTimeout)) {
+      return {};
+    }
+  }
+  return socket.readLine().trimmed();
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName(QStringLiteral("%1-stats").arg(kAppId));
+  QCoreApplication::setApplicationVersion(kVersion);
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription(QStringLiteral("Query a running %1 core for live statistics").arg(kAppName));
+  parser.addHelpOption();
+  parser.addVersionOption();
+  parser.addOption(
+      {{QStringLiteral("p"), QStringLiteral("port")}, QStringLiteral("Stats port, defaults to core/statsPort"),
+       QStringLiteral("port")}
+  );
+  parser.addOption(
+      {{QStringLiteral("i"), QStringLiteral("interval")}, QStringLiteral("Keep polling every <seconds>"),
+       QStringLiteral("seconds")}
+  );
+  parser.addOption(
+      {{QStringLiteral("l"), QStringLiteral("log-level")}, QStringLiteral("Change the core's log level and exit"),
+       QStringLiteral("level")}
+  );
+  parser.process(app);
+
+  QTextStream out(stdout);
+  QTextStream err(stderr);
+
+  const auto port = parser.isSet(QStringLiteral("port")) ? parser.value(QStringLiteral("port")).toInt()
+                                                         : Settings::value(Settings::Core::StatsPort).toInt();
+  if (port <= 0 || port > 65535) {
+    err << "no stats port, set core/statsPort or pass --port\n";
+    return s_exitArgs;
+  }
+
+  // only the user running the core can read it
+  QFile tokenFile(Settings::statsTokenFile());
+  if (!tokenFile.open(QFile::ReadOnly)) {
+    err << QStringLiteral("could not read %1, is the core running as this user?\n").arg(tokenFile.fileName());
+    return s_exitFailed;
+  }
+
+  QTcpSocket socket;
+  socket.connectToHost(QStringLiteral("127.0.0.1"), static_cast<quint16>(port));
+  if (!socket.waitForConnected(kTimeout)) {
+    err << QStringLiteral("could not connect to port %1: %2\n").arg(port).arg(socket.errorString());
+    return s_exitFailed;
+  }
+
+  if (request(socket, "auth=" + tokenFile.readAll().trimmed()) != "ok") {
+    err << "the core did not accept the token\n";
+    return s_exitFailed;
+  }
+
+  if (parser.isSet(QStringLiteral("log-level"))) {
+    const auto reply = request(socket, "logLevel=" + parser.value(QStringLiteral("log-level")).toUtf8());
+    out << (reply.isEmpty() ? QByteArrayLiteral("no reply") : reply) << "\n";
+    return reply == "ok" ? s_exitSuccess : s_exitFailed;
+  }
+
+  const auto interval = parser.value(QStringLiteral("interval")).toInt();
+  do {
+    const auto reply = request(socket, "stats");
+    const auto document = QJsonDocument::fromJson(reply);
+    if (!document.isObject()) {
+      err << "invalid reply from the core\n";
+      return s_exitFailed;
+    }
+    out << document.toJson(QJsonDocument::Indented);
+    out.flush();
+
+    if (interval > 0) {
+      QThread::sleep(interval);
+    }
+  } while (interval > 0);
+
+  return s_exitSuccess;
+}
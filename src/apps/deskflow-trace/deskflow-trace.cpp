@@ -0,0 +1,174 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "base/Trace.h"
+#include "common/Constants.h"
+#include "common/ExitCodes.h"
+#include "common/VersionInfo.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QTextStream>
+
+#include <algorithm>
+#include <array>
+#include <map>
+
+namespace {
+
+const std::array<const char *, 8> s_inputNames = {"key-down", "key-repeat", "key-up",         "mouse-down",
+                                                  "mouse-up", "mouse-move", "mouse-rel-move", "mouse-wheel"};
+
+QString describe(const TraceRecord &record)
+{
+  switch (record.point) {
+    using enum TracePoint;
+  case EventAdded:
+  case EventDispatched:
+    return QStringLiteral("type=%1 target=0x%2").arg(record.a).arg(record.target, 0, 16);
+
+  case SocketRead:
+  case SocketWrite:
+    return QStringLiteral("bytes=%1").arg(record.a);
+
+  case MessageParsed: {
+    QString code;
+    for (int shift = 24; shift >= 0; shift -= 8) {
+      code.append(QLatin1Char(static_cast<char>((record.a >> shift) & 0xff)));
+    }
+    return QStringLiteral("code=%1").arg(code);
+  }
+
+  case FakeInput: {
+    const auto input = static_cast<size_t>(record.a);
+    const auto name = input < s_inputNames.size() ? s_inputNames.at(input) : "unknown";
+    if (static_cast<TraceInput>(record.a) == TraceInput::MouseMove ||
+        static_cast<TraceInput>(record.a) == TraceInput::MouseRelativeMove ||
+        static_cast<TraceInput>(record.a) == TraceInput::MouseWheel) {
+      const auto first = static_cast<int32_t>(static_cast<uint64_t>(record.b) >> 32);
+      const auto second = static_cast<int32_t>(record.b & 0xffffffff);
+      return QStringLiteral("%1 %2,%3").arg(name).arg(first).arg(second);
+    }
+    return QStringLiteral("%1 %2").arg(name).arg(record.b);
+  }
+
+  case SpanBegin:
+    return QStringLiteral("%1 %2").arg(Trace::spanName(static_cast<TraceSpan>(record.a))).arg(record.b);
+
+  case SpanEnd:
+    return QString::fromLatin1(Trace::spanName(static_cast<TraceSpan>(record.a)));
+
+  case FlowBegin:
+  case FlowEnd:
+    return QStringLiteral("flow=%1").arg(record.a);
+  }
+  return {};
+}
+
+void printTimeline(QTextStream &out, const std::vector<TraceRecord> &records)
+{
+  const auto start = records.front().time;
+  for (const auto &record : records) {
+    out << QStringLiteral("%1 ms  [%2]  %3  %4\n")
+               .arg(double(record.time - start) / 1e6, 12, 'f', 3)
+               .arg(record.thread, 3)
+               .arg(QString::fromLatin1(Trace::pointName(record.point)), -16)
+               .arg(describe(record));
+  }
+  out << "\n";
+}
+
+void printSummary(QTextStream &out, const std::vector<TraceRecord> &records)
+{
+  std::map<TracePoint, size_t> counts;
+  for (const auto &record : records) {
+    ++counts[record.point];
+  }
+
+  const auto duration = double(records.back().time - records.front().time) / 1e9;
+  out << QStringLiteral("%1 records over %2 s\n").arg(records.size()).arg(duration, 0, 'f', 3);
+  for (const auto &[point, count] : counts) {
+    out << QStringLiteral("  %1 %2\n").arg(QString::fromLatin1(Trace::pointName(point)), -18).arg(count, 10);
+  }
+
+  out << "\nlatency (us)                          count       p50       p90       p99       max\n";
+  for (auto &latency : Trace::latencies(records)) {
+    auto &samples = latency.samples;
+    if (samples.empty()) {
+      out << QStringLiteral("  %1 %2\n").arg(QString::fromStdString(latency.name), -34).arg(0, 6);
+      continue;
+    }
+
+    std::ranges::sort(samples);
+    const auto percentile = [&samples](double p) {
+      const auto index = std::min(samples.size() - 1, static_cast<size_t>(p * double(samples.size())));
+      return double(samples.at(index)) / 1e3;
+    };
+    out << QStringLiteral("  %1 %2 %3 %4 %5 %6\n")
+               .arg(QString::fromStdString(latency.name), -34)
+               .arg(samples.size(), 6)
+               .arg(percentile(0.5), 9, 'f', 1)
+               .arg(percentile(0.9), 9, 'f', 1)
+               .arg(percentile(0.99), 9, 'f', 1)
+               .arg(double(samples.back()) / 1e3, 9, 'f', 1);
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName(QStringLiteral("%1-trace").arg(kAppId));
+  QCoreApplication::setApplicationVersion(kVersion);
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription(QStringLiteral("Decode %1 input traces").arg(kAppName));
+  parser.addHelpOption();
+  parser.addVersionOption();
+  parser.addOption({QStringLiteral("timeline"), QStringLiteral("Print every record, not just the summary")});
+  parser.addOption(
+      {QStringLiteral("chrome"), QStringLiteral("Convert to Trace Event Format JSON for ui.perfetto.dev"),
+       QStringLiteral("json")}
+  );
+  parser.addPositionalArgument(QStringLiteral("file"), QStringLiteral("Trace file written by the core"));
+  parser.process(app);
+
+  QTextStream out(stdout);
+  QTextStream err(stderr);
+
+  const auto files = parser.positionalArguments();
+  if (files.size() != 1) {
+    parser.showHelp(s_exitArgs);
+  }
+
+  std::vector<TraceRecord> records;
+  if (!Trace::load(files.first().toStdString(), records)) {
+    err << QStringLiteral("%1 is not a readable trace file\n").arg(files.first());
+    return s_exitFailed;
+  }
+
+  if (records.empty()) {
+    out << "no records\n";
+    return s_exitSuccess;
+  }
+
+  if (parser.isSet(QStringLiteral("chrome"))) {
+    const auto json = parser.value(QStringLiteral("chrome"));
+    if (!Trace::saveJson(json.toStdString(), records)) {
+      err << QStringLiteral("failed to write %1\n").arg(json);
+      return s_exitFailed;
+    }
+    out << QStringLiteral("wrote %1\n").arg(json);
+    return s_exitSuccess;
+  }
+
+  if (parser.isSet(QStringLiteral("timeline"))) {
+    printTimeline(out, records);
+  }
+  printSummary(out, records);
+  return s_exitSuccess;
+}
@@ -8,8 +8,13 @@
 
 #include "arch/Arch.h"
 
+#include <chrono>
 #include <thread>
 
+#if SYSAPI_UNIX
+#include <time.h>
+#endif
+
 #if SYSAPI_WIN32
 #include "arch/win32/ArchMiscWindows.h"
 #endif
@@ -51,7 +56,22 @@ void Arch::sleep(double timeout)
 
 double Arch::time()
 {
-  auto sinceEpoch = std::chrono::steady_clock::now().time_since_epoch();
-  auto uSecSinceEpoch = std::chrono::duration_cast<std::chrono::microseconds>(sinceEpoch).count();
-  return double(uSecSinceEpoch / 1000000);
+  return static_cast<double>(nanoTime()) / 1.0e+9;
+}
+
+int64_t Arch::nanoTime()
+{
+  const auto sinceEpoch = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(sinceEpoch).count();
+}
+
+int64_t Arch::coarseNanoTime()
+{
+#if defined(CLOCK_MONOTONIC_COARSE)
+  timespec now{};
+  if (clock_gettime(CLOCK_MONOTONIC_COARSE, &now) == 0) {
+    return static_cast<int64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+  }
+#endif
+  return nanoTime();
 }
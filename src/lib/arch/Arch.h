@@ -25,6 +25,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 #if SYSAPI_WIN32
 
 #include "arch/win32/ArchDaemonWindows.h"
@@ -96,6 +98,22 @@ public:
    */
   static double time();
 
+  /**
+   * @brief nanoTime
+   * @return Returns the number of nanoseconds since some arbitrary starting time
+   * from a monotonic clock. Prefer this over time() when computing intervals
+   * so repeated subtraction does not accumulate floating point error.
+   */
+  static int64_t nanoTime();
+
+  /**
+   * @brief coarseNanoTime
+   * @return Like nanoTime() but read from a cheaper clock with a resolution of
+   * a few milliseconds where the platform offers one (CLOCK_MONOTONIC_COARSE).
+   * Only use this for non-critical timing, and never mix it with nanoTime().
+   */
+  static int64_t coarseNanoTime();
+
 private:
   static Arch *s_instance;
 };
@@ -9,6 +9,8 @@
 #pragma once
 
 #include <cstdint>
+#include <string>
+#include <vector>
 
 /*!
 \class ArchCondImpl
@@ -83,6 +85,18 @@ public:
   //! Type of signal handler function
   using SignalFunc = void (*)(ThreadSignal, void *userData);
 
+  //! Thread scheduling policies
+  /*!
+  Real-time policies are not available on all platforms and usually
+  require elevated privileges.
+  */
+  enum class SchedulingPolicy : uint8_t
+  {
+    Normal,    //!< Default time-sharing scheduler
+    Fifo,      //!< Real-time, first in first out (SCHED_FIFO)
+    RoundRobin //!< Real-time, round robin (SCHED_RR)
+  };
+
   //! @name manipulators
   //@{
 
@@ -195,6 +209,24 @@ public:
   */
   virtual void setPriorityOfThread(ArchThread, int n) = 0;
 
+  //! Change thread scheduling policy
+  /*!
+  Switches \c thread to the scheduling \c policy with the given real-time
+  \c priority (1 is lowest).  If the real-time policy is refused (usually
+  for lack of privileges) the implementation may fall back to boosting
+  the thread's time-sharing priority instead.  Returns true iff the
+  requested policy is in effect.
+  */
+  virtual bool setSchedulingOfThread(ArchThread thread, SchedulingPolicy policy, int priority) = 0;
+
+  //! Pin thread to CPUs
+  /*!
+  Restricts \c thread to run only on the given CPU indices.  An empty
+  list removes any restriction.  Returns false if the platform does
+  not support CPU affinity or the request was refused.
+  */
+  virtual bool setAffinityOfThread(ArchThread thread, const std::vector<int> &cpus) = 0;
+
   //! Cancellation point
   /*!
   This method does nothing but is a cancellation point.  Clients
@@ -247,6 +279,14 @@ public:
   */
   virtual ThreadID getIDOfThread(ArchThread thread) = 0;
 
+  //! Describe thread scheduling
+  /*!
+  Returns a human readable description of the scheduling policy,
+  priority and CPU affinity currently in effect for \c thread.  This
+  is for diagnostic logging.
+  */
+  virtual std::string getSchedulingOfThread(ArchThread thread) = 0;
+
   //! Set the interrupt handler
   /*!
   Sets the function to call on receipt of an external interrupt.
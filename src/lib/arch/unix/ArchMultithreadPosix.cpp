@@ -10,11 +10,19 @@
 #include "arch/Arch.h"
 #include "arch/ArchException.h"
 
+#include <algorithm>
 #include <cerrno>
+#include <sched.h>
 #include <signal.h>
+#include <sys/resource.h>
 #include <sys/time.h>
 #include <time.h>
 
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #define SIGWAKEUP SIGUSR1
 
 static void setSignalSet(sigset_t *sigset)
@@ -26,6 +34,30 @@ static void setSignalSet(sigset_t *sigset)
   sigaddset(sigset, SIGUSR2);
 }
 
+//! Kernel thread id of the calling thread, 0 where not available
+static pid_t currentKernelThreadId()
+{
+#if defined(__linux__)
+  return static_cast<pid_t>(syscall(SYS_gettid));
+#else
+  return 0;
+#endif
+}
+
+static const char *schedulingPolicyName(int policy)
+{
+  switch (policy) {
+  case SCHED_FIFO:
+    return "SCHED_FIFO";
+  case SCHED_RR:
+    return "SCHED_RR";
+  case SCHED_OTHER:
+    return "SCHED_OTHER";
+  default:
+    return "unknown";
+  }
+}
+
 //
 // ArchThreadImpl
 //
@@ -46,6 +78,7 @@ public:
   bool m_exited = false;
   void *m_result = nullptr;
   void *m_networkData = nullptr;
+  pid_t m_tid = 0;
 };
 
 //
@@ -70,6 +103,7 @@ ArchMultithreadPosix::ArchMultithreadPosix()
   // list.  no need to lock the mutex since we're the only thread.
   m_mainThread = new ArchThreadImpl;
   m_mainThread->m_thread = pthread_self();
+  m_mainThread->m_tid = currentKernelThreadId();
   insert(m_mainThread);
 
   // install SIGWAKEUP handler.  this causes SIGWAKEUP to interrupt
@@ -375,11 +409,89 @@ void ArchMultithreadPosix::cancelThread(ArchThread thread)
   }
 }
 
-void ArchMultithreadPosix::setPriorityOfThread(ArchThread thread, int /*n*/)
+void ArchMultithreadPosix::setPriorityOfThread(ArchThread thread, int n)
 {
   assert(thread != nullptr);
 
-  // FIXME
+  // posix has no portable per-thread nice value.  on linux each thread
+  // is a task with its own nice value so we can set that.  boosting
+  // (n < 0) needs CAP_SYS_NICE or RLIMIT_NICE and is silently ignored
+  // otherwise.
+#if defined(__linux__)
+  pid_t tid = 0;
+  {
+    std::scoped_lock lock{m_threadMutex};
+    tid = thread->m_tid;
+  }
+  if (tid != 0) {
+    setpriority(PRIO_PROCESS, static_cast<id_t>(tid), std::clamp(n, -20, 19));
+  }
+#else
+  (void)n;
+#endif
+}
+
+bool ArchMultithreadPosix::setSchedulingOfThread(ArchThread thread, SchedulingPolicy policy, int priority)
+{
+  assert(thread != nullptr);
+
+  int nativePolicy = SCHED_OTHER;
+  sched_param param{};
+  switch (policy) {
+    using enum SchedulingPolicy;
+  case Fifo:
+    nativePolicy = SCHED_FIFO;
+    break;
+
+  case RoundRobin:
+    nativePolicy = SCHED_RR;
+    break;
+
+  case Normal:
+    break;
+  }
+
+  if (nativePolicy != SCHED_OTHER) {
+    param.sched_priority =
+        std::clamp(priority, sched_get_priority_min(nativePolicy), sched_get_priority_max(nativePolicy));
+  }
+
+  if (pthread_setschedparam(thread->m_thread, nativePolicy, &param) == 0) {
+    return true;
+  }
+
+  // real-time scheduling was refused, most likely EPERM because we lack
+  // CAP_SYS_NICE or an RLIMIT_RTPRIO.  the next best thing is a nice
+  // boost which RLIMIT_NICE may still allow.
+  if (nativePolicy != SCHED_OTHER) {
+    setPriorityOfThread(thread, -std::clamp(priority, 1, 20));
+  }
+  return false;
+}
+
+bool ArchMultithreadPosix::setAffinityOfThread(ArchThread thread, const std::vector<int> &cpus)
+{
+  assert(thread != nullptr);
+
+#if defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (cpus.empty()) {
+    for (int i = 0; i < CPU_SETSIZE; ++i) {
+      CPU_SET(i, &set);
+    }
+  } else {
+    for (int cpu : cpus) {
+      if (cpu >= 0 && cpu < CPU_SETSIZE) {
+        CPU_SET(cpu, &set);
+      }
+    }
+  }
+  return pthread_setaffinity_np(thread->m_thread, sizeof(set), &set) == 0;
+#else
+  // macos only offers affinity tags which are hints, not pinning
+  return cpus.empty();
+#endif
 }
 
 void ArchMultithreadPosix::testCancelThread()
@@ -467,6 +579,50 @@ IArchMultithread::ThreadID ArchMultithreadPosix::getIDOfThread(ArchThread thread
   return thread->m_id;
 }
 
+std::string ArchMultithreadPosix::getSchedulingOfThread(ArchThread thread)
+{
+  assert(thread != nullptr);
+
+  int policy = SCHED_OTHER;
+  sched_param param{};
+  if (pthread_getschedparam(thread->m_thread, &policy, &param) != 0) {
+    return "unknown";
+  }
+
+  std::string description = schedulingPolicyName(policy);
+  if (policy != SCHED_OTHER) {
+    description += " priority " + std::to_string(param.sched_priority);
+  }
+
+#if defined(__linux__)
+  pid_t tid = 0;
+  {
+    std::scoped_lock lock{m_threadMutex};
+    tid = thread->m_tid;
+  }
+  if (tid != 0) {
+    errno = 0;
+    if (const int nice = getpriority(PRIO_PROCESS, static_cast<id_t>(tid)); errno == 0) {
+      description += ", nice " + std::to_string(nice);
+    }
+  }
+
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (pthread_getaffinity_np(thread->m_thread, sizeof(set), &set) == 0) {
+    std::string cpus;
+    for (int i = 0; i < CPU_SETSIZE; ++i) {
+      if (CPU_ISSET(i, &set)) {
+        cpus += (cpus.empty() ? "" : ",") + std::to_string(i);
+      }
+    }
+    description += ", cpus " + cpus;
+  }
+#endif
+
+  return description;
+}
+
 void ArchMultithreadPosix::setSignalHandler(ThreadSignal signal, SignalFunc func, void *userData)
 {
   std::scoped_lock lock{m_threadMutex};
@@ -606,12 +762,10 @@ void *ArchMultithreadPosix::threadFunc(void *vrep)
 
 void ArchMultithreadPosix::doThreadFunc(ArchThread thread)
 {
-  // default priority is slightly below normal
-  setPriorityOfThread(thread, 1);
-
   // wait for parent to initialize this object
   {
     std::scoped_lock lock{m_threadMutex};
+    thread->m_tid = currentKernelThreadId();
   }
 
   void *result = nullptr;
@@ -386,6 +386,39 @@ void ArchMultithreadWindows::setPriorityOfThread(ArchThread thread, int n)
   SetThreadPriority(thread->m_thread, s_pClass[index].m_level);
 }
 
+bool ArchMultithreadWindows::setSchedulingOfThread(ArchThread thread, SchedulingPolicy policy, int)
+{
+  assert(thread != nullptr);
+
+  // windows has no real-time policies for threads outside the realtime
+  // priority class, so the closest equivalent is time critical within
+  // our current class.
+  const int level = policy == SchedulingPolicy::Normal ? THREAD_PRIORITY_NORMAL : THREAD_PRIORITY_TIME_CRITICAL;
+  return SetThreadPriority(thread->m_thread, level) != FALSE;
+}
+
+bool ArchMultithreadWindows::setAffinityOfThread(ArchThread thread, const std::vector<int> &cpus)
+{
+  assert(thread != nullptr);
+
+  DWORD_PTR processMask = 0;
+  DWORD_PTR systemMask = 0;
+  if (!GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask)) {
+    return false;
+  }
+
+  DWORD_PTR mask = 0;
+  for (int cpu : cpus) {
+    if (cpu >= 0 && cpu < static_cast<int>(sizeof(DWORD_PTR) * 8)) {
+      mask |= static_cast<DWORD_PTR>(1) << cpu;
+    }
+  }
+  if (cpus.empty()) {
+    mask = processMask;
+  }
+  return SetThreadAffinityMask(thread->m_thread, mask & processMask) != 0;
+}
+
 void ArchMultithreadWindows::testCancelThread()
 {
   // find current thread
@@ -474,6 +507,14 @@ IArchMultithread::ThreadID ArchMultithreadWindows::getIDOfThread(ArchThread thre
   return static_cast<ThreadID>(thread->m_id);
 }
 
+std::string ArchMultithreadWindows::getSchedulingOfThread(ArchThread thread)
+{
+  assert(thread != nullptr);
+
+  return "priority class " + std::to_string(GetPriorityClass(GetCurrentProcess())) + ", thread priority " +
+         std::to_string(GetThreadPriority(thread->m_thread));
+}
+
 void ArchMultithreadWindows::setSignalHandler(ThreadSignal signal, SignalFunc func, void *userData)
 {
   std::scoped_lock lock{m_threadMutex};
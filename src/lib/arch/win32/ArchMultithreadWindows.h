@@ -77,12 +77,15 @@ public:
   void closeThread(ArchThread) override;
   void cancelThread(ArchThread) override;
   void setPriorityOfThread(ArchThread, int n) override;
+  bool setSchedulingOfThread(ArchThread, SchedulingPolicy policy, int priority) override;
+  bool setAffinityOfThread(ArchThread, const std::vector<int> &cpus) override;
   void testCancelThread() override;
   bool wait(ArchThread, double timeout) override;
   bool isSameThread(ArchThread, ArchThread) override;
   bool isExitedThread(ArchThread) override;
   void *getResultOfThread(ArchThread) override;
   ThreadID getIDOfThread(ArchThread) override;
+  std::string getSchedulingOfThread(ArchThread) override;
   void setSignalHandler(ThreadSignal, SignalFunc, void *) override;
   void raiseSignal(ThreadSignal) override;
 
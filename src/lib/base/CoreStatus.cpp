@@ -0,0 +1,104 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "base/CoreStatus.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <mutex>
+
+namespace {
+
+std::mutex s_mutex;
+CoreStatus::Sink s_sink;
+
+// the last of each kind, replayed to a new sink
+QByteArray s_connection;
+QByteArray s_clients;
+QByteArray s_tls;
+
+QByteArray encode(const QJsonObject &message)
+{
+  return QJsonDocument(message).toJson(QJsonDocument::Compact);
+}
+
+void publish(QByteArray *last, const QByteArray &message)
+{
+  std::scoped_lock lock{s_mutex};
+  if (last != nullptr) {
+    if (*last == message) {
+      return;
+    }
+    *last = message;
+  }
+  if (s_sink) {
+    s_sink(message);
+  }
+}
+
+} // namespace
+
+//
+// CoreStatus
+//
+
+void CoreStatus::setSink(const Sink &sink)
+{
+  std::scoped_lock lock{s_mutex};
+  s_sink = sink;
+  if (!s_sink) {
+    return;
+  }
+
+  for (const auto *last : {&s_connection, &s_clients, &s_tls}) {
+    if (!last->isEmpty()) {
+      s_sink(*last);
+    }
+  }
+}
+
+void CoreStatus::setConnectionState(CoreConnectionState state)
+{
+  publish(&s_connection, encode({{"type", "connection"}, {"state", stateName(state)}}));
+}
+
+void CoreStatus::setClients(const std::vector<std::string> &names)
+{
+  QJsonArray array;
+  for (const auto &name : names) {
+    array.append(QString::fromStdString(name));
+  }
+  publish(&s_clients, encode({{"type", "clients"}, {"names", array}}));
+}
+
+void CoreStatus::setTlsProtocol(const std::string &protocol)
+{
+  publish(&s_tls, encode({{"type", "tls"}, {"protocol", QString::fromStdString(protocol)}}));
+}
+
+void CoreStatus::peerFingerprint(const std::string &sha256)
+{
+  // every connection is reported, the GUI ignores ones it already handled
+  publish(nullptr, encode({{"type", "fingerprint"}, {"sha256", QString::fromStdString(sha256)}}));
+}
+
+const char *CoreStatus::stateName(CoreConnectionState state)
+{
+  switch (state) {
+    using enum CoreConnectionState;
+  case Disconnected:
+    return "disconnected";
+  case Connecting:
+    return "connecting";
+  case Connected:
+    return "connected";
+  case Listening:
+    return "listening";
+  }
+  return "unknown";
+}
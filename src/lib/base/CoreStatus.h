@@ -0,0 +1,59 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <QByteArray>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+//! Connection state published to the GUI
+enum class CoreConnectionState
+{
+  Disconnected,
+  Connecting,
+  Connected,
+  Listening
+};
+
+//! State the core publishes to the GUI
+/*!
+The GUI used to infer connection state, the connected clients and the TLS
+details by searching every log line for known phrases.  The core now
+reports them here as typed messages instead, one compact JSON object per
+message:
+
+- \c {"type":"connection","state":"listening"}
+- \c {"type":"clients","names":["laptop"]}
+- \c {"type":"tls","protocol":"TLSv1.3"}
+- \c {"type":"fingerprint","sha256":"AB:CD:..."}
+
+Messages go to the sink set by setSink(), which is given the current
+state first so a late listener catches up.  Any thread may publish; the
+sink is called with a lock held so messages keep their order.
+*/
+class CoreStatus
+{
+public:
+  using Sink = std::function<void(const QByteArray &message)>;
+
+  //! Send messages to \p sink, or stop sending them if it is empty
+  static void setSink(const Sink &sink);
+
+  static void setConnectionState(CoreConnectionState state);
+
+  //! Set the names of the connected secondary screens
+  static void setClients(const std::vector<std::string> &names);
+
+  static void setTlsProtocol(const std::string &protocol);
+
+  //! Report a peer certificate, the GUI decides whether it is trusted
+  static void peerFingerprint(const std::string &sha256);
+
+  static const char *stateName(CoreConnectionState state);
+};
@@ -80,6 +80,7 @@ public:
     case Quit:
     case System:
     case Timer:
+    case CoroutineResume:
       break;
 
     default:
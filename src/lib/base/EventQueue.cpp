@@ -12,11 +12,29 @@
 #include "base/EventQueueTimer.h"
 #include "base/Log.h"
 #include "base/SimpleEventQueueBuffer.h"
+#include "base/Task.h"
+#include "base/Trace.h"
+#include "base/WakeupStats.h"
 #include "mt/Lock.h"
 #include "mt/Mutex.h"
 
+#include <algorithm>
+#include <coroutine>
 #include <stdexcept>
 
+#if defined(__linux__)
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// events taken from the buffer at once by loop().  the whole batch is
+// dispatched before the buffer is locked again.
+const size_t kMaxBatchSize = 64;
+
+} // namespace
+
 // interrupt handler.  this just adds a quit event to the queue.
 static void interrupt(Arch::ThreadSignal, void *data)
 {
@@ -33,13 +51,29 @@ EventQueue::EventQueue() : m_readyMutex(new Mutex), m_readyCondVar(new CondVar<b
   ARCH->setSignalHandler(Arch::ThreadSignal::Interrupt, &interrupt, this);
   ARCH->setSignalHandler(Arch::ThreadSignal::Terminate, &interrupt, this);
   m_buffer = std::make_unique<SimpleEventQueueBuffer>();
+
+#if defined(__linux__)
+  m_timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if (m_timerFd == -1) {
+    LOG_DEBUG("timerfd not available, timers use the wait timeout");
+  }
+#endif
 }
 
 EventQueue::~EventQueue()
 {
+  // coroutines waiting for a CoroutineResume event would otherwise leak
+  deskflow::destroyTasks(this);
+
   delete m_readyCondVar;
   delete m_readyMutex;
 
+#if defined(__linux__)
+  if (m_timerFd != -1) {
+    close(m_timerFd);
+  }
+#endif
+
   ARCH->setSignalHandler(Arch::ThreadSignal::Interrupt, nullptr, nullptr);
   ARCH->setSignalHandler(Arch::ThreadSignal::Terminate, nullptr, nullptr);
 }
@@ -60,12 +94,23 @@ void EventQueue::loop()
     m_pending.pop();
   }
 
-  Event event;
-  getEvent(event);
-  while (event.getType() != EventTypes::Quit) {
-    dispatchEvent(event);
-    Event::deleteData(event);
-    getEvent(event);
+  std::vector<Event> batch;
+  batch.reserve(kMaxBatchSize);
+  Stopwatch timer(true);
+  for (;;) {
+    batch.clear();
+    processEvents(batch, kMaxBatchSize, -1.0, timer);
+    for (auto it = batch.begin(); it != batch.end(); ++it) {
+      if (it->getType() == EventTypes::Quit) {
+        // the rest of the batch will never be dispatched
+        for (++it; it != batch.end(); ++it) {
+          Event::deleteData(*it);
+        }
+        return;
+      }
+      dispatchEvent(*it);
+      Event::deleteData(*it);
+    }
   }
 }
 
@@ -94,62 +139,86 @@ void EventQueue::adoptBuffer(IEventQueueBuffer *buffer)
   if (buffer == nullptr) {
     m_buffer = std::make_unique<SimpleEventQueueBuffer>();
   }
+  m_timerFdWatched = m_timerFd != -1 && m_buffer->watchTimerFd(m_timerFd);
 }
 
 bool EventQueue::processEvent(Event &event, double timeout, Stopwatch &timer)
 {
-  // if no events are waiting then handle timers and then wait
-  while (m_buffer->isEmpty()) {
-    // handle timers first
-    if (hasTimerExpired(event)) {
-      return true;
-    }
+  std::vector<Event> events;
+  if (processEvents(events, 1, timeout, timer) == 0) {
+    return false;
+  }
+  event = std::move(events.front());
+  return true;
+}
 
-    // get time remaining in timeout
-    double timeLeft = timeout - timer.getTime();
-    if (timeout >= 0.0 && timeLeft <= 0.0) {
-      return false;
+size_t EventQueue::processEvents(std::vector<Event> &events, size_t max, double timeout, Stopwatch &timer)
+{
+  for (;;) {
+    // if no events are waiting then handle timers and then wait
+    while (m_buffer->isEmpty()) {
+      // handle timers first
+      if (Event event; hasTimerExpired(event)) {
+        WakeupStats::add(WakeupSource::Timer);
+        events.push_back(std::move(event));
+        return 1;
+      }
+
+      // get time remaining in timeout
+      int64_t timeLeft = -1;
+      if (timeout >= 0.0) {
+        timeLeft = Stopwatch::toNanoseconds(timeout) - timer.getTimeNs();
+        if (timeLeft <= 0) {
+          return 0;
+        }
+      }
+
+      // get time until next timer expires.  if there is a timer
+      // and it'll expire before the client's timeout then use
+      // that duration for our timeout instead.
+      if (int64_t timerTimeout = getNextTimerTimeoutNs();
+          timerTimeout >= 0 && (timeLeft < 0 || timerTimeout < timeLeft)) {
+        timeLeft = timerTimeout;
+      }
+
+      // wait for an event
+      waitForEvent(timeLeft);
+      WakeupStats::add(WakeupSource::EventQueue);
     }
 
-    // get time until next timer expires.  if there is a timer
-    // and it'll expire before the client's timeout then use
-    // that duration for our timeout instead.
-    if (double timerTimeout = getNextTimerTimeout();
-        timeout < 0.0 || (timerTimeout >= 0.0 && timerTimeout < timeLeft)) {
-      timeLeft = timerTimeout;
+    // get the events
+    m_entries.clear();
+    if (m_buffer->getEvents(m_entries, max) > 0) {
+      break;
     }
 
-    // wait for an event
-    m_buffer->waitForEvent(timeLeft);
-  }
-
-  // get the event
-  uint32_t dataID;
-  IEventQueueBuffer::Type type = m_buffer->getEvent(event, dataID);
-  switch (type) {
-    using enum IEventQueueBuffer::Type;
-  case Unknown:
-    if (timeout < 0.0 || timeout <= timer.getTime()) {
-      // don't want to fail if client isn't expecting that
-      // so if getEvent() fails with an infinite timeout
-      // then just try getting another event.
-      processEvent(event, timeout, timer);
+    // don't want to fail if client isn't expecting that
+    // so if getEvents() fails with time left then just
+    // try getting more events.
+    if (timeout >= 0.0 && timeout <= timer.getTime()) {
+      return 0;
     }
-    return false;
+  }
 
-  case System:
-    return true;
+  // user events are saved here, look them all up under one lock
+  std::scoped_lock lock{m_mutex};
+  for (auto &entry : m_entries) {
+    switch (entry.type) {
+      using enum IEventQueueBuffer::Type;
+    case System:
+      events.push_back(std::move(entry.event));
+      break;
 
-  case User: {
-    std::scoped_lock lock{m_mutex};
-    event = removeEvent(dataID);
-    return true;
-  }
+    case User:
+      events.push_back(removeEvent(entry.dataID));
+      break;
 
-  default:
-    assert(0 && "invalid event type");
-    return false;
+    default:
+      assert(0 && "invalid event type");
+      break;
+    }
   }
+  return m_entries.size();
 }
 
 bool EventQueue::getEvent(Event &event, double timeout)
@@ -160,6 +229,16 @@ bool EventQueue::getEvent(Event &event, double timeout)
 
 bool EventQueue::dispatchEvent(const Event &event)
 {
+  TRACE(TracePoint::EventDispatched, event.getTarget(), static_cast<int64_t>(event.getType()));
+  m_dispatched.fetch_add(1, std::memory_order_relaxed);
+  const TraceScope scope(TraceSpan::Dispatch, event.getTarget(), static_cast<int64_t>(event.getType()));
+
+  // coroutines are resumed directly, they have no handler to look up
+  if (event.getType() == EventTypes::CoroutineResume) {
+    std::coroutine_handle<>::from_address(event.getData()).resume();
+    return true;
+  }
+
   void *target = event.getTarget();
   if (const auto *type_handler = getHandler(event.getType(), target); type_handler) {
     (*type_handler)(event);
@@ -185,6 +264,9 @@ void EventQueue::addEvent(Event &&event)
     break;
   }
 
+  TRACE(TracePoint::EventAdded, event.getTarget(), static_cast<int64_t>(event.getType()));
+  m_added.fetch_add(1, std::memory_order_relaxed);
+
   if ((event.getFlags() & Event::EventFlags::DeliverImmediately) != 0) {
     dispatchEvent(event);
     Event::deleteData(event);
@@ -212,22 +294,15 @@ void EventQueue::addEventToBuffer(Event &&event)
 
 EventQueueTimer *EventQueue::newTimer(double duration, void *target)
 {
-  assert(duration > 0.0);
-
-  auto timer = new EventQueueTimer;
-  if (target == nullptr) {
-    target = timer;
-  }
-  std::scoped_lock lock{m_mutex};
-  m_timers.insert(timer);
-  // initial duration is requested duration plus whatever's on
-  // the clock currently because the latter will be subtracted
-  // the next time we check for timers.
-  m_timerQueue.push(Timer(timer, duration, duration + m_time.getTime(), target, false));
-  return timer;
+  return addTimer(duration, target, false);
 }
 
 EventQueueTimer *EventQueue::newOneShotTimer(double duration, void *target)
+{
+  return addTimer(duration, target, true);
+}
+
+EventQueueTimer *EventQueue::addTimer(double duration, void *target, bool oneShot)
 {
   assert(duration > 0.0);
 
@@ -235,12 +310,18 @@ EventQueueTimer *EventQueue::newOneShotTimer(double duration, void *target)
   if (target == nullptr) {
     target = timer;
   }
+
+  // timers are kept in integer nanoseconds so that counting down does
+  // not accumulate floating point error.  never round a tiny duration
+  // down to zero, that would make the timer fire continuously.
+  const int64_t timeout = std::max<int64_t>(Stopwatch::toNanoseconds(duration), 1);
+
   std::scoped_lock lock{m_mutex};
   m_timers.insert(timer);
   // initial duration is requested duration plus whatever's on
   // the clock currently because the latter will be subtracted
   // the next time we check for timers.
-  m_timerQueue.push(Timer(timer, duration, duration + m_time.getTime(), target, true));
+  m_timerQueue.push(Timer(timer, timeout, timeout + m_time.getTimeNs(), target, oneShot));
   return timer;
 }
 
@@ -347,9 +428,9 @@ bool EventQueue::hasTimerExpired(Event &event)
     return false;
   }
 
-  // get time elapsed since last check
-  const double time = m_time.getTime();
-  m_time.reset();
+  // get time elapsed since last check.  a single clock read both
+  // measures and restarts the interval so no time is lost between them.
+  const int64_t time = m_time.resetNs();
 
   // countdown elapsed time
   for (auto index = m_timerQueue.begin(); index != m_timerQueue.end(); ++index) {
@@ -357,7 +438,7 @@ bool EventQueue::hasTimerExpired(Event &event)
   }
 
   // done if no timers are expired
-  if (m_timerQueue.top() > 0.0) {
+  if (m_timerQueue.top() > 0) {
     return false;
   }
 
@@ -378,18 +459,40 @@ bool EventQueue::hasTimerExpired(Event &event)
   return true;
 }
 
-double EventQueue::getNextTimerTimeout() const
+int64_t EventQueue::getNextTimerTimeoutNs() const
 {
   // return -1 if no timers, 0 if the top timer has expired, otherwise
-  // the time until the top timer in the timer priority queue will
-  // expire.
+  // the nanoseconds until the top timer in the timer priority queue
+  // will expire.
   if (m_timerQueue.empty()) {
-    return -1.0;
+    return -1;
   }
-  if (m_timerQueue.top() <= 0.0) {
-    return 0.0;
+  return std::max<int64_t>(m_timerQueue.top(), 0);
+}
+
+void EventQueue::waitForEvent(int64_t timeoutNs)
+{
+#if defined(__linux__)
+  // the timerfd expires on the exact nanosecond, converting the timeout
+  // to the buffer's milliseconds would wake early and then spin on the
+  // remainder.  an all zero value disarms it, so an immediate expiry
+  // still needs one nanosecond.
+  if (m_timerFdWatched) {
+    itimerspec spec{};
+    if (timeoutNs >= 0) {
+      const auto ns = std::max<int64_t>(timeoutNs, 1);
+      spec.it_value.tv_sec = static_cast<time_t>(ns / 1'000'000'000);
+      spec.it_value.tv_nsec = static_cast<long>(ns % 1'000'000'000);
+    }
+    // setting the timer also clears a previous expiry
+    if (timerfd_settime(m_timerFd, 0, &spec, nullptr) == 0) {
+      m_buffer->waitForEvent(-1.0);
+      return;
+    }
   }
-  return m_timerQueue.top();
+#endif
+
+  m_buffer->waitForEvent(timeoutNs < 0 ? -1.0 : Stopwatch::toSeconds(timeoutNs));
 }
 
 void *EventQueue::getSystemTarget()
@@ -398,6 +501,18 @@ void *EventQueue::getSystemTarget()
   return &m_systemTarget;
 }
 
+IEventQueue::Stats EventQueue::getStats() const
+{
+  Stats stats;
+  stats.added = m_added.load(std::memory_order_relaxed);
+  stats.dispatched = m_dispatched.load(std::memory_order_relaxed);
+
+  std::scoped_lock lock{m_mutex};
+  stats.pending = m_events.size();
+  stats.timers = m_timers.size();
+  return stats;
+}
+
 void EventQueue::waitForReady() const
 {
   double timeout = Arch::time() + 10;
@@ -414,28 +529,35 @@ void EventQueue::waitForReady() const
 // EventQueue::Timer
 //
 
-EventQueue::Timer::Timer(EventQueueTimer *timer, double timeout, double initialTime, void *target, bool oneShot)
+EventQueue::Timer::Timer(EventQueueTimer *timer, int64_t timeout, int64_t initialTime, void *target, bool oneShot)
     : m_timer(timer),
       m_timeout(timeout),
       m_target(target),
       m_oneShot(oneShot),
       m_time(initialTime)
 {
-  assert(m_timeout > 0.0);
+  assert(m_timeout > 0);
 }
 
 void EventQueue::Timer::reset()
 {
-  m_time = m_timeout;
+  // keep the timer's phase by carrying the overshoot into the next
+  // period.  restarting from a full period would make a repeating timer
+  // drift later by the dispatch latency on every tick.
+  if (m_time <= 0) {
+    m_time += m_timeout * ((m_timeout - m_time) / m_timeout);
+  } else {
+    m_time = m_timeout;
+  }
 }
 
-EventQueue::Timer &EventQueue::Timer::operator-=(double dt)
+EventQueue::Timer &EventQueue::Timer::operator-=(int64_t dt)
 {
   m_time -= dt;
   return *this;
 }
 
-EventQueue::Timer::operator double() const
+EventQueue::Timer::operator int64_t() const
 {
   return m_time;
 }
@@ -459,7 +581,7 @@ void EventQueue::Timer::fillEvent(TimerEvent &event) const
 {
   event.m_timer = m_timer;
   event.m_count = 0;
-  if (m_time <= 0.0) {
+  if (m_time <= 0) {
     event.m_count = static_cast<uint32_t>((m_timeout - m_time) / m_timeout);
   }
 }
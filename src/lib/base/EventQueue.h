@@ -9,10 +9,12 @@
 #pragma once
 
 #include "base/IEventQueue.h"
+#include "base/IEventQueueBuffer.h"
 #include "base/PriorityQueue.h"
 #include "base/Stopwatch.h"
 #include "mt/CondVar.h"
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -48,13 +50,16 @@ public:
   void removeHandlers(void *target) override;
   void *getSystemTarget() override;
   void waitForReady() const override;
+  Stats getStats() const override;
 
 private:
   const EventHandler *getHandler(EventTypes type, void *target) const;
   uint32_t saveEvent(Event &&event);
   Event removeEvent(uint32_t eventID);
   bool hasTimerExpired(Event &event);
-  double getNextTimerTimeout() const;
+  int64_t getNextTimerTimeoutNs() const;
+  void waitForEvent(int64_t timeoutNs);
+  EventQueueTimer *addTimer(double duration, void *target, bool oneShot);
   void addEventToBuffer(Event &&event);
 
   //!
@@ -66,18 +71,30 @@ private:
   //!
   bool processEvent(Event &event, double timeout, Stopwatch &timer);
 
+  //!
+  //! \brief processEvents Take a batch of events
+  //! \param events - appended with up to \p max events
+  //! \param max - largest batch to take
+  //! \param timeout - Timeout to stop
+  //! \param timer - StopWatch to use
+  //! \return number of events appended, 0 on timeout
+  //!
+  size_t processEvents(std::vector<Event> &events, size_t max, double timeout, Stopwatch &timer);
+
 private:
   class Timer
   {
   public:
-    Timer(EventQueueTimer *, double timeout, double initialTime, void *target, bool oneShot);
+    Timer(EventQueueTimer *, int64_t timeout, int64_t initialTime, void *target, bool oneShot);
     ~Timer() = default;
 
     void reset();
 
-    Timer &operator-=(double);
+    //! Count down \c dt nanoseconds
+    Timer &operator-=(int64_t dt);
 
-    operator double() const;
+    //! Nanoseconds until the timer expires, <= 0 when expired
+    operator int64_t() const;
 
     bool isOneShot() const;
     EventQueueTimer *getTimer() const;
@@ -86,10 +103,10 @@ private:
 
   private:
     EventQueueTimer *m_timer;
-    double m_timeout;
+    int64_t m_timeout;
     void *m_target;
     bool m_oneShot;
-    double m_time;
+    int64_t m_time;
   };
 
   using Timers = std::set<EventQueueTimer *>;
@@ -109,16 +126,26 @@ private:
   EventTable m_events;
   EventIDList m_oldEventIDs;
 
+  // entries of the batch being taken from the buffer
+  std::vector<IEventQueueBuffer::Entry> m_entries;
+
   // timers
   Stopwatch m_time;
   Timers m_timers;
   TimerQueue m_timerQueue;
   TimerEvent m_timerEvent;
 
+  // a timerfd the buffer waits on along with its own fds, -1 if unused
+  int m_timerFd = -1;
+  bool m_timerFdWatched = false;
+
   // event handlers
   HandlerTable m_handlers;
 
   Mutex *m_readyMutex = nullptr;
   CondVar<bool> *m_readyCondVar = nullptr;
   std::queue<Event> m_pending;
+
+  std::atomic<uint64_t> m_added = 0;
+  std::atomic<uint64_t> m_dispatched = 0;
 };
@@ -25,6 +25,9 @@ enum class EventTypes : uint32_t
   /// This event is sent when a timer event occurs. The data is pointer to TimerInfo.
   Timer,
 
+  /// This event resumes a suspended coroutine on the event queue thread. The data is the coroutine handle address.
+  CoroutineResume,
+
   /// This event is sent when the client has successfully connected to the server.
   ClientConnected,
 
@@ -224,9 +227,21 @@ enum class EventTypes : uint32_t
   /// This event is sent whenever a clipboard chunk is transferred.
   ClipboardSending,
 
+  /// This event is sent when a file transfer finishes, successfully or not.
+  FileReceived,
+
+  /// A file transfer has more of a file to hash before it can go on.
+  FileTransferHashing,
+
+  /// This event is sent when a bulk data connection closes, the main connection is used again.
+  BulkChannelClosed,
+
   /// Start libEI
   EIConnected,
   /// Stop libEi
-  EISessionClosed
+  EISessionClosed,
+
+  /// The core status has messages waiting to be sent to the GUI.
+  StatusChannelPending
 };
 } // namespace deskflow
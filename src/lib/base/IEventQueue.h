@@ -38,6 +38,15 @@ public:
     uint32_t m_count;         //!< Number of repeats
   };
 
+  //! Counters describing the queue's activity
+  struct Stats
+  {
+    uint64_t added = 0;      //!< Events added since the queue was created
+    uint64_t dispatched = 0; //!< Events dispatched since the queue was created
+    size_t pending = 0;      //!< Events waiting to be dispatched
+    size_t timers = 0;       //!< Active timers
+  };
+
   //! @name manipulators
   //@{
 
@@ -156,5 +165,11 @@ public:
   */
   virtual void *getSystemTarget() = 0;
 
+  //! Get activity counters
+  /*!
+  Safe to call from any thread.
+  */
+  virtual Stats getStats() const = 0;
+
   //@}
 };
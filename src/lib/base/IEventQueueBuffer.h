@@ -8,10 +8,12 @@
 
 #pragma once
 
+#include "base/Event.h"
+
 #include <assert.h>
 #include <cstdint>
+#include <vector>
 
-class Event;
 class EventQueueTimer;
 
 //! Event queue buffer interface
@@ -29,6 +31,14 @@ public:
     User     //!< Event is a user event
   };
 
+  //! An event taken by \c getEvents()
+  struct Entry
+  {
+    Type type = Type::Unknown;
+    Event event;         //!< Filled in for a System event
+    uint32_t dataID = 0; //!< Filled in for a User event
+  };
+
   //! @name manipulators
   //@{
 
@@ -56,6 +66,28 @@ public:
   */
   virtual Type getEvent(Event &event, uint32_t &dataID) = 0;
 
+  //! Get up to \p max events
+  /*!
+  Append up to \p max events to \p entries, as \c getEvent() would
+  return them, locking the buffer only once.  Return the number of
+  events appended, 0 if none are available.  System event data may
+  point to a buffer that is reused by the next call.  The default
+  takes a single event with \c getEvent().
+  */
+  virtual size_t getEvents(std::vector<Entry> &entries, size_t max)
+  {
+    if (max == 0) {
+      return 0;
+    }
+    Entry entry;
+    entry.type = getEvent(entry.event, entry.dataID);
+    if (entry.type == Type::Unknown) {
+      return 0;
+    }
+    entries.push_back(std::move(entry));
+    return 1;
+  }
+
   //! Post an event
   /*!
   Add the given event to the end of the queue buffer.  This is a user
@@ -65,6 +97,19 @@ public:
   */
   virtual bool addEvent(uint32_t dataID) = 0;
 
+  //! Watch a timer file descriptor
+  /*!
+  Make \c waitForEvent() also return when \p fd becomes readable, which
+  lets the event queue arm a \c timerfd with nanosecond precision instead
+  of passing a timeout.  The buffer must not read from \p fd.  Return
+  false if the buffer can't wait on file descriptors, the queue then
+  keeps passing timeouts to \c waitForEvent().
+  */
+  virtual bool watchTimerFd(int fd [[maybe_unused]])
+  {
+    return false;
+  }
+
   //! Check if event queue buffer is empty
   /*!
   Return true iff the event queue buffer  is empty.
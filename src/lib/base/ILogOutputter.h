@@ -48,5 +48,15 @@ public:
   */
   virtual bool write(LogLevel level, const QString &message) = 0;
 
+  //! Flush buffered output
+  /*!
+  Writes out anything the outputter is holding back.  Called when the
+  log goes idle and before the process exits.  The default does nothing.
+  */
+  virtual void flush()
+  {
+    // do nothing
+  }
+
   //@}
 };
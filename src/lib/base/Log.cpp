@@ -14,6 +14,8 @@
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <string>
+#include <vector>
 
 #if HAVE_FORMAT
 #include <format>
@@ -57,7 +59,7 @@ LogLevel getPriority(const char *&fmt)
   return static_cast<LogLevel>(fmt[2] - '0');
 }
 
-std::vector<char> makeMessage(const char *filename, int lineNumber, const char *message, LogLevel priority)
+std::string makeMessage(const char *filename, int lineNumber, const char *message, LogLevel priority)
 {
 
   // base size includes null terminator, colon, space, etc.
@@ -82,8 +84,10 @@ std::vector<char> makeMessage(const char *filename, int lineNumber, const char *
     size_t filenameLength = strnlen(filename, SIZE_MAX);
     size_t lineNumberLength = snprintf(nullptr, 0, "%d", lineNumber);
     bufferSize += filenameLength + lineNumberLength;
+  }
 
-    std::vector<char> buffer(bufferSize);
+  std::string buffer(bufferSize, '\0');
+  if (filenameSet) {
 #if HAVE_FORMAT
     std::format_to_n(
         buffer.data(), bufferSize, "[{}] {}: {}\n\t{}:{}", timeStr.c_str(), sectionName, message, filename, lineNumber
@@ -93,16 +97,17 @@ std::vector<char> makeMessage(const char *filename, int lineNumber, const char *
         buffer.data(), bufferSize, "[%s] %s: %s\n\t%s:%d", timeStr.c_str(), sectionName, message, filename, lineNumber
     );
 #endif
-    return buffer;
   } else {
-    std::vector<char> buffer(bufferSize);
 #if HAVE_FORMAT
     std::format_to_n(buffer.data(), bufferSize, "[{}] {}: {}", timeStr.c_str(), sectionName, message);
 #else
     snprintf(buffer.data(), bufferSize, "[%s] %s: %s", timeStr.c_str(), sectionName, message);
 #endif
-    return buffer;
   }
+
+  // the buffer is sized generously, trim it to the formatted text
+  buffer.resize(strnlen(buffer.data(), bufferSize));
+  return buffer;
 }
 } // namespace
 
@@ -134,6 +139,8 @@ Log::Log(Log *src)
 
 Log::~Log()
 {
+  stopWriter();
+
   // clean up
   for (auto index = m_outputters.begin(); index != m_outputters.end(); ++index) {
     delete *index;
@@ -192,12 +199,20 @@ void Log::print(const char *file, int line, const char *fmt, ...)
     }
   }
 
-  if (priority == LogLevel::Print) {
-    output(priority, buffer.data());
-  } else {
-    auto message = makeMessage(file, line, buffer.data(), priority);
-    output(priority, message.data());
+  auto message = priority == LogLevel::Print ? std::string(buffer.data())
+                                              : makeMessage(file, line, buffer.data(), priority);
+
+  if (priority > LogLevel::Fatal) {
+    std::shared_lock lock{m_queueMutex};
+    if (m_writerRunning.load(std::memory_order_acquire)) {
+      enqueue(priority, message);
+      return;
+    }
   }
+
+  // keep direct output in order with anything still queued
+  waitForWriter();
+  output(priority, message.c_str());
 }
 
 void Log::insert(ILogOutputter *adoptedOutputter, bool alwaysAtHead)
@@ -216,6 +231,7 @@ void Log::insert(ILogOutputter *adoptedOutputter, bool alwaysAtHead)
 
 void Log::remove(ILogOutputter *outputter)
 {
+  waitForWriter();
   std::scoped_lock lock{m_mutex};
   m_outputters.remove(outputter);
   m_alwaysOutputters.remove(outputter);
@@ -223,6 +239,7 @@ void Log::remove(ILogOutputter *outputter)
 
 void Log::pop_front(bool alwaysAtHead)
 {
+  waitForWriter();
   std::scoped_lock lock{m_mutex};
   OutputterList *list = alwaysAtHead ? &m_alwaysOutputters : &m_outputters;
   if (!list->empty()) {
@@ -248,14 +265,166 @@ bool Log::setFilter(const QString &maxPriority)
 
 void Log::setFilter(LogLevel maxPriority)
 {
-  std::scoped_lock lock{m_mutex};
-  m_maxPriority = maxPriority;
+  m_maxPriority.store(maxPriority, std::memory_order_relaxed);
 }
 
 LogLevel Log::getFilter() const
+{
+  return m_maxPriority.load(std::memory_order_relaxed);
+}
+
+uint64_t Log::getDroppedCount() const
+{
+  return m_dropped.load(std::memory_order_relaxed);
+}
+
+void Log::startWriter(size_t capacity, LogQueue::Overflow overflow)
+{
+  std::scoped_lock lock{m_queueMutex};
+  if (m_writerRunning.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  // nobody is pushing while we hold the lock, so the queue can be replaced
+  if (!m_queue || m_queue->capacity() < capacity) {
+    m_queue = std::make_unique<LogQueue>(capacity);
+  }
+  m_overflow = overflow;
+  m_writerStopping.store(false, std::memory_order_relaxed);
+  m_writer = std::thread(&Log::writerLoop, this);
+  m_writerRunning.store(true, std::memory_order_release);
+}
+
+void Log::stopWriter()
+{
+  // once the flag is down under the lock nothing else is pushed, so what
+  // the writer leaves behind is all there is
+  {
+    std::scoped_lock lock{m_queueMutex};
+    if (!m_writerRunning.exchange(false, std::memory_order_acq_rel)) {
+      return;
+    }
+  }
+
+  m_writerStopping.store(true, std::memory_order_release);
+  m_writerWakeups.fetch_add(1, std::memory_order_release);
+  m_writerWakeups.notify_one();
+  m_writer.join();
+
+  // write anything pushed while the writer was finishing
+  writeQueued();
+}
+
+void Log::flush()
+{
+  waitForWriter();
+  flushOutputters();
+}
+
+void Log::waitForWriter()
+{
+  if (!m_writerRunning.load(std::memory_order_acquire) || isWriterThread()) {
+    return;
+  }
+
+  const auto queued = m_queued.load(std::memory_order_acquire);
+  wakeWriter();
+  for (auto written = m_written.load(std::memory_order_acquire); written < queued;
+       written = m_written.load(std::memory_order_acquire)) {
+    m_written.wait(written, std::memory_order_acquire);
+  }
+}
+
+void Log::enqueue(LogLevel priority, std::string &message)
+{
+  // notes, warnings and errors are what's needed after a crash, so they always wait
+  const bool droppable = m_overflow == LogQueue::Overflow::Drop && priority > LogLevel::Note;
+  while (!m_queue->tryPush(priority, message)) {
+    // the writer can't wait on itself, so it always drops
+    if (droppable || isWriterThread()) {
+      m_dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    wakeWriter();
+    std::this_thread::yield();
+  }
+  m_queued.fetch_add(1, std::memory_order_release);
+  wakeWriter();
+}
+
+void Log::wakeWriter()
+{
+  // pairs with the fence in writerLoop(): either the writer sees the new
+  // message before sleeping, or we see that it is about to sleep
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (m_writerSleeping.load(std::memory_order_relaxed) && m_writerSleeping.exchange(false)) {
+    m_writerWakeups.fetch_add(1, std::memory_order_release);
+    m_writerWakeups.notify_one();
+  }
+}
+
+void Log::writerLoop()
+{
+  while (true) {
+    writeQueued();
+
+    if (m_writerStopping.load(std::memory_order_acquire)) {
+      break;
+    }
+
+    // nothing more to write for now, don't leave lines sitting in buffers
+    if (m_written.load(std::memory_order_relaxed) != m_flushedAt) {
+      m_flushedAt = m_written.load(std::memory_order_relaxed);
+      flushOutputters();
+    }
+
+    const auto wakeups = m_writerWakeups.load(std::memory_order_acquire);
+    m_writerSleeping.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!m_queue->isEmpty() || m_writerStopping.load(std::memory_order_acquire)) {
+      m_writerSleeping.store(false, std::memory_order_relaxed);
+      continue;
+    }
+    m_writerWakeups.wait(wakeups, std::memory_order_acquire);
+  }
+}
+
+void Log::writeQueued()
+{
+  LogLevel priority;
+  std::string message;
+  uint64_t written = 0;
+  while (m_queue->tryPop(priority, message)) {
+    output(priority, message.c_str());
+    ++written;
+  }
+
+  if (const auto dropped = m_dropped.load(std::memory_order_relaxed); dropped != m_droppedReported) {
+    const auto text = std::to_string(dropped - m_droppedReported) + " log message(s) dropped, queue full";
+    m_droppedReported = dropped;
+    output(LogLevel::Warning, makeMessage(nullptr, 0, text.c_str(), LogLevel::Warning).c_str());
+  }
+
+  if (written > 0) {
+    m_written.fetch_add(written, std::memory_order_release);
+    m_written.notify_all();
+  }
+}
+
+void Log::flushOutputters()
 {
   std::scoped_lock lock{m_mutex};
-  return m_maxPriority;
+  for (auto *outputter : m_alwaysOutputters) {
+    outputter->flush();
+  }
+  for (auto *outputter : m_outputters) {
+    outputter->flush();
+  }
+}
+
+bool Log::isWriterThread() const
+{
+  return std::this_thread::get_id() == m_writer.get_id();
 }
 
 void Log::output(LogLevel priority, const char *msg)
@@ -8,9 +8,16 @@
 #pragma once
 
 #include "LogLevel.h"
+#include "LogQueue.h"
 
+#include <atomic>
+#include <cstdint>
 #include <list>
+#include <memory>
 #include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
 
 #include <QString>
 
@@ -26,6 +33,11 @@ The logging class;  all console output should go through this class.
 It supports multithread safe operation, several message priority levels,
 filtering by priority, and output redirection.  The macros LOG() and
 LOGC() provide convenient access.
+
+By default outputters are called on the thread that logs the message.
+After startWriter() messages are instead formatted by the caller and
+handed to a background writer thread through a lock-free queue, so the
+event loop and socket threads do not wait on console or file output.
 */
 class Log
 {
@@ -90,6 +102,34 @@ public:
   //! Set the minimum priority filter (by ordinal).
   void setFilter(LogLevel);
 
+  //! Start the background writer
+  /*!
+  From now on messages are queued, up to \p capacity of them, and written
+  to the outputters by a writer thread.  When the queue is full
+  \p overflow decides whether a message is dropped (the writer reports
+  how many were lost) or the logging thread waits for room.  NOTE,
+  WARNING and ERROR messages always wait.
+
+  FATAL, PRINT and IPC messages flush the queue and are written directly,
+  so they are never dropped or reordered, and neither are messages
+  queued before an outputter is removed.
+  */
+  void startWriter(size_t capacity, LogQueue::Overflow overflow = LogQueue::Overflow::Drop);
+
+  //! Stop the background writer
+  /*!
+  Writes any queued messages and returns to writing on the calling thread.
+  This does nothing if the writer is not running.
+  */
+  void stopWriter();
+
+  //! Write out pending messages
+  /*!
+  Blocks until every message queued so far has been written, then asks
+  each outputter to flush what it has buffered.
+  */
+  void flush();
+
   //@}
   //! @name accessors
   //@{
@@ -105,6 +145,9 @@ public:
   //! Get the minimum priority level.
   LogLevel getFilter() const;
 
+  //! Get the number of messages dropped because the queue was full
+  uint64_t getDroppedCount() const;
+
   //! Get the filter name of the current filter level.
   const char *getFilterName() const;
 
@@ -114,6 +157,16 @@ public:
   //! Get the singleton instance of the log
   static Log *getInstance();
 
+  //! Test if a level passes the filter of the singleton log
+  /*!
+  A single relaxed atomic load, used by the LOG_* macros to skip
+  formatting and argument evaluation for filtered messages.
+  */
+  static bool isEnabled(LogLevel level)
+  {
+    return level <= s_log->m_maxPriority.load(std::memory_order_relaxed);
+  }
+
   //! Get the console filter level (messages above this are not sent to
   //! console).
   LogLevel getConsoleMaxLevel() const
@@ -125,6 +178,13 @@ public:
 
 private:
   void output(LogLevel priority, const char *msg);
+  void enqueue(LogLevel priority, std::string &message);
+  void wakeWriter();
+  void writerLoop();
+  void writeQueued();
+  void waitForWriter();
+  void flushOutputters();
+  bool isWriterThread() const;
 
 private:
   using OutputterList = std::list<ILogOutputter *>;
@@ -134,7 +194,23 @@ private:
   mutable std::mutex m_mutex;
   OutputterList m_outputters;
   OutputterList m_alwaysOutputters;
-  LogLevel m_maxPriority;
+  std::atomic<LogLevel> m_maxPriority;
+
+  // held shared while pushing and exclusively while the writer starts or
+  // stops, so no message is pushed to a queue nobody will read
+  std::shared_mutex m_queueMutex;
+  std::unique_ptr<LogQueue> m_queue;
+  LogQueue::Overflow m_overflow = LogQueue::Overflow::Drop;
+  std::thread m_writer;
+  std::atomic<bool> m_writerRunning = false;
+  std::atomic<bool> m_writerStopping = false;
+  std::atomic<bool> m_writerSleeping = false;
+  std::atomic<uint32_t> m_writerWakeups = 0;
+  std::atomic<uint64_t> m_queued = 0;
+  std::atomic<uint64_t> m_written = 0;
+  std::atomic<uint64_t> m_dropped = 0;
+  uint64_t m_droppedReported = 0;
+  uint64_t m_flushedAt = 0;
 };
 
 /*!
@@ -154,6 +230,9 @@ If \c NOLOGGING is defined during the build then this macro expands to
 nothing.  If \c NDEBUG is defined during the build then it expands to a
 call to Log::print.  Otherwise it expands to a call to Log::print,
 which includes the filename and line number.
+
+Prefer the LOG_XXX() macros, which check the level before the arguments
+are evaluated.
 */
 
 /*!
@@ -213,16 +292,41 @@ otherwise it expands to a call that doesn't.
 #define CLOG_DEBUG4 CLOG_TRACE "%z\071" // char is '9'
 #define CLOG_DEBUG5 CLOG_TRACE "%z\072" // char is ':'
 
-#define LOG_IPC(...) LOG((CLOG_IPC __VA_ARGS__))
-#define LOG_PRINT(...) LOG((CLOG_PRINT __VA_ARGS__))
-#define LOG_CRIT(...) LOG((CLOG_CRIT __VA_ARGS__))
-#define LOG_ERR(...) LOG((CLOG_ERR __VA_ARGS__))
-#define LOG_WARN(...) LOG((CLOG_WARN __VA_ARGS__))
-#define LOG_NOTE(...) LOG((CLOG_NOTE __VA_ARGS__))
-#define LOG_INFO(...) LOG((CLOG_INFO __VA_ARGS__))
-#define LOG_DEBUG(...) LOG((CLOG_DEBUG __VA_ARGS__))
-#define LOG_DEBUG1(...) LOG((CLOG_DEBUG1 __VA_ARGS__))
-#define LOG_DEBUG2(...) LOG((CLOG_DEBUG2 __VA_ARGS__))
-#define LOG_DEBUG3(...) LOG((CLOG_DEBUG3 __VA_ARGS__))
-#define LOG_DEBUG4(...) LOG((CLOG_DEBUG4 __VA_ARGS__))
-#define LOG_DEBUG5(...) LOG((CLOG_DEBUG5 __VA_ARGS__))
+/*!
+\def LOG_MAX_LEVEL
+The highest level, as the integer value of a LogLevel, compiled into the
+build.  LOG_XXX() statements above it are discarded at compile time and
+cost nothing at run time.  Set with the LOG_MAX_LEVEL cmake option.
+*/
+#ifndef LOG_MAX_LEVEL
+#define LOG_MAX_LEVEL 10 // LogLevel::Debug5
+#endif
+
+/*!
+\def LOG_AT(level, arg)
+Write to the log if \c level passes both the compile time maximum and the
+current filter.  Neither the format nor the arguments in \c arg are
+evaluated otherwise.
+*/
+#define LOG_AT(_level, _a1)                                                                                            \
+  do {                                                                                                                 \
+    if constexpr (static_cast<int>(_level) <= LOG_MAX_LEVEL) {                                                         \
+      if (::Log::isEnabled(_level)) {                                                                                  \
+        LOG(_a1);                                                                                                      \
+      }                                                                                                                \
+    }                                                                                                                  \
+  } while (false)
+
+#define LOG_IPC(...) LOG_AT(LogLevel::IPC, (CLOG_IPC __VA_ARGS__))
+#define LOG_PRINT(...) LOG_AT(LogLevel::Print, (CLOG_PRINT __VA_ARGS__))
+#define LOG_CRIT(...) LOG_AT(LogLevel::Fatal, (CLOG_CRIT __VA_ARGS__))
+#define LOG_ERR(...) LOG_AT(LogLevel::Error, (CLOG_ERR __VA_ARGS__))
+#define LOG_WARN(...) LOG_AT(LogLevel::Warning, (CLOG_WARN __VA_ARGS__))
+#define LOG_NOTE(...) LOG_AT(LogLevel::Note, (CLOG_NOTE __VA_ARGS__))
+#define LOG_INFO(...) LOG_AT(LogLevel::Info, (CLOG_INFO __VA_ARGS__))
+#define LOG_DEBUG(...) LOG_AT(LogLevel::Debug, (CLOG_DEBUG __VA_ARGS__))
+#define LOG_DEBUG1(...) LOG_AT(LogLevel::Debug1, (CLOG_DEBUG1 __VA_ARGS__))
+#define LOG_DEBUG2(...) LOG_AT(LogLevel::Debug2, (CLOG_DEBUG2 __VA_ARGS__))
+#define LOG_DEBUG3(...) LOG_AT(LogLevel::Debug3, (CLOG_DEBUG3 __VA_ARGS__))
+#define LOG_DEBUG4(...) LOG_AT(LogLevel::Debug4, (CLOG_DEBUG4 __VA_ARGS__))
+#define LOG_DEBUG5(...) LOG_AT(LogLevel::Debug5, (CLOG_DEBUG5 __VA_ARGS__))
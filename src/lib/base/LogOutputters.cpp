@@ -9,11 +9,17 @@
 #include "base/LogOutputters.h"
 #include "arch/Arch.h"
 
+#include <algorithm>
 #include <iostream>
+#include <utility>
+
+#if SYSAPI_WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
-#include <QFile>
 #include <QString>
-#include <QTextStream>
 
 constexpr auto s_logFileSizeLimit = 1024 * 1024; //!< Max Log size before rotating (1Mb)
 
@@ -60,7 +66,7 @@ bool ConsoleLogOutputter::write(LogLevel level, const QString &msg)
   return true;
 }
 
-void ConsoleLogOutputter::flush() const
+void ConsoleLogOutputter::flush()
 {
   // do nothing
 }
@@ -115,41 +121,198 @@ SystemLogger::~SystemLogger()
 // FileLogOutputter
 //
 
-FileLogOutputter::FileLogOutputter(const QString &logFile)
+FileLogOutputter::FileLogOutputter(const QString &logFile) : m_maxSize(s_logFileSizeLimit)
 {
   setLogFilename(logFile);
 }
 
+FileLogOutputter::~FileLogOutputter()
+{
+  close();
+}
+
 void FileLogOutputter::setLogFilename(const QString &logFile)
 {
   assert(logFile != nullptr);
+
+  std::scoped_lock lock{m_mutex};
+  if (m_fileName == logFile) {
+    return;
+  }
+
+  const bool wasOpen = m_file.isOpen();
+  closeFile();
   m_fileName = logFile;
+  if (wasOpen) {
+    openFile();
+  }
+}
+
+void FileLogOutputter::setMaxSize(qint64 bytes)
+{
+  std::scoped_lock lock{m_mutex};
+  m_maxSize = bytes;
+}
+
+void FileLogOutputter::setGenerations(int generations)
+{
+  std::scoped_lock lock{m_mutex};
+  m_generations = std::max(generations, 0);
+}
+
+void FileLogOutputter::setFlushInterval(double seconds)
+{
+  std::scoped_lock lock{m_mutex};
+  m_flushInterval = seconds;
 }
 
-bool FileLogOutputter::write(LogLevel, const QString &message)
+bool FileLogOutputter::write(LogLevel level, const QString &message)
 {
-  QFile file(m_fileName);
-  if (!file.open(QFile::WriteOnly | QFile::Append))
+  // the windows watchdog writes from its own thread as well as through Log
+  std::scoped_lock lock{m_mutex};
+  if (!m_file.isOpen() && !openFile()) {
     return false;
+  }
 
-  QTextStream(&file) << message << Qt::endl;
-  file.close();
+  auto line = message.toUtf8();
+  line.append('\n');
 
-  if (file.size() > s_logFileSizeLimit) {
-    const auto oldFile = QStringLiteral("%1.1").arg(m_fileName);
-    QFile::remove(m_fileName);
-    QFile::rename(m_fileName, oldFile);
+  if (m_size > 0 && m_size + line.size() > m_maxSize) {
+    rotate();
+    if (!m_file.isOpen()) {
+      return false;
+    }
+  }
+
+  if (const auto written = m_file.write(line); written > 0) {
+    m_size += written;
+  }
+
+  // errors are what gets read after a crash, make sure they are on disk
+  if (level >= LogLevel::Fatal && level <= LogLevel::Error) {
+    sync();
+  } else if (m_sinceFlush.getTime() >= m_flushInterval) {
+    m_file.flush();
+    m_sinceFlush.reset();
   }
 
   return true;
 }
 
-void FileLogOutputter::open(const QString &title)
+void FileLogOutputter::flush()
 {
-  // do nothing
+  std::scoped_lock lock{m_mutex};
+  if (m_file.isOpen()) {
+    m_file.flush();
+    m_sinceFlush.reset();
+  }
+}
+
+void FileLogOutputter::open(const QString &)
+{
+  std::scoped_lock lock{m_mutex};
+  if (!m_file.isOpen()) {
+    openFile();
+  }
 }
 
 void FileLogOutputter::close()
+{
+  std::scoped_lock lock{m_mutex};
+  closeFile();
+}
+
+bool FileLogOutputter::openFile()
+{
+  m_file.setFileName(m_fileName);
+  if (!m_file.open(QFile::WriteOnly | QFile::Append)) {
+    return false;
+  }
+
+  // track the size from here on rather than asking the file system per line
+  m_size = m_file.size();
+  m_sinceFlush.reset();
+  return true;
+}
+
+void FileLogOutputter::closeFile()
+{
+  if (m_file.isOpen()) {
+    sync();
+    m_file.close();
+  }
+}
+
+void FileLogOutputter::rotate()
+{
+  closeFile();
+
+  if (m_generations == 0) {
+    QFile::remove(m_fileName);
+  } else {
+    QFile::remove(QStringLiteral("%1.%2").arg(m_fileName).arg(m_generations));
+    for (int i = m_generations - 1; i > 0; --i) {
+      QFile::rename(QStringLiteral("%1.%2").arg(m_fileName).arg(i), QStringLiteral("%1.%2").arg(m_fileName).arg(i + 1));
+    }
+    QFile::rename(m_fileName, QStringLiteral("%1.1").arg(m_fileName));
+  }
+
+  openFile();
+}
+
+void FileLogOutputter::sync()
+{
+  m_file.flush();
+  m_sinceFlush.reset();
+#if SYSAPI_WIN32
+  _commit(m_file.handle());
+#else
+  fsync(m_file.handle());
+#endif
+}
+
+//
+// QueueLogOutputter
+//
+
+QueueLogOutputter::QueueLogOutputter(qsizetype capacity) : m_capacity(std::max<qsizetype>(capacity, 1))
+{
+  // do nothing
+}
+
+void QueueLogOutputter::open(const QString &)
+{
+  // do nothing
+}
+
+void QueueLogOutputter::close()
 {
   // do nothing
 }
+
+bool QueueLogOutputter::write(LogLevel, const QString &message)
+{
+  // the windows watchdog writes from its own thread as well as through Log
+  std::scoped_lock lock{m_mutex};
+  if (m_queue.size() >= m_capacity) {
+    m_queue.removeFirst();
+  }
+  m_queue.append(message);
+
+  if (m_queue.size() == 1 && m_notifier) {
+    m_notifier();
+  }
+  return true;
+}
+
+void QueueLogOutputter::setNotifier(const Notifier &notifier)
+{
+  std::scoped_lock lock{m_mutex};
+  m_notifier = notifier;
+}
+
+QStringList QueueLogOutputter::take()
+{
+  std::scoped_lock lock{m_mutex};
+  return std::exchange(m_queue, {});
+}
@@ -9,8 +9,15 @@
 #pragma once
 
 #include "base/ILogOutputter.h"
+#include "base/Stopwatch.h"
 
+#include <functional>
+#include <mutex>
+
+#include <QFile>
 #include <QString>
+#include <QStringList>
+
 //! Stop traversing log chain outputter
 /*!
 This outputter performs no output and returns false from \c write(),
@@ -44,30 +51,105 @@ public:
   void open(const QString &title) override;
   void close() override;
   bool write(LogLevel level, const QString &message) override;
-  void flush() const;
+  void flush() override;
 };
 
 //! Write log to file
 /*!
 This outputter writes output to the file.  The level for each
-message is ignored.
+message is ignored, except that errors are flushed and synced to disk
+straight away.
+
+The file is kept open.  With a flush interval lines are buffered and
+flushed when the interval has passed, when Log::flush() is called and on
+close; only the background log writer calls Log::flush() when the log
+goes idle, so nothing else should set an interval.  Once the file would grow past the maximum size it is rotated:
+\c file becomes \c file.1, \c file.1 becomes \c file.2 and so on, keeping
+at most the configured number of old generations.
 */
-
 class FileLogOutputter : public ILogOutputter
 {
 public:
   explicit FileLogOutputter(const QString &logFile);
-  ~FileLogOutputter() override = default;
+  FileLogOutputter(FileLogOutputter const &) = delete;
+  FileLogOutputter(FileLogOutputter &&) = delete;
+  ~FileLogOutputter() override;
+
+  FileLogOutputter &operator=(FileLogOutputter const &) = delete;
+  FileLogOutputter &operator=(FileLogOutputter &&) = delete;
 
   // ILogOutputter overrides
   void open(const QString &title) override;
   void close() override;
   bool write(LogLevel level, const QString &message) override;
+  void flush() override;
 
   void setLogFilename(const QString &title);
 
+  //! Set the size in bytes at which the file is rotated
+  void setMaxSize(qint64 bytes);
+
+  //! Set how many rotated files to keep, 0 truncates instead
+  void setGenerations(int generations);
+
+  //! Set the longest time, in seconds, a line may sit in the buffer
+  /*!
+  The interval is only checked as lines are written, so the last lines
+  before a quiet spell wait for Log::flush().  The default of 0 writes
+  every line out at once.
+  */
+  void setFlushInterval(double seconds);
+
+private:
+  bool openFile();
+  void closeFile();
+  void rotate();
+  void sync();
+
 private:
+  std::mutex m_mutex;
   QString m_fileName;
+  QFile m_file;
+  qint64 m_size = 0;
+  qint64 m_maxSize;
+  int m_generations = 1;
+  double m_flushInterval = 0.0;
+  Stopwatch m_sinceFlush{false, Stopwatch::Clock::Coarse};
+};
+
+//! Queue log for another thread
+/*!
+This outputter holds messages until take() is called, dropping the
+oldest once the capacity is reached.  The notifier is called when a
+message is queued after the last take(), so the reader is woken once
+per batch rather than once per line.  The level for each message is
+ignored.
+*/
+class QueueLogOutputter : public ILogOutputter
+{
+public:
+  //! Called with the queue locked, must not log or block
+  using Notifier = std::function<void()>;
+
+  explicit QueueLogOutputter(qsizetype capacity = 1000);
+  ~QueueLogOutputter() override = default;
+
+  // ILogOutputter overrides
+  void open(const QString &title) override;
+  void close() override;
+  bool write(LogLevel level, const QString &message) override;
+
+  //! Set the function called when the queue stops being empty
+  void setNotifier(const Notifier &notifier);
+
+  //! Take every queued message
+  QStringList take();
+
+private:
+  std::mutex m_mutex;
+  qsizetype m_capacity;
+  QStringList m_queue;
+  Notifier m_notifier;
 };
 
 //! Write log to system log
@@ -0,0 +1,70 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "base/LogQueue.h"
+
+#include <algorithm>
+#include <bit>
+
+//
+// LogQueue
+//
+// each slot carries a sequence number: equal to the slot's position when it
+// is free for the producer claiming that position, and position + 1 once the
+// message has been written and may be consumed.
+//
+
+LogQueue::LogQueue(size_t capacity)
+    : m_slots(std::make_unique<Slot[]>(std::bit_ceil(std::max<size_t>(capacity, 2)))),
+      m_mask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1)
+{
+  for (size_t i = 0; i <= m_mask; ++i) {
+    m_slots[i].m_sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+bool LogQueue::tryPush(LogLevel level, std::string &message)
+{
+  size_t position = m_head.load(std::memory_order_relaxed);
+  for (;;) {
+    Slot &slot = m_slots[position & m_mask];
+    const size_t sequence = slot.m_sequence.load(std::memory_order_acquire);
+    const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+    if (difference == 0) {
+      if (m_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+        slot.m_level = level;
+        slot.m_message.swap(message);
+        slot.m_sequence.store(position + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (difference < 0) {
+      // the consumer has not freed this slot yet
+      return false;
+    } else {
+      position = m_head.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+bool LogQueue::tryPop(LogLevel &level, std::string &message)
+{
+  Slot &slot = m_slots[m_tail & m_mask];
+  if (slot.m_sequence.load(std::memory_order_acquire) != m_tail + 1) {
+    return false;
+  }
+
+  level = slot.m_level;
+  message.swap(slot.m_message);
+  slot.m_message.clear();
+  slot.m_sequence.store(m_tail + m_mask + 1, std::memory_order_release);
+  ++m_tail;
+  return true;
+}
+
+bool LogQueue::isEmpty() const
+{
+  return m_slots[m_tail & m_mask].m_sequence.load(std::memory_order_acquire) != m_tail + 1;
+}
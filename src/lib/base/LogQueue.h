@@ -0,0 +1,87 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "base/LogLevel.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+//! Bounded multi-producer single-consumer queue of log records
+/*!
+A fixed size ring of preformatted log messages.  Any number of threads
+may push concurrently without taking a lock; a single thread (the log
+writer) pops.  The capacity is rounded up to a power of two.
+*/
+class LogQueue
+{
+public:
+  //! What to do when a message is logged while the queue is full
+  enum class Overflow : uint8_t
+  {
+    Drop, //!< Discard the message and count it as dropped
+    Block //!< Wait for the writer to make room
+  };
+
+  explicit LogQueue(size_t capacity);
+  LogQueue(LogQueue const &) = delete;
+  LogQueue(LogQueue &&) = delete;
+  ~LogQueue() = default;
+
+  LogQueue &operator=(LogQueue const &) = delete;
+  LogQueue &operator=(LogQueue &&) = delete;
+
+  //! @name manipulators
+  //@{
+
+  //! Add a message
+  /*!
+  Moves \p message into the queue.  Returns false, leaving \p message
+  untouched, if the queue is full.  Safe to call from any thread.
+  */
+  bool tryPush(LogLevel level, std::string &message);
+
+  //! Remove the oldest message
+  /*!
+  Returns false if the queue is empty.  Must only be called by the
+  consumer thread.
+  */
+  bool tryPop(LogLevel &level, std::string &message);
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Test if the queue has no messages ready to pop
+  bool isEmpty() const;
+
+  //! Get the number of slots
+  size_t capacity() const
+  {
+    return m_mask + 1;
+  }
+
+  //@}
+
+private:
+  struct Slot
+  {
+    std::atomic<size_t> m_sequence;
+    LogLevel m_level = LogLevel::Print;
+    std::string m_message;
+  };
+
+  std::unique_ptr<Slot[]> m_slots;
+  size_t m_mask;
+
+  // producers and the consumer touch these from different threads, keep
+  // them on separate cache lines
+  alignas(64) std::atomic<size_t> m_head = 0;
+  alignas(64) size_t m_tail = 0;
+};
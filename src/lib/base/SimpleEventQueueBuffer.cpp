@@ -54,6 +54,18 @@ IEventQueueBuffer::Type SimpleEventQueueBuffer::getEvent(Event &, uint32_t &data
   return IEventQueueBuffer::Type::User;
 }
 
+size_t SimpleEventQueueBuffer::getEvents(std::vector<Entry> &entries, size_t max)
+{
+  ArchMutexLock lock(m_queueMutex);
+  size_t count = 0;
+  for (; count < max && !m_queue.empty(); ++count) {
+    entries.push_back({IEventQueueBuffer::Type::User, Event(), m_queue.back()});
+    m_queue.pop_back();
+  }
+  m_queueReady = !m_queue.empty();
+  return count;
+}
+
 bool SimpleEventQueueBuffer::addEvent(uint32_t dataID)
 {
   ArchMutexLock lock(m_queueMutex);
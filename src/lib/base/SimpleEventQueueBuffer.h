@@ -34,6 +34,7 @@ public:
   }
   void waitForEvent(double timeout) override;
   Type getEvent(Event &event, uint32_t &dataID) override;
+  size_t getEvents(std::vector<Entry> &entries, size_t max) override;
   bool addEvent(uint32_t dataID) override;
   bool isEmpty() const override;
 
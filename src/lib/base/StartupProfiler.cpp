@@ -0,0 +1,100 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "base/StartupProfiler.h"
+
+#include "arch/Arch.h"
+#include "base/Log.h"
+
+#include <cstdio>
+#include <mutex>
+
+namespace {
+
+// start-up mostly runs on the main thread, the screen may mark from its own
+std::mutex s_mutex;
+int64_t s_started = 0;
+int64_t s_last = 0;
+int64_t s_finished = 0;
+std::vector<StartupPhase> s_phases;
+
+} // namespace
+
+void StartupProfiler::start()
+{
+  std::scoped_lock lock{s_mutex};
+  s_started = Arch::nanoTime();
+  s_last = s_started;
+  s_finished = 0;
+  s_phases.clear();
+}
+
+void StartupProfiler::mark(const char *name)
+{
+  std::scoped_lock lock{s_mutex};
+  if (s_started == 0 || s_finished != 0) {
+    return;
+  }
+
+  const auto now = Arch::nanoTime();
+  s_phases.push_back({name, now - s_last});
+  s_last = now;
+}
+
+bool StartupProfiler::finish(const char *milestone, double budgetMs)
+{
+  std::string breakdown;
+  double total = 0;
+  {
+    std::scoped_lock lock{s_mutex};
+    if (s_started == 0 || s_finished != 0) {
+      return true;
+    }
+
+    s_finished = Arch::nanoTime();
+    s_phases.push_back({milestone, s_finished - s_last});
+    total = static_cast<double>(s_finished - s_started) / 1e6;
+
+    for (const auto &phase : s_phases) {
+      char entry[128];
+      std::snprintf(
+          entry, sizeof(entry), "%s%s %.1f", breakdown.empty() ? "" : ", ", phase.name.c_str(),
+          static_cast<double>(phase.nanos) / 1e6
+      );
+      breakdown += entry;
+    }
+  }
+
+  const auto withinBudget = total <= budgetMs;
+  if (withinBudget) {
+    LOG_DEBUG("start-up took %.1f ms to %s (%s)", total, milestone, breakdown.c_str());
+  } else {
+    LOG_INFO("start-up took %.1f ms to %s, over the %.0f ms budget (%s)", total, milestone, budgetMs, breakdown.c_str());
+  }
+  return withinBudget;
+}
+
+std::vector<StartupPhase> StartupProfiler::phases()
+{
+  std::scoped_lock lock{s_mutex};
+  return s_phases;
+}
+
+double StartupProfiler::totalMs()
+{
+  std::scoped_lock lock{s_mutex};
+  if (s_started == 0) {
+    return 0;
+  }
+  const auto end = s_finished != 0 ? s_finished : Arch::nanoTime();
+  return static_cast<double>(end - s_started) / 1e6;
+}
+
+bool StartupProfiler::isFinished()
+{
+  std::scoped_lock lock{s_mutex};
+  return s_finished != 0;
+}
@@ -0,0 +1,57 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//! One start-up phase and how long it took
+struct StartupPhase
+{
+  std::string name;
+  int64_t nanos; //!< Nanoseconds since the previous phase ended
+};
+
+//! Times the phases of start-up
+/*!
+Start-up is split into phases by calling mark() as each one ends, so a
+phase covers everything since the previous mark.  finish() closes the
+profile when the process starts listening or connecting and logs where
+the time went, at info level if it went over the budget and debug level
+otherwise.  Later marks and finishes are ignored until start() is called
+again, so restarting the server or client does not skew the numbers.
+*/
+class StartupProfiler
+{
+public:
+  //! Time to listening or connecting that a typical machine should meet
+  static constexpr double kBudgetMs = 100.0;
+
+  //! Forget any previous profile and start timing now
+  static void start();
+
+  //! End the phase called \p name
+  static void mark(const char *name);
+
+  //! End the last phase and log the profile
+  /*!
+  \p milestone names what start-up reached, such as "listening".  Returns
+  true if start-up took no longer than \p budgetMs.  Does nothing and
+  returns true if the profile is already finished or was never started.
+  */
+  static bool finish(const char *milestone, double budgetMs = kBudgetMs);
+
+  //! Get the phases so far
+  static std::vector<StartupPhase> phases();
+
+  //! Get the start-up time in milliseconds, up to now if not finished
+  static double totalMs();
+
+  //! Test if finish() was called since start()
+  static bool isFinished();
+};
@@ -1,5 +1,6 @@
 /*
  * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
  * SPDX-FileCopyrightText: (C) 2012 - 2016 Symless Ltd.
  * SPDX-FileCopyrightText: (C) 2002 Chris Schoeneman
  * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
@@ -12,22 +13,27 @@
 // Stopwatch
 //
 
-Stopwatch::Stopwatch(bool triggered) : m_triggered(triggered), m_stopped(triggered)
+Stopwatch::Stopwatch(bool triggered, Clock clock) : m_triggered(triggered), m_stopped(triggered), m_clock(clock)
 {
   if (!triggered) {
-    m_mark = Arch::time();
+    m_mark = getClock();
   }
 }
 
 double Stopwatch::reset()
+{
+  return toSeconds(resetNs());
+}
+
+int64_t Stopwatch::resetNs()
 {
   if (m_stopped) {
-    const double dt = m_mark;
-    m_mark = 0.0;
+    const int64_t dt = m_mark;
+    m_mark = 0;
     return dt;
   } else {
-    const double t = Arch::time();
-    const double dt = t - m_mark;
+    const int64_t t = getClock();
+    const int64_t dt = t - m_mark;
     m_mark = t;
     return dt;
   }
@@ -40,7 +46,7 @@ void Stopwatch::stop()
   }
 
   // save the elapsed time
-  m_mark = Arch::time() - m_mark;
+  m_mark = getClock() - m_mark;
   m_stopped = true;
 }
 
@@ -52,7 +58,7 @@ void Stopwatch::start()
   }
 
   // set the mark such that it reports the time elapsed at stop()
-  m_mark = Arch::time() - m_mark;
+  m_mark = getClock() - m_mark;
   m_stopped = false;
 }
 
@@ -63,15 +69,20 @@ void Stopwatch::setTrigger()
 }
 
 double Stopwatch::getTime()
+{
+  return toSeconds(getTimeNs());
+}
+
+int64_t Stopwatch::getTimeNs()
 {
   if (m_triggered) {
-    const double dt = m_mark;
+    const int64_t dt = m_mark;
     start();
     return dt;
   } else if (m_stopped) {
     return m_mark;
   } else {
-    return Arch::time() - m_mark;
+    return getClock() - m_mark;
   }
 }
 
@@ -81,10 +92,20 @@ bool Stopwatch::isStopped() const
 }
 
 double Stopwatch::getTime() const
+{
+  return toSeconds(getTimeNs());
+}
+
+int64_t Stopwatch::getTimeNs() const
 {
   if (m_stopped) {
     return m_mark;
   } else {
-    return Arch::time() - m_mark;
+    return getClock() - m_mark;
   }
 }
+
+int64_t Stopwatch::getClock() const
+{
+  return m_clock == Clock::Coarse ? Arch::coarseNanoTime() : Arch::nanoTime();
+}
@@ -1,5 +1,6 @@
 /*
  * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
  * SPDX-FileCopyrightText: (C) 2012 - 2016 Symless Ltd.
  * SPDX-FileCopyrightText: (C) 2002 Chris Schoeneman
  * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
@@ -7,19 +8,29 @@
 
 #pragma once
 
+#include <cstdint>
+
 //! A timer class
 /*!
 This class measures time intervals.  All time interval measurement
-should use this class.
+should use this class.  Time is kept internally as integer nanoseconds
+from a monotonic clock; the \c double accessors return seconds.
 */
 class Stopwatch
 {
 public:
+  //! Clock source
+  enum class Clock
+  {
+    Precise, //!< Full resolution monotonic clock
+    Coarse   //!< Cheaper clock with a few milliseconds resolution, for non-critical paths
+  };
+
   /*!
   The default constructor does an implicit reset() or setTrigger().
   If triggered == false then the clock starts ticking.
   */
-  explicit Stopwatch(bool triggered = false);
+  explicit Stopwatch(bool triggered = false, Clock clock = Clock::Precise);
   ~Stopwatch() = default;
 
   //! @name manipulators
@@ -34,6 +45,12 @@ public:
   */
   double reset();
 
+  //! Reset the timer to zero
+  /*!
+  Same as reset() but returns integer nanoseconds.
+  */
+  int64_t resetNs();
+
   //! Stop the timer
   /*!
   Stop the stopwatch.  The time interval while stopped is not
@@ -64,6 +81,12 @@ public:
   returns zero if the trigger is set).
   */
   double getTime();
+
+  //! Get elapsed time
+  /*!
+  Same as getTime() but returns integer nanoseconds.
+  */
+  int64_t getTimeNs();
   //@}
   //! @name accessors
   //@{
@@ -81,13 +104,32 @@ public:
   stopwatch to start and will not clear the trigger.
   */
   double getTime() const;
+
+  //! Get elapsed time
+  /*!
+  Same as getTime() const but returns integer nanoseconds.
+  */
+  int64_t getTimeNs() const;
   //@}
 
+  //! Convert seconds to nanoseconds
+  static constexpr int64_t toNanoseconds(double seconds)
+  {
+    return static_cast<int64_t>(seconds * 1.0e+9 + (seconds < 0.0 ? -0.5 : 0.5));
+  }
+
+  //! Convert nanoseconds to seconds
+  static constexpr double toSeconds(int64_t nanoseconds)
+  {
+    return static_cast<double>(nanoseconds) / 1.0e+9;
+  }
+
 private:
-  double getClock() const;
+  int64_t getClock() const;
 
 private:
-  double m_mark = 0.0;
+  int64_t m_mark = 0;
   bool m_triggered = false;
   bool m_stopped = false;
+  Clock m_clock = Clock::Precise;
 };
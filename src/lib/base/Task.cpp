@@ -0,0 +1,60 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "base/Task.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+// detached tasks that have not finished, by the queue they were started on
+std::mutex s_tasksMutex;
+std::unordered_map<IEventQueue *, std::unordered_set<void *>> s_tasks;
+
+} // namespace
+
+namespace deskflow {
+
+void destroyTasks(IEventQueue *events)
+{
+  std::vector<void *> tasks;
+  {
+    std::scoped_lock lock(s_tasksMutex);
+    if (auto node = s_tasks.extract(events); node) {
+      tasks.assign(node.mapped().begin(), node.mapped().end());
+    }
+  }
+
+  for (auto *address : tasks) {
+    std::coroutine_handle<>::from_address(address).destroy();
+  }
+}
+
+namespace detail {
+
+void adoptTask(IEventQueue *events, std::coroutine_handle<> handle)
+{
+  std::scoped_lock lock(s_tasksMutex);
+  s_tasks[events].insert(handle.address());
+}
+
+void releaseTask(IEventQueue *events, std::coroutine_handle<> handle)
+{
+  std::scoped_lock lock(s_tasksMutex);
+  if (auto it = s_tasks.find(events); it != s_tasks.end()) {
+    it->second.erase(handle.address());
+    if (it->second.empty()) {
+      s_tasks.erase(it);
+    }
+  }
+}
+
+} // namespace detail
+
+} // namespace deskflow
@@ -0,0 +1,301 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "base/Event.h"
+#include "base/IEventQueue.h"
+#include "base/Log.h"
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace deskflow {
+
+template <typename T = void> class Task;
+
+//! Resume a coroutine from the event queue
+/*!
+Posts a CoroutineResume event so that \p handle is resumed by the thread
+running the event loop, rather than the thread calling this function.
+*/
+inline void resumeOnEventQueue(IEventQueue *events, std::coroutine_handle<> handle)
+{
+  events->addEvent(Event(EventTypes::CoroutineResume, events->getSystemTarget(), handle.address()));
+}
+
+//! Destroy the tasks detached onto a queue that have not finished
+/*!
+Called by the event queue as it is destroyed, since the CoroutineResume
+events those tasks wait for will never be dispatched.  Destroying a task
+destroys the tasks it awaits and runs the destructors of their locals,
+so anything they refer to must outlive the queue.
+*/
+void destroyTasks(IEventQueue *events);
+
+namespace detail {
+
+//! Keep a task detached onto \p events until it finishes or the queue goes
+void adoptTask(IEventQueue *events, std::coroutine_handle<> handle);
+
+//! Forget a task detached onto \p events that has finished
+void releaseTask(IEventQueue *events, std::coroutine_handle<> handle);
+
+} // namespace detail
+
+//! Awaitable that continues a coroutine on the event queue thread
+class ResumeOnEventQueue
+{
+public:
+  explicit ResumeOnEventQueue(IEventQueue *events) : m_events(events)
+  {
+    // do nothing
+  }
+
+  bool await_ready() const noexcept
+  {
+    return false;
+  }
+  void await_suspend(std::coroutine_handle<> handle) const
+  {
+    resumeOnEventQueue(m_events, handle);
+  }
+  void await_resume() const noexcept
+  {
+    // do nothing
+  }
+
+private:
+  IEventQueue *m_events;
+};
+
+namespace detail {
+
+class TaskPromiseBase
+{
+public:
+  struct FinalAwaiter
+  {
+    bool await_ready() const noexcept
+    {
+      return false;
+    }
+
+    template <typename Promise> std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+    {
+      auto &promise = handle.promise();
+      if (promise.m_continuation) {
+        return promise.m_continuation;
+      }
+      if (promise.m_detached) {
+        promise.logUnhandledException();
+        if (promise.m_events != nullptr) {
+          releaseTask(promise.m_events, handle);
+        }
+        handle.destroy();
+      }
+      return std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept
+    {
+      // do nothing
+    }
+  };
+
+  std::suspend_always initial_suspend() const noexcept
+  {
+    return {};
+  }
+  FinalAwaiter final_suspend() const noexcept
+  {
+    return {};
+  }
+  void unhandled_exception() noexcept
+  {
+    m_exception = std::current_exception();
+  }
+
+  void logUnhandledException() const noexcept
+  {
+    // nobody is awaiting a detached task, so its exception would be lost
+    if (!m_exception) {
+      return;
+    }
+    try {
+      std::rethrow_exception(m_exception);
+    } catch (const std::exception &e) {
+      LOG_ERR("unhandled exception in detached task: %s", e.what());
+    } catch (...) {
+      LOG_ERR("unhandled unknown exception in detached task");
+    }
+  }
+
+  std::coroutine_handle<> m_continuation;
+  std::exception_ptr m_exception;
+  bool m_detached = false;
+  IEventQueue *m_events = nullptr;
+};
+
+template <typename T> class TaskPromise : public TaskPromiseBase
+{
+public:
+  Task<T> get_return_object() noexcept;
+
+  template <typename U> void return_value(U &&value)
+  {
+    m_value.emplace(std::forward<U>(value));
+  }
+
+  T takeResult()
+  {
+    if (m_exception) {
+      std::rethrow_exception(m_exception);
+    }
+    return std::move(*m_value);
+  }
+
+private:
+  std::optional<T> m_value;
+};
+
+template <> class TaskPromise<void> : public TaskPromiseBase
+{
+public:
+  Task<void> get_return_object() noexcept;
+
+  void return_void() const noexcept
+  {
+    // do nothing
+  }
+
+  void takeResult() const
+  {
+    if (m_exception) {
+      std::rethrow_exception(m_exception);
+    }
+  }
+};
+
+} // namespace detail
+
+//! Lazily started coroutine
+/*!
+A coroutine returning \c Task<T> does not run until it is either awaited
+by another coroutine or detached.  Awaiting a task yields its result, or
+rethrows the exception it finished with.
+
+Tasks have no scheduler of their own; they suspend on awaitables such as
+AsyncSocket::readable() and are resumed on the event queue thread through
+CoroutineResume events, so all coroutine code runs on the same thread as
+ordinary event handlers.
+*/
+template <typename T> class [[nodiscard]] Task
+{
+public:
+  using promise_type = detail::TaskPromise<T>;
+
+  explicit Task(std::coroutine_handle<promise_type> handle) noexcept : m_handle(handle)
+  {
+    // do nothing
+  }
+  Task(Task const &) = delete;
+  Task(Task &&other) noexcept : m_handle(std::exchange(other.m_handle, {}))
+  {
+    // do nothing
+  }
+  ~Task()
+  {
+    if (m_handle) {
+      m_handle.destroy();
+    }
+  }
+
+  Task &operator=(Task const &) = delete;
+  Task &operator=(Task &&other) noexcept
+  {
+    if (this != &other) {
+      if (m_handle) {
+        m_handle.destroy();
+      }
+      m_handle = std::exchange(other.m_handle, {});
+    }
+    return *this;
+  }
+
+  //! @name manipulators
+  //@{
+
+  //! Start the task without awaiting it
+  /*!
+  Releases ownership of the coroutine, which destroys itself when it
+  finishes.  If \p events is given the task starts on the event queue
+  thread and is destroyed with the queue if it has not finished by then,
+  otherwise it runs on the calling thread until it first suspends and
+  must not be left waiting on a queue that goes away.  Exceptions leaving
+  a detached task are logged and discarded.
+  */
+  void detach(IEventQueue *events = nullptr)
+  {
+    auto handle = std::exchange(m_handle, {});
+    handle.promise().m_detached = true;
+    if (events != nullptr) {
+      handle.promise().m_events = events;
+      detail::adoptTask(events, handle);
+      resumeOnEventQueue(events, handle);
+    } else {
+      handle.resume();
+    }
+  }
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Test if the task has run to completion
+  bool isDone() const noexcept
+  {
+    return !m_handle || m_handle.done();
+  }
+
+  //@}
+
+  // awaitable interface
+  bool await_ready() const noexcept
+  {
+    return false;
+  }
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept
+  {
+    m_handle.promise().m_continuation = continuation;
+    return m_handle;
+  }
+  T await_resume()
+  {
+    return m_handle.promise().takeResult();
+  }
+
+private:
+  std::coroutine_handle<promise_type> m_handle;
+};
+
+namespace detail {
+
+template <typename T> inline Task<T> TaskPromise<T>::get_return_object() noexcept
+{
+  return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept
+{
+  return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+} // namespace detail
+
+} // namespace deskflow
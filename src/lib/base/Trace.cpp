@@ -0,0 +1,391 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "base/Trace.h"
+
+#include "arch/Arch.h"
+#include "base/String.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <utility>
+
+namespace {
+
+const char s_magic[8] = {'D', 'F', 'T', 'R', 'A', 'C', 'E', '1'};
+
+struct TraceFileHeader
+{
+  char magic[8];
+  uint32_t recordSize;
+  uint32_t reserved;
+  uint64_t count;
+};
+
+//! Ring of records written by exactly one thread
+struct TraceBuffer
+{
+  explicit TraceBuffer(size_t capacity, uint32_t thread, uint64_t generation)
+      : m_records(std::make_unique<TraceRecord[]>(capacity)),
+        m_mask(capacity - 1),
+        m_thread(thread),
+        m_generation(generation)
+  {
+    // do nothing
+  }
+
+  std::unique_ptr<TraceRecord[]> m_records;
+  size_t m_mask;
+  uint32_t m_thread;
+  std::atomic<uint64_t> m_count = 0;
+
+  //! The start() the records belong to
+  std::atomic<uint64_t> m_generation;
+};
+
+// buffers are never freed, a thread may still hold its pointer after
+// tracing stops.  start() bumps the generation and each thread rewinds its
+// own ring when it sees the change, so a record being written while
+// tracing restarts can't undo the rewind.
+std::mutex s_buffersMutex;
+std::vector<std::unique_ptr<TraceBuffer>> s_buffers;
+size_t s_capacity = 0;
+std::atomic<uint64_t> s_generation = 0;
+
+thread_local TraceBuffer *t_buffer = nullptr;
+thread_local uint64_t t_flow = 0;
+std::atomic<uint64_t> s_nextFlow = 1;
+
+TraceBuffer *threadBuffer()
+{
+  if (t_buffer == nullptr) {
+    std::scoped_lock lock{s_buffersMutex};
+    const auto thread = static_cast<uint32_t>(s_buffers.size());
+    s_buffers.push_back(
+        std::make_unique<TraceBuffer>(s_capacity, thread, s_generation.load(std::memory_order_relaxed))
+    );
+    t_buffer = s_buffers.back().get();
+  }
+
+  if (const auto generation = s_generation.load(std::memory_order_acquire);
+      t_buffer->m_generation.load(std::memory_order_relaxed) != generation) {
+    t_buffer->m_count.store(0, std::memory_order_relaxed);
+    t_buffer->m_generation.store(generation, std::memory_order_release);
+  }
+  return t_buffer;
+}
+
+} // namespace
+
+//
+// Trace
+//
+
+std::atomic<bool> Trace::s_enabled = false;
+
+void Trace::start(size_t recordsPerThread)
+{
+  std::scoped_lock lock{s_buffersMutex};
+  // the size is fixed by the first start, existing threads keep their rings
+  if (s_capacity == 0) {
+    s_capacity = std::bit_ceil(std::max<size_t>(recordsPerThread, 2));
+  }
+  s_generation.fetch_add(1, std::memory_order_release);
+  s_enabled.store(true, std::memory_order_release);
+}
+
+void Trace::stop()
+{
+  s_enabled.store(false, std::memory_order_release);
+}
+
+void Trace::record(TracePoint point, const void *target, int64_t a, int64_t b)
+{
+  if (!isEnabled()) {
+    return;
+  }
+
+  auto *buffer = threadBuffer();
+  const auto count = buffer->m_count.load(std::memory_order_relaxed);
+  auto &record = buffer->m_records[count & buffer->m_mask];
+  record.time = Arch::nanoTime();
+  record.thread = buffer->m_thread;
+  record.point = point;
+  record.target = reinterpret_cast<uintptr_t>(target);
+  record.a = a;
+  record.b = b;
+  buffer->m_count.store(count + 1, std::memory_order_release);
+}
+
+uint64_t Trace::beginFlow(const void *target)
+{
+  if (!isEnabled()) {
+    return 0;
+  }
+
+  t_flow = s_nextFlow.fetch_add(1, std::memory_order_relaxed);
+  record(TracePoint::FlowBegin, target, static_cast<int64_t>(t_flow));
+  return t_flow;
+}
+
+uint64_t Trace::takeFlow()
+{
+  return std::exchange(t_flow, 0);
+}
+
+void Trace::endFlow(uint64_t flow, const void *target)
+{
+  if (flow != 0) {
+    record(TracePoint::FlowEnd, target, static_cast<int64_t>(flow));
+  }
+}
+
+std::vector<TraceRecord> Trace::collect()
+{
+  std::vector<TraceRecord> records;
+
+  std::scoped_lock lock{s_buffersMutex};
+  const auto generation = s_generation.load(std::memory_order_acquire);
+  for (const auto &buffer : s_buffers) {
+    // a thread that has not recorded since the last start() holds old records
+    if (buffer->m_generation.load(std::memory_order_acquire) != generation) {
+      continue;
+    }
+    const auto count = buffer->m_count.load(std::memory_order_acquire);
+    const auto kept = std::min<uint64_t>(count, buffer->m_mask + 1);
+    for (auto i = count - kept; i < count; ++i) {
+      records.push_back(buffer->m_records[i & buffer->m_mask]);
+    }
+  }
+
+  std::ranges::stable_sort(records, {}, &TraceRecord::time);
+  return records;
+}
+
+bool Trace::save(const std::string &fileName, const std::vector<TraceRecord> &records)
+{
+  std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    return false;
+  }
+
+  TraceFileHeader header{};
+  std::memcpy(header.magic, s_magic, sizeof(s_magic));
+  header.recordSize = sizeof(TraceRecord);
+  header.count = records.size();
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char *>(records.data()), std::streamsize(records.size() * sizeof(TraceRecord)));
+  return file.good();
+}
+
+bool Trace::load(const std::string &fileName, std::vector<TraceRecord> &records)
+{
+  std::ifstream file(fileName, std::ios::binary);
+  TraceFileHeader header{};
+  if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+      std::memcmp(header.magic, s_magic, sizeof(s_magic)) != 0 || header.recordSize != sizeof(TraceRecord)) {
+    return false;
+  }
+
+  // a truncated or corrupt header must not make us allocate what isn't there
+  const auto offset = file.tellg();
+  file.seekg(0, std::ios::end);
+  const auto remaining = static_cast<uint64_t>(file.tellg() - offset);
+  if (!file || header.count > remaining / sizeof(TraceRecord)) {
+    return false;
+  }
+  file.seekg(offset);
+
+  records.resize(header.count);
+  return static_cast<bool>(
+      file.read(reinterpret_cast<char *>(records.data()), std::streamsize(records.size() * sizeof(TraceRecord)))
+  );
+}
+
+bool Trace::saveJson(const std::string &fileName, const std::vector<TraceRecord> &records)
+{
+  std::ofstream file(fileName, std::ios::trunc);
+  if (!file) {
+    return false;
+  }
+
+  const auto start = records.empty() ? 0 : records.front().time;
+  std::set<uint32_t> threads;
+  const char *separator = "\n";
+
+  file << R"({"displayTimeUnit":"ns","traceEvents":[)";
+  for (const auto &record : records) {
+    threads.insert(record.thread);
+
+    using deskflow::string::sprintf;
+    const auto ts = sprintf(R"("ts":%.3f,"pid":1,"tid":%u)", double(record.time - start) / 1e3, record.thread);
+    const auto target = static_cast<unsigned long long>(record.target);
+    const auto a = static_cast<long long>(record.a);
+    const auto b = static_cast<long long>(record.b);
+    std::string event;
+    switch (record.point) {
+      using enum TracePoint;
+    case EventDispatched:
+      // shown by the dispatch span
+      continue;
+
+    case SpanBegin: {
+      // name dispatches by event type so they can be compared per type
+      const auto span = static_cast<TraceSpan>(record.a);
+      const auto name = span == TraceSpan::Dispatch ? sprintf("%s %lld", spanName(span), b) : spanName(span);
+      event = sprintf(
+          R"({"name":"%s","cat":"span","ph":"B",%s,"args":{"target":"0x%llx","value":%lld}})", name.c_str(), ts.c_str(),
+          target, b
+      );
+      break;
+    }
+
+    case SpanEnd:
+      event = sprintf(R"({"ph":"E",%s})", ts.c_str());
+      break;
+
+    case FlowBegin:
+      event = sprintf(R"({"name":"input","cat":"flow","ph":"s","id":%lld,%s})", a, ts.c_str());
+      break;
+
+    case FlowEnd:
+      event = sprintf(R"({"name":"input","cat":"flow","ph":"f","bp":"e","id":%lld,%s})", a, ts.c_str());
+      break;
+
+    default:
+      event = sprintf(
+          R"({"name":"%s","cat":"point","ph":"i","s":"t",%s,"args":{"target":"0x%llx","a":%lld,"b":%lld}})",
+          pointName(record.point), ts.c_str(), target, a, b
+      );
+      break;
+    }
+
+    file << separator << event;
+    separator = ",\n";
+  }
+
+  for (const auto thread : threads) {
+    file << separator
+         << deskflow::string::sprintf(
+                R"({"name":"thread_name","ph":"M","pid":1,"tid":%u,"args":{"name":"thread %u"}})", thread, thread
+            );
+    separator = ",\n";
+  }
+  file << "\n]}\n";
+  return file.good();
+}
+
+std::vector<TraceLatency> Trace::latencies(const std::vector<TraceRecord> &records)
+{
+  TraceLatency queue{"event queued to dispatched", {}};
+  TraceLatency parse{"socket read to message parsed", {}};
+  TraceLatency inject{"message parsed to input injected", {}};
+
+  // events are dispatched in the order they were added per target and type
+  std::map<std::pair<uint64_t, int64_t>, std::deque<int64_t>> pending;
+  int64_t lastRead = -1;
+  std::map<uint32_t, int64_t> lastParsed;
+
+  for (const auto &record : records) {
+    switch (record.point) {
+      using enum TracePoint;
+    case EventAdded:
+      pending[{record.target, record.a}].push_back(record.time);
+      break;
+
+    case EventDispatched:
+      if (auto it = pending.find({record.target, record.a}); it != pending.end() && !it->second.empty()) {
+        queue.samples.push_back(record.time - it->second.front());
+        it->second.pop_front();
+      }
+      break;
+
+    case SocketRead:
+      lastRead = record.time;
+      break;
+
+    case MessageParsed:
+      // the first message after a read waited for all of it to arrive
+      if (lastRead >= 0) {
+        parse.samples.push_back(record.time - lastRead);
+        lastRead = -1;
+      }
+      lastParsed[record.thread] = record.time;
+      break;
+
+    case FakeInput:
+      if (auto it = lastParsed.find(record.thread); it != lastParsed.end()) {
+        inject.samples.push_back(record.time - it->second);
+        lastParsed.erase(it);
+      }
+      break;
+
+    case SocketWrite:
+    case SpanBegin:
+    case SpanEnd:
+    case FlowBegin:
+    case FlowEnd:
+      break;
+    }
+  }
+
+  return {std::move(queue), std::move(parse), std::move(inject)};
+}
+
+const char *Trace::pointName(TracePoint point)
+{
+  switch (point) {
+    using enum TracePoint;
+  case EventAdded:
+    return "event-added";
+  case EventDispatched:
+    return "event-dispatched";
+  case SocketRead:
+    return "socket-read";
+  case SocketWrite:
+    return "socket-write";
+  case MessageParsed:
+    return "message-parsed";
+  case FakeInput:
+    return "fake-input";
+  case SpanBegin:
+    return "span-begin";
+  case SpanEnd:
+    return "span-end";
+  case FlowBegin:
+    return "flow-begin";
+  case FlowEnd:
+    return "flow-end";
+  }
+  return "unknown";
+}
+
+const char *Trace::spanName(TraceSpan span)
+{
+  switch (span) {
+    using enum TraceSpan;
+  case Dispatch:
+    return "dispatch";
+  case SocketJob:
+    return "socket-job";
+  case SecureRead:
+    return "tls-read";
+  case SecureWrite:
+    return "tls-write";
+  case ClipboardChunk:
+    return "clipboard-chunk";
+  case Inject:
+    return "inject";
+  }
+  return "unknown";
+}
@@ -0,0 +1,226 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//! Points in the input path that can be traced
+enum class TracePoint : uint16_t
+{
+  EventAdded,      //!< An event was queued, \c a is the event type
+  EventDispatched, //!< An event was handed to its handler, \c a is the event type
+  SocketRead,      //!< Data was read from a socket, \c a is the byte count
+  SocketWrite,     //!< Data was written to a socket, \c a is the byte count
+  MessageParsed,   //!< A protocol message was parsed, \c a is the packed message code
+  FakeInput,       //!< Input was injected on a secondary screen, \c a is a TraceInput
+  SpanBegin,       //!< A span started, \c a is a TraceSpan, \c b is span specific
+  SpanEnd,         //!< The innermost open span on the thread ended, \c a is a TraceSpan
+  FlowBegin,       //!< A flow left the current span, \c a is the flow id
+  FlowEnd          //!< A flow arrived in the current span, \c a is the flow id
+};
+
+//! Kind of span for TracePoint::SpanBegin and TracePoint::SpanEnd
+enum class TraceSpan : uint8_t
+{
+  Dispatch,       //!< An event handler ran, \c b is the event type
+  SocketJob,      //!< A socket multiplexer job ran
+  SecureRead,     //!< A TLS read, \c b is the requested byte count
+  SecureWrite,    //!< A TLS write, \c b is the byte count
+  ClipboardChunk, //!< A clipboard chunk was sent, \c b is the chunk size
+  Inject          //!< Input was injected into the platform, \c b is a TraceInput
+};
+
+//! Kind of injected input for TracePoint::FakeInput
+enum class TraceInput : uint8_t
+{
+  KeyDown,   //!< \c b is the key id
+  KeyRepeat, //!< \c b is the key id
+  KeyUp,     //!< \c b is the key button
+  MouseDown, //!< \c b is the button
+  MouseUp,   //!< \c b is the button
+  MouseMove, //!< \c b is the packed position, see Trace::packPair()
+  MouseRelativeMove,
+  MouseWheel
+};
+
+//! A single trace record
+/*!
+Records have a fixed size and are written to trace files as is, in the
+byte order of the machine that recorded them.
+*/
+struct TraceRecord
+{
+  int64_t time;     //!< Nanoseconds on the monotonic clock
+  uint32_t thread;  //!< Index of the recording thread
+  TracePoint point; //!< What happened
+  uint16_t reserved = 0;
+  uint64_t target; //!< Address of the object involved, used to pair records
+  int64_t a;       //!< Point specific value
+  int64_t b;       //!< Point specific value
+};
+static_assert(sizeof(TraceRecord) == 40, "trace files depend on the record layout");
+
+//! Latency samples between two kinds of trace points
+struct TraceLatency
+{
+  std::string name;
+  std::vector<int64_t> samples; //!< Nanoseconds
+};
+
+//! High rate binary tracer for the input path
+/*!
+Text logging is too slow to capture every motion and key event, so the
+hot paths record fixed size binary records instead.  Each thread writes
+to its own ring buffer without locking or allocating; once a ring is full
+the oldest records are overwritten.  When tracing stops the rings are
+merged into one timeline that can be saved and later decoded with the
+\c deskflow-trace tool.
+
+Besides single points, spans (see TraceScope) mark how long a piece of
+work took and flows link work on one thread to the work it caused on
+another, such as a motion event on the primary screen and the socket
+write that sent it.  saveJson() writes the Trace Event Format read by
+ui.perfetto.dev and chrome://tracing.
+
+Recording is gated by a relaxed atomic load in the TRACE() macro, so
+disabled trace points cost next to nothing.
+*/
+class Trace
+{
+public:
+  //! Start recording, keeping at most \p recordsPerThread per thread
+  static void start(size_t recordsPerThread = 64 * 1024);
+
+  //! Stop recording
+  static void stop();
+
+  //! Test if recording is on
+  static bool isEnabled()
+  {
+    return s_enabled.load(std::memory_order_relaxed);
+  }
+
+  //! Add a record for the calling thread
+  static void record(TracePoint point, const void *target, int64_t a = 0, int64_t b = 0);
+
+  //! Start a flow from the current span
+  /*!
+  Returns the new flow id, or 0 when tracing is off.  The id is also
+  remembered as the calling thread's current flow until takeFlow() is
+  called.
+  */
+  static uint64_t beginFlow(const void *target);
+
+  //! Get and forget the calling thread's current flow, 0 if there is none
+  static uint64_t takeFlow();
+
+  //! End \p flow in the current span, does nothing if \p flow is 0
+  static void endFlow(uint64_t flow, const void *target);
+
+  //! Get all records in time order, should be called after stop()
+  static std::vector<TraceRecord> collect();
+
+  //! Write \p records to \p fileName, returns false on error
+  static bool save(const std::string &fileName, const std::vector<TraceRecord> &records);
+
+  //! Write \p records to \p fileName as Trace Event Format JSON
+  static bool saveJson(const std::string &fileName, const std::vector<TraceRecord> &records);
+
+  //! Read records written by save(), returns false if the file is not a trace
+  static bool load(const std::string &fileName, std::vector<TraceRecord> &records);
+
+  //! Work out the input path latencies of a time ordered timeline
+  static std::vector<TraceLatency> latencies(const std::vector<TraceRecord> &records);
+
+  //! Get a readable name for a trace point
+  static const char *pointName(TracePoint point);
+
+  //! Get a readable name for a span
+  static const char *spanName(TraceSpan span);
+
+  //! Pack a four character protocol message code into a record value
+  static int64_t packCode(const uint8_t *code)
+  {
+    return (int64_t{code[0]} << 24) | (int64_t{code[1]} << 16) | (int64_t{code[2]} << 8) | int64_t{code[3]};
+  }
+
+  //! Pack two 32 bit values, such as a position, into a record value
+  static int64_t packPair(int32_t first, int32_t second)
+  {
+    return static_cast<int64_t>((uint64_t{static_cast<uint32_t>(first)} << 32) | static_cast<uint32_t>(second));
+  }
+
+private:
+  static std::atomic<bool> s_enabled;
+};
+
+//! Records a span for the lifetime of the object
+class TraceScope
+{
+public:
+  TraceScope(TraceSpan span, const void *target, int64_t detail = 0) : m_span(span), m_enabled(Trace::isEnabled())
+  {
+    if (m_enabled) {
+      Trace::record(TracePoint::SpanBegin, target, static_cast<int64_t>(span), detail);
+    }
+  }
+  TraceScope(TraceScope const &) = delete;
+  TraceScope(TraceScope &&) = delete;
+  ~TraceScope()
+  {
+    if (m_enabled) {
+      Trace::record(TracePoint::SpanEnd, nullptr, static_cast<int64_t>(m_span));
+    }
+  }
+
+  TraceScope &operator=(TraceScope const &) = delete;
+  TraceScope &operator=(TraceScope &&) = delete;
+
+private:
+  TraceSpan m_span;
+  bool m_enabled;
+};
+
+//! Starts a flow for the lifetime of the object
+/*!
+Code further down the call stack claims the flow with Trace::takeFlow();
+if nothing does by the time the object is destroyed the flow is dropped.
+*/
+class TraceFlow
+{
+public:
+  explicit TraceFlow(const void *target)
+  {
+    if (Trace::isEnabled()) {
+      Trace::beginFlow(target);
+    }
+  }
+  TraceFlow(TraceFlow const &) = delete;
+  TraceFlow(TraceFlow &&) = delete;
+  ~TraceFlow()
+  {
+    Trace::takeFlow();
+  }
+
+  TraceFlow &operator=(TraceFlow const &) = delete;
+  TraceFlow &operator=(TraceFlow &&) = delete;
+};
+
+/*!
+\def TRACE(point, target, ...)
+Record a trace point if tracing is enabled.  The remaining arguments are
+only evaluated when it is.
+*/
+#define TRACE(...)                                                                                                     \
+  do {                                                                                                                 \
+    if (Trace::isEnabled()) {                                                                                          \
+      Trace::record(__VA_ARGS__);                                                                                      \
+    }                                                                                                                  \
+  } while (false)
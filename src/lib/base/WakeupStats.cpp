@@ -0,0 +1,57 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "base/WakeupStats.h"
+
+#include <array>
+#include <atomic>
+
+namespace {
+
+std::array<std::atomic<uint64_t>, WakeupStats::kSourceCount> s_counts{};
+
+} // namespace
+
+void WakeupStats::add(WakeupSource source)
+{
+  s_counts[static_cast<std::size_t>(source)].fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t WakeupStats::count(WakeupSource source)
+{
+  return s_counts[static_cast<std::size_t>(source)].load(std::memory_order_relaxed);
+}
+
+void WakeupStats::reset()
+{
+  for (auto &count : s_counts) {
+    count.store(0, std::memory_order_relaxed);
+  }
+}
+
+const char *WakeupStats::name(WakeupSource source)
+{
+  switch (source) {
+    using enum WakeupSource;
+  case EventQueue:
+    return "eventQueue";
+  case Timer:
+    return "timer";
+  case Socket:
+    return "socket";
+  case Display:
+    return "display";
+  case Clipboard:
+    return "clipboard";
+  case ScreenSaver:
+    return "screenSaver";
+  case KeepAlive:
+    return "keepAlive";
+  case Count:
+    break;
+  }
+  return "unknown";
+}
@@ -0,0 +1,47 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+//! Things that wake the process up
+enum class WakeupSource : uint8_t
+{
+  EventQueue,  //!< The event thread returned from waiting
+  Timer,       //!< An event queue timer expired
+  Socket,      //!< The socket multiplexer returned from polling
+  Display,     //!< The display connection was polled
+  Clipboard,   //!< A clipboard monitor checked for changes
+  ScreenSaver, //!< The screen saver was told not to start
+  KeepAlive,   //!< A keep alive was sent to the other side
+  Count
+};
+
+//! Counts wakeups per source
+/*!
+Every place that wakes up a thread, on a timeout or an event, counts
+itself here so an idle process can be checked for periodic wakeups.  The
+counters are always on, counting is one relaxed atomic increment.
+*/
+class WakeupStats
+{
+public:
+  static constexpr auto kSourceCount = static_cast<std::size_t>(WakeupSource::Count);
+
+  //! Count one wakeup from \p source
+  static void add(WakeupSource source);
+
+  //! Get the wakeups counted from \p source
+  static uint64_t count(WakeupSource source);
+
+  //! Set every counter back to zero
+  static void reset();
+
+  //! Get the name of \p source as shown in the stats
+  static const char *name(WakeupSource source);
+};
@@ -9,10 +9,12 @@
 #include "client/Client.h"
 
 #include "arch/Arch.h"
+#include "base/CoreStatus.h"
 #include "base/IEventQueue.h"
 #include "base/Log.h"
 #include "client/ServerProxy.h"
 #include "common/Settings.h"
+#include "deskflow/BulkChannel.h"
 #include "deskflow/Clipboard.h"
 #include "deskflow/DeskflowException.h"
 #include "deskflow/IPlatformScreen.h"
@@ -44,7 +46,7 @@ Client::Client(
       m_socketFactory(socketFactory),
       m_screen(screen),
       m_events(events),
-      m_useSecureNetwork(Settings::value(Settings::Security::TlsEnabled).toBool())
+      m_useSecureNetwork(Settings::snapshot()->tlsEnabled)
 {
   assert(m_socketFactory != nullptr);
   assert(m_screen != nullptr);
@@ -108,6 +110,8 @@ void Client::connect(size_t addressIndex)
       );
     }
 
+    CoreStatus::setConnectionState(CoreConnectionState::Connecting);
+
     // create the socket
     IDataSocket *socket = m_socketFactory->create(ARCH->getAddrFamily(m_serverAddress.getAddress()), securityLevel);
     bindNetworkInterface(socket);
@@ -160,6 +164,53 @@ void Client::handshakeComplete()
   sendEvent(EventTypes::ClientConnected);
 }
 
+bool Client::sendFiles(const std::vector<std::string> &paths)
+{
+  if (!m_ready) {
+    LOG_WARN("can't send files, not connected");
+    return false;
+  }
+  return m_server->sendFiles(paths);
+}
+
+void Client::openBulkChannel(const std::string &token)
+{
+  if (m_bulkStream != nullptr) {
+    return;
+  }
+
+  auto securityLevel = m_useSecureNetwork ? SecurityLevel::PeerAuth : SecurityLevel::PlainText;
+
+  try {
+    IDataSocket *socket = m_socketFactory->create(ARCH->getAddrFamily(m_serverAddress.getAddress()), securityLevel);
+    bindNetworkInterface(socket);
+    m_bulkStream = new PacketStreamFilter(m_events, socket, true);
+    m_bulkToken = token;
+
+    // the server says hello once the connection (and with tls, the
+    // handshake checking its fingerprint) is done
+    using enum EventTypes;
+    m_events->addHandler(StreamInputReady, m_bulkStream->getEventTarget(), [this](const auto &) {
+      handleBulkHello();
+    });
+    m_events->addHandler(DataSocketConnectionFailed, m_bulkStream->getEventTarget(), [this](const auto &e) {
+      delete static_cast<IDataSocket::ConnectionFailedInfo *>(e.getData());
+      LOG_WARN("failed to open bulk connection, using the main connection");
+      cleanupBulkStream();
+    });
+    m_events->addHandler(StreamInputShutdown, m_bulkStream->getEventTarget(), [this](const auto &) {
+      LOG_WARN("bulk connection closed by server, using the main connection");
+      cleanupBulkStream();
+    });
+
+    LOG_DEBUG1("opening bulk connection to server");
+    socket->connect(m_serverAddress);
+  } catch (BaseException &e) {
+    LOG_WARN("failed to open bulk connection: %s", e.what());
+    cleanupBulkStream();
+  }
+}
+
 bool Client::isConnected() const
 {
   return (m_server != nullptr);
@@ -175,6 +226,14 @@ NetworkAddress Client::getServerAddress() const
   return m_serverAddress;
 }
 
+PacketStreamFilter::Counters Client::getTraffic() const
+{
+  if (const auto *packets = dynamic_cast<const PacketStreamFilter *>(m_stream); packets != nullptr) {
+    return packets->getCounters();
+  }
+  return {};
+}
+
 void *Client::getEventTarget() const
 {
   return m_screen->getEventTarget();
@@ -379,7 +438,7 @@ void Client::setupConnecting()
 {
   assert(m_stream != nullptr);
 
-  if (Settings::value(Settings::Security::TlsEnabled).toBool()) {
+  if (m_useSecureNetwork) {
     m_events->addHandler(EventTypes::DataSocketSecureConnected, m_stream->getEventTarget(), [this](const auto &) {
       handleConnected();
     });
@@ -454,6 +513,7 @@ void Client::cleanupConnecting()
 
 void Client::cleanupConnection()
 {
+  cleanupBulkStream();
   if (m_stream != nullptr) {
     using enum EventTypes;
     m_events->removeHandler(StreamInputReady, m_stream->getEventTarget());
@@ -494,6 +554,18 @@ void Client::cleanupStream()
   m_stream = nullptr;
 }
 
+void Client::cleanupBulkStream()
+{
+  if (m_bulkStream != nullptr) {
+    using enum EventTypes;
+    m_events->removeHandler(StreamInputReady, m_bulkStream->getEventTarget());
+    m_events->removeHandler(DataSocketConnectionFailed, m_bulkStream->getEventTarget());
+    m_events->removeHandler(StreamInputShutdown, m_bulkStream->getEventTarget());
+    delete m_bulkStream;
+    m_bulkStream = nullptr;
+  }
+}
+
 void Client::handleConnected()
 {
   LOG_DEBUG1("connected, waiting for hello");
@@ -593,6 +665,24 @@ void Client::handleHello()
   }
 }
 
+void Client::handleBulkHello()
+{
+  deskflow::IStream *stream = m_bulkStream;
+  if (!BulkChannel::helloBack(stream, m_name, m_bulkToken)) {
+    LOG_WARN("got invalid hello on bulk connection, using the main connection");
+    cleanupBulkStream();
+    return;
+  }
+
+  // the server proxy owns the stream from now on
+  using enum EventTypes;
+  m_events->removeHandler(StreamInputReady, stream->getEventTarget());
+  m_events->removeHandler(DataSocketConnectionFailed, stream->getEventTarget());
+  m_events->removeHandler(StreamInputShutdown, stream->getEventTarget());
+  m_bulkStream = nullptr;
+  m_server->setBulkStream(stream);
+}
+
 void Client::handleSuspend()
 {
   if (!m_suspended) {
@@ -619,7 +709,7 @@ void Client::handleResume()
 void Client::bindNetworkInterface(IDataSocket *socket) const
 {
   try {
-    if (const auto address = Settings::value(Settings::Core::Interface).toString(); !address.isEmpty()) {
+    if (const auto &address = Settings::snapshot()->networkInterface; !address.isEmpty()) {
       LOG_DEBUG1("bind to network interface: %s", qPrintable(address));
 
       NetworkAddress bindAddress(address.toStdString());
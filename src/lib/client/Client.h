@@ -13,6 +13,7 @@
 #include "HelloBack.h"
 #include "base/EventTypes.h"
 #include "deskflow/IClipboard.h"
+#include "deskflow/PacketStreamFilter.h"
 #include "net/NetworkAddress.h"
 
 #include <climits>
@@ -97,6 +98,21 @@ public:
   */
   virtual void handshakeComplete();
 
+  //! Send files to the server
+  /*!
+  Sends the files at \p paths to the server.  Returns false if not
+  connected.
+  */
+  bool sendFiles(const std::vector<std::string> &paths);
+
+  //! Open the bulk data connection
+  /*!
+  Opens a second connection to the server, with the same security, and
+  answers its hello with \p token.  Once the server takes it, clipboards
+  and files go over it.  Ignored while one is being opened.
+  */
+  void openBulkChannel(const std::string &token);
+
   //@}
   //! @name accessors
   //@{
@@ -127,6 +143,12 @@ public:
     return m_resolvedAddressesCount;
   }
 
+  //! Get traffic counters for the connection to the server
+  /*!
+  Returns all zeros when not connected.
+  */
+  PacketStreamFilter::Counters getTraffic() const;
+
   //@}
 
   // IScreen overrides
@@ -168,6 +190,7 @@ private:
   void cleanupScreen();
   void cleanupTimer();
   void cleanupStream();
+  void cleanupBulkStream();
   void handleConnected();
   void handleConnectionFailed(const Event &event);
   void handleConnectTimeout();
@@ -176,6 +199,7 @@ private:
   void handleShapeChanged();
   void handleClipboardGrabbed(const Event &event);
   void handleHello();
+  void handleBulkHello();
   void handleSuspend();
   void handleResume();
   void sendClipboardThread(void *);
@@ -187,6 +211,8 @@ private:
   ISocketFactory *m_socketFactory = nullptr;
   deskflow::Screen *m_screen = nullptr;
   deskflow::IStream *m_stream = nullptr;
+  deskflow::IStream *m_bulkStream = nullptr;
+  std::string m_bulkToken;
   EventQueueTimer *m_timer = nullptr;
   ServerProxy *m_server = nullptr;
   bool m_ready = false;
@@ -76,11 +76,14 @@ void HelloBack::handleHello(deskflow::IStream *stream, const std::string &client
 bool HelloBack::shouldDowngrade(int major, int minor) const
 {
   const std::map<int, std::set<int>> map{
-      // 1.6 is compatible with 1.7 and 1.8
-      {6, {7, 8}},
+      // 1.6 is compatible with 1.7, 1.8 and 1.9
+      {6, {7, 8, 9}},
 
-      // 1.7 is compatible with 1.8
-      {7, {8}},
+      // 1.7 is compatible with 1.8 and 1.9
+      {7, {8, 9}},
+
+      // 1.8 is compatible with 1.9
+      {8, {9}},
   };
 
   if (major == m_majorVersion) {
@@ -10,10 +10,14 @@
 
 #include "base/IEventQueue.h"
 #include "base/Log.h"
+#include "base/Trace.h"
 #include "client/Client.h"
+#include "deskflow/BulkChannel.h"
 #include "deskflow/Clipboard.h"
 #include "deskflow/ClipboardChunk.h"
+#include "common/Settings.h"
 #include "deskflow/DeskflowException.h"
+#include "deskflow/FileTransfer.h"
 #include "deskflow/OptionTypes.h"
 #include "deskflow/ProtocolTypes.h"
 #include "deskflow/ProtocolUtil.h"
@@ -29,7 +33,8 @@
 ServerProxy::ServerProxy(Client *client, deskflow::IStream *stream, IEventQueue *events)
     : m_client(client),
       m_stream(stream),
-      m_events(events)
+      m_events(events),
+      m_fileTransfer(std::make_unique<FileTransfer>(events, stream, Settings::snapshot()->fileTransferDir))
 {
   assert(m_client != nullptr);
   assert(m_stream != nullptr);
@@ -43,7 +48,7 @@ ServerProxy::ServerProxy(Client *client, deskflow::IStream *stream, IEventQueue
     handleData();
   });
   m_events->addHandler(EventTypes::ClipboardSending, this, [this](const auto &e) {
-    ClipboardChunk::send(m_stream, e.getDataObject());
+    sendClipboardChunk(static_cast<ClipboardChunk *>(e.getDataObject()));
   });
 
   // send heartbeat
@@ -52,6 +57,7 @@ ServerProxy::ServerProxy(Client *client, deskflow::IStream *stream, IEventQueue
 
 ServerProxy::~ServerProxy()
 {
+  detachBulkStream();
   setKeepAliveRate(-1.0);
   m_events->removeHandler(EventTypes::StreamInputReady, m_stream->getEventTarget());
 }
@@ -90,6 +96,7 @@ void ServerProxy::handleData()
 
     // parse message
     LOG_DEBUG2("msg from server: %c%c%c%c", code[0], code[1], code[2], code[3]);
+    TRACE(TracePoint::MessageParsed, this, Trace::packCode(code));
     try {
       switch ((this->*m_parser)(code)) {
         using enum ConnectionResult;
@@ -286,7 +293,7 @@ ServerProxy::ConnectionResult ServerProxy::parseMessage(const uint8_t *code)
   }
 
   else if (memcmp(code, kMsgDClipboard, 4) == 0) {
-    setClipboard();
+    setClipboard(m_stream);
   }
 
   else if (memcmp(code, kMsgCResetOptions, 4) == 0) {
@@ -301,6 +308,18 @@ ServerProxy::ConnectionResult ServerProxy::parseMessage(const uint8_t *code)
     secureInputNotification();
   }
 
+  else if (memcmp(code, kMsgDFileTransfer, 4) == 0) {
+    m_fileTransfer->readFileTransfer();
+  }
+
+  else if (memcmp(code, kMsgDDragInfo, 4) == 0) {
+    m_fileTransfer->readDragInfo();
+  }
+
+  else if (memcmp(code, kMsgDBulkChannel, 4) == 0) {
+    openBulkChannel();
+  }
+
   else if (memcmp(code, kMsgCClose, 4) == 0) {
     // server wants us to hangup
     LOG_DEBUG1("recv close");
@@ -332,6 +351,38 @@ void ServerProxy::handleKeepAliveAlarm()
   m_client->disconnect("server is not responding");
 }
 
+void ServerProxy::detachBulkStream()
+{
+  if (m_bulk != nullptr) {
+    for (ClipboardID id = 0; id < kClipboardEnd; ++id) {
+      if (m_clipboardStreams[id] == m_bulk->getStream()) {
+        LOG_WARN("dropped clipboard %d, its connection closed", id);
+        m_clipboardStreams[id] = nullptr;
+      }
+    }
+    m_events->removeHandler(EventTypes::BulkChannelClosed, m_bulk.get());
+    m_bulk.reset();
+  }
+}
+
+void ServerProxy::sendClipboardChunk(ClipboardChunk *chunk)
+{
+  // each clipboard stays on the stream chosen at its start
+  auto &stream = m_clipboardStreams[chunk->getID()];
+  if (chunk->isStart()) {
+    const auto isSmall = chunk->getStartSize() <= s_smallClipboardSize;
+    stream = isSmall || m_bulk == nullptr ? m_stream : m_bulk->getStream();
+  } else if (stream == nullptr) {
+    // the rest of a clipboard whose stream closed
+    return;
+  }
+
+  ClipboardChunk::send(stream, chunk);
+  if (chunk->isEnd()) {
+    stream = nullptr;
+  }
+}
+
 void ServerProxy::onInfoChanged()
 {
   // ignore mouse motion until we receive acknowledgment of our info
@@ -357,6 +408,36 @@ void ServerProxy::onClipboardChanged(ClipboardID id, const IClipboard *clipboard
   StreamChunker::sendClipboard(data, data.size(), id, m_seqNum, m_events, this);
 }
 
+bool ServerProxy::sendFiles(const std::vector<std::string> &paths)
+{
+  // older servers have no reply to the start of a file
+  if (!m_serverTakesFiles) {
+    LOG_WARN("the server is too old to receive files");
+    return false;
+  }
+
+  QStringList files;
+  for (const auto &path : paths) {
+    files.append(QString::fromStdString(path));
+  }
+  return m_bulk != nullptr ? m_bulk->sendFiles(files) : m_fileTransfer->sendFiles(files);
+}
+
+void ServerProxy::setBulkStream(deskflow::IStream *adoptedStream)
+{
+  detachBulkStream();
+
+  LOG_DEBUG("sending clipboards and files on the bulk connection");
+  m_bulk = std::make_unique<BulkChannel>(
+      m_events, adoptedStream, Settings::snapshot()->fileTransferDir,
+      [this](deskflow::IStream *stream) { setClipboard(stream); }
+  );
+  m_events->addHandler(EventTypes::BulkChannelClosed, m_bulk.get(), [this](const auto &) {
+    LOG_NOTE("bulk connection to server closed, using the main connection");
+    detachBulkStream();
+  });
+}
+
 void ServerProxy::flushCompressedMouse()
 {
   if (m_compressMouse) {
@@ -517,24 +598,23 @@ void ServerProxy::leave()
   m_client->leave();
 }
 
-void ServerProxy::setClipboard()
+void ServerProxy::setClipboard(deskflow::IStream *stream)
 {
   // parse
-  static std::string dataCached;
   ClipboardID id;
   uint32_t seq;
 
-  auto r = ClipboardChunk::assemble(m_stream, dataCached, id, seq);
+  auto r = ClipboardChunk::assemble(stream, m_clipboardData, id, seq);
 
   if (r == TransferState::Started) {
-    size_t size = ClipboardChunk::getExpectedSize();
+    size_t size = ClipboardChunk::getExpectedSize(id);
     LOG_DEBUG("receiving clipboard %d size=%d", id, size);
   } else if (r == TransferState::Finished) {
-    LOG_DEBUG("received clipboard %d size=%d", id, dataCached.size());
+    LOG_DEBUG("received clipboard %d size=%d", id, m_clipboardData[id].size());
 
     // forward
     Clipboard clipboard;
-    clipboard.unmarshall(dataCached, 0);
+    clipboard.unmarshall(m_clipboardData[id], 0);
     m_client->setClipboard(id, &clipboard);
 
     LOG_INFO("clipboard was updated");
@@ -844,6 +924,17 @@ void ServerProxy::setActiveServerLanguage(const std::string_view &language)
   }
 }
 
+void ServerProxy::openBulkChannel()
+{
+  std::string token;
+  ProtocolUtil::readf(m_stream, kMsgDBulkChannel + 4, &token);
+  LOG_DEBUG1("recv bulk connection offer");
+
+  // the offer is new in 1.9, like the file transfer replies
+  m_serverTakesFiles = true;
+  m_client->openBulkChannel(token);
+}
+
 void ServerProxy::checkMissedLanguages() const
 {
   auto missedLanguages = m_languageManager.getMissedLanguages();
@@ -12,9 +12,15 @@
 #include "deskflow/KeyTypes.h"
 #include "deskflow/languages/LanguageManager.h"
 
+#include <array>
+#include <memory>
+
+class BulkChannel;
 class Client;
 class ClientInfo;
+class ClipboardChunk;
 class EventQueueTimer;
+class FileTransfer;
 class IClipboard;
 namespace deskflow {
 class IStream;
@@ -48,6 +54,21 @@ public:
   bool onGrabClipboard(ClipboardID);
   void onClipboardChanged(ClipboardID, const IClipboard *);
 
+  //! Send \p paths to the server
+  /*!
+  Only a server on protocol 1.9 or later, which offers a bulk connection,
+  takes files.  Returns false for an older one.
+  */
+  bool sendFiles(const std::vector<std::string> &paths);
+
+  //! Send clipboards and files on \p adoptedStream
+  /*!
+  Takes the connection the client opened after the server offered one
+  with \c kMsgDBulkChannel.  If it closes the main connection is used
+  again.
+  */
+  void setBulkStream(deskflow::IStream *adoptedStream);
+
   //@}
 
 protected:
@@ -76,11 +97,13 @@ private:
   // event handlers
   void handleData();
   void handleKeepAliveAlarm();
+  void detachBulkStream();
+  void sendClipboardChunk(ClipboardChunk *chunk);
 
   // message handlers
   void enter();
   void leave();
-  void setClipboard();
+  void setClipboard(deskflow::IStream *stream);
   void grabClipboard();
   void keyDown(uint16_t id, uint16_t mask, uint16_t button, const std::string &lang);
   void keyRepeat();
@@ -99,6 +122,7 @@ private:
   void setServerLanguages();
   void setActiveServerLanguage(const std::string_view &language);
   void checkMissedLanguages() const;
+  void openBulkChannel();
 
 private:
   using MessageParser = ConnectionResult (ServerProxy::*)(const uint8_t *);
@@ -127,4 +151,9 @@ private:
   std::string m_serverLanguage = "";
   bool m_isUserNotifiedAboutLanguageSyncError = false;
   deskflow::languages::LanguageManager m_languageManager;
+  std::unique_ptr<FileTransfer> m_fileTransfer;
+  std::unique_ptr<BulkChannel> m_bulk;
+  std::array<deskflow::IStream *, kClipboardEnd> m_clipboardStreams{};
+  std::array<std::string, kClipboardEnd> m_clipboardData;
+  bool m_serverTakesFiles = false;
 };
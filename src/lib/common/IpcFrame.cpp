@@ -0,0 +1,59 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "IpcFrame.h"
+
+#include <QtEndian>
+
+namespace deskflow::ipc {
+
+namespace {
+const qsizetype kHeaderSize = sizeof(quint32);
+}
+
+QByteArray encodeFrame(const QByteArray &payload)
+{
+  QByteArray frame(kHeaderSize, Qt::Uninitialized);
+  qToBigEndian(static_cast<quint32>(payload.size()), frame.data());
+  frame.append(payload);
+  return frame;
+}
+
+void FrameReader::append(const QByteArray &data)
+{
+  if (m_error)
+    return;
+
+  // drop consumed frames before growing, so the buffer stays as small as the unread data
+  if (m_offset > 0) {
+    m_buffer.remove(0, m_offset);
+    m_offset = 0;
+  }
+  m_buffer.append(data);
+}
+
+std::optional<QByteArray> FrameReader::next()
+{
+  if (m_error || m_buffer.size() - m_offset < kHeaderSize)
+    return std::nullopt;
+
+  const auto size = static_cast<qsizetype>(qFromBigEndian<quint32>(m_buffer.constData() + m_offset));
+  if (size > kMaxFrameSize) {
+    m_error = true;
+    m_buffer.clear();
+    m_offset = 0;
+    return std::nullopt;
+  }
+
+  if (m_buffer.size() - m_offset - kHeaderSize < size)
+    return std::nullopt;
+
+  auto payload = m_buffer.mid(m_offset + kHeaderSize, size);
+  m_offset += kHeaderSize + size;
+  return payload;
+}
+
+} // namespace deskflow::ipc
@@ -0,0 +1,65 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <QByteArray>
+
+#include <optional>
+
+namespace deskflow::ipc {
+
+/**
+ * @brief Largest payload accepted in one frame
+ *
+ * A length above this means the peer is not speaking the protocol.
+ */
+inline const qsizetype kMaxFrameSize = 1024 * 1024;
+
+/**
+ * @brief Environment variable the GUI passes the core status token in
+ *
+ * Another user can read a process command line but not its environment, so
+ * the token only goes on the command line when the daemon starts the core.
+ */
+inline const auto kStatusTokenVariable = "DESKFLOW_STATUS_TOKEN";
+
+/**
+ * @brief Prefix @p payload with its length as a 32 bit big endian integer
+ */
+QByteArray encodeFrame(const QByteArray &payload);
+
+/**
+ * @brief Reassembles frames from a byte stream
+ *
+ * Bytes are added as they arrive, however the stream happened to split or
+ * join them; next() returns each complete payload in order.
+ */
+class FrameReader
+{
+public:
+  void append(const QByteArray &data);
+
+  /**
+   * @brief Take the next complete payload, if there is one
+   */
+  std::optional<QByteArray> next();
+
+  /**
+   * @brief True once an oversized frame was seen, the stream can't be resynchronized
+   */
+  bool hasError() const
+  {
+    return m_error;
+  }
+
+private:
+  QByteArray m_buffer;
+  qsizetype m_offset = 0;
+  bool m_error = false;
+};
+
+} // namespace deskflow::ipc
@@ -8,6 +8,8 @@
 
 #include "UrlConstants.h"
 
+#include "arch/IArchMultithread.h"
+
 #include <QCoreApplication>
 #include <QFile>
 #include <QRect>
@@ -35,6 +37,7 @@ void Settings::setSettingsFile(const QString &settingsFile)
   qInfo().noquote() << "settings file changed:" << instance()->m_settings->fileName();
 
   instance()->setupScreenName();
+  instance()->updateSnapshot();
 }
 
 void Settings::setStateFile(const QString &stateFile)
@@ -193,6 +196,36 @@ QVariant Settings::defaultValue(const QString &key)
   if (key == Client::ScrollSpeed)
     return 120;
 
+  if (key == Core::ThreadScheduling)
+    return static_cast<int>(IArchMultithread::SchedulingPolicy::Normal);
+
+  if (key == Core::ThreadPriority)
+    return 10;
+
+  if (key == Core::TimerSlack)
+    return 0;
+
+  if (key == Server::BulkRateLimit || key == Server::BulkGlobalRateLimit)
+    return 0;
+
+  if (key == Core::FileTransferDir)
+    return QStandardPaths::writableLocation(QStandardPaths::DownloadLocation);
+
+  if (key == Core::FileTransferMaxSize)
+    return 1024;
+
+  if (key == Log::QueueSize)
+    return 4096;
+
+  if (key == Log::FileMaxSize)
+    return 1024 * 1024;
+
+  if (key == Log::FileGenerations)
+    return 1;
+
+  if (key == Log::FileFlushInterval)
+    return 1000;
+
   return QVariant();
 }
 
@@ -260,6 +293,19 @@ QString Settings::tlsTrustedClientsDb()
   return QStringLiteral("%1/trusted-clients").arg(instance()->tlsDir());
 }
 
+QString Settings::statsTokenFile()
+{
+  // a per user directory that other users can't read
+  const auto directory = QStandardPaths::writableLocation(QStandardPaths::RuntimeLocation);
+  return QStringLiteral("%1/%2-stats.token").arg(directory, kAppId);
+}
+
+QString Settings::statusTokenFile()
+{
+  const auto directory = QStandardPaths::writableLocation(QStandardPaths::RuntimeLocation);
+  return QStringLiteral("%1/%2-status.token").arg(directory, kAppId);
+}
+
 void Settings::setValue(const QString &key, const QVariant &value)
 {
   const bool useState = Settings::m_stateKeys.contains(key) && !instance()->isPortableMode();
@@ -278,6 +324,7 @@ void Settings::setValue(const QString &key, const QVariant &value)
   }
 
   settings->sync();
+  instance()->updateSnapshot();
   Q_EMIT instance()->settingsChanged(key);
 }
 
@@ -295,6 +342,56 @@ void Settings::restoreDefaultSettings()
   }
 }
 
+std::shared_ptr<const Settings::Snapshot> Settings::snapshot()
+{
+  auto *settings = instance();
+  std::scoped_lock lock{settings->m_snapshotMutex};
+  // not built in the constructor, the defaults need the instance to exist
+  if (!settings->m_snapshot)
+    settings->m_snapshot = std::make_shared<const Snapshot>(readSnapshot());
+  return settings->m_snapshot;
+}
+
+void Settings::reload()
+{
+  instance()->m_settings->sync();
+  instance()->m_stateSettings->sync();
+  instance()->updateSnapshot();
+}
+
+Settings::Snapshot Settings::readSnapshot()
+{
+  Snapshot snapshot;
+  snapshot.screenName = value(Core::ScreenName).toString();
+  snapshot.networkInterface = value(Core::Interface).toString();
+  snapshot.preventSleep = value(Core::PreventSleep).toBool();
+  snapshot.useWlClipboard = value(Core::UseWlClipboard).toBool();
+  snapshot.languageSync = value(Client::LanguageSync).toBool();
+  snapshot.invertScrollDirection = value(Client::InvertScrollDirection).toBool();
+  snapshot.scrollSpeed = value(Client::ScrollSpeed).toInt();
+  snapshot.tlsEnabled = value(Security::TlsEnabled).toBool();
+  snapshot.checkPeers = value(Security::CheckPeers).toBool();
+  snapshot.certificate = value(Security::Certificate).toString();
+  snapshot.fileTransferDir = value(Core::FileTransferDir).toString();
+  snapshot.fileTransferReceive = value(Core::FileTransferReceive).toBool();
+  snapshot.fileTransferMaxSize = value(Core::FileTransferMaxSize).toULongLong();
+  snapshot.bulkRateLimit = value(Server::BulkRateLimit).toDouble();
+  snapshot.bulkGlobalRateLimit = value(Server::BulkGlobalRateLimit).toDouble();
+  return snapshot;
+}
+
+void Settings::updateSnapshot()
+{
+  auto next = std::make_shared<const Snapshot>(readSnapshot());
+  {
+    std::scoped_lock lock{m_snapshotMutex};
+    if (m_snapshot && *m_snapshot == *next)
+      return;
+    m_snapshot = std::move(next);
+  }
+  Q_EMIT snapshotChanged();
+}
+
 QString Settings::portableSettingsFile()
 {
   static const auto filename =
@@ -14,6 +14,9 @@
 #include "common/Constants.h"
 #include "common/QSettingsProxy.h"
 
+#include <memory>
+#include <mutex>
+
 class Settings : public QObject
 {
   Q_OBJECT
@@ -53,6 +56,16 @@ public:
     inline static const auto UseHooks = QStringLiteral("core/useHooks");
     inline static const auto Language = QStringLiteral("core/language");
     inline static const auto UseWlClipboard = QStringLiteral("core/wlClipboard");
+    inline static const auto ThreadScheduling = QStringLiteral("core/threadScheduling");
+    inline static const auto ThreadPriority = QStringLiteral("core/threadPriority");
+    inline static const auto CpuAffinity = QStringLiteral("core/cpuAffinity");
+    inline static const auto LockMemory = QStringLiteral("core/lockMemory");
+    inline static const auto TimerSlack = QStringLiteral("core/timerSlack");
+    inline static const auto TraceFile = QStringLiteral("core/traceFile");
+    inline static const auto StatsPort = QStringLiteral("core/statsPort");
+    inline static const auto FileTransferDir = QStringLiteral("core/fileTransferDir");
+    inline static const auto FileTransferReceive = QStringLiteral("core/fileTransferReceive");
+    inline static const auto FileTransferMaxSize = QStringLiteral("core/fileTransferMaxSize");
   };
   struct Daemon
   {
@@ -82,6 +95,12 @@ public:
     inline static const auto Level = QStringLiteral("log/level");
     inline static const auto ToFile = QStringLiteral("log/toFile");
     inline static const auto GuiDebug = QStringLiteral("log/guiDebug");
+    inline static const auto Async = QStringLiteral("log/async");
+    inline static const auto QueueSize = QStringLiteral("log/queueSize");
+    inline static const auto BlockWhenFull = QStringLiteral("log/blockWhenFull");
+    inline static const auto FileMaxSize = QStringLiteral("log/fileMaxSize");
+    inline static const auto FileGenerations = QStringLiteral("log/fileGenerations");
+    inline static const auto FileFlushInterval = QStringLiteral("log/fileFlushInterval");
   };
   struct Security
   {
@@ -94,6 +113,8 @@ public:
   {
     inline static const auto ExternalConfig = QStringLiteral("server/externalConfig");
     inline static const auto ExternalConfigFile = QStringLiteral("server/externalConfigFile");
+    inline static const auto BulkRateLimit = QStringLiteral("server/bulkRateLimit");
+    inline static const auto BulkGlobalRateLimit = QStringLiteral("server/bulkGlobalRateLimit");
   };
 
   // Enums types used in settings
@@ -118,6 +139,34 @@ public:
   };
   Q_ENUM(CoreMode)
 
+  /**
+   * @brief Typed copy of the settings the core reads while running
+   *
+   * Built the first time it is asked for and replaced as a whole when a value
+   * changes or reload() is called, so a snapshot never changes once built and
+   * can be read from any thread without touching QSettings.
+   */
+  struct Snapshot
+  {
+    QString screenName;
+    QString networkInterface;
+    bool preventSleep = false;
+    bool useWlClipboard = false;
+    bool languageSync = true;
+    bool invertScrollDirection = false;
+    int scrollSpeed = 120;
+    bool tlsEnabled = true;
+    bool checkPeers = true;
+    QString certificate;
+    QString fileTransferDir;
+    bool fileTransferReceive = false;
+    qulonglong fileTransferMaxSize = 1024; //!< MiB
+    double bulkRateLimit = 0.0;            //!< KiB/s, 0 for none
+    double bulkGlobalRateLimit = 0.0;      //!< KiB/s, 0 for none
+
+    bool operator==(const Snapshot &other) const = default;
+  };
+
   static Settings *instance();
   static void setSettingsFile(const QString &settingsFile = QString());
   static void setStateFile(const QString &stateFile = QString());
@@ -132,6 +181,8 @@ public:
   static QString tlsDir();
   static QString tlsTrustedServersDb();
   static QString tlsTrustedClientsDb();
+  static QString statsTokenFile();
+  static QString statusTokenFile();
   static QString logLevelText();
   static QSettingsProxy &proxy();
   static void save(bool emitSaving = true);
@@ -139,10 +190,25 @@ public:
   static int logLevelToInt(const QString &level);
   static QString portableSettingsFile();
 
+  /**
+   * @brief The current settings snapshot, safe to call from any thread
+   */
+  static std::shared_ptr<const Snapshot> snapshot();
+
+  /**
+   * @brief Re-read the settings files and replace the snapshot if anything changed
+   */
+  static void reload();
+
 Q_SIGNALS:
   void settingsChanged(const QString key);
   void serverSettingsChanged();
 
+  /**
+   * @brief Emitted on the thread that replaced the snapshot, after the swap
+   */
+  void snapshotChanged();
+
 private:
   explicit Settings(QObject *parent = nullptr);
   Settings *operator=(Settings &other) = delete;
@@ -163,9 +229,14 @@ private:
    */
   static QString cleanScreenName(const QString &name);
 
+  static Snapshot readSnapshot();
+  void updateSnapshot();
+
   QSettings *m_settings = nullptr;
   QSettings *m_stateSettings = nullptr;
   std::shared_ptr<QSettingsProxy> m_settingsProxy;
+  std::shared_ptr<const Snapshot> m_snapshot;
+  std::mutex m_snapshotMutex;
 
   // clang-format off
   inline static const QStringList m_logLevels = {
@@ -196,6 +267,16 @@ private:
     , Settings::Core::UseHooks
     , Settings::Core::UseWlClipboard
     , Settings::Core::Language
+    , Settings::Core::ThreadScheduling
+    , Settings::Core::ThreadPriority
+    , Settings::Core::CpuAffinity
+    , Settings::Core::LockMemory
+    , Settings::Core::TimerSlack
+    , Settings::Core::TraceFile
+    , Settings::Core::StatsPort
+    , Settings::Core::FileTransferDir
+    , Settings::Core::FileTransferReceive
+    , Settings::Core::FileTransferMaxSize
     , Settings::Daemon::Command
     , Settings::Daemon::Elevate
     , Settings::Daemon::LogFile
@@ -203,6 +284,12 @@ private:
     , Settings::Log::Level
     , Settings::Log::ToFile
     , Settings::Log::GuiDebug
+    , Settings::Log::Async
+    , Settings::Log::QueueSize
+    , Settings::Log::BlockWhenFull
+    , Settings::Log::FileMaxSize
+    , Settings::Log::FileGenerations
+    , Settings::Log::FileFlushInterval
     , Settings::Gui::Autohide
     , Settings::Gui::AutoStartCore
     , Settings::Gui::AutoUpdateCheck
@@ -221,6 +308,8 @@ private:
     , Settings::Security::TlsEnabled
     , Settings::Server::ExternalConfig
     , Settings::Server::ExternalConfigFile
+    , Settings::Server::BulkRateLimit
+    , Settings::Server::BulkGlobalRateLimit
   };
 
   // When checking the default values this list contains the ones that default to false.
@@ -231,10 +320,14 @@ private:
     , Settings::Gui::ShownServerFirstStartMessage
     , Settings::Core::PreventSleep
     , Settings::Core::UseWlClipboard
+    , Settings::Core::LockMemory
+    , Settings::Core::FileTransferReceive
     , Settings::Server::ExternalConfig
     , Settings::Client::InvertScrollDirection
     , Settings::Log::ToFile
     , Settings::Log::GuiDebug
+    , Settings::Log::BlockWhenFull
+    , Settings::Log::Async
   };
 
   // When checking the default values this list contains the ones that default to true.
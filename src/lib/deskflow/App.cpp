@@ -11,17 +11,33 @@
 #include "arch/Arch.h"
 #include "base/Log.h"
 #include "base/LogOutputters.h"
+#include "base/StartupProfiler.h"
+#include "base/Trace.h"
 #include "common/ExitCodes.h"
 #include "common/PlatformInfo.h"
 #include "common/Settings.h"
 #include "deskflow/DeskflowException.h"
+#include "deskflow/StatsServer.h"
+#include "deskflow/StatusChannel.h"
+#include "mt/Thread.h"
 
 #if SYSAPI_WIN32
 #include "base/IEventQueue.h"
 #endif
 
+#include <algorithm>
 #include <stdexcept>
 
+#if SYSAPI_UNIX
+#include <cerrno>
+#include <cstring>
+#include <sys/mman.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/prctl.h>
+#endif
+
 #if WINAPI_CARBON
 #include "platform/OSXCocoaApp.h"
 #include <ApplicationServices/ApplicationServices.h>
@@ -33,6 +49,38 @@
 
 using namespace deskflow;
 
+namespace {
+
+void applyThreadScheduling(Thread &thread, const char *name)
+{
+  using enum IArchMultithread::SchedulingPolicy;
+
+  const auto policy =
+      static_cast<IArchMultithread::SchedulingPolicy>(Settings::value(Settings::Core::ThreadScheduling).toInt());
+  if (policy == Fifo || policy == RoundRobin) {
+    const auto priority = Settings::value(Settings::Core::ThreadPriority).toInt();
+    if (!thread.setScheduling(policy, priority)) {
+      LOG_WARN("%s thread: real-time scheduling refused, using best effort priority", name);
+    }
+  }
+
+  std::vector<int> cpus;
+  const auto cpuList = Settings::value(Settings::Core::CpuAffinity).toString().split(',', Qt::SkipEmptyParts);
+  for (const auto &cpu : cpuList) {
+    bool ok = false;
+    if (const int index = cpu.trimmed().toInt(&ok); ok) {
+      cpus.push_back(index);
+    }
+  }
+  if (!cpus.empty() && !thread.setAffinity(cpus)) {
+    LOG_WARN("%s thread: cpu affinity refused", name);
+  }
+
+  LOG_INFO("%s thread scheduling: %s", name, thread.getScheduling().c_str());
+}
+
+} // namespace
+
 App *App::s_instance = nullptr;
 
 //
@@ -71,6 +119,8 @@ int App::run()
   TransformProcessType(&psn, kProcessTransformToBackgroundApplication);
 #endif
 
+  StartupProfiler::start();
+
   // install application in to arch
   appUtil().adoptApp(this);
 
@@ -98,6 +148,7 @@ int App::run()
     LOG_CRIT("an unknown error occurred\n");
   }
 
+  saveTrace();
   return result;
 }
 
@@ -106,11 +157,120 @@ void App::setupFileLogging()
   if (Settings::value(Settings::Log::ToFile).toBool()) {
     const auto file = Settings::value(Settings::Log::File).toString();
     m_fileLog = new FileLogOutputter(file); // NOSONAR - Adopted by `Log`
+    m_fileLog->setMaxSize(Settings::value(Settings::Log::FileMaxSize).toLongLong());
+    m_fileLog->setGenerations(Settings::value(Settings::Log::FileGenerations).toInt());
+    // only the background writer flushes the file when the log goes idle,
+    // without it the last lines before a quiet spell would sit in the buffer
+    if (Settings::value(Settings::Log::Async).toBool()) {
+      m_fileLog->setFlushInterval(Settings::value(Settings::Log::FileFlushInterval).toInt() / 1000.0);
+    }
     CLOG->insert(m_fileLog);
     LOG_DEBUG1("logging to file (%s) enabled", qPrintable(file));
   }
 }
 
+void App::setupAsyncLogging()
+{
+  if (!Settings::value(Settings::Log::Async).toBool()) {
+    return;
+  }
+
+  const auto overflow =
+      Settings::value(Settings::Log::BlockWhenFull).toBool() ? LogQueue::Overflow::Block : LogQueue::Overflow::Drop;
+  const auto queueSize = std::max(Settings::value(Settings::Log::QueueSize).toInt(), 1);
+  CLOG->startWriter(static_cast<size_t>(queueSize), overflow);
+  LOG_DEBUG1("logging on background thread, queue size %d", queueSize);
+}
+
+void App::setupTracing()
+{
+  if (Settings::value(Settings::Core::TraceFile).toString().isEmpty()) {
+    return;
+  }
+
+  Trace::start();
+  LOG_INFO("input tracing enabled");
+}
+
+void App::saveTrace() const
+{
+  if (!Trace::isEnabled()) {
+    return;
+  }
+
+  Trace::stop();
+  const auto file = Settings::value(Settings::Core::TraceFile).toString();
+  const auto records = Trace::collect();
+  const auto saved = file.endsWith(QStringLiteral(".json"), Qt::CaseInsensitive)
+                         ? Trace::saveJson(file.toStdString(), records)
+                         : Trace::save(file.toStdString(), records);
+  if (saved) {
+    LOG_INFO("saved %d trace records to %s", static_cast<int>(records.size()), qPrintable(file));
+  } else {
+    LOG_ERR("failed to save trace to %s", qPrintable(file));
+  }
+}
+
+void App::setupStatsServer()
+{
+  const auto port = Settings::value(Settings::Core::StatsPort).toInt();
+  if (port <= 0) {
+    return;
+  }
+
+  m_statsServer =
+      std::make_unique<StatsServer>(m_events, m_socketMultiplexer.get(), port, Settings::statsTokenFile());
+}
+
+void App::setupStatusChannel()
+{
+  if (m_statusPort <= 0) {
+    return;
+  }
+
+  m_statusChannel =
+      std::make_unique<StatusChannel>(m_events, m_socketMultiplexer.get(), m_statusPort, m_statusToken.toStdString());
+}
+
+void App::setupThreadScheduling()
+{
+  if (Settings::value(Settings::Core::LockMemory).toBool()) {
+#if SYSAPI_UNIX
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) == 0) {
+      LOG_DEBUG("process memory locked");
+    } else {
+      LOG_WARN("failed to lock process memory: %s", strerror(errno));
+    }
+#else
+    LOG_WARN("memory locking is not supported on this platform");
+#endif
+  }
+
+  if (m_socketMultiplexer) {
+    applyThreadScheduling(m_socketMultiplexer->getThread(), "socket");
+  }
+
+#if !WINAPI_CARBON
+  // on macos the event loop runs on its own thread, see runEventsLoop()
+  auto eventThread = Thread::getCurrentThread();
+  applyThreadScheduling(eventThread, "event");
+#endif
+
+  // timers on an idle core are keep alives and screen saver pokes, letting
+  // them slip lets the kernel batch them with other wakeups
+  if (const auto slackMs = Settings::value(Settings::Core::TimerSlack).toInt(); slackMs > 0) {
+#if defined(__linux__)
+    if (prctl(PR_SET_TIMERSLACK, static_cast<unsigned long>(slackMs) * 1'000'000UL, 0, 0, 0) == 0) {
+      LOG_DEBUG("event thread timer slack set to %dms", slackMs);
+    } else {
+      LOG_WARN("failed to set timer slack: %s", strerror(errno));
+    }
+#else
+    LOG_WARN("timer slack is not supported on this platform");
+#endif
+  }
+}
+
 void App::loggingFilterWarning() const
 {
   if ((CLOG->getFilter() > CLOG->getConsoleMaxLevel()) && (Settings::value(Settings::Log::ToFile).toBool())) {
@@ -137,9 +297,13 @@ void App::initApp()
 
   // setup file logging after parsing args
   setupFileLogging();
+  setupAsyncLogging();
+  setupTracing();
+  StartupProfiler::mark("logging");
 
   // load configuration
   loadConfig();
+  StartupProfiler::mark("config");
 }
 
 void App::handleScreenError() const
@@ -150,6 +314,11 @@ void App::handleScreenError() const
 
 void App::runEventsLoop(const void *)
 {
+#if WINAPI_CARBON
+  auto eventThread = Thread::getCurrentThread();
+  applyThreadScheduling(eventThread, "event");
+#endif
+
   m_events->loop();
 
 #if WINAPI_CARBON
@@ -29,6 +29,8 @@ class Screen;
 class FileLogOutputter;
 class IEventQueue;
 class SocketMultiplexer;
+class StatsServer;
+class StatusChannel;
 
 class App : public IApp
 {
@@ -60,6 +62,9 @@ public:
   }
   void bye(int error) override
   {
+    // exit() skips the log's destructor, write what is still queued
+    saveTrace();
+    CLOG->flush();
     m_bye(error);
   }
   IEventQueue *getEvents() const override
@@ -74,6 +79,50 @@ public:
 
   int run();
   void setupFileLogging();
+
+  /**
+   * @brief Move log output onto the background writer thread when enabled
+   * in the settings, so logging does not block the event or socket threads.
+   */
+  void setupAsyncLogging();
+
+  /**
+   * @brief Start recording an input trace when a trace file is configured.
+   * The trace is written by saveTrace() when the app exits.
+   */
+  void setupTracing();
+  void saveTrace() const;
+
+  /**
+   * @brief Apply the configured scheduling, CPU affinity and memory locking
+   * to the input critical threads: the socket multiplexer thread and the
+   * calling (event loop) thread. Must be called after the socket multiplexer
+   * has been created.
+   */
+  void setupThreadScheduling();
+
+  /**
+   * @brief Serve live statistics on the configured local port. Must be
+   * called after the socket multiplexer has been created.
+   */
+  void setupStatsServer();
+
+  /**
+   * @brief Publish the core status to the GUI that started this core, if
+   * it asked for it with setStatusTarget(). Must be called after the socket
+   * multiplexer has been created.
+   */
+  void setupStatusChannel();
+
+  /**
+   * @brief Set the port the GUI listens on for status and the token it
+   * expects, a port of 0 publishes nothing. Must be called before run().
+   */
+  void setStatusTarget(int port, const QString &token)
+  {
+    m_statusPort = port;
+    m_statusToken = token;
+  }
   void loggingFilterWarning() const;
   void initApp() override;
 
@@ -91,6 +140,16 @@ public:
     return m_socketMultiplexer.get();
   }
 
+  StatsServer *getStatsServer() const
+  {
+    return m_statsServer.get();
+  }
+
+  StatusChannel *getStatusChannel() const
+  {
+    return m_statusChannel.get();
+  }
+
   static App &instance()
   {
     assert(s_instance != nullptr);
@@ -114,6 +173,10 @@ private:
   FileLogOutputter *m_fileLog = nullptr;
   ARCH_APP_UTIL m_appUtil;
   std::unique_ptr<SocketMultiplexer> m_socketMultiplexer;
+  std::unique_ptr<StatsServer> m_statsServer;
+  std::unique_ptr<StatusChannel> m_statusChannel;
+  int m_statusPort = 0;
+  QString m_statusToken;
   QString m_pname;
 };
 
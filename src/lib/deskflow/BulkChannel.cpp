@@ -0,0 +1,165 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "deskflow/BulkChannel.h"
+
+#include "base/IEventQueue.h"
+#include "base/Log.h"
+#include "deskflow/FileTransfer.h"
+#include "deskflow/ProtocolTypes.h"
+#include "deskflow/ProtocolUtil.h"
+#include "io/IStream.h"
+#include "io/StreamFilter.h"
+#include "net/SecureSocket.h"
+
+#include <QRandomGenerator>
+
+#include <array>
+#include <cstring>
+
+namespace {
+
+const size_t kTokenSize = 16;
+
+const SecureSocket *findSecureSocket(deskflow::IStream *stream)
+{
+  while (stream != nullptr) {
+    if (const auto *socket = dynamic_cast<const SecureSocket *>(stream); socket != nullptr) {
+      return socket;
+    }
+    const auto *filter = dynamic_cast<const StreamFilter *>(stream);
+    stream = filter != nullptr ? filter->getStream() : nullptr;
+  }
+  return nullptr;
+}
+
+} // namespace
+
+//
+// BulkChannel
+//
+
+BulkChannel::BulkChannel(
+    IEventQueue *events, deskflow::IStream *stream, const QString &directory, const ClipboardReader &readClipboard
+)
+    : m_events(events),
+      m_stream(stream),
+      m_readClipboard(readClipboard),
+      m_fileTransfer(std::make_unique<FileTransfer>(events, stream, directory))
+{
+  using enum EventTypes;
+  m_events->addHandler(StreamInputReady, m_stream->getEventTarget(), [this](const auto &) { handleData(); });
+  m_events->addHandler(StreamOutputError, m_stream->getEventTarget(), [this](const auto &) { handleClosed(); });
+  m_events->addHandler(StreamInputShutdown, m_stream->getEventTarget(), [this](const auto &) { handleClosed(); });
+  m_events->addHandler(StreamOutputShutdown, m_stream->getEventTarget(), [this](const auto &) { handleClosed(); });
+  m_events->addHandler(StreamInputFormatError, m_stream->getEventTarget(), [this](const auto &) {
+    handleClosed();
+  });
+
+  // messages that arrived with the hello won't get another event
+  if (m_stream->isReady()) {
+    m_events->addEvent(Event(StreamInputReady, m_stream->getEventTarget()));
+  }
+}
+
+BulkChannel::~BulkChannel()
+{
+  using enum EventTypes;
+  m_events->removeHandler(StreamInputReady, m_stream->getEventTarget());
+  m_events->removeHandler(StreamOutputError, m_stream->getEventTarget());
+  m_events->removeHandler(StreamInputShutdown, m_stream->getEventTarget());
+  m_events->removeHandler(StreamOutputShutdown, m_stream->getEventTarget());
+  m_events->removeHandler(StreamInputFormatError, m_stream->getEventTarget());
+
+  m_fileTransfer.reset();
+  m_stream->close();
+  delete m_stream;
+}
+
+bool BulkChannel::sendFiles(const QStringList &paths)
+{
+  return m_fileTransfer->sendFiles(paths);
+}
+
+void BulkChannel::setShaper(BulkShaper *shaper)
+{
+  m_fileTransfer->setShaper(shaper);
+}
+
+bool BulkChannel::helloBack(deskflow::IStream *stream, const std::string &name, const std::string &token)
+{
+  std::string protocolName;
+  int16_t major;
+  int16_t minor;
+  if (!ProtocolUtil::readf(stream, kMsgHello, &protocolName, &major, &minor) ||
+      (protocolName != kSynergyProtocolName && protocolName != kBarrierProtocolName)) {
+    return false;
+  }
+
+  LOG_DEBUG("got hello on bulk connection from %s, protocol v%d.%d", protocolName.c_str(), major, minor);
+  const std::string helloBackMessage = protocolName + kMsgHelloBackBulkArgs;
+  ProtocolUtil::writef(stream, helloBackMessage.c_str(), kProtocolMajorVersion, kProtocolMinorVersion, &name, &token);
+  return true;
+}
+
+std::string BulkChannel::newToken()
+{
+  std::array<quint32, kTokenSize / sizeof(quint32)> words;
+  QRandomGenerator::system()->fillRange(words.data(), words.size());
+  const auto bytes = QByteArray(reinterpret_cast<const char *>(words.data()), kTokenSize);
+  return bytes.toHex().toStdString();
+}
+
+bool BulkChannel::isToken(const std::string &token, const std::string &offered)
+{
+  if (offered.empty() || token.size() != offered.size()) {
+    return false;
+  }
+
+  uint8_t difference = 0;
+  for (size_t i = 0; i < offered.size(); ++i) {
+    difference |= static_cast<uint8_t>(token[i] ^ offered[i]);
+  }
+  return difference == 0;
+}
+
+bool BulkChannel::isSamePeer(deskflow::IStream *stream, deskflow::IStream *other)
+{
+  const auto *socket = findSecureSocket(stream);
+  const auto *otherSocket = findSecureSocket(other);
+  if (socket == nullptr || otherSocket == nullptr) {
+    return socket == otherSocket;
+  }
+
+  return socket->getPeerFingerprint() == otherSocket->getPeerFingerprint();
+}
+
+void BulkChannel::handleData()
+{
+  uint8_t code[4];
+  while (m_stream->read(code, 4) == 4) {
+    if (memcmp(code, kMsgDClipboard, 4) == 0) {
+      m_readClipboard(m_stream);
+    } else if (memcmp(code, kMsgDFileTransfer, 4) == 0) {
+      m_fileTransfer->readFileTransfer();
+    } else if (memcmp(code, kMsgDDragInfo, 4) == 0) {
+      m_fileTransfer->readDragInfo();
+    } else {
+      LOG_ERR("invalid message on bulk connection: %c%c%c%c", code[0], code[1], code[2], code[3]);
+      handleClosed();
+      return;
+    }
+  }
+}
+
+void BulkChannel::handleClosed()
+{
+  if (!m_closed) {
+    m_closed = true;
+    LOG_DEBUG("bulk connection closed");
+    m_events->addEvent(Event(EventTypes::BulkChannelClosed, this));
+  }
+}
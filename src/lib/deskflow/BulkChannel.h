@@ -0,0 +1,108 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <QString>
+#include <QStringList>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+class BulkShaper;
+class FileTransfer;
+class IEventQueue;
+
+namespace deskflow {
+class IStream;
+}
+
+//! Second connection carrying clipboards and files
+/*!
+The server offers it with \c kMsgDBulkChannel and a token, the client
+opens a connection with the same security and answers the hello on it
+with helloBack().  Both sides then wrap the connection in a BulkChannel.
+
+Only \c kMsgDClipboard, \c kMsgDFileTransfer and \c kMsgDDragInfo go
+over it, so a key press on the main connection never waits for a
+clipboard or file already in the kernel send buffer.  When the
+connection closes it sends \c BulkChannelClosed and the owner goes back
+to the main connection.
+
+Everything runs on the event queue thread.
+*/
+class BulkChannel
+{
+public:
+  //! Reads a \c kMsgDClipboard message from the stream, after its code
+  using ClipboardReader = std::function<void(deskflow::IStream *)>;
+
+  //! Receive files into \p directory and clipboards with \p readClipboard
+  BulkChannel(
+      IEventQueue *events, deskflow::IStream *adoptedStream, const QString &directory,
+      const ClipboardReader &readClipboard
+  );
+  BulkChannel(BulkChannel const &) = delete;
+  BulkChannel(BulkChannel &&) = delete;
+  ~BulkChannel();
+
+  BulkChannel &operator=(BulkChannel const &) = delete;
+  BulkChannel &operator=(BulkChannel &&) = delete;
+
+  //! @name manipulators
+  //@{
+
+  //! Send \p paths to the other side, after any files still being sent
+  bool sendFiles(const QStringList &paths);
+
+  //! Pace the files sent with \p shaper, or not at all if it is null
+  void setShaper(BulkShaper *shaper);
+
+  //! Answer the server's hello on a new connection
+  /*!
+  Reads \c kMsgHello from \p stream and replies with the client \p name
+  and the \p token offered on the main connection.  Returns false if the
+  hello is not from a server.
+  */
+  static bool helloBack(deskflow::IStream *stream, const std::string &name, const std::string &token);
+
+  //! Make a token to offer with \c kMsgDBulkChannel
+  static std::string newToken();
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Get the stream, for writing clipboard chunks
+  deskflow::IStream *getStream() const
+  {
+    return m_stream;
+  }
+
+  //! Test if \p token is \p offered, taking the same time for any token
+  static bool isToken(const std::string &token, const std::string &offered);
+
+  //! Test if both streams come from the same peer
+  /*!
+  With TLS the peer must have presented the same certificate, or none,
+  on both.  Without it the streams must both be plain.
+  */
+  static bool isSamePeer(deskflow::IStream *stream, deskflow::IStream *other);
+
+  //@}
+
+private:
+  void handleData();
+  void handleClosed();
+
+private:
+  IEventQueue *m_events;
+  deskflow::IStream *m_stream;
+  ClipboardReader m_readClipboard;
+  std::unique_ptr<FileTransfer> m_fileTransfer;
+  bool m_closed = false;
+};
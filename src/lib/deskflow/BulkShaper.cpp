@@ -0,0 +1,86 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "deskflow/BulkShaper.h"
+
+#include "arch/Arch.h"
+
+#include <algorithm>
+
+namespace {
+
+// seconds of unused rate a bucket keeps, the most a sender bursts after idling
+const double kBurstTime = 0.05;
+
+} // namespace
+
+BulkShaper::Bucket BulkShaper::s_global;
+BulkShaper::Stats BulkShaper::s_stats;
+BulkShaper::Clock BulkShaper::s_clock;
+
+//
+// BulkShaper
+//
+
+BulkShaper::BulkShaper(double rate)
+{
+  setRate(rate);
+}
+
+void BulkShaper::setRate(double rate)
+{
+  m_bucket = Bucket{std::max(rate, 0.0), 0.0, now()};
+}
+
+double BulkShaper::take(uint32_t size)
+{
+  const auto time = now();
+  m_bucket.refill(time);
+  s_global.refill(time);
+
+  if (const auto wait = std::max(m_bucket.wait(), s_global.wait()); wait > 0.0) {
+    ++s_stats.delays;
+    s_stats.delayed += wait;
+    return wait;
+  }
+
+  if (m_bucket.m_rate > 0.0) {
+    m_bucket.m_tokens -= size;
+  }
+  if (s_global.m_rate > 0.0) {
+    s_global.m_tokens -= size;
+  }
+  s_stats.bytes += size;
+  return 0.0;
+}
+
+void BulkShaper::setGlobalRate(double rate)
+{
+  s_global = Bucket{std::max(rate, 0.0), 0.0, now()};
+}
+
+void BulkShaper::setClock(const Clock &clock)
+{
+  s_clock = clock;
+}
+
+int64_t BulkShaper::now()
+{
+  return s_clock ? s_clock() : Arch::nanoTime();
+}
+
+void BulkShaper::Bucket::refill(int64_t now)
+{
+  if (m_rate > 0.0) {
+    m_tokens = std::min(m_tokens + m_rate * static_cast<double>(now - m_last) / 1e9, m_rate * kBurstTime);
+  }
+  m_last = now;
+}
+
+double BulkShaper::Bucket::wait() const
+{
+  return m_tokens < 0.0 ? -m_tokens / m_rate : 0.0;
+}
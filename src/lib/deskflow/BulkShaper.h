@@ -0,0 +1,100 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+//! Limits the rate clipboards and files are sent at
+/*!
+Each sender asks take() before writing a chunk.  A token bucket per
+sender and one shared by every sender fill at their rate; a chunk is
+written while neither is in debt and is then charged to both, so a
+bucket may go negative by one chunk.  Otherwise take() says how long
+until the debt is paid and the sender sets a timer for it, so the
+stream never holds more than a chunk beyond the rate and input messages
+behind it are not held up.
+
+A rate of 0 leaves that bucket unlimited.  Everything runs on the event
+queue thread.
+*/
+class BulkShaper
+{
+public:
+  //! Delays over every sender
+  struct Stats
+  {
+    uint64_t delays = 0;  //!< Chunks that had to wait
+    double delayed = 0.0; //!< Seconds of those waits
+    uint64_t bytes = 0;   //!< Bytes charged, delayed or not
+  };
+
+  //! Returns the time in nanoseconds
+  using Clock = std::function<int64_t()>;
+
+  //! Limit this sender to \p rate bytes per second
+  explicit BulkShaper(double rate = 0.0);
+
+  //! @name manipulators
+  //@{
+
+  //! Change this sender's rate in bytes per second
+  void setRate(double rate);
+
+  //! Ask to write \p size bytes
+  /*!
+  Returns 0 and charges the chunk if it may be written now, otherwise the
+  seconds to wait before asking again.
+  */
+  double take(uint32_t size);
+
+  //! Change the rate shared by every sender, in bytes per second
+  static void setGlobalRate(double rate);
+
+  //! Read the time from \p clock, or from Arch::nanoTime() if it is empty
+  /*!
+  For tests.  Set it before the rates, which start their buckets now.
+  */
+  static void setClock(const Clock &clock);
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Get this sender's rate in bytes per second
+  double rate() const
+  {
+    return m_bucket.m_rate;
+  }
+
+  //! Get the delays so far, only valid on the event queue thread
+  static Stats getStats()
+  {
+    return s_stats;
+  }
+
+  //@}
+
+private:
+  struct Bucket
+  {
+    void refill(int64_t now);
+    double wait() const;
+
+    double m_rate = 0.0;
+    double m_tokens = 0.0;
+    int64_t m_last = 0;
+  };
+
+  static int64_t now();
+
+  Bucket m_bucket;
+
+  static Bucket s_global;
+  static Stats s_stats;
+  static Clock s_clock;
+};
@@ -8,15 +8,19 @@
 
 #include "deskflow/ClientApp.h"
 
+#include "base/CoreStatus.h"
 #include "base/Event.h"
 #include "base/IEventQueue.h"
 #include "base/Log.h"
+#include "base/StartupProfiler.h"
 #include "client/Client.h"
 #include "common/ExitCodes.h"
 #include "common/PlatformInfo.h"
 #include "common/Settings.h"
 #include "deskflow/Screen.h"
 #include "deskflow/ScreenException.h"
+#include "deskflow/StatsServer.h"
+#include "deskflow/StatusChannel.h"
 #include "net/NetworkAddress.h"
 #include "net/SocketException.h"
 #include "net/SocketMultiplexer.h"
@@ -27,6 +31,8 @@
 #endif
 
 #include <QFileInfo> // Must include before XWindowsScreen to avoid conflicts with xlib.h
+#include <QJsonArray>
+#include <QJsonObject>
 
 #if WINAPI_XWINDOWS
 #include "platform/XWindowsScreen.h"
@@ -81,12 +87,13 @@ const char *ClientApp::daemonName() const
 
 deskflow::Screen *ClientApp::createScreen()
 {
-  const bool invertScrolling = Settings::value(Settings::Client::InvertScrollDirection).toBool();
+  const auto settings = Settings::snapshot();
+  const bool invertScrolling = settings->invertScrollDirection;
 #if WINAPI_MSWINDOWS
   return new deskflow::Screen(
       new MSWindowsScreen(
-          false, Settings::value(Settings::Core::UseHooks).toBool(), getEvents(),
-          Settings::value(Settings::Client::LanguageSync).toBool(), invertScrolling
+          false, Settings::value(Settings::Core::UseHooks).toBool(), getEvents(), settings->languageSync,
+          invertScrolling
       ),
       getEvents()
   );
@@ -107,8 +114,8 @@ deskflow::Screen *ClientApp::createScreen()
   LOG_INFO("using legacy x windows screen");
   return new deskflow::Screen(
       new XWindowsScreen(
-          qPrintable(Settings::value(Settings::Core::Display).toString()), false,
-          Settings::value(Settings::Client::ScrollSpeed).toInt(), getEvents(), invertScrolling
+          qPrintable(Settings::value(Settings::Core::Display).toString()), false, settings->scrollSpeed, getEvents(),
+          invertScrolling
       ),
       getEvents()
   );
@@ -116,10 +123,7 @@ deskflow::Screen *ClientApp::createScreen()
 #endif
 
 #if WINAPI_CARBON
-  return new deskflow::Screen(
-      new OSXScreen(getEvents(), false, Settings::value(Settings::Client::LanguageSync).toBool(), invertScrolling),
-      getEvents()
-  );
+  return new deskflow::Screen(new OSXScreen(getEvents(), false, settings->languageSync, invertScrolling), getEvents());
 #endif
 }
 
@@ -161,6 +165,7 @@ void ClientApp::scheduleClientRestart(double retryTime)
 void ClientApp::handleClientConnected() const
 {
   LOG_IPC("connected to server");
+  CoreStatus::setConnectionState(CoreConnectionState::Connected);
 }
 
 void ClientApp::handleClientFailed(const Event &e)
@@ -196,6 +201,7 @@ void ClientApp::handleClientRefused(const Event &e)
 void ClientApp::handleClientDisconnected()
 {
   LOG_IPC("disconnected from server");
+  CoreStatus::setConnectionState(CoreConnectionState::Disconnected);
   if (!m_suspended) {
     scheduleClientRestart(s_retryTime);
   }
@@ -247,6 +253,7 @@ bool ClientApp::startClient()
   try {
     if (m_clientScreen == nullptr) {
       clientScreen = openClientScreen();
+      StartupProfiler::mark("screen");
       m_client = openClient(
           Settings::value(Settings::Core::ScreenName).toString().toStdString(), *m_serverAddress, clientScreen
       );
@@ -254,6 +261,8 @@ bool ClientApp::startClient()
       LOG_NOTE("started client");
     }
 
+    StartupProfiler::finish("connecting");
+
     m_client->connect(m_lastServerAddressIndex);
 
     return true;
@@ -288,6 +297,36 @@ int ClientApp::mainLoop()
   // create socket multiplexer.  this must happen after daemonization
   // on unix because threads evaporate across a fork().
   setSocketMultiplexer(std::make_unique<SocketMultiplexer>());
+  setupThreadScheduling();
+  setupStatusChannel();
+  setupStatsServer();
+  if (auto *channel = getStatusChannel(); channel != nullptr) {
+    // only the gui that started this core can ask it to send files
+    channel->addCommand(QStringLiteral("sendFiles"), [this](const QJsonObject &message) {
+      std::vector<std::string> paths;
+      for (const auto &path : message.value("paths").toArray()) {
+        paths.push_back(path.toString().toStdString());
+      }
+      if (m_client == nullptr || !m_client->sendFiles(paths)) {
+        LOG_WARN("can't send files, not connected to the server");
+      }
+    });
+  }
+  StartupProfiler::mark("services");
+  if (auto *stats = getStatsServer(); stats != nullptr) {
+    stats->addSource(QStringLiteral("server"), [this] {
+      if (m_client == nullptr || !m_client->isConnected()) {
+        return QJsonValue();
+      }
+      const auto traffic = m_client->getTraffic();
+      return QJsonValue(QJsonObject{
+          {"messagesIn", static_cast<qint64>(traffic.packetsIn)},
+          {"messagesOut", static_cast<qint64>(traffic.packetsOut)},
+          {"bytesIn", static_cast<qint64>(traffic.bytesIn)},
+          {"bytesOut", static_cast<qint64>(traffic.bytesOut)},
+      });
+    });
+  }
 
   // start client, etc
   appUtil().startNode();
@@ -8,12 +8,14 @@
 
 #include "base/Log.h"
 #include "base/String.h"
+#include "base/Trace.h"
 #include "deskflow/ProtocolTypes.h"
 #include "deskflow/ProtocolUtil.h"
 #include "io/IStream.h"
 #include <cstring>
 
-size_t ClipboardChunk::s_expectedSize = 0;
+std::array<size_t, kClipboardEnd> ClipboardChunk::s_expectedSize{};
+ClipboardChunk::Progress ClipboardChunk::s_progress;
 
 ClipboardChunk::ClipboardChunk(size_t size) : Chunk(size)
 {
@@ -62,8 +64,14 @@ ClipboardChunk *ClipboardChunk::end(ClipboardID id, uint32_t sequence)
   return end;
 }
 
-TransferState
-ClipboardChunk::assemble(deskflow::IStream *stream, std::string &dataCached, ClipboardID &id, uint32_t &sequence)
+size_t ClipboardChunk::getStartSize() const
+{
+  return QString::fromStdString(std::string(&m_chunk[6], m_dataSize)).toULong();
+}
+
+TransferState ClipboardChunk::assemble(
+    deskflow::IStream *stream, std::array<std::string, kClipboardEnd> &dataCached, ClipboardID &id, uint32_t &sequence
+)
 {
   using enum TransferState;
   uint8_t mark;
@@ -72,21 +80,26 @@ ClipboardChunk::assemble(deskflow::IStream *stream, std::string &dataCached, Cli
   if (!ProtocolUtil::readf(stream, kMsgDClipboard + 4, &id, &sequence, &mark, &data)) {
     return Error;
   }
+  if (id >= kClipboardEnd) {
+    return Error;
+  }
 
+  auto &cached = dataCached[id];
   if (mark == ChunkType::DataStart) {
-    s_expectedSize = QString::fromStdString(data).toULong();
+    s_expectedSize[id] = QString::fromStdString(data).toULong();
     LOG_DEBUG("start receiving clipboard data");
-    dataCached.clear();
+    cached.clear();
+    s_progress.receiveTotal = s_expectedSize[id];
+    s_progress.received = 0;
     return Started;
   } else if (mark == ChunkType::DataChunk) {
-    dataCached.append(data);
+    cached.append(data);
+    s_progress.received = cached.size();
     return TransferState::InProgress;
   } else if (mark == ChunkType::DataEnd) {
     // validate
-    if (id >= kClipboardEnd) {
-      return Error;
-    } else if (s_expectedSize != dataCached.size()) {
-      LOG_ERR("corrupted clipboard data, expected size=%d actual size=%d", s_expectedSize, dataCached.size());
+    if (s_expectedSize[id] != cached.size()) {
+      LOG_ERR("corrupted clipboard data, expected size=%d actual size=%d", s_expectedSize[id], cached.size());
       return Error;
     }
     return Finished;
@@ -99,6 +112,7 @@ ClipboardChunk::assemble(deskflow::IStream *stream, std::string &dataCached, Cli
 void ClipboardChunk::send(deskflow::IStream *stream, void *data)
 {
   const auto *clipboardData = static_cast<ClipboardChunk *>(data);
+  const TraceScope scope(TraceSpan::ClipboardChunk, stream, static_cast<int64_t>(clipboardData->m_dataSize));
 
   LOG_DEBUG1("sending clipboard chunk");
 
@@ -112,10 +126,13 @@ void ClipboardChunk::send(deskflow::IStream *stream, void *data)
   switch (mark) {
   case ChunkType::DataStart:
     LOG_DEBUG2("sending clipboard chunk start: size=%s", dataChunk.c_str());
+    s_progress.sendTotal = QString::fromStdString(dataChunk).toULong();
+    s_progress.sent = 0;
     break;
 
   case ChunkType::DataChunk:
     LOG_DEBUG2("sending clipboard chunk data: size=%i", dataChunk.size());
+    s_progress.sent += dataChunk.size();
     break;
 
   case ChunkType::DataEnd:
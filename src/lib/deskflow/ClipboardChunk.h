@@ -10,10 +10,18 @@
 #include "deskflow/ClipboardTypes.h"
 #include "deskflow/ProtocolTypes.h"
 
+#include <array>
 #include <string>
 
 constexpr static auto s_clipboardChunkMetaSize = 7;
 
+//! Clipboards up to this size stay on the main connection
+/*!
+So they reach the peer before the enter and keys sent after them, and a
+paste straight after switching screens gets the new clipboard.
+*/
+constexpr static auto s_smallClipboardSize = 64 * 1024;
+
 namespace deskflow {
 class IStream;
 }
@@ -21,22 +29,66 @@ class IStream;
 class ClipboardChunk : public Chunk
 {
 public:
+  //! Bytes of the most recent clipboard transfer in each direction
+  struct Progress
+  {
+    size_t sendTotal = 0;
+    size_t sent = 0;
+    size_t receiveTotal = 0;
+    size_t received = 0;
+  };
+
   explicit ClipboardChunk(size_t size);
 
   static ClipboardChunk *start(ClipboardID id, uint32_t sequence, const std::string &size);
   static ClipboardChunk *data(ClipboardID id, uint32_t sequence, const std::string &data);
   static ClipboardChunk *end(ClipboardID id, uint32_t sequence);
 
-  static TransferState
-  assemble(deskflow::IStream *stream, std::string &dataCached, ClipboardID &id, uint32_t &sequence);
+  //! Read a chunk from \p stream into the data of its clipboard
+  /*!
+  Each clipboard is assembled apart, so one can arrive on the main
+  connection while another is part way across the bulk connection.
+  */
+  static TransferState assemble(
+      deskflow::IStream *stream, std::array<std::string, kClipboardEnd> &dataCached, ClipboardID &id,
+      uint32_t &sequence
+  );
 
   static void send(deskflow::IStream *stream, void *data);
 
-  static size_t getExpectedSize()
+  //! Get the clipboard this chunk is part of
+  ClipboardID getID() const
+  {
+    return static_cast<ClipboardID>(m_chunk[0]);
+  }
+
+  //! Test if this chunk starts a clipboard
+  bool isStart() const
+  {
+    return m_chunk[5] == ChunkType::DataStart;
+  }
+
+  //! Test if this chunk ends a clipboard
+  bool isEnd() const
+  {
+    return m_chunk[5] == ChunkType::DataEnd;
+  }
+
+  //! Get the size of the clipboard a start chunk begins
+  size_t getStartSize() const;
+
+  static size_t getExpectedSize(ClipboardID id)
+  {
+    return s_expectedSize[id];
+  }
+
+  //! Get the transfer progress, only valid on the event queue thread
+  static Progress getProgress()
   {
-    return s_expectedSize;
+    return s_progress;
   }
 
 private:
-  static size_t s_expectedSize;
+  static std::array<size_t, kClipboardEnd> s_expectedSize;
+  static Progress s_progress;
 };
@@ -0,0 +1,621 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "deskflow/FileTransfer.h"
+
+#include "arch/Arch.h"
+#include "base/IEventQueue.h"
+#include "base/Log.h"
+#include "common/Constants.h"
+#include "common/Settings.h"
+#include "deskflow/BulkShaper.h"
+#include "deskflow/ProtocolTypes.h"
+#include "deskflow/ProtocolUtil.h"
+#include "io/IStream.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QStorageInfo>
+
+#include <algorithm>
+
+namespace {
+
+// same message as kMsgDFileTransfer, with the data passed as a size and pointer
+const char *const kMsgDFileTransferData = "DFTR%1i%S";
+
+const size_t kDigestSize = 32;
+const size_t kStartSize = 8 + kDigestSize;
+const size_t kResumeSize = kDigestSize + 8;
+
+// resume offset of a refused file
+const uint64_t kRefused = UINT64_MAX;
+
+// digest of the refusal of a start that couldn't be read
+const QByteArray kNoDigest(kDigestSize, '\0');
+
+// files named by an old peer, or without a name, are saved under this one
+const auto kDefaultName = QStringLiteral("received-file");
+
+void appendUInt64(QByteArray &data, uint64_t value)
+{
+  for (int shift = 56; shift >= 0; shift -= 8) {
+    data.append(static_cast<char>((value >> shift) & 0xff));
+  }
+}
+
+uint64_t readUInt64(const char *data)
+{
+  uint64_t value = 0;
+  for (int i = 0; i < 8; ++i) {
+    value = (value << 8) | static_cast<uint8_t>(data[i]);
+  }
+  return value;
+}
+
+} // namespace
+
+FileTransfer::Progress FileTransfer::s_progress;
+
+//
+// FileTransfer
+//
+
+FileTransfer::FileTransfer(IEventQueue *events, deskflow::IStream *stream, const QString &directory)
+    : m_events(events),
+      m_stream(stream),
+      m_directory(directory)
+{
+  m_events->addHandler(EventTypes::StreamOutputFlushed, m_stream->getEventTarget(), [this](const auto &) {
+    if (m_awaitingFlush) {
+      m_awaitingFlush = false;
+      sendChunks();
+    }
+  });
+  m_events->addHandler(EventTypes::FileTransferHashing, this, [this](const auto &) { hashStep(); });
+
+  // files only arrive unasked when the user turned it on
+  if (const auto settings = Settings::snapshot(); settings->fileTransferReceive) {
+    m_receiveLimit = settings->fileTransferMaxSize * 1024 * 1024;
+  }
+}
+
+FileTransfer::~FileTransfer()
+{
+  m_events->removeHandler(EventTypes::StreamOutputFlushed, m_stream->getEventTarget());
+  m_events->removeHandler(EventTypes::FileTransferHashing, this);
+  closeSentFile();
+
+  // a partial file is kept so the transfer can resume
+  m_receiveFile.close();
+}
+
+QString FileTransfer::partPath(const QString &directory, const QByteArray &digest)
+{
+  const auto name = QStringLiteral(".%1-%2.part").arg(kAppId, QString::fromLatin1(digest.toHex()));
+  return QDir(directory).filePath(name);
+}
+
+bool FileTransfer::sendFiles(const QStringList &paths)
+{
+  QStringList files;
+  std::string names;
+  for (const auto &path : paths) {
+    const QFileInfo info(path);
+    if (!info.isFile() || !info.isReadable()) {
+      LOG_WARN("can't send \"%s\", not a readable file", qPrintable(path));
+      continue;
+    }
+    files.append(info.absoluteFilePath());
+    names.append(info.fileName().toStdString());
+    names.push_back('\0');
+  }
+
+  if (files.isEmpty() || files.size() > UINT16_MAX) {
+    return false;
+  }
+
+  LOG_DEBUG("offering %d files", static_cast<int>(files.size()));
+  ProtocolUtil::writef(m_stream, kMsgDDragInfo, static_cast<uint16_t>(files.size()), &names);
+
+  const bool idle = m_sendFile == nullptr;
+  m_sendQueue.append(files);
+  if (idle) {
+    startNextFile();
+  }
+  return true;
+}
+
+bool FileTransfer::readDragInfo()
+{
+  uint16_t count = 0;
+  std::string names;
+  if (!ProtocolUtil::readf(m_stream, kMsgDDragInfo + 4, &count, &names)) {
+    return false;
+  }
+
+  // only the name is used, whatever path the other side sent
+  int added = 0;
+  for (const auto &name : QString::fromStdString(names).split(QChar(u'\0'), Qt::SkipEmptyParts)) {
+    const auto fileName = QFileInfo(name).fileName();
+    m_receiveNames.append(fileName == "." || fileName == ".." ? kDefaultName : fileName);
+    ++added;
+  }
+  if (added != count) {
+    LOG_WARN("file offer names %d files, expected %d", added, count);
+  }
+  return true;
+}
+
+bool FileTransfer::readFileTransfer()
+{
+  uint8_t mark = 0;
+  std::string data;
+  if (!ProtocolUtil::readf(m_stream, kMsgDFileTransfer + 4, &mark, &data)) {
+    return false;
+  }
+
+  switch (mark) {
+  case ChunkType::DataStart:
+    startFile(data);
+    break;
+
+  case ChunkType::DataChunk:
+    appendFile(data);
+    break;
+
+  case ChunkType::DataEnd:
+    endFile();
+    break;
+
+  case ChunkType::DataResume:
+    resume(data);
+    break;
+
+  default:
+    LOG_WARN("file transfer message with unknown mark %d", mark);
+    break;
+  }
+  return true;
+}
+
+void FileTransfer::postHashStep()
+{
+  if (!m_hashStepPosted) {
+    m_hashStepPosted = true;
+    m_events->addEvent(Event(EventTypes::FileTransferHashing, this));
+  }
+}
+
+void FileTransfer::hashStep()
+{
+  m_hashStepPosted = false;
+  if (m_sendHashing) {
+    hashSendStep();
+  }
+  if (m_receiveHashing) {
+    hashReceiveStep();
+  }
+  if (m_sendHashing || m_receiveHashing) {
+    postHashStep();
+  }
+}
+
+void FileTransfer::startNextFile()
+{
+  while (!m_sendQueue.isEmpty()) {
+    const auto path = m_sendQueue.takeFirst();
+    auto file = std::make_unique<QFile>(path);
+
+    // unbuffered, each chunk is read straight into the buffer it's sent from
+    if (!file->open(QFile::ReadOnly | QFile::Unbuffered)) {
+      LOG_ERR("can't send \"%s\": %s", qPrintable(path), qPrintable(file->errorString()));
+      continue;
+    }
+
+    m_sendFile = std::move(file);
+    m_sendSize = static_cast<uint64_t>(m_sendFile->size());
+    m_sendOffset = 0;
+    m_sendHash.reset();
+    m_sendHashing = true;
+
+    LOG_INFO("sending \"%s\", %llu bytes", qPrintable(path), static_cast<unsigned long long>(m_sendSize));
+    s_progress.sendTotal = m_sendSize;
+    s_progress.sent = 0;
+
+    // the start holds the digest, the file is hashed first
+    postHashStep();
+    return;
+  }
+}
+
+void FileTransfer::hashSendStep()
+{
+  const auto size = static_cast<uint32_t>(std::min<uint64_t>(kHashStepSize, m_sendSize - m_sendOffset));
+  if (!readChunk(m_sendOffset, size)) {
+    dropSentFile();
+    return;
+  }
+  m_sendHash.addData(m_chunk);
+  m_sendOffset += size;
+  if (m_sendOffset < m_sendSize) {
+    return;
+  }
+
+  m_sendHashing = false;
+  m_sendOffset = 0;
+  m_sendDigest = m_sendHash.result();
+
+  QByteArray start;
+  appendUInt64(start, m_sendSize);
+  start.append(m_sendDigest);
+  writeMessage(ChunkType::DataStart, start.constData(), static_cast<uint32_t>(start.size()));
+
+  // the receiver replies with how much it already has
+  m_awaitingResume = true;
+  startResumeTimer();
+}
+
+void FileTransfer::resume(const std::string &data)
+{
+  if (!m_awaitingResume || data.size() != kResumeSize) {
+    LOG_DEBUG("ignoring file transfer resume for another file");
+    return;
+  }
+
+  const QByteArrayView digest(data.data(), static_cast<qsizetype>(kDigestSize));
+  const auto offset = readUInt64(data.data() + kDigestSize);
+  if (digest != QByteArrayView(m_sendDigest) && (digest != QByteArrayView(kNoDigest) || offset != kRefused)) {
+    LOG_DEBUG("ignoring file transfer resume for another file");
+    return;
+  }
+
+  m_awaitingResume = false;
+  stopResumeTimer();
+  if (offset == kRefused) {
+    LOG_WARN("the other side refused \"%s\"", qPrintable(m_sendFile->fileName()));
+    ++s_progress.filesFailed;
+    closeSentFile();
+    startNextFile();
+    return;
+  }
+
+  m_sendOffset = std::min(offset, m_sendSize);
+  if (m_sendOffset > 0) {
+    LOG_INFO("resuming file transfer at %llu bytes", static_cast<unsigned long long>(m_sendOffset));
+  }
+  s_progress.sent = m_sendOffset;
+  s_progress.resumed += m_sendOffset;
+  sendChunks();
+}
+
+void FileTransfer::sendChunks()
+{
+  if (m_sendFile == nullptr || m_sendHashing || m_awaitingResume || m_shapingTimer != nullptr) {
+    return;
+  }
+
+  // one window at a time, the rest once the stream has written it
+  if (m_sendOffset >= m_windowEnd) {
+    m_windowEnd = std::min(m_sendOffset + kWindowSize, m_sendSize);
+  }
+  while (m_sendOffset < m_windowEnd) {
+    const auto size = static_cast<uint32_t>(std::min<uint64_t>(kChunkSize, m_windowEnd - m_sendOffset));
+    if (const auto wait = m_shaper != nullptr ? m_shaper->take(size) : 0.0; wait > 0.0) {
+      startShapingTimer(wait);
+      return;
+    }
+    if (!readChunk(m_sendOffset, size)) {
+      // ending early makes the receiver drop what it has
+      writeMessage(ChunkType::DataEnd, nullptr, 0);
+      dropSentFile();
+      return;
+    }
+    writeMessage(ChunkType::DataChunk, m_chunk.constData(), size);
+    m_sendOffset += size;
+    s_progress.sent = m_sendOffset;
+  }
+
+  if (m_sendOffset < m_sendSize) {
+    m_awaitingFlush = true;
+    return;
+  }
+
+  writeMessage(ChunkType::DataEnd, nullptr, 0);
+  LOG_DEBUG("finished sending \"%s\"", qPrintable(m_sendFile->fileName()));
+  ++s_progress.filesSent;
+  closeSentFile();
+  startNextFile();
+}
+
+bool FileTransfer::readChunk(uint64_t offset, uint32_t size)
+{
+  // a file that shrank since it was opened reads short, where a mapping would fault
+  m_chunk.resize(size);
+  return m_sendFile->seek(static_cast<qint64>(offset)) && m_sendFile->read(m_chunk.data(), size) == size;
+}
+
+void FileTransfer::dropSentFile()
+{
+  LOG_ERR("can't send \"%s\", it changed while being read", qPrintable(m_sendFile->fileName()));
+  ++s_progress.filesFailed;
+  closeSentFile();
+  startNextFile();
+}
+
+void FileTransfer::closeSentFile()
+{
+  m_sendFile.reset();
+  m_chunk.clear();
+  m_sendSize = 0;
+  m_sendOffset = 0;
+  m_windowEnd = 0;
+  m_sendHashing = false;
+  m_awaitingResume = false;
+  m_awaitingFlush = false;
+  stopShapingTimer();
+  stopResumeTimer();
+}
+
+void FileTransfer::startShapingTimer(double wait)
+{
+  m_shapingTimer = m_events->newOneShotTimer(wait, nullptr);
+  m_events->addHandler(EventTypes::Timer, m_shapingTimer, [this](const auto &) {
+    stopShapingTimer();
+    sendChunks();
+  });
+}
+
+void FileTransfer::stopShapingTimer()
+{
+  if (m_shapingTimer != nullptr) {
+    m_events->removeHandler(EventTypes::Timer, m_shapingTimer);
+    m_events->deleteTimer(m_shapingTimer);
+    m_shapingTimer = nullptr;
+  }
+}
+
+void FileTransfer::startResumeTimer()
+{
+  // a peer that never replies must not hold up the files behind this one
+  m_resumeTimer = m_events->newOneShotTimer(m_resumeTimeout, nullptr);
+  m_events->addHandler(EventTypes::Timer, m_resumeTimer, [this](const auto &) {
+    LOG_WARN("no reply to sending \"%s\", skipping it", qPrintable(m_sendFile->fileName()));
+    ++s_progress.filesFailed;
+    closeSentFile();
+    startNextFile();
+  });
+}
+
+void FileTransfer::stopResumeTimer()
+{
+  if (m_resumeTimer != nullptr) {
+    m_events->removeHandler(EventTypes::Timer, m_resumeTimer);
+    m_events->deleteTimer(m_resumeTimer);
+    m_resumeTimer = nullptr;
+  }
+}
+
+void FileTransfer::writeMessage(uint8_t mark, const void *data, uint32_t size)
+{
+  ProtocolUtil::writef(m_stream, kMsgDFileTransferData, mark, size, static_cast<const uint8_t *>(data));
+}
+
+void FileTransfer::startFile(const std::string &data)
+{
+  if (m_receiveFile.isOpen()) {
+    LOG_WARN("file transfer of \"%s\" interrupted", qPrintable(m_receiveName));
+    m_receiveFile.close();
+    m_receiveFile.setFileName(QString());
+  }
+
+  m_receiveName = m_receiveNames.isEmpty() ? kDefaultName : m_receiveNames.takeFirst();
+  if (data.size() != kStartSize) {
+    // without a digest the sender can't tell which file, so it is refused with none
+    failFile("invalid start of file");
+    m_receiveDigest = kNoDigest;
+    m_received = 0;
+    sendResume(kRefused);
+    return;
+  }
+
+  m_receiveSize = readUInt64(data.data());
+  m_receiveDigest = QByteArray(data.data() + 8, static_cast<qsizetype>(kDigestSize));
+  m_receiveHash.reset();
+  m_received = 0;
+  m_receiveHashed = 0;
+  m_receiveHashing = false;
+  m_receiveStarted = Arch::nanoTime();
+
+  if (m_receiveLimit == 0) {
+    refuseFile("receiving files is turned off");
+    return;
+  }
+  if (m_receiveSize > m_receiveLimit) {
+    refuseFile("larger than the size limit");
+    return;
+  }
+
+  // a partial file left by an interrupted transfer of the same content is continued
+  QDir().mkpath(m_directory);
+  const auto path = partPath(m_directory, m_receiveDigest);
+  const auto partial = static_cast<uint64_t>(QFileInfo(path).size());
+  const auto needed = m_receiveSize - (partial <= m_receiveSize ? partial : 0);
+  if (const QStorageInfo storage(m_directory);
+      storage.isValid() && static_cast<uint64_t>(storage.bytesAvailable()) < needed) {
+    refuseFile("not enough free space");
+    return;
+  }
+
+  m_receiveFile.setFileName(path);
+  if (!m_receiveFile.open(QFile::ReadWrite)) {
+    LOG_ERR("can't write \"%s\": %s", qPrintable(m_receiveFile.fileName()), qPrintable(m_receiveFile.errorString()));
+    failFile("can't create the file");
+    sendResume(kRefused);
+    return;
+  }
+
+  if (static_cast<uint64_t>(m_receiveFile.size()) > m_receiveSize) {
+    m_receiveFile.resize(0);
+  }
+  m_received = static_cast<uint64_t>(m_receiveFile.size());
+
+  LOG_INFO(
+      "receiving \"%s\", %llu bytes", qPrintable(m_receiveName), static_cast<unsigned long long>(m_receiveSize)
+  );
+  s_progress.receiveTotal = m_receiveSize;
+  s_progress.received = m_received;
+
+  if (m_received == 0) {
+    sendResume(0);
+    return;
+  }
+
+  // the digest must cover what is already there, it is read a step at a time
+  LOG_DEBUG("hashing %llu bytes of a partial file", static_cast<unsigned long long>(m_received));
+  m_receiveFile.seek(0);
+  m_receiveHashing = true;
+  postHashStep();
+}
+
+void FileTransfer::hashReceiveStep()
+{
+  const auto size = static_cast<qint64>(std::min<uint64_t>(kHashStepSize, m_received - m_receiveHashed));
+  const auto data = m_receiveFile.read(size);
+  if (data.size() != size) {
+    // start over rather than resume from what can't be read
+    LOG_WARN("can't read the partial file, receiving \"%s\" from the start", qPrintable(m_receiveName));
+    m_receiveFile.resize(0);
+    m_receiveHash.reset();
+    m_received = 0;
+    m_receiveHashing = false;
+    sendResume(0);
+    return;
+  }
+
+  m_receiveHash.addData(data);
+  m_receiveHashed += static_cast<uint64_t>(size);
+  if (m_receiveHashed < m_received) {
+    return;
+  }
+
+  m_receiveHashing = false;
+  sendResume(m_received);
+}
+
+void FileTransfer::sendResume(uint64_t offset)
+{
+  if (m_receiveFile.isOpen()) {
+    m_receiveFile.seek(m_receiveFile.size());
+  }
+  s_progress.received = m_received;
+
+  QByteArray reply(m_receiveDigest);
+  appendUInt64(reply, offset);
+  writeMessage(ChunkType::DataResume, reply.constData(), static_cast<uint32_t>(reply.size()));
+}
+
+void FileTransfer::appendFile(const std::string &data)
+{
+  if (!m_receiveFile.isOpen() || m_receiveHashing) {
+    LOG_DEBUG2("ignoring file data outside a transfer");
+    return;
+  }
+
+  if (m_received + data.size() > m_receiveSize) {
+    failFile("more data than announced");
+    return;
+  }
+
+  if (m_receiveFile.write(data.data(), static_cast<qint64>(data.size())) != static_cast<qint64>(data.size())) {
+    LOG_ERR("can't write \"%s\": %s", qPrintable(m_receiveFile.fileName()), qPrintable(m_receiveFile.errorString()));
+    failFile("write failed");
+    return;
+  }
+
+  m_receiveHash.addData(QByteArrayView(data.data(), static_cast<qsizetype>(data.size())));
+  m_received += data.size();
+  s_progress.received = m_received;
+}
+
+void FileTransfer::endFile()
+{
+  if (!m_receiveFile.isOpen() || m_receiveHashing) {
+    return;
+  }
+
+  m_receiveFile.close();
+  if (m_received != m_receiveSize) {
+    failFile("fewer bytes than announced");
+    return;
+  }
+  if (m_receiveHash.result() != m_receiveDigest) {
+    failFile("checksum mismatch");
+    return;
+  }
+
+  const auto path = uniquePath(m_receiveName);
+  if (!m_receiveFile.rename(path)) {
+    LOG_ERR("can't rename \"%s\": %s", qPrintable(m_receiveFile.fileName()), qPrintable(m_receiveFile.errorString()));
+    failFile("rename failed");
+    return;
+  }
+
+  const auto elapsed = static_cast<double>(Arch::nanoTime() - m_receiveStarted) / 1e9;
+  s_progress.receiveRate = elapsed > 0 ? static_cast<double>(m_receiveSize) / elapsed : 0.0;
+  ++s_progress.filesReceived;
+
+  LOG_NOTE("received \"%s\"", qPrintable(path));
+  m_lastReceived = path;
+  m_events->addEvent(Event(EventTypes::FileReceived, this));
+}
+
+void FileTransfer::refuseFile(const char *reason)
+{
+  LOG_WARN("refused \"%s\": %s", qPrintable(m_receiveName), reason);
+  sendResume(kRefused);
+
+  ++s_progress.filesFailed;
+  m_lastReceived.clear();
+  m_events->addEvent(Event(EventTypes::FileReceived, this));
+}
+
+void FileTransfer::failFile(const char *reason)
+{
+  LOG_ERR("file transfer of \"%s\" failed: %s", qPrintable(m_receiveName), reason);
+
+  // bad data must not be resumed from
+  m_receiveHashing = false;
+  m_receiveFile.close();
+  if (!m_receiveFile.fileName().isEmpty()) {
+    m_receiveFile.remove();
+  }
+  m_receiveFile.setFileName(QString());
+
+  ++s_progress.filesFailed;
+  m_lastReceived.clear();
+  m_events->addEvent(Event(EventTypes::FileReceived, this));
+}
+
+QString FileTransfer::uniquePath(const QString &name) const
+{
+  const QDir dir(m_directory);
+  auto path = dir.filePath(name);
+  if (!QFileInfo::exists(path)) {
+    return path;
+  }
+
+  // like browsers do, "name (2).ext"
+  const QFileInfo info(name);
+  const auto base = info.completeBaseName();
+  const auto suffix = info.suffix().isEmpty() ? QString() : QStringLiteral(".") + info.suffix();
+  for (int n = 2;; ++n) {
+    path = dir.filePath(QStringLiteral("%1 (%2)%3").arg(base).arg(n).arg(suffix));
+    if (!QFileInfo::exists(path)) {
+      return path;
+    }
+  }
+}
@@ -0,0 +1,214 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QFile>
+#include <QString>
+#include <QStringList>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+class BulkShaper;
+class EventQueueTimer;
+class IEventQueue;
+
+namespace deskflow {
+class IStream;
+}
+
+//! Sends and receives files over one connection
+/*!
+Files are offered with a \c kMsgDDragInfo message naming them, then each
+is sent with \c kMsgDFileTransfer messages:
+
+- the sender starts with its size and SHA-256 digest,
+- the receiver replies with how much of it is already in a partial file
+  kept under the digest, so an interrupted transfer continues where it
+  stopped, or refuses it,
+- the sender reads the rest a chunk at a time and sends it, then the end.
+
+A start the receiver can't read is refused with a zero digest.  If no
+reply comes the sender gives up on the file after a timeout.  Peers before
+protocol 1.9 ignore these messages, so the proxies only send files to 1.9
+and later.
+
+Chunks are sent a window at a time, the next window once the stream has
+written the last, so input queued meanwhile waits behind one window at
+most.  With a BulkShaper each chunk also waits until the shaper allows
+it.  The receiver checks the digest before the file gets its name.
+
+Files are only received when the core/fileTransferReceive setting is on,
+up to core/fileTransferMaxSize and the free space of the directory.
+
+Everything runs on the event queue thread.  Digests of whole files are
+worked out a step at a time between other events, so a large file does
+not hold up input.
+*/
+class FileTransfer
+{
+public:
+  //! Bytes of the current or last file in each direction
+  struct Progress
+  {
+    uint64_t sendTotal = 0;
+    uint64_t sent = 0;
+    uint64_t resumed = 0; //!< Bytes the receiver already had, over all files
+    uint64_t receiveTotal = 0;
+    uint64_t received = 0;
+    double receiveRate = 0.0; //!< Bytes per second of the last file received
+    uint64_t filesSent = 0;
+    uint64_t filesReceived = 0;
+    uint64_t filesFailed = 0;
+  };
+
+  inline static const uint32_t kChunkSize = 256 * 1024;
+  inline static const uint32_t kWindowSize = 4 * kChunkSize;
+
+  //! Bytes hashed before other events get a turn
+  inline static const uint32_t kHashStepSize = 16 * kChunkSize;
+
+  //! Seconds to wait for the reply to a start, the receiver may hash a partial file first
+  inline static const double kResumeTimeout = 60.0;
+
+  //! Receive files into \p directory, if the settings allow it
+  FileTransfer(IEventQueue *events, deskflow::IStream *stream, const QString &directory);
+  FileTransfer(FileTransfer const &) = delete;
+  FileTransfer(FileTransfer &&) = delete;
+  ~FileTransfer();
+
+  FileTransfer &operator=(FileTransfer const &) = delete;
+  FileTransfer &operator=(FileTransfer &&) = delete;
+
+  //! @name manipulators
+  //@{
+
+  //! Send \p paths to the other side, after any files still being sent
+  bool sendFiles(const QStringList &paths);
+
+  //! Pace the chunks sent with \p shaper, or not at all if it is null
+  void setShaper(BulkShaper *shaper)
+  {
+    m_shaper = shaper;
+  }
+
+  //! Accept files of up to \p maxSize bytes, 0 refuses every file
+  void setReceiveLimit(uint64_t maxSize)
+  {
+    m_receiveLimit = maxSize;
+  }
+
+  //! Give up on a file if the receiver doesn't reply to its start in \p seconds
+  void setResumeTimeout(double seconds)
+  {
+    m_resumeTimeout = seconds;
+  }
+
+  //! Read a \c kMsgDDragInfo message, after its code
+  bool readDragInfo();
+
+  //! Read a \c kMsgDFileTransfer message, after its code
+  bool readFileTransfer();
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Where received files are put
+  const QString &directory() const
+  {
+    return m_directory;
+  }
+
+  //! Path of the last file received, empty if it failed
+  const QString &lastReceived() const
+  {
+    return m_lastReceived;
+  }
+
+  //! Get the transfer progress, only valid on the event queue thread
+  static Progress getProgress()
+  {
+    return s_progress;
+  }
+
+  //! Where the partial file of the content with \p digest is kept
+  static QString partPath(const QString &directory, const QByteArray &digest);
+
+  //@}
+
+private:
+  // hashing, a step of each direction per event
+  void postHashStep();
+  void hashStep();
+
+  // sending
+  void startNextFile();
+  void hashSendStep();
+  void resume(const std::string &data);
+  void sendChunks();
+  bool readChunk(uint64_t offset, uint32_t size);
+  void dropSentFile();
+  void closeSentFile();
+  void startShapingTimer(double wait);
+  void stopShapingTimer();
+  void startResumeTimer();
+  void stopResumeTimer();
+  void writeMessage(uint8_t mark, const void *data, uint32_t size);
+
+  // receiving
+  void startFile(const std::string &data);
+  void hashReceiveStep();
+  void sendResume(uint64_t offset);
+  void appendFile(const std::string &data);
+  void endFile();
+  void refuseFile(const char *reason);
+  void failFile(const char *reason);
+  QString uniquePath(const QString &name) const;
+
+private:
+  IEventQueue *m_events;
+  deskflow::IStream *m_stream;
+  QString m_directory;
+  bool m_hashStepPosted = false;
+
+  // the file being sent, the offset is how far it was hashed until the start is sent
+  QStringList m_sendQueue;
+  std::unique_ptr<QFile> m_sendFile;
+  QByteArray m_chunk;
+  uint64_t m_sendSize = 0;
+  uint64_t m_sendOffset = 0;
+  uint64_t m_windowEnd = 0;
+  QCryptographicHash m_sendHash{QCryptographicHash::Sha256};
+  QByteArray m_sendDigest;
+  bool m_sendHashing = false;
+  bool m_awaitingResume = false;
+  double m_resumeTimeout = kResumeTimeout;
+  EventQueueTimer *m_resumeTimer = nullptr;
+  bool m_awaitingFlush = false;
+  BulkShaper *m_shaper = nullptr;
+  EventQueueTimer *m_shapingTimer = nullptr;
+
+  // the file being received, a partial file is hashed up to m_received before it's resumed
+  uint64_t m_receiveLimit = 0;
+  QStringList m_receiveNames;
+  QString m_receiveName;
+  QFile m_receiveFile;
+  QCryptographicHash m_receiveHash{QCryptographicHash::Sha256};
+  QByteArray m_receiveDigest;
+  uint64_t m_receiveSize = 0;
+  uint64_t m_received = 0;
+  uint64_t m_receiveHashed = 0;
+  bool m_receiveHashing = false;
+  int64_t m_receiveStarted = 0;
+  QString m_lastReceived;
+
+  static Progress s_progress;
+};
@@ -22,6 +22,14 @@ PacketStreamFilter::PacketStreamFilter(IEventQueue *events, deskflow::IStream *s
   // do nothing
 }
 
+PacketStreamFilter::Counters PacketStreamFilter::getCounters() const
+{
+  return {
+      m_packetsIn.load(std::memory_order_relaxed), m_packetsOut.load(std::memory_order_relaxed),
+      m_bytesIn.load(std::memory_order_relaxed), m_bytesOut.load(std::memory_order_relaxed)
+  };
+}
+
 void PacketStreamFilter::close()
 {
   std::scoped_lock lock{m_mutex};
@@ -78,6 +86,9 @@ void PacketStreamFilter::write(const void *buffer, uint32_t count)
 
   // write the payload
   getStream()->write(buffer, count);
+
+  m_packetsOut.fetch_add(1, std::memory_order_relaxed);
+  m_bytesOut.fetch_add(sizeof(length) + count, std::memory_order_relaxed);
 }
 
 void PacketStreamFilter::shutdownInput()
@@ -119,6 +130,8 @@ bool PacketStreamFilter::readPacketSize()
       m_events->addEvent(Event(EventTypes::StreamInputFormatError, getEventTarget()));
       return false;
     }
+    m_packetsIn.fetch_add(1, std::memory_order_relaxed);
+    m_bytesIn.fetch_add(sizeof(buffer) + m_size, std::memory_order_relaxed);
   }
   return true;
 }
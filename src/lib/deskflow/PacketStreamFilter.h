@@ -10,6 +10,7 @@
 #include "io/StreamBuffer.h"
 #include "io/StreamFilter.h"
 
+#include <atomic>
 #include <mutex>
 
 class IEventQueue;
@@ -21,9 +22,21 @@ Filters a stream to read and write packets.
 class PacketStreamFilter : public StreamFilter
 {
 public:
+  //! Packets and bytes, including the size prefix, seen in each direction
+  struct Counters
+  {
+    uint64_t packetsIn = 0;
+    uint64_t packetsOut = 0;
+    uint64_t bytesIn = 0;
+    uint64_t bytesOut = 0;
+  };
+
   PacketStreamFilter(IEventQueue *events, deskflow::IStream *stream, bool adoptStream = true);
   ~PacketStreamFilter() override = default;
 
+  //! Get the traffic counters, safe to call from any thread
+  Counters getCounters() const;
+
   // IStream overrides
   void close() override;
   uint32_t read(void *buffer, uint32_t n) override;
@@ -47,4 +60,8 @@ private:
   StreamBuffer m_buffer;
   bool m_inputShutdown = false;
   IEventQueue *m_events = nullptr;
+  std::atomic<uint64_t> m_packetsIn = 0;
+  std::atomic<uint64_t> m_packetsOut = 0;
+  std::atomic<uint64_t> m_bytesIn = 0;
+  std::atomic<uint64_t> m_bytesOut = 0;
 };
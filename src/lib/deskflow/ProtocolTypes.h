@@ -45,7 +45,7 @@ static const int16_t kProtocolMajorVersion = 1;
  * @note When incrementing the minor version, the Deskflow application version should also increment
  * @since Protocol version 1.0
  */
-static const int16_t kProtocolMinorVersion = 8;
+static const int16_t kProtocolMinorVersion = 9;
 
 /**
  * @brief Default TCP port for Deskflow connections
@@ -157,9 +157,10 @@ static constexpr uint32_t PROTOCOL_MAX_STRING_LENGTH = 1024 * 1024;
  */
 struct ChunkType
 {
-  inline static const auto DataStart = 1; ///< Start of transfer (contains file size)
-  inline static const auto DataChunk = 2; ///< Data chunk (contains file content)
-  inline static const auto DataEnd = 3;   ///< End of transfer (transfer complete)
+  inline static const auto DataStart = 1;  ///< Start of transfer (contains file size)
+  inline static const auto DataChunk = 2;  ///< Data chunk (contains file content)
+  inline static const auto DataEnd = 3;    ///< End of transfer (transfer complete)
+  inline static const auto DataResume = 4; ///< Reply to a file's start (contains the offset to continue from)
 };
 
 /**
@@ -310,6 +311,27 @@ extern const char *const kMsgHelloBack;
  */
 extern const char *const kMsgHelloBackArgs;
 
+/**
+ * @brief Format string for the hello response opening a bulk data connection
+ *
+ * **Format**: `"%2i%2i%s%s"`
+ * **Parameters**:
+ * - `$1`: Client major version number (2 bytes)
+ * - `$2`: Client minor version number (2 bytes)
+ * - `$3`: Client name (string)
+ * - `$4`: Token from the kMsgDBulkChannel message (string)
+ *
+ * Sent instead of kMsgHelloBackArgs on a second connection, after the
+ * protocol name, by a client whose main connection was offered one with
+ * kMsgDBulkChannel.  The server takes the connection as that client's
+ * bulk data connection if the token matches and, with TLS, the client
+ * presented the same certificate on both connections.
+ *
+ * @see kMsgDBulkChannel
+ * @since Protocol version 1.9
+ */
+extern const char *const kMsgHelloBackBulkArgs;
+
 /** @} */ // end of protocol_handshake group
 
 /**
@@ -1020,16 +1042,18 @@ extern const char *const kMsgDSetOptions;
  * - `$2`: Data (string) - Content depends on mark
  *
  * **Transfer Marks**:
- * - `1` (kDataStart): Data contains file size (8 bytes)
+ * - `1` (kDataStart): Data contains file size (8 bytes, NBO) then its SHA-256 digest (32 bytes)
  * - `2` (kDataChunk): Data contains file content chunk
- * - `3` (kDataEnd): Transfer complete (data may be empty)
+ * - `3` (kDataEnd): Transfer complete (data is empty)
+ * - `4` (kDataResume): Receiver to sender, data contains the digest (32 bytes) then
+ *   the offset to continue from (8 bytes, NBO), or all ones if the file is refused
  *
  * **Example Transfer Sequence**:
  *
- * Send 4096 bytes
+ * Send 4096 bytes, of which the receiver already has 1024
  * ```
- * "DFTR\x01\x00\x00\x00\x00\x00\x00\x10\x00"
- * "DFTR\x02[1024 bytes of file data]"
+ * "DFTR\x01\x00\x00\x00\x00\x00\x00\x10\x00[32 byte digest]"
+ *                           "DFTR\x04[32 byte digest]\x00\x00\x00\x00\x00\x00\x04\x00"
  * "DFTR\x02[1024 bytes of file data]"
  * "DFTR\x02[1024 bytes of file data]"
  * "DFTR\x02[1024 bytes of file data]"
@@ -1037,14 +1061,25 @@ extern const char *const kMsgDSetOptions;
  * ```
  *
  * **Protocol Flow**:
- * 1. Sender initiates with kDataStart containing total file size
- * 2. Sender sends multiple kDataChunk messages with file content
- * 3. Sender concludes with kDataEnd to signal completion
- * 4. Receiver can abort by closing connection
+ * 1. Sender initiates with kDataStart containing total file size and digest
+ * 2. Receiver replies with kDataResume, the offset is the size of a partial
+ *    file with the same digest left by an interrupted transfer, or 0; a
+ *    receiver that doesn't take files, or not one this large, or lacks the
+ *    space for it, refuses it and the sender moves on to the next file; a
+ *    start that can't be read is refused with an all zero digest, and a
+ *    sender with no reply in time gives up on the file
+ * 3. Sender sends kDataChunk messages with the file content from that offset,
+ *    a window at a time so other messages are not held up
+ * 4. Sender concludes with kDataEnd, the receiver checks size and digest
+ *    before keeping the file; a sender whose file shrank while it was read
+ *    ends early, so the receiver drops it
+ * 5. Receiver can abort by closing connection, the partial file is kept
+ *
+ * Before 1.9 the message was defined but not handled, so files are only
+ * sent to peers on 1.9 or later.
  *
  * @see kMsgDDragInfo, EDataTransfer
  * @since Protocol version 1.5
- * @deprecated File drag and drop is no longer implemented.
  */
 extern const char *const kMsgDFileTransfer;
 
@@ -1056,26 +1091,25 @@ extern const char *const kMsgDFileTransfer;
  * **Format**: `"DDRG%2i%s"`
  * **Parameters**:
  * - `$1`: Number of files (2 bytes)
- * - `$2`: File paths (string) - Null-separated file paths
+ * - `$2`: File names (string) - Null-separated file names
  *
  * **Example**:
  *
  * Dragging 2 files
- * ``` * "DDRG\x00\x02/path/to/file1.txt\x00/path/to/file2.txt\x00"
+ * ```
+ * "DDRG\x00\x02file1.txt\x00file2.txt\x00"
  * ```
  *
- * Sent when a drag-and-drop operation begins. Contains the list
- * of files being dragged. The actual file transfer follows using
- * kMsgDFileTransfer messages.
+ * Sent before files are transferred. Contains the names of the files,
+ * in the order their kMsgDFileTransfer transfers follow.
  *
- * **File Path Format**:
- * - Paths are null-terminated strings
- * - Multiple paths are concatenated with null separators
- * - Paths should use forward slashes for compatibility
+ * **File Name Format**:
+ * - Names are null-terminated strings
+ * - Multiple names are concatenated with null separators
+ * - Any directory part is ignored by the receiver
  *
  * @see kMsgDFileTransfer
  * @since Protocol version 1.5
- * @deprecated File drag and drop is no longer implemented.
  */
 extern const char *const kMsgDDragInfo;
 
@@ -1146,6 +1180,32 @@ extern const char *const kMsgDSecureInputNotification;
  */
 extern const char *const kMsgDLanguageSynchronisation;
 
+/**
+ * @brief Offer a bulk data connection
+ *
+ * **Message Code**: `"DBLK"`
+ * **Direction**: Primary → Secondary
+ * **Format**: `"DBLK%s"`
+ * **Parameters**:
+ * - `$1`: Token (string) - Random, names this client's connection
+ *
+ * Sent once after the first kMsgDSetOptions.  The client opens a second
+ * connection to the server, with the same security, and answers the
+ * server's kMsgHello on it with kMsgHelloBackBulkArgs and the token.
+ *
+ * Once accepted, the connection carries only kMsgDClipboard,
+ * kMsgDFileTransfer and kMsgDDragInfo in both directions, so a large
+ * clipboard or file never sits in the main connection's send buffer ahead
+ * of input.  Clipboards up to 64 KiB stay on the main connection, so they
+ * arrive before the input sent after them, and every chunk of a clipboard
+ * goes on the connection its start went on.  If it closes, both sides go
+ * back to the main connection and drop the clipboards part sent on it.
+ *
+ * @see kMsgHelloBackBulkArgs
+ * @since Protocol version 1.9
+ */
+extern const char *const kMsgDBulkChannel;
+
 /** @} */ // end of protocol_system group
 
 /** @} */ // end of protocol_data group
@@ -115,6 +115,7 @@ void ProtocolUtil::vwritef(deskflow::IStream *stream, const char *fmt, uint32_t
 
   // fill buffer
   std::vector<uint8_t> Buffer;
+  Buffer.reserve(size);
   writef(Buffer, fmt, args);
 
   try {
@@ -348,7 +349,7 @@ void ProtocolUtil::writef(std::vector<uint8_t> &buffer, const char *fmt, va_list
         const uint32_t len = va_arg(args, uint32_t);
         const uint8_t *src = va_arg(args, uint8_t *);
         writeInt(len, sizeof(len), buffer);
-        std::copy(src, src + len, std::back_inserter(buffer));
+        buffer.insert(buffer.end(), src, src + len);
         break;
       }
 
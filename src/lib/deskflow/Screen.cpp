@@ -8,6 +8,7 @@
 #include "deskflow/Screen.h"
 #include "base/IEventQueue.h"
 #include "base/Log.h"
+#include "base/Trace.h"
 #include "deskflow/IPlatformScreen.h"
 
 namespace deskflow {
@@ -186,45 +187,61 @@ void Screen::keyDown(KeyID id, KeyModifierMask mask, KeyButton button, const std
       return;
     }
   }
+  TRACE(TracePoint::FakeInput, this, static_cast<int64_t>(TraceInput::KeyDown), id);
+  const TraceScope scope(TraceSpan::Inject, this, static_cast<int64_t>(TraceInput::KeyDown));
   m_screen->fakeKeyDown(id, mask, button, lang);
 }
 
 void Screen::keyRepeat(KeyID id, KeyModifierMask mask, int32_t count, KeyButton button, const std::string &lang)
 {
   assert(!m_isPrimary);
+  TRACE(TracePoint::FakeInput, this, static_cast<int64_t>(TraceInput::KeyRepeat), id);
+  const TraceScope scope(TraceSpan::Inject, this, static_cast<int64_t>(TraceInput::KeyRepeat));
   m_screen->fakeKeyRepeat(id, mask, count, button, lang);
 }
 
 void Screen::keyUp(KeyID, KeyModifierMask, KeyButton button)
 {
+  TRACE(TracePoint::FakeInput, this, static_cast<int64_t>(TraceInput::KeyUp), button);
+  const TraceScope scope(TraceSpan::Inject, this, static_cast<int64_t>(TraceInput::KeyUp));
   m_screen->fakeKeyUp(button);
 }
 
 void Screen::mouseDown(ButtonID button)
 {
+  TRACE(TracePoint::FakeInput, this, static_cast<int64_t>(TraceInput::MouseDown), button);
+  const TraceScope scope(TraceSpan::Inject, this, static_cast<int64_t>(TraceInput::MouseDown));
   m_screen->fakeMouseButton(button, true);
 }
 
 void Screen::mouseUp(ButtonID button)
 {
+  TRACE(TracePoint::FakeInput, this, static_cast<int64_t>(TraceInput::MouseUp), button);
+  const TraceScope scope(TraceSpan::Inject, this, static_cast<int64_t>(TraceInput::MouseUp));
   m_screen->fakeMouseButton(button, false);
 }
 
 void Screen::mouseMove(int32_t x, int32_t y)
 {
   assert(!m_isPrimary);
+  TRACE(TracePoint::FakeInput, this, static_cast<int64_t>(TraceInput::MouseMove), Trace::packPair(x, y));
+  const TraceScope scope(TraceSpan::Inject, this, static_cast<int64_t>(TraceInput::MouseMove));
   m_screen->fakeMouseMove(x, y);
 }
 
 void Screen::mouseRelativeMove(int32_t dx, int32_t dy) const
 {
   assert(!m_isPrimary);
+  TRACE(TracePoint::FakeInput, this, static_cast<int64_t>(TraceInput::MouseRelativeMove), Trace::packPair(dx, dy));
+  const TraceScope scope(TraceSpan::Inject, this, static_cast<int64_t>(TraceInput::MouseRelativeMove));
   m_screen->fakeMouseRelativeMove(dx, dy);
 }
 
 void Screen::mouseWheel(int32_t xDelta, int32_t yDelta) const
 {
   assert(!m_isPrimary);
+  TRACE(TracePoint::FakeInput, this, static_cast<int64_t>(TraceInput::MouseWheel), Trace::packPair(xDelta, yDelta));
+  const TraceScope scope(TraceSpan::Inject, this, static_cast<int64_t>(TraceInput::MouseWheel));
   m_screen->fakeMouseWheel(xDelta, yDelta);
 }
 
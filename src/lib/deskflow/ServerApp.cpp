@@ -9,15 +9,20 @@
 #include "deskflow/ServerApp.h"
 
 #include "arch/Arch.h"
+#include "base/CoreStatus.h"
 #include "base/IEventQueue.h"
 #include "base/Log.h"
+#include "base/StartupProfiler.h"
 #include "common/ExitCodes.h"
 #include "common/PlatformInfo.h"
 #include "common/Settings.h"
 #include "deskflow/App.h"
+#include "deskflow/BulkShaper.h"
 #include "deskflow/ProtocolTypes.h"
 #include "deskflow/Screen.h"
 #include "deskflow/ScreenException.h"
+#include "deskflow/StatsServer.h"
+#include "deskflow/StatusChannel.h"
 #include "net/SocketException.h"
 #include "net/SocketMultiplexer.h"
 #include "net/TCPSocketFactory.h"
@@ -29,6 +34,8 @@
 
 // must be before screen header includes
 #include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonObject>
 
 #if WINAPI_MSWINDOWS
 #include "platform/MSWindowsScreen.h"
@@ -95,6 +102,9 @@ QString ServerApp::currentConfig() const
 void ServerApp::reloadConfig()
 {
   LOG_DEBUG("reload configuration");
+  // pick up settings edited while running, e.g. a new certificate path
+  Settings::reload();
+  applyBulkRateLimits();
   if (loadConfig(currentConfig())) {
     if (m_server != nullptr) {
       m_server->setConfig(*m_config);
@@ -103,6 +113,16 @@ void ServerApp::reloadConfig()
   }
 }
 
+void ServerApp::applyBulkRateLimits()
+{
+  // limits are in KiB/s, 0 for none
+  const auto settings = Settings::snapshot();
+  BulkShaper::setGlobalRate(settings->bulkGlobalRateLimit * 1024);
+  if (m_server != nullptr) {
+    m_server->setBulkRate(settings->bulkRateLimit * 1024);
+  }
+}
+
 void ServerApp::loadConfig()
 {
   const auto path = currentConfig();
@@ -315,7 +335,9 @@ bool ServerApp::initServer()
   try {
     std::string name = m_config->getCanonicalName(m_name);
     serverScreen = openServerScreen();
+    StartupProfiler::mark("screen");
     primaryClient = openPrimaryClient(name, serverScreen);
+    StartupProfiler::mark("primary client");
     m_serverScreen = serverScreen;
     m_primaryClient = primaryClient;
     m_serverState = Initialized;
@@ -378,11 +400,16 @@ bool ServerApp::startServer()
   ClientListener *listener = nullptr;
   try {
     listener = openClientListener(m_config->getDeskflowAddress());
+    StartupProfiler::mark("listen");
+    // enables the primary screen, which builds the keymap
     m_server = openServer(*m_config, m_primaryClient);
+    StartupProfiler::mark("server");
     listener->setServer(m_server);
     m_server->setListener(listener);
     m_listener = listener;
     LOG_IPC("started server, waiting for clients");
+    CoreStatus::setConnectionState(CoreConnectionState::Listening);
+    StartupProfiler::finish("listening");
     m_serverState = Started;
     return true;
   } catch (SocketAddressInUseException &e) {
@@ -455,8 +482,9 @@ ClientListener *ServerApp::openClientListener(const NetworkAddress &address)
 {
   using enum SecurityLevel;
   auto securityLevel = PlainText;
-  if (Settings::value(Settings::Security::TlsEnabled).toBool()) {
-    if (Settings::value(Settings::Security::CheckPeers).toBool()) {
+  const auto settings = Settings::snapshot();
+  if (settings->tlsEnabled) {
+    if (settings->checkPeers) {
       securityLevel = PeerAuth;
     } else {
       securityLevel = Encrypted;
@@ -506,6 +534,54 @@ int ServerApp::mainLoop()
   // create socket multiplexer.  this must happen after daemonization
   // on unix because threads evaporate across a fork().
   setSocketMultiplexer(std::make_unique<SocketMultiplexer>());
+  setupThreadScheduling();
+  setupStatusChannel();
+  setupStatsServer();
+  StartupProfiler::mark("services");
+  if (auto *channel = getStatusChannel(); channel != nullptr) {
+    // only the gui that started this core can ask it to send files
+    channel->addCommand(QStringLiteral("sendFiles"), [this](const QJsonObject &message) {
+      const auto screen = message.value("screen").toString().toStdString();
+      std::vector<std::string> paths;
+      for (const auto &path : message.value("paths").toArray()) {
+        paths.push_back(path.toString().toStdString());
+      }
+      if (m_server == nullptr || !m_server->sendFiles(screen, paths)) {
+        LOG_WARN("can't send files to \"%s\"", screen.c_str());
+      }
+    });
+  }
+
+  applyBulkRateLimits();
+
+  if (auto *stats = getStatsServer(); stats != nullptr) {
+    stats->addSource(QStringLiteral("shaping"), [] {
+      const auto shaping = BulkShaper::getStats();
+      return QJsonObject{
+          {"delays", static_cast<qint64>(shaping.delays)},
+          {"delayedMs", shaping.delayed * 1000.0},
+          {"bytes", static_cast<qint64>(shaping.bytes)},
+      };
+    });
+    stats->addSource(QStringLiteral("clients"), [this] {
+      QJsonArray clients;
+      std::vector<Server::ClientStats> list;
+      if (m_server != nullptr) {
+        m_server->getClientStats(list);
+      }
+      for (const auto &client : list) {
+        clients.append(QJsonObject{
+            {"name", QString::fromStdString(client.name)},
+            {"messagesIn", static_cast<qint64>(client.messagesIn)},
+            {"messagesOut", static_cast<qint64>(client.messagesOut)},
+            {"bytesIn", static_cast<qint64>(client.bytesIn)},
+            {"bytesOut", static_cast<qint64>(client.bytesOut)},
+            {"rttMs", client.roundTripTime < 0 ? QJsonValue() : QJsonValue(double(client.roundTripTime) / 1e6)},
+        });
+      }
+      return clients;
+    });
+  }
 
   // if configuration has no screens then add this system
   // as the default
@@ -67,6 +67,7 @@ public:
   //
 
   void reloadConfig();
+  void applyBulkRateLimits();
   void forceReconnect();
   void resetServer();
   void handleClientConnected(const Event &e, ClientListener *listener);
@@ -0,0 +1,369 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "deskflow/StatsServer.h"
+
+#include "arch/Arch.h"
+#include "base/IEventQueue.h"
+#include "base/Log.h"
+#include "base/StartupProfiler.h"
+#include "deskflow/BulkChannel.h"
+#include "deskflow/ClipboardChunk.h"
+#include "deskflow/FileTransfer.h"
+#include "net/IDataSocket.h"
+#include "net/NetworkAddress.h"
+#include "net/SocketException.h"
+#include "net/TCPListenSocket.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+#include <algorithm>
+
+#if defined(__linux__)
+#include <QDir>
+#include <unistd.h>
+#elif SYSAPI_UNIX
+#include <sys/resource.h>
+#elif SYSAPI_WIN32
+#include <Windows.h>
+#endif
+
+namespace {
+
+const auto kAckMessage = QByteArrayLiteral("ok");
+const auto kErrorMessage = QByteArrayLiteral("error");
+
+// a client that sends this much without a newline is not speaking our protocol
+const qsizetype kMaxRequestSize = 4096;
+
+const auto kAuthRequest = QByteArrayLiteral("auth=");
+
+} // namespace
+
+//
+// StatsServer
+//
+
+StatsServer::StatsServer(IEventQueue *events, SocketMultiplexer *socketMultiplexer, int port, const QString &tokenFile)
+    : m_events(events),
+      m_started(Arch::nanoTime()),
+      m_tokenFile(tokenFile),
+      m_lastTime(m_started),
+      m_lastWakeupTime(m_started)
+{
+  addSource(QStringLiteral("eventQueue"), [this] { return eventQueueStats(); });
+  addSource(QStringLiteral("wakeups"), [this] { return wakeupStats(); });
+  addSource(QStringLiteral("threads"), &StatsServer::threadStats);
+  addSource(QStringLiteral("log"), [] {
+    return QJsonObject{
+        {"level", CLOG->getFilterName()},
+        {"dropped", static_cast<qint64>(CLOG->getDroppedCount())},
+    };
+  });
+  addSource(QStringLiteral("startup"), [] {
+    QJsonObject phases;
+    for (const auto &phase : StartupProfiler::phases()) {
+      phases.insert(QString::fromStdString(phase.name), static_cast<double>(phase.nanos) / 1e6);
+    }
+    return QJsonObject{{"totalMs", StartupProfiler::totalMs()}, {"phasesMs", phases}};
+  });
+  addSource(QStringLiteral("clipboard"), [] {
+    const auto progress = ClipboardChunk::getProgress();
+    return QJsonObject{
+        {"sendTotal", static_cast<qint64>(progress.sendTotal)},
+        {"sent", static_cast<qint64>(progress.sent)},
+        {"receiveTotal", static_cast<qint64>(progress.receiveTotal)},
+        {"received", static_cast<qint64>(progress.received)},
+    };
+  });
+  addSource(QStringLiteral("files"), [] {
+    const auto progress = FileTransfer::getProgress();
+    return QJsonObject{
+        {"sendTotal", static_cast<qint64>(progress.sendTotal)},
+        {"sent", static_cast<qint64>(progress.sent)},
+        {"resumed", static_cast<qint64>(progress.resumed)},
+        {"receiveTotal", static_cast<qint64>(progress.receiveTotal)},
+        {"received", static_cast<qint64>(progress.received)},
+        {"receiveRate", progress.receiveRate},
+        {"filesSent", static_cast<qint64>(progress.filesSent)},
+        {"filesReceived", static_cast<qint64>(progress.filesReceived)},
+        {"filesFailed", static_cast<qint64>(progress.filesFailed)},
+    };
+  });
+
+  if (port <= 0 || !writeTokenFile()) {
+    return;
+  }
+
+  // only ever reachable from this machine, but by any user on it
+  NetworkAddress address("127.0.0.1", port);
+  try {
+    address.resolve();
+    m_listen = std::make_unique<TCPListenSocket>(m_events, socketMultiplexer, IArchNetwork::AddressFamily::INet);
+    m_events->addHandler(EventTypes::ListenSocketConnecting, m_listen.get(), [this](const auto &) {
+      handleConnecting();
+    });
+    m_listen->bind(address);
+    LOG_NOTE("serving stats on 127.0.0.1:%d", port);
+  } catch (const SocketException &e) {
+    LOG_ERR("failed to serve stats on port %d: %s", port, e.what());
+    if (m_listen != nullptr) {
+      m_events->removeHandler(EventTypes::ListenSocketConnecting, m_listen.get());
+      m_listen.reset();
+    }
+  }
+}
+
+StatsServer::~StatsServer()
+{
+  while (!m_clients.empty()) {
+    removeClient(m_clients.begin()->first);
+  }
+  if (m_listen != nullptr) {
+    m_events->removeHandler(EventTypes::ListenSocketConnecting, m_listen.get());
+  }
+  if (!m_token.empty()) {
+    QFile::remove(m_tokenFile);
+  }
+}
+
+void StatsServer::addSource(const QString &name, const Source &source)
+{
+  const auto it = std::ranges::find(m_sources, name, &std::pair<QString, Source>::first);
+  if (it != m_sources.end()) {
+    it->second = source;
+  } else {
+    m_sources.emplace_back(name, source);
+  }
+}
+
+QByteArray StatsServer::handleRequest(const QByteArray &request)
+{
+  const auto line = request.trimmed();
+  if (line == "stats") {
+    return QJsonDocument(collect()).toJson(QJsonDocument::Compact);
+  }
+
+  if (line == "logLevel") {
+    return CLOG->getFilterName();
+  }
+
+  if (line.startsWith("logLevel=")) {
+    const auto level = QString::fromUtf8(line.mid(line.indexOf('=') + 1));
+    if (level.isEmpty() || !CLOG->setFilter(level)) {
+      LOG_WARN("stats client sent an invalid log level: %s", qPrintable(level));
+      return kErrorMessage;
+    }
+    LOG_NOTE("log level changed to %s by stats client", CLOG->getFilterName());
+    return kAckMessage;
+  }
+
+  LOG_DEBUG("stats client sent an unknown request: %s", line.constData());
+  return kErrorMessage;
+}
+
+QJsonObject StatsServer::collect() const
+{
+  QJsonObject stats;
+  stats.insert("uptimeMs", static_cast<qint64>((Arch::nanoTime() - m_started) / 1'000'000));
+  for (const auto &[name, source] : m_sources) {
+    stats.insert(name, source());
+  }
+  return stats;
+}
+
+void StatsServer::handleConnecting()
+{
+  auto socket = m_listen->accept();
+  if (socket == nullptr) {
+    return;
+  }
+
+  auto *raw = socket.get();
+  LOG_DEBUG1("stats client connected");
+  m_clients.emplace(raw, Client{std::move(socket), {}});
+
+  m_events->addHandler(EventTypes::StreamInputReady, raw->getEventTarget(), [this, raw](const auto &) {
+    handleData(raw);
+  });
+  m_events->addHandler(EventTypes::StreamInputShutdown, raw->getEventTarget(), [this, raw](const auto &) {
+    removeClient(raw);
+  });
+  m_events->addHandler(EventTypes::SocketDisconnected, raw->getEventTarget(), [this, raw](const auto &) {
+    removeClient(raw);
+  });
+}
+
+void StatsServer::handleData(IDataSocket *socket)
+{
+  const auto it = m_clients.find(socket);
+  if (it == m_clients.end()) {
+    return;
+  }
+
+  auto &buffer = it->second.m_buffer;
+  char data[1024];
+  for (uint32_t n = socket->read(data, sizeof(data)); n > 0; n = socket->read(data, sizeof(data))) {
+    buffer.append(data, n);
+  }
+
+  for (auto end = buffer.indexOf('\n'); end >= 0; end = buffer.indexOf('\n')) {
+    const auto line = buffer.left(end).trimmed();
+    buffer.remove(0, end + 1);
+
+    if (!it->second.m_authenticated) {
+      const auto offered = line.startsWith(kAuthRequest) ? line.mid(kAuthRequest.size()).toStdString() : std::string();
+      if (!BulkChannel::isToken(m_token, offered)) {
+        LOG_WARN("stats client did not authenticate, disconnecting");
+        removeClient(socket);
+        return;
+      }
+      it->second.m_authenticated = true;
+      socket->write(kAckMessage.constData(), static_cast<uint32_t>(kAckMessage.size()));
+      socket->write("\n", 1);
+      continue;
+    }
+
+    const auto reply = handleRequest(line) + '\n';
+    socket->write(reply.constData(), static_cast<uint32_t>(reply.size()));
+  }
+
+  if (buffer.size() > kMaxRequestSize) {
+    LOG_WARN("stats client sent an oversized request, disconnecting");
+    removeClient(socket);
+  }
+}
+
+void StatsServer::removeClient(IDataSocket *socket)
+{
+  const auto it = m_clients.find(socket);
+  if (it == m_clients.end()) {
+    return;
+  }
+
+  LOG_DEBUG1("stats client disconnected");
+  m_events->removeHandlers(socket->getEventTarget());
+  m_clients.erase(it);
+}
+
+bool StatsServer::writeTokenFile()
+{
+  // owner only from the start, the token is all that keeps other users out
+  QFile file(m_tokenFile);
+  if (m_tokenFile.isEmpty() || !file.open(QFile::WriteOnly | QFile::Truncate) ||
+      !file.setPermissions(QFile::ReadOwner | QFile::WriteOwner)) {
+    LOG_ERR("not serving stats, failed to write the token file %s", qPrintable(m_tokenFile));
+    return false;
+  }
+
+  m_token = BulkChannel::newToken();
+  file.write(m_token.c_str(), static_cast<qint64>(m_token.size()));
+  return true;
+}
+
+QJsonValue StatsServer::eventQueueStats() const
+{
+  const auto stats = m_events->getStats();
+
+  // the rate covers the time since the previous request
+  const auto now = Arch::nanoTime();
+  const auto elapsed = static_cast<double>(now - m_lastTime) / 1e9;
+  const auto rate = elapsed > 0 ? static_cast<double>(stats.dispatched - m_lastDispatched) / elapsed : 0.0;
+  m_lastTime = now;
+  m_lastDispatched = stats.dispatched;
+
+  return QJsonObject{
+      {"added", static_cast<qint64>(stats.added)},
+      {"dispatched", static_cast<qint64>(stats.dispatched)},
+      {"depth", static_cast<qint64>(stats.pending)},
+      {"timers", static_cast<qint64>(stats.timers)},
+      {"dispatchRate", rate},
+  };
+}
+
+QJsonValue StatsServer::wakeupStats() const
+{
+  // like the dispatch rate, per second covers the time since the previous request
+  const auto now = Arch::nanoTime();
+  const auto elapsed = static_cast<double>(now - m_lastWakeupTime) / 1e9;
+  m_lastWakeupTime = now;
+
+  QJsonObject wakeups;
+  double total = 0.0;
+  for (std::size_t i = 0; i < WakeupStats::kSourceCount; ++i) {
+    const auto source = static_cast<WakeupSource>(i);
+    const auto count = WakeupStats::count(source);
+    const auto rate = elapsed > 0 ? static_cast<double>(count - m_lastWakeups[i]) / elapsed : 0.0;
+    m_lastWakeups[i] = count;
+    total += rate;
+
+    wakeups.insert(
+        WakeupStats::name(source), QJsonObject{{"count", static_cast<qint64>(count)}, {"perSecond", rate}}
+    );
+  }
+  wakeups.insert("perSecond", total);
+  return wakeups;
+}
+
+QJsonValue StatsServer::threadStats()
+{
+  QJsonArray threads;
+
+#if defined(__linux__)
+  const auto ticks = static_cast<double>(sysconf(_SC_CLK_TCK));
+  const QDir tasks(QStringLiteral("/proc/self/task"));
+  for (const auto &tid : tasks.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+    QFile stat(tasks.filePath(tid + QStringLiteral("/stat")));
+    if (!stat.open(QFile::ReadOnly)) {
+      continue;
+    }
+
+    // the name is in parentheses and may contain spaces, the fields after
+    // it start with the state; utime and stime are the 12th and 13th
+    const auto line = stat.readAll();
+    const auto open = line.indexOf('(');
+    const auto close = line.lastIndexOf(')');
+    const auto fields = line.mid(close + 2).split(' ');
+    if (open < 0 || close < open || fields.size() < 13) {
+      continue;
+    }
+
+    threads.append(QJsonObject{
+        {"id", tid.toLongLong()},
+        {"name", QString::fromUtf8(line.mid(open + 1, close - open - 1))},
+        {"userMs", fields.at(11).toDouble() * 1000.0 / ticks},
+        {"systemMs", fields.at(12).toDouble() * 1000.0 / ticks},
+    });
+  }
+#elif SYSAPI_UNIX
+  // per thread times are not portable, report the whole process
+  rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+    const auto toMs = [](const timeval &time) {
+      return static_cast<double>(time.tv_sec) * 1e3 + static_cast<double>(time.tv_usec) / 1e3;
+    };
+    threads.append(
+        QJsonObject{{"name", "process"}, {"userMs", toMs(usage.ru_utime)}, {"systemMs", toMs(usage.ru_stime)}}
+    );
+  }
+#elif SYSAPI_WIN32
+  // per thread times are not portable, report the whole process
+  FILETIME creation;
+  FILETIME exit;
+  FILETIME kernel;
+  FILETIME user;
+  if (GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) {
+    const auto toMs = [](const FILETIME &time) {
+      return static_cast<double>((uint64_t{time.dwHighDateTime} << 32) | time.dwLowDateTime) / 1e4;
+    };
+    threads.append(QJsonObject{{"name", "process"}, {"userMs", toMs(user)}, {"systemMs", toMs(kernel)}});
+  }
+#endif
+
+  return threads;
+}
@@ -0,0 +1,113 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QString>
+
+#include "base/WakeupStats.h"
+
+#include <array>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+class IDataSocket;
+class IEventQueue;
+class IListenSocket;
+class SocketMultiplexer;
+
+//! Local endpoint serving live statistics
+/*!
+Listens on a port of the loopback interface and answers newline
+delimited requests, one reply line per request.  Any local user can
+connect, so a connection must first send \c auth=TOKEN with the token
+written to the token file, which only the user can read; anything else
+closes it.  Then:
+
+- \c stats replies with a JSON object holding every stats source.
+- \c logLevel replies with the current log level.
+- \c logLevel=NAME changes the log level and replies \c ok or \c error.
+
+The event queue, wakeup, log, start-up, clipboard, file transfer and thread
+CPU time sources are built in; the server and client apps add their
+connection stats with addSource().  Everything runs on the event queue thread.
+*/
+class StatsServer
+{
+public:
+  //! Produces one section of the stats
+  using Source = std::function<QJsonValue()>;
+
+  //! Serve on \p port, writing the token to \p tokenFile
+  /*!
+  Only answers handleRequest() if \p port is 0.  The token file is
+  removed again when the server is destroyed.
+  */
+  StatsServer(IEventQueue *events, SocketMultiplexer *socketMultiplexer, int port, const QString &tokenFile = {});
+  StatsServer(StatsServer const &) = delete;
+  StatsServer(StatsServer &&) = delete;
+  ~StatsServer();
+
+  StatsServer &operator=(StatsServer const &) = delete;
+  StatsServer &operator=(StatsServer &&) = delete;
+
+  //! @name manipulators
+  //@{
+
+  //! Add a section named \p name, replacing any with the same name
+  void addSource(const QString &name, const Source &source);
+
+  //! Answer one request line from an authenticated client, without the trailing newline
+  QByteArray handleRequest(const QByteArray &request);
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Gather every source into one object
+  QJsonObject collect() const;
+
+  //@}
+
+private:
+  struct Client
+  {
+    std::unique_ptr<IDataSocket> m_socket;
+    QByteArray m_buffer;
+    bool m_authenticated = false;
+  };
+
+  void handleConnecting();
+  void handleData(IDataSocket *socket);
+  void removeClient(IDataSocket *socket);
+  bool writeTokenFile();
+
+  QJsonValue eventQueueStats() const;
+  QJsonValue wakeupStats() const;
+
+  static QJsonValue threadStats();
+
+private:
+  IEventQueue *m_events;
+  std::unique_ptr<IListenSocket> m_listen;
+  std::map<IDataSocket *, Client> m_clients;
+  std::vector<std::pair<QString, Source>> m_sources;
+  int64_t m_started;
+  QString m_tokenFile;
+  std::string m_token;
+
+  // for dispatch rates between requests
+  mutable int64_t m_lastTime;
+  mutable uint64_t m_lastDispatched = 0;
+  mutable int64_t m_lastWakeupTime;
+  mutable std::array<uint64_t, WakeupStats::kSourceCount> m_lastWakeups{};
+};
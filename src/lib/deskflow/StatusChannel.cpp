@@ -0,0 +1,142 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "deskflow/StatusChannel.h"
+
+#include "base/CoreStatus.h"
+#include "base/IEventQueue.h"
+#include "base/Log.h"
+#include "net/NetworkAddress.h"
+#include "net/SocketException.h"
+#include "net/TCPSocket.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+
+//
+// StatusChannel
+//
+
+StatusChannel::StatusChannel(
+    IEventQueue *events, SocketMultiplexer *socketMultiplexer, int port, const std::string &token
+)
+    : m_events(events),
+      m_token(token)
+{
+  // the gui only listens on the loopback interface
+  NetworkAddress address("127.0.0.1", port);
+  try {
+    address.resolve();
+    m_socket = std::make_unique<TCPSocket>(m_events, socketMultiplexer, IArchNetwork::AddressFamily::INet);
+
+    auto *target = m_socket->getEventTarget();
+    m_events->addHandler(EventTypes::DataSocketConnected, target, [this](const auto &) { handleConnected(); });
+    m_events->addHandler(EventTypes::DataSocketConnectionFailed, target, [this](const auto &) {
+      LOG_WARN("gui status channel connection failed");
+      close();
+    });
+    m_events->addHandler(EventTypes::SocketDisconnected, target, [this](const auto &) {
+      LOG_DEBUG("gui status channel disconnected");
+      close();
+    });
+    m_events->addHandler(EventTypes::StreamInputReady, target, [this](const auto &) { handleData(); });
+    m_events->addHandler(EventTypes::StatusChannelPending, this, [this](const auto &) { handlePending(); });
+
+    m_socket->connect(address);
+  } catch (const SocketException &e) {
+    LOG_WARN("failed to connect gui status channel on port %d: %s", port, e.what());
+    close();
+  }
+}
+
+StatusChannel::~StatusChannel()
+{
+  close();
+}
+
+void StatusChannel::handleConnected()
+{
+  LOG_DEBUG("gui status channel connected");
+
+  // the gui ignores everything until it sees its token
+  QJsonObject hello;
+  hello["type"] = "hello";
+  hello["token"] = QString::fromStdString(m_token);
+  {
+    std::scoped_lock lock{m_mutex};
+    m_outbox.prepend(QJsonDocument(hello).toJson(QJsonDocument::Compact));
+    m_events->addEvent(Event(EventTypes::StatusChannelPending, this));
+  }
+
+  // called for the current state straight away, then on every change
+  CoreStatus::setSink([this](const QByteArray &message) {
+    std::scoped_lock lock{m_mutex};
+    m_outbox.append(message);
+    if (m_outbox.size() == 1) {
+      m_events->addEvent(Event(EventTypes::StatusChannelPending, this));
+    }
+  });
+}
+
+void StatusChannel::handlePending()
+{
+  QList<QByteArray> messages;
+  {
+    std::scoped_lock lock{m_mutex};
+    messages.swap(m_outbox);
+  }
+
+  if (m_socket == nullptr) {
+    return;
+  }
+
+  for (const auto &message : std::as_const(messages)) {
+    const auto frame = deskflow::ipc::encodeFrame(message);
+    m_socket->write(frame.constData(), static_cast<uint32_t>(frame.size()));
+  }
+}
+
+void StatusChannel::addCommand(const QString &type, const Command &command)
+{
+  m_commands[type] = command;
+}
+
+void StatusChannel::handleData()
+{
+  if (m_socket == nullptr) {
+    return;
+  }
+
+  char buffer[4096];
+  while (const auto size = m_socket->read(buffer, sizeof(buffer))) {
+    m_reader.append(QByteArray(buffer, static_cast<qsizetype>(size)));
+  }
+
+  while (const auto payload = m_reader.next()) {
+    const auto message = QJsonDocument::fromJson(*payload).object();
+    const auto type = message.value("type").toString();
+    if (const auto command = m_commands.find(type); command != m_commands.end()) {
+      command->second(message);
+    } else {
+      LOG_WARN("gui status channel sent an unknown command: %s", qPrintable(type));
+    }
+  }
+
+  if (m_reader.hasError()) {
+    LOG_WARN("gui status channel sent an oversized frame, closing");
+    close();
+  }
+}
+
+void StatusChannel::close()
+{
+  CoreStatus::setSink({});
+  m_events->removeHandler(EventTypes::StatusChannelPending, this);
+  if (m_socket != nullptr) {
+    m_events->removeHandlers(m_socket->getEventTarget());
+    m_socket.reset();
+  }
+}
@@ -0,0 +1,67 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "common/IpcFrame.h"
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QList>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+class IDataSocket;
+class IEventQueue;
+class SocketMultiplexer;
+
+//! Sends the core status to the GUI
+/*!
+Connects to the port the GUI listens on for this core, sends a hello
+message with the token the GUI gave this core, then forwards every
+CoreStatus message as a length prefixed frame, see deskflow::ipc::encodeFrame().
+Status may change on any thread, so messages are queued and written from
+the event queue thread.
+
+The GUI sends commands back the same way, one JSON object per frame with
+its \c type, and each is passed to the command added for that type.  Only
+the GUI that started this core knows the port, and it only accepts this
+core once it has seen the token.
+*/
+class StatusChannel
+{
+public:
+  using Command = std::function<void(const QJsonObject &message)>;
+
+  StatusChannel(IEventQueue *events, SocketMultiplexer *socketMultiplexer, int port, const std::string &token);
+  StatusChannel(StatusChannel const &) = delete;
+  StatusChannel(StatusChannel &&) = delete;
+  ~StatusChannel();
+
+  StatusChannel &operator=(StatusChannel const &) = delete;
+  StatusChannel &operator=(StatusChannel &&) = delete;
+
+  //! Run \p command for messages of \p type from the GUI, replacing any with the same type
+  void addCommand(const QString &type, const Command &command);
+
+private:
+  void handleConnected();
+  void handlePending();
+  void handleData();
+  void close();
+
+  IEventQueue *m_events;
+  std::string m_token;
+  std::unique_ptr<IDataSocket> m_socket;
+  std::mutex m_mutex;
+  QList<QByteArray> m_outbox;
+  deskflow::ipc::FrameReader m_reader;
+  std::map<QString, Command> m_commands;
+};
@@ -7,26 +7,44 @@
 #include "DaemonIpcServer.h"
 
 #include "base/Log.h"
+#include "base/LogOutputters.h"
 #include "common/Constants.h"
 
+#include <QJsonArray>
+#include <QJsonDocument>
 #include <QLocalServer>
 #include <QLocalSocket>
 
 namespace deskflow::core::ipc {
 
-const auto kAckMessage = "ok";
-const auto kErrorMessage = "error";
+using deskflow::ipc::encodeFrame;
+using deskflow::ipc::FrameReader;
 
-DaemonIpcServer::DaemonIpcServer(QObject *parent, const QString &logFilename)
+// keeps each log frame well under the frame size limit
+const auto kLogLinesPerFrame = 256;
+
+DaemonIpcServer::DaemonIpcServer(QObject *parent, const QString &logFilename, QueueLogOutputter *logQueue)
     : QObject(parent),
       m_logFilename(logFilename),
+      m_logQueue(logQueue),
       m_server{new QLocalServer(this)} // NOSONAR - Qt memory
 {
-  // do nothing
+  if (m_logQueue != nullptr) {
+    // lines are written on any thread, send them from ours
+    m_logQueue->setNotifier([this] {
+      QMetaObject::invokeMethod(this, &DaemonIpcServer::sendLog, Qt::QueuedConnection);
+    });
+
+    // only lines queued after the last take wake us, so drain what is there already
+    QMetaObject::invokeMethod(this, &DaemonIpcServer::sendLog, Qt::QueuedConnection);
+  }
 }
 
 DaemonIpcServer::~DaemonIpcServer()
 {
+  if (m_logQueue != nullptr) {
+    m_logQueue->setNotifier({});
+  }
   m_server->close();
 }
 
@@ -53,7 +71,7 @@ void DaemonIpcServer::handleNewConnection()
   }
 
   LOG_DEBUG("ipc server got new connection");
-  m_clients.insert(clientSocket);
+  m_clients.insert(clientSocket, FrameReader{});
 
   connect(clientSocket, &QLocalSocket::readyRead, this, &DaemonIpcServer::handleReadyRead);
   connect(clientSocket, &QLocalSocket::disconnected, this, &DaemonIpcServer::handleDisconnected);
@@ -63,160 +81,175 @@ void DaemonIpcServer::handleNewConnection()
 void DaemonIpcServer::handleReadyRead()
 {
   const auto clientSocket = qobject_cast<QLocalSocket *>(sender());
-  LOG_DEBUG1("ipc server ready to read data");
-
-  QByteArray data = clientSocket->readAll();
-  if (data.isEmpty()) {
-    LOG_WARN("ipc server got empty message");
+  const auto it = m_clients.find(clientSocket);
+  if (it == m_clients.end()) {
     return;
   }
 
-  // we don't handle incomplete messages yet; each socket read must have delimiters.
-  if (!data.contains('\n')) {
-    LOG_WARN("ipc server got incomplete message: %s", data.constData());
-    return;
+  // reads may hold part of a frame or several frames, the reader reassembles them
+  auto &reader = it.value();
+  reader.append(clientSocket->readAll());
+  while (const auto message = reader.next()) {
+    processMessage(clientSocket, *message);
   }
 
-  // each message is delimited by a newline to keep the protocol super simple.
-  while (data.contains('\n')) {
-    const auto index = data.indexOf('\n');
-    QByteArray messageData = data.left(index);
-    data.remove(0, index + 1);
-    QString message = QString::fromUtf8(messageData);
-    processMessage(clientSocket, message);
+  if (reader.hasError()) {
+    LOG_WARN("ipc server got an oversized frame, disconnecting client");
+    removeClient(clientSocket);
+    clientSocket->abort();
+    return;
   }
+
+  clientSocket->flush();
 }
 
 void DaemonIpcServer::handleDisconnected()
 {
-  const auto clientSocket = qobject_cast<QLocalSocket *>(sender());
   LOG_DEBUG("ipc server client disconnected");
-  m_clients.remove(clientSocket);
-  clientSocket->deleteLater();
+  removeClient(qobject_cast<QLocalSocket *>(sender()));
 }
 
 void DaemonIpcServer::handleErrorOccurred()
 {
   const auto clientSocket = qobject_cast<QLocalSocket *>(sender());
   LOG_ERR("ipc server client error: %s", clientSocket->errorString().toUtf8().constData());
-  m_clients.remove(clientSocket);
-  clientSocket->deleteLater();
+  removeClient(clientSocket);
 }
 
-void DaemonIpcServer::processMessage(QLocalSocket *clientSocket, const QString &message)
+void DaemonIpcServer::removeClient(QLocalSocket *clientSocket)
 {
-  LOG_DEBUG1("ipc server got message: %s", message.toUtf8().constData());
-  const auto parts = message.split('=');
-  if (parts.size() < 1) {
-    LOG_ERR("ipc server got invalid message: %s", message.toUtf8().constData());
-    writeToClientSocket(clientSocket, kErrorMessage);
-    return;
+  if (m_clients.remove(clientSocket)) {
+    m_logSubscribers.remove(clientSocket);
+    clientSocket->deleteLater();
   }
+}
 
-  const auto &command = parts[0];
-  if (command == "hello") { // NOSONAR - if-init is confusing here
-    LOG_DEBUG("ipc server got hello message, sending hello back");
-    writeToClientSocket(clientSocket, "hello");
-  } else if (command == "noop") {
-    LOG_DEBUG("ipc server got noop message");
-    writeToClientSocket(clientSocket, kAckMessage);
-  } else if (command == "logLevel") {
-    processLogLevel(clientSocket, parts);
-  } else if (command == "elevate") {
-    processElevate(clientSocket, parts);
-  } else if (command == "command") {
-    processCommand(clientSocket, parts);
-  } else if (command == "start") {
-    LOG_DEBUG("ipc server got start message");
-    Q_EMIT startProcessRequested();
-    writeToClientSocket(clientSocket, kAckMessage);
-  } else if (command == "stop") {
-    LOG_DEBUG("ipc server got stop message");
-    Q_EMIT stopProcessRequested();
-    writeToClientSocket(clientSocket, kAckMessage);
-  } else if (command == "logPath") {
-    LOG_DEBUG("ipc server got log path request");
-    writeToClientSocket(clientSocket, "logPath=" + m_logFilename.toUtf8());
-  } else if (command == "clearSettings") {
-    LOG_DEBUG("ipc server got clear settings message");
-    Q_EMIT clearSettingsRequested();
-    writeToClientSocket(clientSocket, kAckMessage);
-  } else {
-    LOG_WARN("ipc server got unknown message: %s", message.toUtf8().constData());
+void DaemonIpcServer::processMessage(QLocalSocket *clientSocket, const QByteArray &message)
+{
+  LOG_DEBUG1("ipc server got message: %s", message.constData());
+  const auto request = QJsonDocument::fromJson(message).object();
+  const auto id = request.value("id");
+  const auto command = request.value("command").toString();
+  if (!id.isDouble() || command.isEmpty()) {
+    LOG_ERR("ipc server got invalid message: %s", message.constData());
+    writeToClientSocket(clientSocket, {{"id", id}, {"ok", false}});
+    return;
   }
 
-  clientSocket->flush();
+  auto reply = processRequest(clientSocket, command, request.value("value").toString());
+  reply.insert("id", id);
+  if (!writeToClientSocket(clientSocket, reply)) {
+    LOG_ERR("ipc server failed to write full message to client socket");
+  }
 }
 
-void DaemonIpcServer::processLogLevel(QLocalSocket *&clientSocket, const QStringList &messageParts)
+QJsonObject DaemonIpcServer::processRequest(QLocalSocket *clientSocket, const QString &command, const QString &value)
 {
-  if (messageParts.size() < 2) {
-    LOG_ERR("ipc server got invalid log level message");
-    writeToClientSocket(clientSocket, kErrorMessage);
-    return;
+  const QJsonObject ack{{"ok", true}};
+  const QJsonObject error{{"ok", false}};
+
+  if (command == "hello") {
+    LOG_DEBUG("ipc server got hello message");
+    return ack;
   }
 
-  const auto &logLevel = messageParts[1];
-  if (logLevel.isEmpty()) {
-    LOG_ERR("ipc server got empty log level");
-    writeToClientSocket(clientSocket, kErrorMessage);
-    return;
+  if (command == "noop") {
+    LOG_DEBUG("ipc server got noop message");
+    return ack;
   }
 
-  LOG_DEBUG("ipc server got new log level: %s", logLevel.toUtf8().constData());
-  Q_EMIT logLevelChanged(logLevel);
-  writeToClientSocket(clientSocket, kAckMessage);
-}
+  if (command == "logLevel") {
+    if (value.isEmpty()) {
+      LOG_ERR("ipc server got empty log level");
+      return error;
+    }
+    LOG_DEBUG("ipc server got new log level: %s", qPrintable(value));
+    Q_EMIT logLevelChanged(value);
+    return ack;
+  }
 
-void DaemonIpcServer::processElevate(QLocalSocket *&clientSocket, const QStringList &messageParts)
-{
-  if (messageParts.size() < 2) {
-    LOG_ERR("ipc server got invalid elevate message");
-    writeToClientSocket(clientSocket, kErrorMessage);
-    return;
+  if (command == "elevate") {
+    if (value != "yes" && value != "no") {
+      LOG_ERR("ipc server got invalid elevate value: %s", qPrintable(value));
+      return error;
+    }
+    LOG_DEBUG("ipc server got new elevate value: %s", qPrintable(value));
+    Q_EMIT elevateModeChanged(value == "yes");
+    return ack;
   }
 
-  const auto &elevate = messageParts[1];
-  if (elevate != "yes" && elevate != "no") {
-    LOG_ERR("ipc server got invalid elevate value: %s", elevate.toUtf8().constData());
-    writeToClientSocket(clientSocket, kErrorMessage);
-    return;
+  if (command == "command") {
+    if (value.isEmpty()) {
+      LOG_ERR("ipc server got empty command");
+      return error;
+    }
+    LOG_DEBUG("ipc server got new command: %s", qPrintable(value));
+    Q_EMIT commandChanged(value);
+    return ack;
+  }
+
+  if (command == "start") {
+    LOG_DEBUG("ipc server got start message");
+    Q_EMIT startProcessRequested();
+    return ack;
+  }
+
+  if (command == "stop") {
+    LOG_DEBUG("ipc server got stop message");
+    Q_EMIT stopProcessRequested();
+    return ack;
   }
 
-  LOG_DEBUG("ipc server got new elevate value: %s", elevate.toUtf8().constData());
-  Q_EMIT elevateModeChanged(elevate == "yes");
-  writeToClientSocket(clientSocket, kAckMessage);
+  if (command == "logPath") {
+    LOG_DEBUG("ipc server got log path request");
+    return {{"ok", true}, {"value", m_logFilename}};
+  }
+
+  if (command == "subscribeLog") {
+    if (m_logQueue == nullptr) {
+      LOG_ERR("ipc server has no log to stream");
+      return error;
+    }
+    LOG_DEBUG("ipc server streaming log to client");
+    m_logSubscribers.insert(clientSocket);
+    return ack;
+  }
+
+  if (command == "clearSettings") {
+    LOG_DEBUG("ipc server got clear settings message");
+    Q_EMIT clearSettingsRequested();
+    return ack;
+  }
+
+  LOG_WARN("ipc server got unknown command: %s", qPrintable(command));
+  return error;
 }
 
-void DaemonIpcServer::processCommand(QLocalSocket *&clientSocket, const QStringList &messageParts)
+void DaemonIpcServer::sendLog()
 {
-  if (messageParts.size() < 2) {
-    LOG_ERR("ipc server got invalid command message");
-    writeToClientSocket(clientSocket, kErrorMessage);
+  // lines written with nobody subscribed are dropped, like a tail from the end of the file
+  const auto lines = m_logQueue->take();
+  if (lines.isEmpty() || m_logSubscribers.isEmpty()) {
     return;
   }
 
-  const auto &command = messageParts[1];
-  if (command.isEmpty()) {
-    LOG_ERR("ipc server got empty command");
-    writeToClientSocket(clientSocket, kErrorMessage);
-    return;
+  // failures are not logged here, that would queue another batch
+  for (qsizetype i = 0; i < lines.size(); i += kLogLinesPerFrame) {
+    const QJsonObject message{{"log", QJsonArray::fromStringList(lines.mid(i, kLogLinesPerFrame))}};
+    for (const auto clientSocket : std::as_const(m_logSubscribers)) {
+      writeToClientSocket(clientSocket, message);
+    }
   }
 
-  LOG_DEBUG("ipc server got new command: %s", command.toUtf8().constData());
-  Q_EMIT commandChanged(command);
-  writeToClientSocket(clientSocket, kAckMessage);
+  for (const auto clientSocket : std::as_const(m_logSubscribers)) {
+    clientSocket->flush();
+  }
 }
 
-void DaemonIpcServer::writeToClientSocket(QLocalSocket *&clientSocket, const QString &message) const
+bool DaemonIpcServer::writeToClientSocket(QLocalSocket *clientSocket, const QJsonObject &message) const
 {
-  QByteArray messageData = message.toUtf8() + '\n';
-  qint64 bytesWritten = clientSocket->write(messageData);
-  if (bytesWritten != messageData.size()) {
-    LOG_ERR("ipc server failed to write full message to client socket");
-  } else {
-    LOG_DEBUG1("ipc server wrote message to client socket: %s", message.toUtf8().constData());
-  }
+  const auto frame = encodeFrame(QJsonDocument(message).toJson(QJsonDocument::Compact));
+  return clientSocket->write(frame) == frame.size();
 }
 
 } // namespace deskflow::core::ipc
@@ -6,20 +6,38 @@
 
 #pragma once
 
+#include "common/IpcFrame.h"
+
+#include <QHash>
+#include <QJsonObject>
 #include <QObject>
 #include <QSet>
 
 class QLocalServer;
 class QLocalSocket;
+class QueueLogOutputter;
 
 namespace deskflow::core::ipc {
 
+/**
+ * @brief Serves the GUI's requests to the daemon
+ *
+ * Every message is one JSON object sent as a length prefixed frame, see
+ * common/IpcFrame.h. Requests carry an id which is echoed in the reply, so
+ * a client may send several before reading any replies:
+ *
+ *   request: {"id":1,"command":"logLevel","value":"DEBUG"}
+ *   reply:   {"id":1,"ok":true}
+ *
+ * After a client sends \c subscribeLog, lines written to the daemon log are
+ * pushed to it in batches as {"log":["line",...]}.
+ */
 class DaemonIpcServer : public QObject
 {
   Q_OBJECT
 
 public:
-  explicit DaemonIpcServer(QObject *parent, const QString &logFilename);
+  explicit DaemonIpcServer(QObject *parent, const QString &logFilename, QueueLogOutputter *logQueue = nullptr);
   ~DaemonIpcServer() override;
 
   void listen();
@@ -33,29 +51,30 @@ Q_SIGNALS:
   void clearSettingsRequested();
 
 private:
-  void processMessage(QLocalSocket *clientSocket, const QString &message);
-  void processLogLevel(QLocalSocket *&clientSocket, const QStringList &messageParts);
-  void processElevate(QLocalSocket *&clientSocket, const QStringList &messageParts);
-  void processCommand(QLocalSocket *&clientSocket, const QStringList &messageParts);
+  void processMessage(QLocalSocket *clientSocket, const QByteArray &message);
+  QJsonObject processRequest(QLocalSocket *clientSocket, const QString &command, const QString &value);
 
   /**!
-   * Write a message to the client socket and append a newline character.
+   * Write \p message to the client socket as one frame.
    *
-   * \param clientSocket The client socket to write to.
-   * \param message The message to write (without trailing newline).
+   * \return false if the socket did not take the whole frame.
    */
-  void writeToClientSocket(QLocalSocket *&clientSocket, const QString &message) const;
+  bool writeToClientSocket(QLocalSocket *clientSocket, const QJsonObject &message) const;
+  void removeClient(QLocalSocket *clientSocket);
 
 private Q_SLOTS:
   void handleNewConnection();
   void handleReadyRead();
   void handleDisconnected();
   void handleErrorOccurred();
+  void sendLog();
 
 private:
   const QString m_logFilename;
+  QueueLogOutputter *m_logQueue;
   QLocalServer *m_server;
-  QSet<QLocalSocket *> m_clients;
+  QHash<QLocalSocket *, deskflow::ipc::FrameReader> m_clients;
+  QSet<QLocalSocket *> m_logSubscribers;
 };
 
 } // namespace deskflow::core::ipc
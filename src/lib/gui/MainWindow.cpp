@@ -31,12 +31,16 @@
 
 #include <QCloseEvent>
 #include <QDesktopServices>
+#include <QDragEnterEvent>
+#include <QDropEvent>
 #include <QFileDialog>
+#include <QInputDialog>
 #include <QLocalServer>
 #include <QLocalSocket>
 #include <QMenu>
 #include <QMenuBar>
 #include <QMessageBox>
+#include <QMimeData>
 #include <QNetworkAccessManager>
 #include <QNetworkInterface>
 #include <QPushButton>
@@ -45,6 +49,7 @@
 #include <QScreen>
 #include <QScrollBar>
 
+#include <algorithm>
 #include <memory>
 
 #if defined(Q_OS_MACOS)
@@ -84,6 +89,7 @@ MainWindow::MainWindow()
       m_actionStartCore{new QAction(this)},
       m_actionRestartCore{new QAction(this)},
       m_actionStopCore{new QAction(this)},
+      m_actionSendFiles{new QAction(this)},
       m_networkMonitor{new NetworkMonitor(this)}
 {
   ui->setupUi(this);
@@ -126,6 +132,10 @@ MainWindow::MainWindow()
   m_actionStopCore->setIcon(QIcon::fromTheme(QIcon::ThemeIcon::ProcessStop));
   m_actionStopCore->setMenuRole(QAction::NoRole);
 
+  m_actionSendFiles->setIcon(QIcon::fromTheme(QIcon::ThemeIcon::DocumentSend));
+  m_actionSendFiles->setMenuRole(QAction::NoRole);
+  m_actionSendFiles->setEnabled(false);
+
   m_actionReportBug->setIcon(QIcon::fromTheme(QStringLiteral("tools-report-bug")));
   m_actionReportBug->setMenuRole(QAction::NoRole);
 
@@ -269,13 +279,14 @@ void MainWindow::connectSlots()
   connect(Settings::instance(), &Settings::settingsChanged, this, &MainWindow::settingsChanged);
 
   connect(&m_coreProcess, &CoreProcess::error, this, &MainWindow::coreProcessError);
-  connect(&m_coreProcess, &CoreProcess::logLine, this, &MainWindow::handleLogLine);
+  connect(&m_coreProcess, &CoreProcess::logLines, this, &MainWindow::handleLogLines);
   connect(
       &m_coreProcess, &CoreProcess::processStateChanged, this, &MainWindow::coreProcessStateChanged,
       Qt::QueuedConnection
   );
   connect(&m_coreProcess, &CoreProcess::connectionStateChanged, this, &MainWindow::coreConnectionStateChanged);
   connect(&m_coreProcess, &CoreProcess::secureSocket, this, &MainWindow::secureSocket);
+  connect(&m_coreProcess, &CoreProcess::peerFingerprint, this, &MainWindow::checkFingerprint);
   connect(
       &m_coreProcess, &CoreProcess::daemonIpcClientConnectionFailed, this, &MainWindow::daemonIpcClientConnectionFailed
   );
@@ -292,6 +303,7 @@ void MainWindow::connectSlots()
   connect(m_actionStartCore, &QAction::triggered, this, &MainWindow::startCore);
   connect(m_actionRestartCore, &QAction::triggered, this, &MainWindow::resetCore);
   connect(m_actionStopCore, &QAction::triggered, this, &MainWindow::stopCore);
+  connect(m_actionSendFiles, &QAction::triggered, this, &MainWindow::openSendFilesDialog);
 
   connect(&m_versionChecker, &VersionChecker::updateFound, this, &MainWindow::versionCheckerUpdateFound);
 
@@ -666,6 +678,8 @@ void MainWindow::createMenuBar()
   m_menuFile->addAction(m_actionRestartCore);
   m_menuFile->addAction(m_actionStopCore);
   m_menuFile->addSeparator();
+  m_menuFile->addAction(m_actionSendFiles);
+  m_menuFile->addSeparator();
   m_menuFile->addAction(m_actionQuit);
 
   m_menuEdit->addAction(m_actionSettings);
@@ -762,16 +776,17 @@ void MainWindow::setTrayIcon()
   m_trayIcon->setIcon(icon);
 }
 
-void MainWindow::handleLogLine(const QString &line)
+void MainWindow::handleLogLines(const QStringList &lines)
 {
-  m_logDock->appendLine(line);
-  updateFromLogLine(line);
+  m_logDock->appendLines(lines);
+  for (const auto &line : lines) {
+    updateFromLogLine(line);
+  }
 }
 
 void MainWindow::updateFromLogLine(const QString &line)
 {
   checkConnected(line);
-  checkFingerprint(line);
 }
 
 void MainWindow::checkConnected(const QString &line)
@@ -783,16 +798,9 @@ void MainWindow::checkConnected(const QString &line)
   }
 }
 
-void MainWindow::checkFingerprint(const QString &line)
+void MainWindow::checkFingerprint(const QString &fingerprint)
 {
-  static const auto tlsPeerMessage = QStringLiteral("peer fingerprint: ");
-  static const qsizetype msgLen = QString(tlsPeerMessage).length();
-
-  const qsizetype midStart = line.indexOf(tlsPeerMessage);
-  if (midStart == -1)
-    return;
-
-  const auto sha256Text = line.mid(midStart + msgLen).remove(':');
+  const auto sha256Text = QString(fingerprint).remove(':');
 
   const Fingerprint sha256 = {QCryptographicHash::Sha256, QByteArray::fromHex(sha256Text.toLatin1())};
 
@@ -864,6 +872,58 @@ void MainWindow::closeEvent(QCloseEvent *event)
   QApplication::quit();
 }
 
+void MainWindow::dragEnterEvent(QDragEnterEvent *event)
+{
+  const auto urls = event->mimeData()->urls();
+  if (std::ranges::any_of(urls, [](const QUrl &url) { return url.isLocalFile(); })) {
+    event->acceptProposedAction();
+  }
+}
+
+void MainWindow::dropEvent(QDropEvent *event)
+{
+  QStringList paths;
+  for (const auto &url : event->mimeData()->urls()) {
+    if (url.isLocalFile()) {
+      paths.append(url.toLocalFile());
+    }
+  }
+  event->acceptProposedAction();
+  sendFiles(paths);
+}
+
+void MainWindow::openSendFilesDialog()
+{
+  const auto paths = QFileDialog::getOpenFileNames(this, tr("Send Files"));
+  if (!paths.isEmpty()) {
+    sendFiles(paths);
+  }
+}
+
+void MainWindow::sendFiles(const QStringList &paths)
+{
+  // a client sends to its server, a server to the client the user picks
+  QString screen;
+  if (m_coreProcess.mode() == CoreMode::Server) {
+    const auto clients = m_coreProcess.clients();
+    if (clients.isEmpty()) {
+      return;
+    }
+    screen = clients.first();
+    if (clients.size() > 1) {
+      bool ok = false;
+      screen = QInputDialog::getItem(this, tr("Send Files"), tr("Send to:"), clients, 0, false, &ok);
+      if (!ok) {
+        return;
+      }
+    }
+  }
+
+  if (!m_coreProcess.sendFiles(paths, screen)) {
+    QMessageBox::warning(this, tr("Send Files"), tr("The files can't be sent, %1 is not connected.").arg(kAppName));
+  }
+}
+
 void MainWindow::showFirstConnectedMessage()
 {
   if (Settings::value(Settings::Gui::ShownFirstConnectedMessage).toBool())
@@ -990,6 +1050,10 @@ void MainWindow::coreConnectionStateChanged(CoreConnectionState state)
 
   updateStatus();
 
+  // files go over the connection, also when dropped on the window
+  m_actionSendFiles->setEnabled(state == CoreConnectionState::Connected);
+  setAcceptDrops(state == CoreConnectionState::Connected);
+
   // always assume connection is not secure when connection changes
   // to anything except connected. the only way the padlock shows is
   // when the correct TLS version string is detected.
@@ -1051,6 +1115,7 @@ void MainWindow::updateText()
   m_actionStartCore->setText(tr("&Start"));
   m_actionRestartCore->setText(tr("Rest&art"));
   m_actionStopCore->setText(tr("S&top"));
+  m_actionSendFiles->setText(tr("Send &Files..."));
   //: %1 will be the replaced with the appname
   m_actionAbout->setText(tr("About %1...").arg(kAppName));
 
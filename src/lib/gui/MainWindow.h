@@ -136,11 +136,15 @@ private:
   void setStatus(const QString &status);
   void updateFromLogLine(const QString &line);
   void checkConnected(const QString &line);
-  void checkFingerprint(const QString &line);
+  void checkFingerprint(const QString &fingerprint);
   void closeEvent(QCloseEvent *event) override;
+  void dragEnterEvent(QDragEnterEvent *event) override;
+  void dropEvent(QDropEvent *event) override;
+  void openSendFilesDialog();
+  void sendFiles(const QStringList &paths);
   void secureSocket(bool secureSocket);
   void connectSlots();
-  void handleLogLine(const QString &line);
+  void handleLogLines(const QStringList &lines);
   void updateLocalFingerprint();
   void updateScreenName();
   void saveSettings() const;
@@ -224,6 +228,7 @@ private:
   QAction *m_actionStartCore = nullptr;
   QAction *m_actionRestartCore = nullptr;
   QAction *m_actionStopCore = nullptr;
+  QAction *m_actionSendFiles = nullptr;
 
   // Network monitoring
   NetworkMonitor *m_networkMonitor = nullptr;
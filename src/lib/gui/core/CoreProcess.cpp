@@ -8,6 +8,8 @@
 #include "CoreProcess.h"
 
 #include "common/ExitCodes.h"
+#include "common/IpcFrame.h"
+#include "gui/core/CoreStatusServer.h"
 #include "gui/ipc/DaemonIpcClient.h"
 
 #if defined(Q_OS_MACOS)
@@ -17,7 +19,9 @@
 #include <QCoreApplication>
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QMutexLocker>
+#include <QProcessEnvironment>
 #include <QRegularExpression>
 
 namespace deskflow::gui {
@@ -94,7 +98,8 @@ QString CoreProcess::wrapIpv6(const QString &address)
 
 CoreProcess::CoreProcess(const IServerConfig &serverConfig)
     : m_serverConfig(serverConfig),
-      m_daemonIpcClient{new ipc::DaemonIpcClient(this)}
+      m_daemonIpcClient{new ipc::DaemonIpcClient(this)},
+      m_statusServer{new CoreStatusServer(this)}
 {
   m_appPath = QStringLiteral("%1/%2").arg(QCoreApplication::applicationDirPath(), kCoreBinName);
   if (!QFile::exists(m_appPath)) {
@@ -106,6 +111,20 @@ CoreProcess::CoreProcess(const IServerConfig &serverConfig)
   connect(
       m_daemonIpcClient, &ipc::DaemonIpcClient::connectionFailed, this, &CoreProcess::daemonIpcClientConnectionFailed
   );
+  connect(m_daemonIpcClient, &ipc::DaemonIpcClient::logLines, this, [this](const QStringList &lines) {
+    handleLogLines(lines.join('\n'));
+  });
+
+  connect(
+      m_statusServer, &CoreStatusServer::connectionStateChanged, this, &CoreProcess::handleCoreConnectionState
+  );
+  connect(m_statusServer, &CoreStatusServer::clientsChanged, this, &CoreProcess::handleCoreClients);
+  connect(m_statusServer, &CoreStatusServer::tlsProtocolChanged, this, &CoreProcess::handleCoreTlsProtocol);
+  connect(m_statusServer, &CoreStatusServer::peerFingerprint, this, &CoreProcess::peerFingerprint);
+  connect(m_statusServer, &CoreStatusServer::coreDisconnected, this, [this] {
+    m_clients.clear();
+    setConnectionState(ConnectionState::Disconnected);
+  });
 
   connect(&m_retryTimer, &QTimer::timeout, this, [this] {
     if (m_processState == ProcessState::RetryPending) {
@@ -134,19 +153,12 @@ void CoreProcess::daemonIpcClientConnected()
 {
   applyLogLevel();
 
-  const auto logPath = requestDaemonLogPath();
-  if (logPath.isEmpty()) {
-    qWarning() << "daemon no log path";
-    return;
-  }
-
-  qDebug() << "daemon log path:" << logPath;
-  if (m_daemonFileTail) {
-    m_daemonFileTail->setWatchedFile(logPath);
-  } else {
-    m_daemonFileTail = new FileTail(logPath, this);
-    connect(m_daemonFileTail, &FileTail::newLine, this, &CoreProcess::handleLogLines);
-  }
+  // the daemon pushes its log over the same connection
+  m_daemonIpcClient->subscribeLog([](bool ok, const QString &) {
+    if (!ok) {
+      qWarning() << "failed to subscribe to daemon log";
+    }
+  });
 }
 
 void CoreProcess::onProcessFinished(int exitCode, QProcess::ExitStatus)
@@ -184,9 +196,11 @@ void CoreProcess::applyLogLevel()
   const auto processMode = Settings::value(Settings::Core::ProcessMode).value<Settings::ProcessMode>();
   if (processMode == ProcessMode::Service) {
     qDebug() << "setting daemon log level:" << Settings::logLevelText();
-    if (!m_daemonIpcClient->sendLogLevel(Settings::logLevelText())) {
-      qWarning() << "failed to set daemon ipc log level";
-    }
+    m_daemonIpcClient->sendLogLevel(Settings::logLevelText(), [](bool ok, const QString &) {
+      if (!ok) {
+        qWarning() << "failed to set daemon ipc log level";
+      }
+    });
   }
 }
 
@@ -203,6 +217,10 @@ void CoreProcess::startForegroundProcess(const QStringList &args)
   const auto quoted = makeQuotedArgs(m_appPath, args);
   qInfo("running command: %s", qPrintable(quoted));
 
+  // kept out of the command line, which other users can read
+  auto environment = QProcessEnvironment::systemEnvironment();
+  environment.insert(deskflow::ipc::kStatusTokenVariable, m_statusServer->token());
+  m_process->setProcessEnvironment(environment);
   m_process->start(m_appPath, args);
 
   if (m_process->waitForStarted()) {
@@ -219,14 +237,24 @@ void CoreProcess::startProcessFromDaemon(const QStringList &args)
     qFatal("core process must be in starting state");
   }
 
-  QString commandQuoted = makeQuotedArgs(m_appPath, args);
+  // the daemon logs and saves the command, so the token goes in a file only we can read
+  auto daemonArgs = args;
+  if (const auto tokenFile = Settings::statusTokenFile(); m_statusServer->writeTokenFile(tokenFile)) {
+    daemonArgs.append({QStringLiteral("--status-token-file"), tokenFile});
+  }
 
-  qInfo("running command: %s", qPrintable(commandQuoted));
+  const auto command = makeQuotedArgs(m_appPath, daemonArgs);
 
-  if (!m_daemonIpcClient->sendStartProcess(commandQuoted, Settings::value(Settings::Daemon::Elevate).toBool())) {
-    qWarning("cannot start process, ipc command failed");
-    return;
-  }
+  qInfo("running command: %s", qPrintable(command));
+
+  // the reply comes later, a failure moves the state back
+  const auto elevate = Settings::value(Settings::Daemon::Elevate).toBool();
+  m_daemonIpcClient->sendStartProcess(command, elevate, [this](bool ok, const QString &) {
+    if (!ok && m_processState == ProcessState::Started) {
+      qWarning("cannot start process, ipc command failed");
+      setProcessState(ProcessState::Stopped);
+    }
+  });
 
   setProcessState(ProcessState::Started);
 }
@@ -257,18 +285,21 @@ void CoreProcess::stopProcessFromDaemon()
     qFatal("core process must be in stopping state");
   }
 
-  if (!m_daemonIpcClient->sendStopProcess()) {
-    qWarning("cannot stop process, ipc command failed");
-    return;
-  }
+  m_daemonIpcClient->sendStopProcess([](bool ok, const QString &) {
+    if (!ok) {
+      qWarning("cannot stop process, ipc command failed");
+    }
+  });
 
   setProcessState(ProcessState::Stopped);
 }
 
 void CoreProcess::handleLogLines(const QString &text)
 {
-  const auto lines = text.split(kLineSplitRegex);
-  for (const auto &line : lines) {
+  // one signal per read, the log view adds the whole batch at once; state
+  // comes from the status channel so lines are not searched here
+  QStringList lines;
+  for (const auto &line : text.split(kLineSplitRegex)) {
     if (line.isEmpty()) {
       continue;
     }
@@ -279,11 +310,17 @@ void CoreProcess::handleLogLines(const QString &text)
     if (line.contains("calling TIS/TSM in non-main thread environment")) {
       continue;
     }
+
+    // server and client processes are not allowed to show notifications.
+    // process the log from it and show notification from deskflow instead.
+    checkOSXNotification(line);
 #endif
 
-    checkLogLine(line);
-    Q_EMIT logLine(line);
+    lines.append(line);
   }
+
+  if (!lines.isEmpty())
+    Q_EMIT logLines(lines);
 }
 
 void CoreProcess::start(std::optional<ProcessMode> processModeOption)
@@ -329,6 +366,11 @@ void CoreProcess::start(std::optional<ProcessMode> processModeOption)
 
   QStringList args = {coreMode};
 
+  // the core reports its state to this port, proving itself with the token
+  if (const auto statusPort = m_statusServer->listen(); statusPort != 0) {
+    args.append({QStringLiteral("--status-port"), QString::number(statusPort)});
+  }
+
   if (m_mode == Settings::CoreMode::Server) {
     const auto configFilename = persistServerConfig();
     if (configFilename.isEmpty()) {
@@ -458,48 +500,38 @@ void CoreProcess::setProcessState(ProcessState state)
   Q_EMIT processStateChanged(state);
 }
 
-void CoreProcess::checkLogLine(const QString &line)
+void CoreProcess::handleCoreConnectionState(const QString &state)
 {
   using enum ConnectionState;
 
-  if (line.contains("connected to server") || line.contains("has connected")) {
-    m_connections++;
-    setConnectionState(Connected);
-  } else if (line.contains("started server")) {
-    m_connections = 0;
+  if (state == QStringLiteral("listening")) {
     setConnectionState(Listening);
-  } else if (line.contains("disconnected from server") || line.contains("process exited")) {
-    m_connections = 0;
-    setConnectionState(Disconnected);
-  } else if (line.contains("connecting to")) {
+  } else if (state == QStringLiteral("connecting")) {
     setConnectionState(Connecting);
-  } else if (line.contains("has disconnected")) {
-    m_connections--;
-    if (m_connections < 1) {
-      setConnectionState(Listening);
-    }
+  } else if (state == QStringLiteral("connected")) {
+    setConnectionState(Connected);
+  } else if (state == QStringLiteral("disconnected")) {
+    setConnectionState(Disconnected);
+  } else {
+    qWarning() << "core sent an unknown connection state:" << state;
   }
-
-  checkSecureSocket(line);
-
-  // server and client processes are not allowed to show notifications.
-  // process the log from it and show notification from deskflow instead.
-#ifdef Q_OS_MACOS
-  checkOSXNotification(line);
-#endif
 }
 
-bool CoreProcess::checkSecureSocket(const QString &line)
+void CoreProcess::handleCoreClients(const QStringList &names)
 {
-  static const QString tlsCheckString = "network encryption protocol: ";
-  const auto index = line.indexOf(tlsCheckString, 0, Qt::CaseInsensitive);
-  if (index == -1) {
-    return false;
+  using enum ConnectionState;
+  m_clients = names;
+
+  // a listening server is connected while it has any clients
+  if (m_connectionState == Listening || m_connectionState == Connected) {
+    setConnectionState(names.isEmpty() ? Listening : Connected);
   }
+}
 
+void CoreProcess::handleCoreTlsProtocol(const QString &protocol)
+{
+  m_secureSocketVersion = protocol;
   Q_EMIT secureSocket(true);
-  m_secureSocketVersion = line.mid(index + tlsCheckString.size());
-  return true;
 }
 
 #ifdef Q_OS_MACOS
@@ -523,27 +555,6 @@ QString CoreProcess::correctedAddress(const QString &address) const
   return wrapIpv6(address.simplified());
 }
 
-QString CoreProcess::requestDaemonLogPath()
-{
-  qDebug() << "requesting daemon log path";
-  const auto logPath = m_daemonIpcClient->requestLogPath();
-  if (logPath.isEmpty()) {
-    qCritical() << "failed to get daemon log path";
-    return QString();
-  }
-
-  if (QFileInfo logFile(logPath); !logFile.isFile()) {
-    auto file = QFile(logPath);
-    if (!file.open(QFile::ReadWrite)) {
-      qCritical() << "daemon log path file can not be written:" << logPath;
-      return QString();
-    }
-    file.write(""); // Create an empty file
-  }
-
-  return logPath;
-}
-
 void CoreProcess::clearSettings()
 {
   const auto processMode = Settings::value(Settings::Core::ProcessMode).value<ProcessMode>();
@@ -562,9 +573,13 @@ void CoreProcess::clearSettings()
 
 void CoreProcess::retryDaemon()
 {
-  if (m_daemonIpcClient->connectToServer()) {
-    qInfo("successfully reconnected to daemon");
-  }
+  qInfo("reconnecting to daemon");
+  m_daemonIpcClient->connectToServer();
+}
+
+bool CoreProcess::sendFiles(const QStringList &paths, const QString &screen)
+{
+  return m_statusServer->sendFiles(paths, screen);
 }
 
 } // namespace deskflow::gui
@@ -8,7 +8,6 @@
 #pragma once
 
 #include "common/Settings.h"
-#include "gui/FileTail.h"
 #include "gui/config/IServerConfig.h"
 
 #include <QMutex>
@@ -22,6 +21,8 @@ namespace ipc {
 class DaemonIpcClient;
 }
 
+class CoreStatusServer;
+
 class CoreProcess : public QObject
 {
   using ProcessMode = Settings::ProcessMode;
@@ -63,6 +64,12 @@ public:
   void clearSettings();
   void retryDaemon();
 
+  /**
+   * @brief Ask the core to send files, to @p screen when it is a server
+   * @return false when the core is not connected to its status channel
+   */
+  bool sendFiles(const QStringList &paths, const QString &screen = {});
+
   // getters
   Settings::CoreMode mode() const
   {
@@ -84,6 +91,10 @@ public:
   {
     return m_connectionState;
   }
+  QStringList clients() const
+  {
+    return m_clients;
+  }
 
   // setters
   void setAddress(const QString &address)
@@ -97,10 +108,11 @@ public:
 
 Q_SIGNALS:
   void error(deskflow::gui::CoreProcess::Error error);
-  void logLine(const QString &line);
+  void logLines(const QStringList &lines);
   void connectionStateChanged(deskflow::gui::CoreProcess::ConnectionState state);
   void processStateChanged(deskflow::gui::CoreProcess::ProcessState state);
   void secureSocket(bool enabled);
+  void peerFingerprint(const QString &sha256);
   void daemonIpcClientConnectionFailed();
 
 private Q_SLOTS:
@@ -117,11 +129,11 @@ private:
   QString persistServerConfig() const;
   void setConnectionState(ConnectionState state);
   void setProcessState(ProcessState state);
-  void checkLogLine(const QString &line);
-  bool checkSecureSocket(const QString &line);
+  void handleCoreConnectionState(const QString &state);
+  void handleCoreClients(const QStringList &names);
+  void handleCoreTlsProtocol(const QString &protocol);
   void handleLogLines(const QString &text);
   QString correctedAddress(const QString &address) const;
-  QString requestDaemonLogPath();
   static QString makeQuotedArgs(const QString &app, const QStringList &args);
   static QString processModeToString(const Settings::ProcessMode mode);
   static QString processStateToString(const CoreProcess::ProcessState state);
@@ -138,11 +150,11 @@ private:
   Settings::CoreMode m_mode = Settings::CoreMode::None;
   QMutex m_processMutex;
   QString m_secureSocketVersion;
+  QStringList m_clients;
   std::optional<ProcessMode> m_lastProcessMode = std::nullopt;
   QTimer m_retryTimer;
-  int m_connections = 0;
   deskflow::gui::ipc::DaemonIpcClient *m_daemonIpcClient = nullptr;
-  FileTail *m_daemonFileTail = nullptr;
+  CoreStatusServer *m_statusServer = nullptr;
   QProcess *m_process = nullptr;
   QString m_appPath;
 };
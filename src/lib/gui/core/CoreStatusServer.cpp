@@ -0,0 +1,199 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "CoreStatusServer.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+
+#include <array>
+
+namespace deskflow::gui {
+
+namespace {
+
+// a core sends its hello as soon as it connects
+const auto kHelloTimeout = 5000;
+
+QString newToken()
+{
+  std::array<quint32, 8> random;
+  QRandomGenerator::system()->fillRange(random.data(), random.size());
+  return QString::fromLatin1(
+      QByteArray(reinterpret_cast<const char *>(random.data()), sizeof(random)).toHex() // NOSONAR - raw bytes
+  );
+}
+
+} // namespace
+
+CoreStatusServer::CoreStatusServer(QObject *parent)
+    : QObject(parent),
+      m_server{new QTcpServer(this)}, // NOSONAR - Qt memory
+      m_token{newToken()}
+{
+  connect(m_server, &QTcpServer::newConnection, this, &CoreStatusServer::handleNewConnection);
+}
+
+bool CoreStatusServer::writeTokenFile(const QString &fileName) const
+{
+  // owner only before the token goes in
+  QFile file(fileName);
+  if (!file.open(QFile::WriteOnly | QFile::Truncate) || !file.setPermissions(QFile::ReadOwner | QFile::WriteOwner)) {
+    qWarning() << "failed to write the core status token file" << fileName;
+    return false;
+  }
+  return file.write(m_token.toUtf8()) == m_token.toUtf8().size();
+}
+
+quint16 CoreStatusServer::listen()
+{
+  if (!m_server->isListening() && !m_server->listen(QHostAddress::LocalHost)) {
+    qWarning() << "core status server failed to listen:" << m_server->errorString();
+    return 0;
+  }
+  return m_server->serverPort();
+}
+
+void CoreStatusServer::handleNewConnection()
+{
+  while (auto socket = m_server->nextPendingConnection()) {
+    // any local process can connect, nothing is trusted before the hello
+    m_pending.insert(socket, {});
+    connect(socket, &QTcpSocket::readyRead, this, [this, socket] { handlePendingReadyRead(socket); });
+    connect(socket, &QTcpSocket::disconnected, this, [this, socket] {
+      m_pending.remove(socket);
+      socket->deleteLater();
+    });
+    QTimer::singleShot(kHelloTimeout, socket, [this, socket] {
+      if (m_pending.contains(socket)) {
+        qWarning("core status connection sent no hello, disconnecting");
+        socket->abort();
+      }
+    });
+  }
+}
+
+void CoreStatusServer::handlePendingReadyRead(QTcpSocket *socket)
+{
+  auto &reader = m_pending[socket];
+  reader.append(socket->readAll());
+  const auto hello = reader.next();
+  if (!hello && !reader.hasError()) {
+    return;
+  }
+
+  auto rest = m_pending.take(socket);
+  socket->disconnect(this);
+  if (!hello || !isHello(*hello)) {
+    qWarning("core status connection did not present the token, disconnecting");
+    socket->abort();
+    socket->deleteLater();
+    return;
+  }
+
+  // only one core runs at a time, a new connection is a restarted core
+  if (m_socket) {
+    m_socket->disconnect(this);
+    m_socket->deleteLater();
+  }
+
+  qDebug("core status channel connected");
+  m_socket = socket;
+  m_reader = std::move(rest);
+  connect(m_socket, &QTcpSocket::readyRead, this, &CoreStatusServer::handleReadyRead);
+  connect(m_socket, &QTcpSocket::disconnected, this, &CoreStatusServer::handleDisconnected);
+
+  // messages may have arrived with the hello
+  handleReadyRead();
+}
+
+void CoreStatusServer::handleReadyRead()
+{
+  m_reader.append(m_socket->readAll());
+  while (const auto payload = m_reader.next()) {
+    handleMessage(*payload);
+  }
+
+  if (m_reader.hasError()) {
+    qWarning("core status channel sent an oversized frame, disconnecting");
+    m_socket->abort();
+  }
+}
+
+void CoreStatusServer::handleDisconnected()
+{
+  qDebug("core status channel disconnected");
+  m_socket->deleteLater();
+  m_socket = nullptr;
+  Q_EMIT coreDisconnected();
+}
+
+bool CoreStatusServer::sendFiles(const QStringList &paths, const QString &screen)
+{
+  if (m_socket == nullptr) {
+    qWarning("can't send files, the core is not connected");
+    return false;
+  }
+
+  const QJsonObject message{
+      {"type", "sendFiles"},
+      {"screen", screen},
+      {"paths", QJsonArray::fromStringList(paths)},
+  };
+  m_socket->write(deskflow::ipc::encodeFrame(QJsonDocument(message).toJson(QJsonDocument::Compact)));
+  return true;
+}
+
+bool CoreStatusServer::isHello(const QByteArray &payload) const
+{
+  const auto message = QJsonDocument::fromJson(payload).object();
+  if (message.value("type").toString() != QStringLiteral("hello")) {
+    return false;
+  }
+
+  const auto token = message.value("token").toString().toLatin1();
+  const auto expected = m_token.toLatin1();
+  if (token.size() != expected.size()) {
+    return false;
+  }
+
+  // compare every byte so the time taken says nothing about the token
+  char diff = 0;
+  for (qsizetype i = 0; i < token.size(); ++i) {
+    diff |= static_cast<char>(token[i] ^ expected[i]);
+  }
+  return diff == 0;
+}
+
+void CoreStatusServer::handleMessage(const QByteArray &payload)
+{
+  const auto message = QJsonDocument::fromJson(payload).object();
+  const auto type = message.value("type").toString();
+
+  if (type == QStringLiteral("connection")) {
+    Q_EMIT connectionStateChanged(message.value("state").toString());
+  } else if (type == QStringLiteral("clients")) {
+    QStringList names;
+    for (const auto &name : message.value("names").toArray()) {
+      names.append(name.toString());
+    }
+    Q_EMIT clientsChanged(names);
+  } else if (type == QStringLiteral("tls")) {
+    Q_EMIT tlsProtocolChanged(message.value("protocol").toString());
+  } else if (type == QStringLiteral("fingerprint")) {
+    Q_EMIT peerFingerprint(message.value("sha256").toString());
+  } else {
+    qWarning() << "core status channel sent an unknown message:" << payload;
+  }
+}
+
+} // namespace deskflow::gui
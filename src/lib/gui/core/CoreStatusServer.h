@@ -0,0 +1,93 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "common/IpcFrame.h"
+
+#include <QHash>
+#include <QObject>
+#include <QStringList>
+
+class QTcpServer;
+class QTcpSocket;
+
+namespace deskflow::gui {
+
+/**
+ * @brief Receives the status the core publishes
+ *
+ * Listens on a free port of the loopback interface; the core is given the
+ * port and token() when it is started. Any local process can connect to the
+ * port, so a connection is ignored until its first frame is a hello message
+ * holding the token, and only then replaces the current core connection.
+ * Each later frame holds one JSON message, see CoreStatus in the core, and
+ * is turned into a signal here so no state has to be guessed from log lines.
+ * Commands go the other way on the same connection.
+ */
+class CoreStatusServer : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit CoreStatusServer(QObject *parent = nullptr);
+
+  /**
+   * @brief Start listening if not already, returns the port or 0 on failure
+   */
+  quint16 listen();
+
+  /**
+   * @brief The secret a core sends in its hello message, new for each GUI run
+   */
+  const QString &token() const
+  {
+    return m_token;
+  }
+
+  /**
+   * @brief Write token() to a file only the current user can read
+   *
+   * For a core started by the daemon, which would otherwise have to carry
+   * the token on a command line it logs and saves. Returns false on error.
+   */
+  bool writeTokenFile(const QString &fileName) const;
+
+  /**
+   * @brief Ask the core to send files to another screen
+   *
+   * A server sends them to @p screen, a client to its server. Returns false
+   * when no core is connected.
+   */
+  bool sendFiles(const QStringList &paths, const QString &screen = {});
+
+  /**
+   * @brief Handle one message payload, as if it came from the core
+   */
+  void handleMessage(const QByteArray &payload);
+
+Q_SIGNALS:
+  void connectionStateChanged(const QString &state);
+  void clientsChanged(const QStringList &names);
+  void tlsProtocolChanged(const QString &protocol);
+  void peerFingerprint(const QString &sha256);
+  void coreDisconnected();
+
+private:
+  void handleNewConnection();
+  void handlePendingReadyRead(QTcpSocket *socket);
+  void handleReadyRead();
+  void handleDisconnected();
+  bool isHello(const QByteArray &payload) const;
+
+  QTcpServer *m_server;
+  QString m_token;
+  QHash<QTcpSocket *, deskflow::ipc::FrameReader> m_pending;
+  QTcpSocket *m_socket = nullptr;
+  deskflow::ipc::FrameReader m_reader;
+};
+
+} // namespace deskflow::gui
@@ -9,28 +9,54 @@
 #include "common/Constants.h"
 
 #include <QDebug>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QLocalSocket>
 #include <QObject>
+#include <QSignalBlocker>
 #include <QString>
 
+#include <utility>
+
 namespace deskflow::gui::ipc {
 
-const auto kTimeout = 1000;
+using deskflow::ipc::encodeFrame;
+
+const auto kTimeout = 3000;
+const auto kRetryDelay = 1000;
 const auto kRetryLimit = 3;
 
 DaemonIpcClient::DaemonIpcClient(QObject *parent)
     : QObject(parent),
       m_socket{new QLocalSocket(this)} // NOSONAR - Qt memory
 {
-  connect(m_socket, &QLocalSocket::disconnected, this, &DaemonIpcClient::handleDisconnected);
-  connect(m_socket, &QLocalSocket::errorOccurred, this, &DaemonIpcClient::handleErrorOccurred);
+  connect(m_socket, &QLocalSocket::connected, this, &DaemonIpcClient::handleConnected);
+  connect(m_socket, &QLocalSocket::readyRead, this, &DaemonIpcClient::handleReadyRead);
+  connect(m_socket, &QLocalSocket::disconnected, this, &DaemonIpcClient::handleConnectionLost);
+  connect(m_socket, &QLocalSocket::errorOccurred, this, [this] {
+    qWarning() << "daemon ipc client error:" << m_socket->errorString();
+    handleConnectionLost();
+  });
+
+  // a daemon that stops answering is treated like one that went away
+  m_replyTimer.setSingleShot(true);
+  m_replyTimer.setInterval(kTimeout);
+  connect(&m_replyTimer, &QTimer::timeout, this, [this] {
+    qWarning() << "daemon ipc client timed out waiting for a reply";
+    handleConnectionLost();
+  });
+
+  m_retryTimer.setSingleShot(true);
+  m_retryTimer.setInterval(kRetryDelay);
+  connect(&m_retryTimer, &QTimer::timeout, this, &DaemonIpcClient::attemptConnection);
 }
 
-bool DaemonIpcClient::connectToServer()
+void DaemonIpcClient::connectToServer()
 {
   if (m_state == State::Connecting) {
     qWarning() << "daemon ipc client already connecting to server";
-    return false;
+    return;
   }
 
   if (m_state != State::Unconnected) {
@@ -38,216 +64,210 @@ bool DaemonIpcClient::connectToServer()
     disconnectFromServer();
   }
 
-  if (m_socket->state() != QLocalSocket::UnconnectedState) {
-    qWarning() << "daemon ipc client socket not in unconnected state, disconnecting";
-    disconnectFromServer();
+  m_state = State::Connecting;
+  m_attempts = 0;
+  attemptConnection();
+}
+
+void DaemonIpcClient::attemptConnection()
+{
+  if (m_attempts == 0) {
+    qDebug() << "daemon ipc client connecting to server:" << kDaemonIpcName;
+  } else {
+    qDebug() << "daemon ipc client retrying connection, attempt:" << m_attempts + 1;
   }
 
-  for (int i = 0; i < kRetryLimit; ++i) {
-    if (i == 0) {
-      qDebug() << "daemon ipc client connecting to server:" << kDaemonIpcName;
-    } else {
-      qDebug() << "daemon ipc client retrying connection, attempt:" << i + 1;
-    }
+  m_reader = {};
+  m_socket->connectToServer(kDaemonIpcName);
 
-    m_state = State::Connecting;
-    m_socket->connectToServer(kDaemonIpcName);
+  // also covers the hello, so a hung daemon fails the attempt
+  m_replyTimer.start();
+}
 
-    if (!m_socket->waitForConnected(kTimeout)) {
-      qWarning() << "daemon ipc client failed to connect";
-      disconnectFromServer();
-      continue;
-    }
+void DaemonIpcClient::disconnectFromServer()
+{
+  qDebug() << "daemon ipc client disconnecting from server";
+  m_state = State::Unconnected;
+  m_retryTimer.stop();
+  m_replyTimer.stop();
+  m_socket->abort();
+  failPending();
+}
 
-    if (!sendMessage("hello", "hello", false)) {
-      qWarning() << "daemon ipc client failed to send hello";
-      disconnectFromServer();
-      continue;
+void DaemonIpcClient::handleConnected()
+{
+  // requests queued while connecting go out once the daemon has answered
+  m_helloId = m_nextId++;
+  m_pending.insert(m_helloId, [this](bool ok, const QString &) {
+    if (!ok) {
+      return;
     }
 
-    m_state = State::Connected;
     qDebug() << "daemon ipc client connected";
+    m_state = State::Connected;
+    m_attempts = 0;
+    for (const auto &frame : std::exchange(m_outbox, {})) {
+      write(frame);
+    }
     Q_EMIT connected();
-    return true;
-  }
+  });
 
-  qWarning() << "daemon ipc client failed to connect after" << kRetryLimit << "attempts";
-  disconnectFromServer();
-  Q_EMIT connectionFailed();
-  return false;
+  write(encodeFrame(QJsonDocument(QJsonObject{{"id", static_cast<qint64>(m_helloId)}, {"command", "hello"}})
+                        .toJson(QJsonDocument::Compact)));
 }
 
-void DaemonIpcClient::disconnectFromServer()
+void DaemonIpcClient::handleConnectionLost()
 {
-  m_state = State::Disconnecting;
-  qDebug() << "daemon ipc client disconnecting from server";
-  m_socket->disconnectFromServer();
+  // the socket may report one failure as both an error and a disconnect
+  if (m_state == State::Unconnected || m_retryTimer.isActive()) {
+    return;
+  }
+
+  m_replyTimer.stop();
+  m_pending.remove(m_helloId);
+  {
+    // handled here, not again through disconnected()
+    const QSignalBlocker blocker(m_socket);
+    m_socket->abort();
+  }
 
-  if (m_socket->state() != QLocalSocket::UnconnectedState) {
-    qDebug() << "daemon ipc client waiting for socket to disconnect";
-    m_socket->waitForDisconnected(kTimeout);
-    qDebug() << "daemon ipc client disconnected from server";
+  if (m_state == State::Connecting) {
+    if (++m_attempts < kRetryLimit) {
+      qWarning() << "daemon ipc client failed to connect";
+      m_retryTimer.start();
+      return;
+    }
+    qWarning() << "daemon ipc client failed to connect after" << kRetryLimit << "attempts";
   } else {
-    qDebug() << "daemon ipc client socket already disconnected";
+    qWarning() << "daemon ipc client lost connection to server";
   }
 
+  // requests already written may or may not have run, their callers have to assume not
   m_state = State::Unconnected;
+  failPending();
+  Q_EMIT connectionFailed();
 }
 
-void DaemonIpcClient::handleDisconnected()
+void DaemonIpcClient::handleReadyRead()
 {
-  qDebug() << "daemon ipc client disconnected from server";
-  if (m_state == State::Connected) {
-    Q_EMIT connectionFailed();
+  m_reader.append(m_socket->readAll());
+  while (const auto message = m_reader.next()) {
+    handleMessage(*message);
   }
 
-  m_state = State::Unconnected;
+  if (m_reader.hasError()) {
+    qWarning() << "daemon ipc client got an oversized frame";
+    handleConnectionLost();
+  }
 }
 
-void DaemonIpcClient::handleErrorOccurred()
+void DaemonIpcClient::handleMessage(const QByteArray &message)
 {
-  qWarning() << "daemon ipc client error:" << m_socket->errorString();
-  disconnectFromServer();
+  const auto object = QJsonDocument::fromJson(message).object();
 
-  if (m_state == State::Connected) {
-    Q_EMIT connectionFailed();
+  if (const auto log = object.value("log"); log.isArray()) {
+    QStringList lines;
+    for (const auto &line : log.toArray()) {
+      lines.append(line.toString());
+    }
+    Q_EMIT logLines(lines);
+    return;
   }
-}
 
-bool DaemonIpcClient::sendMessage(const QString &message, const QString &expectAck, const bool expectConnected)
-{
-  if (expectConnected && !isConnected()) {
-    qWarning() << "cannot send command, ipc client not connected";
-    return false;
+  const auto id = static_cast<quint32>(object.value("id").toInteger());
+  const auto it = m_pending.find(id);
+  if (it == m_pending.end()) {
+    qWarning() << "daemon ipc client got reply to unknown request:" << id;
+    return;
   }
 
-  QByteArray messageData = message.toUtf8() + "\n";
-  m_socket->write(messageData);
-  if (!m_socket->waitForBytesWritten(kTimeout)) {
-    qWarning() << "daemon ipc client failed to write command";
-    return false;
+  const auto reply = it.value();
+  m_pending.erase(it);
+  if (m_pending.isEmpty()) {
+    m_replyTimer.stop();
+  } else {
+    m_replyTimer.start();
   }
 
-  if (!expectAck.isEmpty()) {
-    qDebug() << "daemon ipc client waiting for ack: " << expectAck;
-
-    if (!m_socket->waitForReadyRead(kTimeout)) {
-      qWarning() << "daemon ipc client socket ready read timed out";
-      return false;
-    }
-
-    QByteArray response = m_socket->readAll();
-    if (response.isEmpty()) {
-      qWarning() << "daemon ipc client got empty response";
-      return false;
-    }
-
-    QString responseData = QString::fromUtf8(response);
-    if (responseData.isEmpty()) {
-      qWarning() << "daemon ipc client failed to convert response to string";
-      return false;
-    }
-
-    if (responseData != expectAck + "\n") {
-      qWarning() << "daemon ipc client got unexpected response: " << responseData;
-      return false;
-    }
+  const auto ok = object.value("ok").toBool();
+  if (!ok) {
+    qWarning() << "daemon ipc client request failed:" << id;
+  }
+  if (reply) {
+    reply(ok, object.value("value").toString());
   }
-
-  qDebug() << "daemon ipc client sent message: " << messageData;
-  return true;
 }
 
-bool DaemonIpcClient::keepAlive()
+void DaemonIpcClient::sendRequest(const QString &command, const QString &value, const Reply &reply)
 {
-  if (!isConnected() && !connectToServer()) {
-    qWarning() << "daemon ipc client keep alive failed to connect";
-    return false;
+  const auto id = m_nextId++;
+  QJsonObject request{{"id", static_cast<qint64>(id)}, {"command", command}};
+  if (!value.isEmpty()) {
+    request.insert("value", value);
   }
 
-  if (!sendMessage("noop")) {
-    qWarning() << "daemon ipc client keep alive ping failed, reconnecting";
-    connectToServer();
-    return false;
+  qDebug() << "daemon ipc client sending:" << command;
+  m_pending.insert(id, reply);
+  const auto frame = encodeFrame(QJsonDocument(request).toJson(QJsonDocument::Compact));
+  if (m_state == State::Connected) {
+    write(frame);
+    return;
   }
 
-  return true;
+  m_outbox.append(frame);
+  if (m_state == State::Unconnected) {
+    connectToServer();
+  }
 }
 
-bool DaemonIpcClient::sendLogLevel(const QString &logLevel)
+void DaemonIpcClient::write(const QByteArray &frame)
 {
-  if (!keepAlive())
-    return false;
-
-  sendMessage("logLevel=" + logLevel);
-  return true;
+  if (m_socket->write(frame) != frame.size()) {
+    qWarning() << "daemon ipc client failed to write request";
+  }
+  if (!m_replyTimer.isActive()) {
+    m_replyTimer.start();
+  }
 }
 
-bool DaemonIpcClient::sendStartProcess(const QString &command, bool elevate)
+void DaemonIpcClient::failPending()
 {
-  if (!keepAlive())
-    return false;
-
-  if (!sendMessage("elevate=" + (elevate ? QStringLiteral("yes") : QStringLiteral("no")))) {
-    return false;
-  }
-
-  if (!sendMessage("command=" + command)) {
-    return false;
+  // callers may send again from their reply, so detach everything first
+  m_outbox.clear();
+  const auto pending = std::exchange(m_pending, {});
+  for (const auto &reply : pending) {
+    if (reply) {
+      reply(false, {});
+    }
   }
-
-  return sendMessage("start");
 }
 
-bool DaemonIpcClient::sendStopProcess()
+void DaemonIpcClient::sendLogLevel(const QString &logLevel, const Reply &reply)
 {
-  return sendMessage("stop");
+  sendRequest("logLevel", logLevel, reply);
 }
 
-QString DaemonIpcClient::requestLogPath()
+void DaemonIpcClient::sendStartProcess(const QString &command, bool elevate, const Reply &reply)
 {
-  if (!keepAlive())
-    return QString();
-
-  if (!sendMessage("logPath", QString())) {
-    return QString();
-  }
-
-  if (!m_socket->waitForReadyRead(kTimeout)) {
-    qWarning() << "daemon ipc client failed to read log path response";
-    return QString();
-  }
-
-  QByteArray response = m_socket->readAll();
-  if (response.isEmpty()) {
-    qWarning() << "daemon ipc client got empty log path response";
-    return QString();
-  }
-
-  QString responseData = QString::fromUtf8(response);
-  if (responseData.isEmpty()) {
-    qWarning() << "daemon ipc client failed to convert log path response to string";
-    return QString();
-  }
-
-  // Trimming removes newline from end of message.
-  QStringList parts = responseData.trimmed().split("=");
-  if (parts.size() != 2) {
-    qWarning() << "daemon ipc client got invalid log path response: " << responseData;
-    return QString();
-  }
+  // pipelined, the daemon handles them in order
+  sendRequest("elevate", elevate ? QStringLiteral("yes") : QStringLiteral("no"));
+  sendRequest("command", command);
+  sendRequest("start", {}, reply);
+}
 
-  if (parts[0] != "logPath") {
-    qWarning() << "daemon ipc client got unexpected log path response: " << responseData;
-    return QString();
-  }
+void DaemonIpcClient::sendStopProcess(const Reply &reply)
+{
+  sendRequest("stop", {}, reply);
+}
 
-  return parts[1];
+void DaemonIpcClient::sendClearSettings(const Reply &reply)
+{
+  sendRequest("clearSettings", {}, reply);
 }
 
-bool DaemonIpcClient::sendClearSettings()
+void DaemonIpcClient::subscribeLog(const Reply &reply)
 {
-  return sendMessage("clearSettings");
+  sendRequest("subscribeLog", {}, reply);
 }
 
 } // namespace deskflow::gui::ipc
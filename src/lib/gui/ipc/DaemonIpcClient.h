@@ -6,12 +6,26 @@
 
 #pragma once
 
+#include "common/IpcFrame.h"
+
+#include <QByteArrayList>
+#include <QMap>
 #include <QObject>
+#include <QTimer>
+
+#include <functional>
 
 class QLocalSocket;
 
 namespace deskflow::gui::ipc {
 
+/**
+ * @brief Sends requests to the daemon without blocking the GUI
+ *
+ * Requests are framed and tagged with an id (see DaemonIpcServer), so they
+ * are written straight away and the replies are matched as they arrive.
+ * Requests made while not connected are held until the daemon says hello.
+ */
 class DaemonIpcClient : public QObject
 {
   Q_OBJECT
@@ -22,18 +36,26 @@ class DaemonIpcClient : public QObject
     Unconnected,
     Connecting,
     Connected,
-    Disconnecting,
   };
 
 public:
+  /**
+   * @brief Called with the daemon's answer, or with false if it never came
+   */
+  using Reply = std::function<void(bool ok, const QString &value)>;
+
   explicit DaemonIpcClient(QObject *parent = nullptr);
-  bool connectToServer();
+  void connectToServer();
   void disconnectFromServer();
-  bool sendLogLevel(const QString &logLevel);
-  bool sendStartProcess(const QString &command, bool elevate);
-  bool sendStopProcess();
-  bool sendClearSettings();
-  QString requestLogPath();
+  void sendLogLevel(const QString &logLevel, const Reply &reply = {});
+  void sendStartProcess(const QString &command, bool elevate, const Reply &reply = {});
+  void sendStopProcess(const Reply &reply = {});
+  void sendClearSettings(const Reply &reply = {});
+
+  /**
+   * @brief Ask the daemon to push its log lines, which arrive as logLines()
+   */
+  void subscribeLog(const Reply &reply = {});
 
   bool isConnected() const
   {
@@ -43,18 +65,31 @@ public:
 Q_SIGNALS:
   void connected();
   void connectionFailed();
+  void logLines(const QStringList &lines);
 
 private Q_SLOTS:
-  void handleDisconnected();
-  void handleErrorOccurred();
+  void handleConnected();
+  void handleReadyRead();
+  void handleConnectionLost();
+  void attemptConnection();
 
 private:
-  bool keepAlive();
-  bool sendMessage(const QString &message, const QString &expectAck = "ok", const bool expectConnected = true);
+  void sendRequest(const QString &command, const QString &value = {}, const Reply &reply = {});
+  void write(const QByteArray &frame);
+  void handleMessage(const QByteArray &message);
+  void failPending();
 
 private:
   QLocalSocket *m_socket;
   State m_state{State::Unconnected};
+  int m_attempts = 0;
+  quint32 m_nextId = 1;
+  quint32 m_helloId = 0;
+  deskflow::ipc::FrameReader m_reader;
+  QMap<quint32, Reply> m_pending;
+  QByteArrayList m_outbox;
+  QTimer m_replyTimer;
+  QTimer m_retryTimer;
 };
 
 } // namespace deskflow::gui::ipc
@@ -57,9 +57,9 @@ LogDock::LogDock(QWidget *parent)
   setAllowedAreas(Qt::BottomDockWidgetArea);
 }
 
-void LogDock::appendLine(const QString &msg)
+void LogDock::appendLines(const QStringList &lines)
 {
-  m_textLog->appendLine(msg);
+  m_textLog->appendLines(lines);
 }
 
 void LogDock::setFloating(bool floating)
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <QDockWidget>
+#include <QStringList>
 
 class LogWidget;
 class QLabel;
@@ -17,7 +18,7 @@ class LogDock : public QDockWidget
   Q_OBJECT
 public:
   explicit LogDock(QWidget *parent = nullptr);
-  void appendLine(const QString &msg);
+  void appendLines(const QStringList &lines);
   void setFloating(bool floating);
 
 protected:
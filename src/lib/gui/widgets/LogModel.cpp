@@ -0,0 +1,206 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "LogModel.h"
+
+#include <QPromise>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <memory>
+
+LogModel::LogModel(QObject *parent, qsizetype capacity)
+    : QAbstractListModel{parent},
+      m_capacity{std::max<qsizetype>(capacity, 1)}
+{
+  m_lines.resize(m_capacity);
+
+  m_flushTimer.setSingleShot(true);
+  m_flushTimer.setInterval(kFlushInterval);
+  connect(&m_flushTimer, &QTimer::timeout, this, &LogModel::flush);
+  connect(&m_filterWatcher, &QFutureWatcher<FilterResult>::finished, this, &LogModel::applyFilterResult);
+}
+
+int LogModel::rowCount(const QModelIndex &parent) const
+{
+  if (parent.isValid())
+    return 0;
+  return static_cast<int>(m_filter.isEmpty() ? m_size : static_cast<qsizetype>(m_matches.size()));
+}
+
+QVariant LogModel::data(const QModelIndex &index, int role) const
+{
+  if (role != Qt::DisplayRole || !index.isValid() || index.row() >= rowCount())
+    return {};
+
+  const auto row = static_cast<size_t>(index.row());
+  return lineAt(m_filter.isEmpty() ? firstSequence() + row : m_matches.at(row));
+}
+
+void LogModel::appendLines(const QStringList &lines)
+{
+  for (const auto &line : lines) {
+    m_pending.append(line.split(QLatin1Char('\n')));
+  }
+
+  // lines that would be evicted by this same flush are never shown
+  if (m_pending.size() > m_capacity) {
+    m_pending.remove(0, m_pending.size() - m_capacity);
+  }
+
+  if (!m_flushTimer.isActive())
+    m_flushTimer.start();
+}
+
+void LogModel::appendLine(const QString &line)
+{
+  appendLines({line});
+}
+
+void LogModel::flush()
+{
+  m_flushTimer.stop();
+  if (m_pending.isEmpty())
+    return;
+
+  const auto batch = std::exchange(m_pending, {});
+  evict(m_size + batch.size() - m_capacity);
+
+  const auto store = [this](const QString &line) {
+    m_lines[(m_head + m_size) % m_capacity] = line;
+    ++m_size;
+    ++m_next;
+  };
+
+  if (m_filter.isEmpty()) {
+    beginInsertRows({}, static_cast<int>(m_size), static_cast<int>(m_size + batch.size() - 1));
+    std::ranges::for_each(batch, store);
+    endInsertRows();
+  } else {
+    QList<uint64_t> matched;
+    for (qsizetype i = 0; i < batch.size(); ++i) {
+      if (matches(batch.at(i), m_filter))
+        matched.append(m_next + static_cast<uint64_t>(i));
+    }
+
+    if (!matched.isEmpty()) {
+      const auto row = static_cast<int>(m_matches.size());
+      beginInsertRows({}, row, row + static_cast<int>(matched.size()) - 1);
+    }
+    std::ranges::for_each(batch, store);
+    m_matches.insert(m_matches.end(), matched.cbegin(), matched.cend());
+    if (!matched.isEmpty())
+      endInsertRows();
+  }
+
+  Q_EMIT flushed();
+}
+
+void LogModel::setFilter(const QString &filter)
+{
+  if (filter == m_pendingFilter)
+    return;
+
+  m_pendingFilter = filter;
+  flush();
+
+  if (filter.isEmpty()) {
+    beginResetModel();
+    m_filter.clear();
+    m_matches.clear();
+    m_filtering = false;
+    endResetModel();
+    Q_EMIT filterApplied();
+    return;
+  }
+
+  // the strings are shared, copying them only touches reference counts
+  QStringList snapshot;
+  snapshot.reserve(m_size);
+  for (auto sequence = firstSequence(); sequence < m_next; ++sequence) {
+    snapshot.append(lineAt(sequence));
+  }
+
+  auto promise = std::make_shared<QPromise<FilterResult>>();
+  m_filterWatcher.setFuture(promise->future());
+  m_filtering = true;
+
+  QThreadPool::globalInstance()->start([promise, snapshot, filter, first = firstSequence(), end = m_next] {
+    promise->start();
+    FilterResult result{filter, first, end, {}};
+    for (qsizetype i = 0; i < snapshot.size(); ++i) {
+      if (matches(snapshot.at(i), filter))
+        result.matches.append(i);
+    }
+    promise->addResult(std::move(result));
+    promise->finish();
+  });
+}
+
+const QString &LogModel::lineAt(uint64_t sequence) const
+{
+  const auto offset = static_cast<qsizetype>(sequence - firstSequence());
+  return m_lines.at((m_head + offset) % m_capacity);
+}
+
+void LogModel::evict(qsizetype count)
+{
+  count = std::min(count, m_size);
+  if (count <= 0)
+    return;
+
+  auto rows = count;
+  if (!m_filter.isEmpty()) {
+    const auto end = firstSequence() + static_cast<uint64_t>(count);
+    rows = std::ranges::lower_bound(m_matches, end) - m_matches.begin();
+  }
+
+  if (rows > 0)
+    beginRemoveRows({}, 0, static_cast<int>(rows - 1));
+
+  for (qsizetype i = 0; i < count; ++i) {
+    m_lines[(m_head + i) % m_capacity] = QString();
+  }
+  m_head = (m_head + count) % m_capacity;
+  m_size -= count;
+
+  if (!m_filter.isEmpty())
+    m_matches.erase(m_matches.begin(), m_matches.begin() + rows);
+
+  if (rows > 0)
+    endRemoveRows();
+}
+
+void LogModel::applyFilterResult()
+{
+  if (m_filterWatcher.future().resultCount() == 0)
+    return;
+
+  // a newer filter was set while this one was matched
+  const auto result = m_filterWatcher.result();
+  if (result.filter != m_pendingFilter)
+    return;
+
+  beginResetModel();
+  m_filter = result.filter;
+  m_matches.clear();
+
+  // drop matches evicted meanwhile and match the lines added meanwhile
+  const auto first = firstSequence();
+  for (const auto index : result.matches) {
+    const auto sequence = result.first + static_cast<uint64_t>(index);
+    if (sequence >= first)
+      m_matches.push_back(sequence);
+  }
+  for (auto sequence = std::max(first, result.end); sequence < m_next; ++sequence) {
+    if (matches(lineAt(sequence), m_filter))
+      m_matches.push_back(sequence);
+  }
+
+  m_filtering = false;
+  endResetModel();
+  Q_EMIT filterApplied();
+}
@@ -0,0 +1,107 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <QAbstractListModel>
+#include <QFutureWatcher>
+#include <QStringList>
+#include <QTimer>
+
+#include <deque>
+
+/**
+ * @brief Ring buffer of log lines shown by the log view
+ *
+ * Lines are queued by appendLines() and added to the model in one batch per
+ * flush interval, so a chatty core costs one row insertion per frame rather
+ * than one per line. When full, the oldest lines are dropped.
+ *
+ * Changing the filter matches the whole buffer on the thread pool; until the
+ * result arrives the previous filter stays in effect.
+ */
+class LogModel : public QAbstractListModel
+{
+  Q_OBJECT
+public:
+  inline static const qsizetype kDefaultCapacity = 10000;
+  inline static const int kFlushInterval = 33;
+
+  explicit LogModel(QObject *parent = nullptr, qsizetype capacity = kDefaultCapacity);
+  ~LogModel() override = default;
+
+  int rowCount(const QModelIndex &parent = {}) const override;
+  QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+  /**
+   * @brief Queue lines for the next flush, multi line entries become one row per line
+   */
+  void appendLines(const QStringList &lines);
+  void appendLine(const QString &line);
+
+  /**
+   * @brief Add all queued lines to the model now
+   */
+  void flush();
+
+  /**
+   * @brief Only show lines containing @p filter, ignoring case
+   */
+  void setFilter(const QString &filter);
+
+  QString filter() const
+  {
+    return m_filter;
+  }
+  qsizetype capacity() const
+  {
+    return m_capacity;
+  }
+  bool isFiltering() const
+  {
+    return m_filtering;
+  }
+
+Q_SIGNALS:
+  void flushed();
+  void filterApplied();
+
+private:
+  struct FilterResult
+  {
+    QString filter;
+    uint64_t first = 0;
+    uint64_t end = 0;
+    QList<qsizetype> matches;
+  };
+
+  const QString &lineAt(uint64_t sequence) const;
+  uint64_t firstSequence() const
+  {
+    return m_next - static_cast<uint64_t>(m_size);
+  }
+  static bool matches(const QString &line, const QString &filter)
+  {
+    return line.contains(filter, Qt::CaseInsensitive);
+  }
+  void evict(qsizetype count);
+  void applyFilterResult();
+
+  qsizetype m_capacity;
+  QList<QString> m_lines;
+  qsizetype m_head = 0;
+  qsizetype m_size = 0;
+  uint64_t m_next = 0;
+
+  QStringList m_pending;
+  QTimer m_flushTimer;
+
+  QString m_filter;
+  QString m_pendingFilter;
+  bool m_filtering = false;
+  std::deque<uint64_t> m_matches;
+  QFutureWatcher<FilterResult> m_filterWatcher;
+};
@@ -5,39 +5,98 @@
  */
 
 #include "LogWidget.h"
+#include "LogModel.h"
 #include "common/PlatformInfo.h"
 
 #include <gui/Logger.h>
 
-#include <QPlainTextEdit>
+#include <QAction>
+#include <QClipboard>
+#include <QEvent>
+#include <QGuiApplication>
+#include <QLineEdit>
+#include <QListView>
+#include <QScrollBar>
 #include <QVBoxLayout>
 
-LogWidget::LogWidget(QWidget *parent) : QWidget{parent}, m_textLog{new QPlainTextEdit(this)}
+#include <algorithm>
+
+LogWidget::LogWidget(QWidget *parent)
+    : QWidget{parent},
+      m_model{new LogModel(this)},
+      m_view{new QListView(this)},
+      m_filter{new QLineEdit(this)}
 {
-  m_textLog->setReadOnly(true);
-  m_textLog->setMaximumBlockCount(10000);
-  m_textLog->setLineWrapMode(QPlainTextEdit::NoWrap);
+  // rows are laid out lazily, only the visible ones are ever measured or painted
+  m_view->setModel(m_model);
+  m_view->setUniformItemSizes(true);
+  m_view->setLayoutMode(QListView::Batched);
+  m_view->setSelectionMode(QAbstractItemView::ExtendedSelection);
+  m_view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+  m_view->setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+  m_view->setTextElideMode(Qt::ElideNone);
 
   // setup the log font
-  m_textLog->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+  m_view->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
   if (deskflow::platform::isMac()) {
-    auto f = m_textLog->font();
+    auto f = m_view->font();
     f.setPixelSize(12);
-    m_textLog->setFont(f);
+    m_view->setFont(f);
   }
 
+  m_filter->setPlaceholderText(tr("Filter"));
+  m_filter->setClearButtonEnabled(true);
+  connect(m_filter, &QLineEdit::textChanged, m_model, &LogModel::setFilter);
+
+  auto copyAction = new QAction(this);
+  copyAction->setShortcut(QKeySequence::Copy);
+  copyAction->setShortcutContext(Qt::WidgetShortcut);
+  connect(copyAction, &QAction::triggered, this, &LogWidget::copySelection);
+  m_view->addAction(copyAction);
+
+  // keep showing new lines unless the user scrolled away from the bottom
+  auto scrollBar = m_view->verticalScrollBar();
+  connect(scrollBar, &QScrollBar::valueChanged, this, [this, scrollBar](int value) {
+    m_followTail = value == scrollBar->maximum();
+  });
+  connect(scrollBar, &QScrollBar::rangeChanged, this, [this] {
+    if (m_followTail)
+      m_view->scrollToBottom();
+  });
+
   auto layout = new QVBoxLayout;
   layout->setContentsMargins(0, 0, 0, 0);
-  layout->addWidget(m_textLog);
+  layout->addWidget(m_filter);
+  layout->addWidget(m_view);
 
   setLayout(layout);
 
-  connect(
-      deskflow::gui::Logger::instance(), &deskflow::gui::Logger::newLine, m_textLog, &QPlainTextEdit::appendPlainText
-  );
+  connect(deskflow::gui::Logger::instance(), &deskflow::gui::Logger::newLine, m_model, &LogModel::appendLine);
+}
+
+void LogWidget::appendLines(const QStringList &lines)
+{
+  m_model->appendLines(lines);
+}
+
+void LogWidget::changeEvent(QEvent *e)
+{
+  QWidget::changeEvent(e);
+  if (e->type() == QEvent::LanguageChange)
+    m_filter->setPlaceholderText(tr("Filter"));
 }
 
-void LogWidget::appendLine(const QString &msg)
+void LogWidget::copySelection() const
 {
-  m_textLog->appendPlainText(msg);
+  auto rows = m_view->selectionModel()->selectedRows();
+  if (rows.isEmpty())
+    return;
+
+  std::ranges::sort(rows, {}, &QModelIndex::row);
+  QStringList lines;
+  lines.reserve(rows.size());
+  for (const auto &index : std::as_const(rows)) {
+    lines.append(index.data().toString());
+  }
+  QGuiApplication::clipboard()->setText(lines.join(QLatin1Char('\n')));
 }
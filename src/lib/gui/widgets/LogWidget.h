@@ -7,18 +7,28 @@
 #pragma once
 
 #include <QObject>
+#include <QStringList>
 #include <QWidget>
 
-class QPlainTextEdit;
-class QTemporaryFile;
+class LogModel;
+class QLineEdit;
+class QListView;
 
 class LogWidget : public QWidget
 {
   Q_OBJECT
 public:
   explicit LogWidget(QWidget *parent = nullptr);
-  void appendLine(const QString &msg);
+  void appendLines(const QStringList &lines);
+
+protected:
+  void changeEvent(QEvent *e) override;
 
 private:
-  QPlainTextEdit *m_textLog = nullptr;
+  void copySelection() const;
+
+  LogModel *m_model = nullptr;
+  QListView *m_view = nullptr;
+  QLineEdit *m_filter = nullptr;
+  bool m_followTail = true;
 };
@@ -31,6 +31,11 @@ StreamFilter::~StreamFilter()
   }
 }
 
+void StreamFilter::adoptStream()
+{
+  m_adopted = true;
+}
+
 void StreamFilter::close()
 {
   getStream()->close();
@@ -51,6 +51,13 @@ public:
   */
   deskflow::IStream *getStream() const;
 
+  //! Take ownership of the stream
+  /*!
+  Makes the d'tor delete the stream passed to the c'tor, for a stream
+  that was not adopted when this object was created.
+  */
+  void adoptStream();
+
 protected:
   //! Handle events from source stream
   /*!
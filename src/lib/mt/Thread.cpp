@@ -70,6 +70,16 @@ void Thread::setPriority(int n)
   ARCH->setPriorityOfThread(m_thread, n);
 }
 
+bool Thread::setScheduling(IArchMultithread::SchedulingPolicy policy, int priority)
+{
+  return ARCH->setSchedulingOfThread(m_thread, policy, priority);
+}
+
+bool Thread::setAffinity(const std::vector<int> &cpus)
+{
+  return ARCH->setAffinityOfThread(m_thread, cpus);
+}
+
 void Thread::unblockPollSocket()
 {
   ARCH->unblockPollSocket(m_thread);
@@ -103,6 +113,11 @@ IArchMultithread::ThreadID Thread::getID() const
   return ARCH->getIDOfThread(m_thread);
 }
 
+std::string Thread::getScheduling() const
+{
+  return ARCH->getSchedulingOfThread(m_thread);
+}
+
 bool Thread::operator==(const Thread &thread) const
 {
   return ARCH->isSameThread(m_thread, thread.m_thread);
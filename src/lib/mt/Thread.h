@@ -116,6 +116,21 @@ public:
   */
   void setPriority(int n);
 
+  //! Change thread scheduling policy
+  /*!
+  Switch the thread to a real-time scheduling \c policy at \c priority.
+  Returns false if the policy was refused, in which case the thread
+  may have received a smaller time-sharing boost instead.
+  */
+  bool setScheduling(IArchMultithread::SchedulingPolicy policy, int priority);
+
+  //! Pin thread to CPUs
+  /*!
+  Restrict the thread to the given CPU indices.  An empty list removes
+  the restriction.  Returns false if the platform refused.
+  */
+  bool setAffinity(const std::vector<int> &cpus);
+
   //! Force pollSocket() to return
   /*!
   Forces a currently blocked pollSocket() in the thread to return
@@ -175,6 +190,13 @@ public:
   */
   IArchMultithread::ThreadID getID() const;
 
+  //! Describe thread scheduling
+  /*!
+  Returns a description of the scheduling policy, priority and CPU
+  affinity in effect for this thread, for diagnostics.
+  */
+  std::string getScheduling() const;
+
   //! Compare thread handles
   /*!
   Returns true if two Thread objects refer to the same thread.
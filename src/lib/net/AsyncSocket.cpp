@@ -0,0 +1,301 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "net/AsyncSocket.h"
+
+#include "arch/Arch.h"
+#include "arch/ArchException.h"
+#include "base/Log.h"
+#include "io/IOException.h"
+#include "net/ISocketMultiplexerJob.h"
+#include "net/NetworkAddress.h"
+#include "net/SocketException.h"
+#include "net/SocketMultiplexer.h"
+
+#include <cassert>
+
+namespace {
+
+//! One-shot job that resumes a coroutine waiting on a socket
+class ResumeJob : public ISocketMultiplexerJob
+{
+public:
+  ResumeJob(
+      IEventQueue *events, ArchSocket socket, bool readable, bool writable, bool &error,
+      std::coroutine_handle<> handle, std::atomic<bool> &resuming
+  )
+      : m_events(events),
+        m_socket(socket),
+        m_readable(readable),
+        m_writable(writable),
+        m_error(error),
+        m_handle(handle),
+        m_resuming(resuming)
+  {
+    // do nothing
+  }
+
+  // ISocketMultiplexerJob overrides
+  ISocketMultiplexerJob *run(bool, bool, bool error) override
+  {
+    // runs on the multiplexer thread, so hand the coroutine back to the
+    // event queue rather than resuming it here.  returning nullptr stops
+    // the multiplexer polling the socket until the next await.
+    if (!m_resuming.exchange(true)) {
+      m_error = error;
+      deskflow::resumeOnEventQueue(m_events, m_handle);
+    }
+    return nullptr;
+  }
+  ArchSocket getSocket() const override
+  {
+    return m_socket;
+  }
+  bool isReadable() const override
+  {
+    return m_readable;
+  }
+  bool isWritable() const override
+  {
+    return m_writable;
+  }
+
+private:
+  IEventQueue *m_events;
+  ArchSocket m_socket;
+  bool m_readable;
+  bool m_writable;
+  bool &m_error;
+  std::coroutine_handle<> m_handle;
+  std::atomic<bool> &m_resuming;
+};
+
+} // namespace
+
+//
+// AsyncSocket::ReadyAwaiter
+//
+
+AsyncSocket::ReadyAwaiter::ReadyAwaiter(AsyncSocket &socket, bool readable, bool writable)
+    : m_socket(socket),
+      m_readable(readable),
+      m_writable(writable)
+{
+  // do nothing
+}
+
+AsyncSocket::ReadyAwaiter::~ReadyAwaiter()
+{
+  // destroyed with its coroutine while still waiting, so the job must not
+  // resume it.  a closed socket has already let go and may be gone.
+  if (!m_closed && m_socket.m_awaiter == this) {
+    m_socket.m_socketMultiplexer->removeSocket(&m_socket);
+    m_socket.m_awaiter = nullptr;
+  }
+}
+
+void AsyncSocket::ReadyAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+  m_socket.await(*this, handle);
+}
+
+bool AsyncSocket::ReadyAwaiter::await_resume()
+{
+  // the socket may be gone, so don't touch it
+  if (m_closed) {
+    throw IOClosedException();
+  }
+  m_socket.m_awaiter = nullptr;
+  return !m_error;
+}
+
+//
+// AsyncSocket
+//
+
+AsyncSocket::AsyncSocket(IEventQueue *events, SocketMultiplexer *socketMultiplexer, IArchNetwork::AddressFamily family)
+    : m_events(events),
+      m_socketMultiplexer(socketMultiplexer)
+{
+  try {
+    m_socket = ARCH->newSocket(family, IArchNetwork::SocketType::Stream);
+  } catch (const ArchNetworkException &e) {
+    throw SocketCreateException(e.what());
+  }
+
+  LOG_DEBUG("opening new async socket: %08X", m_socket);
+}
+
+AsyncSocket::AsyncSocket(IEventQueue *events, SocketMultiplexer *socketMultiplexer, ArchSocket socket)
+    : m_socket(socket),
+      m_events(events),
+      m_socketMultiplexer(socketMultiplexer)
+{
+  assert(m_socket != nullptr);
+}
+
+AsyncSocket::~AsyncSocket()
+{
+  try {
+    close();
+  } catch (...) {
+    // ignore
+  }
+}
+
+AsyncSocket::ReadyAwaiter AsyncSocket::readable()
+{
+  return ReadyAwaiter(*this, true, false);
+}
+
+AsyncSocket::ReadyAwaiter AsyncSocket::writable()
+{
+  return ReadyAwaiter(*this, false, true);
+}
+
+void AsyncSocket::listen()
+{
+  try {
+    ARCH->listenOnSocket(m_socket);
+  } catch (const ArchNetworkException &e) {
+    throw SocketBindException(e.what());
+  }
+}
+
+deskflow::Task<ArchSocket> AsyncSocket::accept()
+{
+  for (;;) {
+    if (ArchSocket socket = ARCH->acceptSocket(m_socket, nullptr); socket != nullptr) {
+      co_return socket;
+    }
+    co_await readable();
+  }
+}
+
+deskflow::Task<> AsyncSocket::connect(const NetworkAddress &address)
+{
+  try {
+    if (ARCH->connectSocket(m_socket, address.getAddress())) {
+      co_return;
+    }
+  } catch (const ArchNetworkException &e) {
+    throw SocketConnectException(e.what());
+  }
+
+  // connection is in progress, it has finished when the socket is writable
+  const bool ok = co_await writable();
+  try {
+    ARCH->throwErrorOnSocket(m_socket);
+  } catch (const ArchNetworkException &e) {
+    throw SocketConnectException(e.what());
+  }
+  if (!ok) {
+    throw SocketConnectException("socket error while connecting");
+  }
+}
+
+deskflow::Task<AsyncSocket::ReadResult> AsyncSocket::read(std::span<uint8_t> buffer)
+{
+  if (buffer.empty()) {
+    co_return ReadResult{};
+  }
+
+  for (;;) {
+    if (!co_await readable()) {
+      ARCH->throwErrorOnSocket(m_socket);
+    }
+    if (const size_t n = ARCH->readSocket(m_socket, buffer.data(), buffer.size()); n > 0) {
+      co_return ReadResult{n};
+    }
+
+    // reading nothing is either the end of the stream or a spurious wakeup
+    // where the read would block.  only a socket that still polls readable
+    // has ended, and then a second read gets any data that came meanwhile.
+    if (pollReadable()) {
+      const size_t n = ARCH->readSocket(m_socket, buffer.data(), buffer.size());
+      co_return n > 0 ? ReadResult{n} : ReadResult{0, true};
+    }
+  }
+}
+
+deskflow::Task<> AsyncSocket::write(std::span<const uint8_t> data)
+{
+  while (!data.empty()) {
+    const size_t n = ARCH->writeSocket(m_socket, data.data(), data.size());
+    data = data.subspan(n);
+    if (n == 0 && !co_await writable()) {
+      ARCH->throwErrorOnSocket(m_socket);
+    }
+  }
+}
+
+void AsyncSocket::bind(const NetworkAddress &addr)
+{
+  try {
+    ARCH->bindSocket(m_socket, addr.getAddress());
+  } catch (const ArchNetworkAddressInUseException &e) {
+    throw SocketAddressInUseException(e.what());
+  } catch (const ArchNetworkException &e) {
+    throw SocketBindException(e.what());
+  }
+}
+
+void AsyncSocket::close()
+{
+  if (m_socket == nullptr) {
+    return;
+  }
+
+  LOG_DEBUG("closing async socket: %08X", m_socket);
+
+  // drops any pending job, then the waiting coroutine gets an error
+  m_socketMultiplexer->removeSocket(this);
+  if (m_awaiter != nullptr) {
+    m_awaiter->m_closed = true;
+    if (!m_resuming.exchange(true)) {
+      deskflow::resumeOnEventQueue(m_events, m_awaiter->m_handle);
+    }
+    m_awaiter = nullptr;
+  }
+
+  ArchSocket socket = m_socket;
+  m_socket = nullptr;
+  try {
+    ARCH->closeSocket(socket);
+  } catch (const ArchNetworkException &e) {
+    // ignore, there's not much we can do
+    LOG_WARN("error closing socket: %s", e.what());
+  }
+}
+
+void *AsyncSocket::getEventTarget() const
+{
+  return const_cast<void *>(static_cast<const void *>(this));
+}
+
+void AsyncSocket::await(ReadyAwaiter &awaiter, std::coroutine_handle<> handle)
+{
+  awaiter.m_error = false;
+  awaiter.m_handle = handle;
+  if (m_socket == nullptr) {
+    awaiter.m_closed = true;
+    deskflow::resumeOnEventQueue(m_events, handle);
+    return;
+  }
+
+  m_awaiter = &awaiter;
+  m_resuming = false;
+  m_socketMultiplexer->addSocket(
+      this,
+      new ResumeJob(m_events, m_socket, awaiter.m_readable, awaiter.m_writable, awaiter.m_error, handle, m_resuming)
+  );
+}
+
+bool AsyncSocket::pollReadable() const
+{
+  IArchNetwork::PollEntry entry{m_socket, static_cast<unsigned short>(IArchNetwork::PollEventMask::In), 0};
+  return ARCH->pollSocket(&entry, 1, 0.0) > 0 && (entry.m_revents & IArchNetwork::PollEventMask::In) != 0;
+}
@@ -0,0 +1,172 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "arch/IArchNetwork.h"
+#include "base/Task.h"
+#include "net/ISocket.h"
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <span>
+
+class IEventQueue;
+class SocketMultiplexer;
+
+//! Coroutine based socket
+/*!
+A TCP socket whose operations are awaited from a deskflow::Task instead
+of being driven by TSocketMultiplexerMethodJob state machines and socket
+events.  Each await registers a one-shot job with the socket multiplexer;
+when the multiplexer sees the socket become ready the awaiting coroutine
+is resumed on the event queue thread, so code after an \c co_await runs
+alongside ordinary event handlers and needs no extra locking.
+
+Only one operation may be awaited on a socket at a time.  Closing or
+destroying the socket while a coroutine is suspended on it resumes that
+coroutine with IOClosedException, and destroying the coroutine, e.g.
+with the event queue it was detached onto, stops its wait.  I/O errors
+from read() and write() propagate out of the task as
+ArchNetworkException.
+
+This is the awaitable layer only.  TCPSocket, the TLS handshake in
+SecureSocket and clipboard streaming deliberately stay on the multiplexer
+jobs: moving them changes the timing of every connection and is left to
+its own change.
+*/
+class AsyncSocket : public ISocket
+{
+public:
+  //! Awaitable that suspends until the socket is ready for I/O
+  class ReadyAwaiter
+  {
+  public:
+    ReadyAwaiter(AsyncSocket &socket, bool readable, bool writable);
+    ReadyAwaiter(ReadyAwaiter const &) = delete;
+    ReadyAwaiter(ReadyAwaiter &&) = delete;
+    ~ReadyAwaiter();
+
+    ReadyAwaiter &operator=(ReadyAwaiter const &) = delete;
+    ReadyAwaiter &operator=(ReadyAwaiter &&) = delete;
+
+    bool await_ready() const noexcept
+    {
+      return false;
+    }
+    void await_suspend(std::coroutine_handle<> handle);
+    //! Returns false if the multiplexer reported an error on the socket
+    /*!
+    Throws IOClosedException if the socket was closed meanwhile.
+    */
+    bool await_resume();
+
+  private:
+    friend class AsyncSocket;
+
+    AsyncSocket &m_socket;
+    bool m_readable;
+    bool m_writable;
+    bool m_error = false;
+    bool m_closed = false;
+    std::coroutine_handle<> m_handle;
+  };
+
+  //! Outcome of read()
+  struct ReadResult
+  {
+    size_t size = 0;  //!< Bytes read
+    bool eof = false; //!< The remote end closed the connection
+  };
+
+  AsyncSocket(
+      IEventQueue *events, SocketMultiplexer *socketMultiplexer,
+      IArchNetwork::AddressFamily family = IArchNetwork::AddressFamily::INet
+  );
+  AsyncSocket(IEventQueue *events, SocketMultiplexer *socketMultiplexer, ArchSocket socket);
+  AsyncSocket(AsyncSocket const &) = delete;
+  AsyncSocket(AsyncSocket &&) = delete;
+  ~AsyncSocket() override;
+
+  AsyncSocket &operator=(AsyncSocket const &) = delete;
+  AsyncSocket &operator=(AsyncSocket &&) = delete;
+
+  //! @name manipulators
+  //@{
+
+  //! Wait until the socket is readable
+  ReadyAwaiter readable();
+
+  //! Wait until the socket is writable
+  ReadyAwaiter writable();
+
+  //! Start listening
+  /*!
+  Listens for connections on the address given to bind().
+  */
+  void listen();
+
+  //! Accept a connection
+  /*!
+  Waits for and accepts an incoming connection on a listening socket.
+  The caller takes ownership of the returned socket, typically by
+  adopting it into a new AsyncSocket.
+  */
+  deskflow::Task<ArchSocket> accept();
+
+  //! Connect to a remote endpoint
+  /*!
+  Throws SocketConnectException if the connection cannot be established.
+  */
+  deskflow::Task<> connect(const NetworkAddress &address);
+
+  //! Read some data
+  /*!
+  Waits until data is available and reads at most \c buffer.size()
+  bytes into \p buffer.  Never returns before there is data or the
+  remote end closed the connection, which the result tells apart.
+  */
+  deskflow::Task<ReadResult> read(std::span<uint8_t> buffer);
+
+  //! Write all data
+  /*!
+  Writes every byte of \p data, waiting whenever the socket's send
+  buffer is full.  \p data must stay valid until the task completes.
+  */
+  deskflow::Task<> write(std::span<const uint8_t> data);
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Get the underlying socket
+  ArchSocket getSocket() const
+  {
+    return m_socket;
+  }
+
+  //@}
+
+  // ISocket overrides
+  void bind(const NetworkAddress &) override;
+  void close() override;
+  void *getEventTarget() const override;
+
+private:
+  void await(ReadyAwaiter &awaiter, std::coroutine_handle<> handle);
+  bool pollReadable() const;
+
+private:
+  ArchSocket m_socket = nullptr;
+  IEventQueue *m_events;
+  SocketMultiplexer *m_socketMultiplexer;
+
+  // the await in progress, and whether its coroutine is already on its way
+  // back to the event queue.  the flag is also set by the multiplexer thread.
+  ReadyAwaiter *m_awaiter = nullptr;
+  std::atomic<bool> m_resuming = false;
+};
@@ -40,7 +40,7 @@ std::unique_ptr<IDataSocket> SecureListenSocket::accept()
     setListeningJob();
 
     // default location of the TLS cert file in users dir
-    if (!secureSocket->loadCertificate(Settings::value(Settings::Security::Certificate).toString())) {
+    if (!secureSocket->loadCertificate(Settings::snapshot()->certificate)) {
       return nullptr;
     }
 
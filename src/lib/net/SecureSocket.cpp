@@ -9,8 +9,10 @@
 #include "SecureUtils.h"
 
 #include "arch/ArchException.h"
+#include "base/CoreStatus.h"
 #include "base/IEventQueue.h"
 #include "base/Log.h"
+#include "base/Trace.h"
 #include "common/Settings.h"
 #include "mt/Lock.h"
 #include "net/FingerprintDatabase.h"
@@ -22,6 +24,7 @@
 #include <cstring>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <openssl/err.h>
 #include <openssl/ssl.h>
 
@@ -219,6 +222,7 @@ TCPSocket::JobResult SecureSocket::doWrite()
 int SecureSocket::secureRead(void *buffer, int size, int &read)
 {
   std::scoped_lock ssl_lock{ssl_mutex_};
+  const TraceScope scope(TraceSpan::SecureRead, this, size);
 
   if (m_ssl->m_ssl != nullptr) {
     LOG_DEBUG2("reading secure socket");
@@ -246,6 +250,7 @@ int SecureSocket::secureRead(void *buffer, int size, int &read)
 int SecureSocket::secureWrite(const void *buffer, int size, int &wrote)
 {
   std::scoped_lock ssl_lock{ssl_mutex_};
+  const TraceScope scope(TraceSpan::SecureWrite, this, size);
 
   if (m_ssl->m_ssl != nullptr) {
     LOG_DEBUG2("writing secure socket: %p", this);
@@ -276,6 +281,22 @@ bool SecureSocket::isSecureReady() const
   return m_secureReady;
 }
 
+Fingerprint SecureSocket::getPeerFingerprint() const
+{
+  if (!m_secureReady) {
+    return {};
+  }
+
+  const auto cert = SSL_get_peer_certificate(m_ssl->m_ssl);
+  if (cert == nullptr) {
+    return {};
+  }
+
+  auto sha256 = deskflow::sslCertFingerprint(cert, QCryptographicHash::Sha256);
+  X509_free(cert);
+  return sha256;
+}
+
 void SecureSocket::initSsl(bool server)
 {
   std::scoped_lock ssl_lock{ssl_mutex_};
@@ -323,16 +344,20 @@ bool SecureSocket::loadCertificate(const QString &filename)
 
 void SecureSocket::initContext(bool server)
 {
-  SSL_library_init();
+  // the library is set up by the first secure socket, not at start-up
+  static std::once_flag s_libraryInit;
+  std::call_once(s_libraryInit, [] {
+    SSL_library_init();
 
-  const SSL_METHOD *method;
+    // load & register all cryptos, etc.
+    OpenSSL_add_all_algorithms();
 
-  // load & register all cryptos, etc.
-  OpenSSL_add_all_algorithms();
+    // load all error messages
+    SSL_load_error_strings();
+    SslLogger::logSecureLibInfo();
+  });
 
-  // load all error messages
-  SSL_load_error_strings();
-  SslLogger::logSecureLibInfo();
+  const SSL_METHOD *method;
 
   if (server) {
     method = SSLv23_server_method();
@@ -453,7 +478,8 @@ int SecureSocket::secureAccept(int socket)
 
 int SecureSocket::secureConnect(int socket)
 {
-  if (!loadCertificate(Settings::value(Settings::Security::Certificate).toString())) {
+  const auto settings = Settings::snapshot();
+  if (!loadCertificate(settings->certificate)) {
     LOG_ERR("could not load client certificates");
     disconnect();
     return -1;
@@ -469,7 +495,7 @@ int SecureSocket::secureConnect(int socket)
   LOG_DEBUG2("connecting secure socket");
 
   // enable hostname verification.
-  const auto name = Settings::value(Settings::Core::ScreenName).toString().toStdString();
+  const auto name = settings->screenName.toStdString();
   SSL_set1_host(m_ssl->m_ssl, name.c_str());
   int r = SSL_connect(m_ssl->m_ssl);
 
@@ -625,8 +651,10 @@ bool SecureSocket::verifyCertFingerprint(const QString &FingerprintDatabasePath)
   if (!sha256.isValid())
     return false;
 
-  // Gui Must Parse this line, DO NOT CHANGE
-  LOG_IPC("peer fingerprint: %s", qPrintable(deskflow::formatSSLFingerprint(sha256.data, false)));
+  // the gui decides whether to trust it, see CoreStatus
+  const auto fingerprint = deskflow::formatSSLFingerprint(sha256.data, false);
+  LOG_IPC("peer fingerprint: %s", qPrintable(fingerprint));
+  CoreStatus::peerFingerprint(fingerprint.toStdString());
 
   QFile file(FingerprintDatabasePath);
 
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include "net/Fingerprint.h"
 #include "net/SecurityLevel.h"
 #include "net/TCPSocket.h"
 
@@ -59,6 +60,14 @@ public:
     m_fatal = b;
   }
   bool isSecureReady() const;
+
+  //! Get the SHA-256 fingerprint of the peer's certificate
+  /*!
+  Invalid if the peer sent no certificate or the connection isn't
+  secure yet.
+  */
+  Fingerprint getPeerFingerprint() const;
+
   void secureConnect();
   void secureAccept();
   int secureRead(void *buffer, int size, int &read);
@@ -11,6 +11,8 @@
 #include "arch/ArchException.h"
 #include "base/Log.h"
 #include "base/TMethodJob.h"
+#include "base/Trace.h"
+#include "base/WakeupStats.h"
 #include "mt/CondVar.h"
 #include "mt/Lock.h"
 #include "mt/Mutex.h"
@@ -170,6 +172,7 @@ void SocketMultiplexer::removeSocket(ISocket *socket)
       // check for status
       if (!pfds.empty()) {
         status = ARCH->pollSocket(&pfds[0], (int)pfds.size(), -1);
+        WakeupStats::add(WakeupSource::Socket);
       } else {
         status = 0;
       }
@@ -195,9 +198,14 @@ void SocketMultiplexer::removeSocket(ISocket *socket)
 
           // run job
           ISocketMultiplexerJob *job = *jobCursor;
+          ISocketMultiplexerJob *newJob;
+          {
+            const TraceScope scope(TraceSpan::SocketJob, job);
+            newJob = job->run(read, write, error);
+          }
 
           // save job, if different
-          if (ISocketMultiplexerJob *newJob = job->run(read, write, error); newJob != job) {
+          if (newJob != job) {
             Lock lock(m_mutex);
             delete job;
             *jobCursor = newJob;
@@ -45,6 +45,15 @@ public:
   // maybe belongs on ISocketMultiplexer
   static SocketMultiplexer *getInstance();
 
+  //! Get the service thread
+  /*!
+  Returns the thread that polls and services the sockets.
+  */
+  Thread &getThread() const
+  {
+    return *m_thread;
+  }
+
   //@}
 
 private:
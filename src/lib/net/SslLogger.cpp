@@ -8,6 +8,7 @@
 #include <iterator>
 #include <sstream>
 
+#include <base/CoreStatus.h>
 #include <base/Log.h>
 #include <openssl/err.h>
 #include <openssl/ssl.h>
@@ -107,11 +108,13 @@ void SslLogger::logSecureConnectInfo(const SSL *ssl)
       if (parts.size() > 2) {
         // log the section containing the protocol version
         LOG_INFO("network encryption protocol: %s", parts[1].c_str());
+        CoreStatus::setTlsProtocol(parts[1]);
       } else {
         // log the error in spliting then display the whole description rather
         // then nothing
         LOG_ERR("could not split cipher for protocol");
         LOG_INFO("network encryption protocol: %s", msg);
+        CoreStatus::setTlsProtocol(msg);
       }
     } else {
       LOG_ERR("could not get secure socket cipher");
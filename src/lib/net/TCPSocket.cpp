@@ -11,6 +11,7 @@
 #include "arch/ArchException.h"
 #include "base/IEventQueue.h"
 #include "base/Log.h"
+#include "base/Trace.h"
 #include "mt/Lock.h"
 #include "net/NetworkAddress.h"
 #include "net/SocketException.h"
@@ -19,6 +20,7 @@
 
 #include <cstdlib>
 #include <cstring>
+#include <utility>
 
 static const std::size_t s_maxInputBufferSize = 1024 * 1024;
 
@@ -155,6 +157,9 @@ void TCPSocket::write(const void *buffer, uint32_t n)
     // copy data to the output buffer
     wasEmpty = (m_outputBuffer.getSize() == 0);
     m_outputBuffer.write(buffer, n);
+    if (const auto flow = Trace::takeFlow(); flow != 0) {
+      m_flow = flow;
+    }
 
     // there's data to write
     m_flushed = false;
@@ -302,6 +307,7 @@ TCPSocket::JobResult TCPSocket::doRead()
   size_t bytesRead = 0;
 
   bytesRead = ARCH->readSocket(m_socket, buffer, sizeof(buffer));
+  TRACE(TracePoint::SocketRead, this, static_cast<int64_t>(bytesRead));
 
   if (bytesRead > 0) {
     bool wasEmpty = (m_inputBuffer.getSize() == 0);
@@ -346,6 +352,7 @@ TCPSocket::JobResult TCPSocket::doWrite()
   bufferSize = m_outputBuffer.getSize();
   const void *buffer = m_outputBuffer.peek(bufferSize);
   bytesWrote = (uint32_t)ARCH->writeSocket(m_socket, buffer, bufferSize);
+  TRACE(TracePoint::SocketWrite, this, bytesWrote);
 
   if (bytesWrote > 0) {
     discardWrittenData(bytesWrote);
@@ -502,6 +509,9 @@ ISocketMultiplexerJob *TCPSocket::serviceConnected(ISocketMultiplexerJob *job, b
   if (write) {
     try {
       writeResult = doWrite();
+      if (writeResult == New) {
+        Trace::endFlow(std::exchange(m_flow, 0), this);
+      }
     } catch (ArchNetworkShutdownException &) {
       // remote read end of stream hungup.  our output side
       // has therefore shutdown.
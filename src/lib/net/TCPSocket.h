@@ -147,4 +147,5 @@ private:
   IEventQueue *m_events;
   CondVar<bool> m_flushed;
   SocketMultiplexer *m_socketMultiplexer;
+  uint64_t m_flow = 0;
 };
@@ -14,6 +14,7 @@
 #include "mt/Thread.h"
 
 #include <cassert>
+#include <cmath>
 #include <fcntl.h>
 #include <poll.h>
 #include <unistd.h>
@@ -44,15 +45,21 @@ void EiEventQueueBuffer::waitForEvent(double msTimeout)
 
   static const auto s_eiFd = 0;
   static const auto s_pipeFd = 1;
-  static const auto s_pollFdCount = 2;
+  static const auto s_timerFd = 2;
+  static const auto s_pollFdCount = 3;
 
+  // the timer fd only has to wake us, the event queue checks its timers
+  // after every wait.  poll() skips it while it is -1.
   struct pollfd pfds[s_pollFdCount];
   pfds[s_eiFd].fd = ei_get_fd(m_ei);
   pfds[s_eiFd].events = POLLIN;
   pfds[s_pipeFd].fd = m_pipeRead;
   pfds[s_pipeFd].events = POLLIN;
+  pfds[s_timerFd].fd = m_timerFd;
+  pfds[s_timerFd].events = POLLIN;
 
-  int timeout = (msTimeout < 0.0) ? -1 : static_cast<int>(1000.0 * msTimeout);
+  // round up so a timeout never ends a fraction of a millisecond early
+  int timeout = (msTimeout < 0.0) ? -1 : static_cast<int>(std::ceil(1000.0 * msTimeout));
 
   if (int retval = poll(pfds, s_pollFdCount, timeout); retval > 0) {
     if (pfds[s_eiFd].revents & POLLIN) {
@@ -113,6 +120,22 @@ IEventQueueBuffer::Type EiEventQueueBuffer::getEvent(Event &event, uint32_t &dat
   return IEventQueueBuffer::Type::System;
 }
 
+size_t EiEventQueueBuffer::getEvents(std::vector<Entry> &entries, size_t max)
+{
+  std::scoped_lock lock{m_mutex};
+  size_t count = 0;
+  for (; count < max && !m_queue.empty(); ++count) {
+    const auto [isSystem, dataID] = m_queue.front();
+    m_queue.pop();
+    if (isSystem) {
+      entries.push_back({IEventQueueBuffer::Type::System, Event(EventTypes::System, m_events->getSystemTarget()), 0});
+    } else {
+      entries.push_back({IEventQueueBuffer::Type::User, Event(), dataID});
+    }
+  }
+  return count;
+}
+
 bool EiEventQueueBuffer::addEvent(uint32_t dataID)
 {
   std::scoped_lock lock{m_mutex};
@@ -125,6 +148,12 @@ bool EiEventQueueBuffer::addEvent(uint32_t dataID)
   return true;
 }
 
+bool EiEventQueueBuffer::watchTimerFd(int fd)
+{
+  m_timerFd = fd;
+  return true;
+}
+
 bool EiEventQueueBuffer::isEmpty() const
 {
   std::scoped_lock lock{m_mutex};
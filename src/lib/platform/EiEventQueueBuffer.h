@@ -30,7 +30,9 @@ public:
   }
   void waitForEvent(double msTimeout) override;
   Type getEvent(Event &event, uint32_t &dataID) override;
+  size_t getEvents(std::vector<Entry> &entries, size_t max) override;
   bool addEvent(uint32_t dataID) override;
+  bool watchTimerFd(int fd) override;
   bool isEmpty() const override;
 
 private:
@@ -39,6 +41,7 @@ private:
   std::queue<std::pair<bool, uint32_t>> m_queue;
   int m_pipeWrite;
   int m_pipeRead;
+  int m_timerFd = -1;
 
   mutable std::mutex m_mutex;
 };
@@ -13,16 +13,16 @@
 #include "deskflow/AppUtil.h"
 #include "platform/XDGKeyUtil.h"
 
+#include <algorithm>
 #include <cstddef>
-#include <memory>
-#include <unistd.h>
+#include <cstring>
+#include <functional>
+#include <sys/mman.h>
 
 namespace deskflow {
 
 EiKeyState::EiKeyState(EiScreen *screen, IEventQueue *events)
-    : KeyState(
-          events, AppUtil::instance().getKeyboardLayoutList(), Settings::value(Settings::Client::LanguageSync).toBool()
-      ),
+    : KeyState(events, AppUtil::instance().getKeyboardLayoutList(), Settings::snapshot()->languageSync),
       m_screen{screen}
 {
   m_xkb = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
@@ -35,11 +35,17 @@ EiKeyState::EiKeyState(EiScreen *screen, IEventQueue *events)
 }
 
 void EiKeyState::initDefaultKeymap()
+{
+  m_cachedKeymap = nullptr;
+  setKeymap(xkb_keymap_new_from_names(m_xkb, nullptr, XKB_KEYMAP_COMPILE_NO_FLAGS));
+}
+
+void EiKeyState::setKeymap(xkb_keymap *keymap)
 {
   if (m_xkbKeymap) {
     xkb_keymap_unref(m_xkbKeymap);
   }
-  m_xkbKeymap = xkb_keymap_new_from_names(m_xkb, nullptr, XKB_KEYMAP_COMPILE_NO_FLAGS);
+  m_xkbKeymap = keymap;
 
   if (m_xkbState) {
     xkb_state_unref(m_xkbState);
@@ -47,43 +53,76 @@ void EiKeyState::initDefaultKeymap()
   m_xkbState = xkb_state_new(m_xkbKeymap);
 }
 
-void EiKeyState::init(int fd, size_t len)
+EiKeyState::CachedKeymap *EiKeyState::findCachedKeymap(std::size_t hash, std::string_view text)
 {
-  auto buffer = std::make_unique<char[]>(len + 1);
-  lseek(fd, 0, SEEK_SET);
+  const auto it = std::ranges::find_if(m_keymapCache, [hash, text](const CachedKeymap &cached) {
+    return cached.hash == hash && cached.text == text;
+  });
+  if (it == m_keymapCache.end()) {
+    return nullptr;
+  }
+
+  m_keymapCache.splice(m_keymapCache.end(), m_keymapCache, it);
+  return &m_keymapCache.back();
+}
 
-  if (auto sz = read(fd, buffer.get(), len); (size_t)sz < len) {
-    LOG_WARN("failed to create xkb context: %s", strerror(errno));
+void EiKeyState::init(int fd, size_t len)
+{
+  // map the keymap rather than copying it, it is only read to look it up
+  // in the cache and copied when it has to be compiled
+  void *mapped = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (mapped == MAP_FAILED) {
+    LOG_WARN("failed to map keymap: %s", strerror(errno));
     return;
   }
 
   // See xkbcommon/libxkbcommon issue #307, xkb_keymap_new_from_buffer fails if
   // we have a terminating null byte. Since we can't control whether the other
-  // end sends that byte, enforce null-termination in our buffer and pass the
-  // whole thing as string.
+  // end sends that byte, leave any out of the text.
+  std::string_view text(static_cast<const char *>(mapped), len);
+  while (!text.empty() && text.back() == '\0') {
+    text.remove_suffix(1);
+  }
+
+  const auto hash = std::hash<std::string_view>{}(text);
+  if (auto *cached = findCachedKeymap(hash, text); cached) {
+    munmap(mapped, len);
+    LOG_DEBUG("reusing compiled keymap");
+    m_cachedKeymap = cached;
+    setKeymap(xkb_keymap_ref(cached->keymap));
+    return;
+  }
 
-  buffer[len] = '\0'; // guarantee null-termination
-  auto keymap = xkb_keymap_new_from_string(m_xkb, buffer.get(), XKB_KEYMAP_FORMAT_TEXT_V1, XKB_KEYMAP_COMPILE_NO_FLAGS);
+  auto keymap = xkb_keymap_new_from_buffer(
+      m_xkb, text.data(), text.size(), XKB_KEYMAP_FORMAT_TEXT_V1, XKB_KEYMAP_COMPILE_NO_FLAGS
+  );
   if (!keymap) {
+    munmap(mapped, len);
     LOG_WARN("failed to compile keymap, falling back to defaults");
     // Falling back to layout "us" is a lot more useful than segfaulting
     initDefaultKeymap();
     return;
   }
 
-  if (m_xkbKeymap) {
-    xkb_keymap_unref(m_xkbKeymap);
+  if (m_keymapCache.size() >= kMaxCachedKeymaps) {
+    if (m_cachedKeymap == &m_keymapCache.front()) {
+      m_cachedKeymap = nullptr;
+    }
+    xkb_keymap_unref(m_keymapCache.front().keymap);
+    m_keymapCache.pop_front();
   }
-  m_xkbKeymap = keymap;
+  m_keymapCache.push_back(CachedKeymap{hash, std::string(text), xkb_keymap_ref(keymap)});
+  munmap(mapped, len);
 
-  if (m_xkbState) {
-    xkb_state_unref(m_xkbState);
-  }
-  m_xkbState = xkb_state_new(m_xkbKeymap);
+  m_cachedKeymap = &m_keymapCache.back();
+  setKeymap(keymap);
 }
 
 EiKeyState::~EiKeyState()
 {
+  for (const auto &cached : m_keymapCache) {
+    xkb_keymap_unref(cached.keymap);
+  }
   xkb_context_unref(m_xkb);
   xkb_keymap_unref(m_xkbKeymap);
   xkb_state_unref(m_xkbState);
@@ -212,6 +251,21 @@ void EiKeyState::assignGeneratedModifiers(std::uint32_t keycode, deskflow::KeyMa
 
 void EiKeyState::getKeyMap(deskflow::KeyMap &keyMap)
 {
+  if (m_cachedKeymap != nullptr && m_cachedKeymap->hasItems) {
+    for (const auto &item : m_cachedKeymap->items) {
+      keyMap.addKeyEntry(item);
+    }
+    keyMap.allowGroupSwitchDuringCompose();
+    return;
+  }
+
+  // remember the entries so the same keymap doesn't have to be walked again
+  std::vector<KeyMap::KeyItem> items;
+  const auto addKeyEntry = [&keyMap, &items](const KeyMap::KeyItem &item) {
+    items.push_back(item);
+    keyMap.addKeyEntry(item);
+  };
+
   auto minKeycode = xkb_keymap_min_keycode(m_xkbKeymap);
   auto maxKeycode = xkb_keymap_max_keycode(m_xkbKeymap);
 
@@ -286,16 +340,21 @@ void EiKeyState::getKeyMap(deskflow::KeyMap &keyMap)
         if (item.m_sensitive & KeyModifierShift && item.m_sensitive & KeyModifierCapsLock) {
           item.m_required &= ~KeyModifierShift;
           item.m_required |= KeyModifierCapsLock;
-          keyMap.addKeyEntry(item);
+          addKeyEntry(item);
           item.m_required |= KeyModifierShift;
           item.m_required &= ~KeyModifierCapsLock;
         }
 
-        keyMap.addKeyEntry(item);
+        addKeyEntry(item);
       }
     }
   }
 
+  if (m_cachedKeymap != nullptr) {
+    m_cachedKeymap->items = std::move(items);
+    m_cachedKeymap->hasItems = true;
+  }
+
   // allow composition across groups
   keyMap.allowGroupSwitchDuringCompose();
 }
@@ -12,6 +12,11 @@
 
 #include <xkbcommon/xkbcommon.h>
 
+#include <list>
+#include <string>
+#include <string_view>
+#include <vector>
+
 struct xkb_context;
 struct xkb_keymap;
 struct xkb_state;
@@ -43,14 +48,33 @@ protected:
   void fakeKey(const Keystroke &keystroke) override;
 
 private:
+  /// A compiled keymap and the key entries derived from it, the EIS server
+  /// tends to send the same keymap again whenever a device is re-added
+  struct CachedKeymap
+  {
+    std::size_t hash = 0;
+    std::string text;
+    xkb_keymap *keymap = nullptr;
+    bool hasItems = false;
+    std::vector<KeyMap::KeyItem> items;
+  };
+
+  inline static const std::size_t kMaxCachedKeymaps = 4;
+
   std::uint32_t convertModMask(xkb_mod_mask_t xkbModMaskIn) const;
   void assignGeneratedModifiers(std::uint32_t keycode, KeyMap::KeyItem &item);
+  void setKeymap(xkb_keymap *keymap);
+  CachedKeymap *findCachedKeymap(std::size_t hash, std::string_view text);
 
   EiScreen *m_screen = nullptr;
 
   xkb_context *m_xkb = nullptr;
   xkb_keymap *m_xkbKeymap = nullptr;
   xkb_state *m_xkbState = nullptr;
+
+  // most recently used last, m_cachedKeymap is the entry for m_xkbKeymap
+  std::list<CachedKeymap> m_keymapCache;
+  CachedKeymap *m_cachedKeymap = nullptr;
 };
 
 } // namespace deskflow
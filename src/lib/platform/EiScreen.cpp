@@ -74,7 +74,7 @@ EiScreen::EiScreen(bool isPrimary, IEventQueue *events, bool usePortal, bool inv
   }
 
   // disable sleep if the flag is set
-  if (Settings::value(Settings::Core::PreventSleep).toBool()) {
+  if (Settings::snapshot()->preventSleep) {
     m_powerManager.disableSleep();
   }
 }
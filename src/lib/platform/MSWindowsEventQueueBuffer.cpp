@@ -11,6 +11,8 @@
 #include "arch/win32/ArchDaemonWindows.h"
 #include "base/IEventQueue.h"
 
+#include <cmath>
+
 //
 // MSWindowsEventQueueBuffer
 //
@@ -46,7 +48,8 @@ void MSWindowsEventQueueBuffer::waitForEvent(double timeout)
   if (timeout < 0.0) {
     t = INFINITE;
   } else {
-    t = (DWORD)(1000.0 * timeout);
+    // round up so the wait never ends just before the timeout
+    t = (DWORD)std::ceil(1000.0 * timeout);
   }
 
   // wait for a message.  we cannot be interrupted by thread
@@ -116,7 +116,7 @@ MSWindowsScreen::MSWindowsScreen(
     LOG_DEBUG("screen shape: %d,%d %dx%d %s", m_x, m_y, m_w, m_h, m_multimon ? "(multi-monitor)" : "");
     LOG_DEBUG("window is 0x%08x", m_window);
 
-    if (Settings::value(Settings::Core::PreventSleep).toBool()) {
+    if (Settings::snapshot()->preventSleep) {
       m_powerManager.disableSleep();
     }
 
@@ -62,8 +62,9 @@ HANDLE openProcessForKill(const PROCESSENTRY32 &entry)
 // MSWindowsWatchdog
 //
 
-MSWindowsWatchdog::MSWindowsWatchdog(bool foreground, FileLogOutputter &fileLogOutputter)
+MSWindowsWatchdog::MSWindowsWatchdog(bool foreground, FileLogOutputter &fileLogOutputter, QueueLogOutputter *logQueue)
     : m_fileLogOutputter(fileLogOutputter),
+      m_logQueue(logQueue),
       m_foreground(foreground)
 {
   initSasFunc();
@@ -354,6 +355,9 @@ void MSWindowsWatchdog::outputLoop(const void *)
     // The file log outputter adds its own newlines, so trim the decoded string to avoid double newlines.
     const auto trimmed = decoded.trimmed();
     m_fileLogOutputter.write(LogLevel::Print, trimmed);
+    if (m_logQueue != nullptr) {
+      m_logQueue->write(LogLevel::Print, trimmed);
+    }
 
     if (m_foreground) {
       // Doesn't add it's own newlines, so use the original ones from the process output.
@@ -21,6 +21,7 @@
 typedef VOID(WINAPI *SendSas)(BOOL asUser);
 
 class FileLogOutputter;
+class QueueLogOutputter;
 
 /**
  * @brief Monitors and controls a core process on Windows, elevating if necessary.
@@ -37,7 +38,12 @@ class MSWindowsWatchdog
   };
 
 public:
-  explicit MSWindowsWatchdog(bool foreground, FileLogOutputter &fileLogOutputter);
+  /**
+   * @param logQueue If set, also receives the process output, for streaming to the GUI.
+   */
+  explicit MSWindowsWatchdog(
+      bool foreground, FileLogOutputter &fileLogOutputter, QueueLogOutputter *logQueue = nullptr
+  );
   ~MSWindowsWatchdog() = default;
 
   /**
@@ -139,6 +145,7 @@ private:
   MSWindowsSession m_session;
   int m_startFailures = 0;
   FileLogOutputter &m_fileLogOutputter;
+  QueueLogOutputter *m_logQueue;
   bool m_foreground = false;
   std::wstring m_activeDesktop = {};
   std::unique_ptr<deskflow::platform::MSWindowsProcess> m_process;
@@ -7,19 +7,25 @@
 #include "platform/WlClipboard.h"
 
 #include "base/Log.h"
+#include "base/WakeupStats.h"
 
 #include <chrono>
+#include <csignal>
+#include <cstring>
 #include <common/Settings.h>
 #include <fcntl.h>
 #include <poll.h>
 #include <spawn.h>
 #include <sys/wait.h>
 #include <unistd.h>
+#include <vector>
 
 #include <QDateTime>
 #include <QProcess>
 #include <QStandardPaths>
 
+extern char **environ;
+
 namespace {
 
 inline static const auto s_copyApp = QStringLiteral("wl-copy");
@@ -27,6 +33,7 @@ inline static const auto s_pasteApp = QStringLiteral("wl-paste");
 
 // wl-clipboard args
 inline static const auto s_listTypes = QStringLiteral("--list-types");
+const char *const s_watch = "--watch";
 inline static const auto s_isPrimary = QStringLiteral("--primary");
 inline static const auto s_noNewLine = QStringLiteral("-n");
 inline static const auto s_readType = QStringLiteral("-t%1");
@@ -76,7 +83,7 @@ bool WlClipboard::isAvailable()
 
 bool WlClipboard::isEnabled()
 {
-  return Settings::value(Settings::Core::UseWlClipboard).toBool();
+  return Settings::snapshot()->useWlClipboard;
 }
 
 void WlClipboard::startMonitoring()
@@ -86,6 +93,9 @@ void WlClipboard::startMonitoring()
   }
   m_stopMonitoring = false;
   m_monitoring = true;
+  if (pipe2(m_stopPipe, O_CLOEXEC | O_NONBLOCK) != 0) {
+    m_stopPipe[0] = m_stopPipe[1] = -1;
+  }
   m_monitorThread = std::make_unique<std::thread>(&WlClipboard::monitorClipboard, this);
 }
 
@@ -98,10 +108,22 @@ void WlClipboard::stopMonitoring()
   m_stopMonitoring = true;
   m_monitoring = false;
 
+  // wake the monitor thread
+  if (m_stopPipe[1] != -1 && write(m_stopPipe[1], "!", 1) < 0) {
+    LOG_DEBUG("failed to wake clipboard monitor: %s", strerror(errno));
+  }
+
   if (m_monitorThread && m_monitorThread->joinable()) {
     m_monitorThread->join();
   }
   m_monitorThread.reset();
+
+  for (auto &fd : m_stopPipe) {
+    if (fd != -1) {
+      close(fd);
+      fd = -1;
+    }
+  }
 }
 
 bool WlClipboard::hasChanged() const
@@ -340,40 +362,125 @@ QStringList WlClipboard::getAvailableMimeTypes() const
 void WlClipboard::monitorClipboard()
 {
   QStringList lastTypes;
-  int consecutiveErrors = 0;
+  if (watchClipboard(lastTypes) || m_stopMonitoring) {
+    return;
+  }
 
+  // wl-paste couldn't watch, poll instead
+  LOG_DEBUG("polling for clipboard changes every %d ms", kMonitorIntervalMs);
+  int consecutiveErrors = 0;
   while (!m_stopMonitoring) {
     std::this_thread::sleep_for(std::chrono::milliseconds(kMonitorIntervalMs));
-    try {
-      // Check if clipboard content has changed by comparing available types
-      const auto currentTypes = getAvailableMimeTypes();
+    WakeupStats::add(WakeupSource::Clipboard);
+    if (!checkClipboard(lastTypes, consecutiveErrors)) {
+      break;
+    }
+  }
+}
 
-      // Reset error counter on successful operation
-      consecutiveErrors = 0;
+bool WlClipboard::watchClipboard(QStringList &lastTypes)
+{
+  if (m_stopPipe[0] == -1) {
+    return false;
+  }
 
-      if (currentTypes != lastTypes) {
-        m_hasChanged = true;
-        lastTypes = currentTypes;
+  int out[2];
+  if (pipe2(out, O_CLOEXEC) != 0) {
+    return false;
+  }
 
-        // Clear cache when clipboard changes
-        std::scoped_lock<std::mutex> lock(m_cacheMutex);
-        invalidateCache();
-        updateOwnership(false);
-      }
-    } catch (const std::exception &e) {
-      LOG_WARN("clipboard monitoring error: %s", e.what());
-      if (++consecutiveErrors >= kMaxConsecutiveErrors) {
-        LOG_ERR("too many consecutive errors in clipboard monitoring, stopping");
-        break;
-      }
-    } catch (...) {
-      LOG_WARN("clipboard monitoring unknown error");
-      if (++consecutiveErrors >= kMaxConsecutiveErrors) {
-        LOG_ERR("too many consecutive errors in clipboard monitoring, stopping");
-        break;
+  // wl-paste runs the command each time the selection changes, the output
+  // of echo is all we need to know that it did
+  const auto paste = s_pasteApp.toStdString();
+  std::vector<char *> argv = {const_cast<char *>(paste.c_str())};
+  if (!m_useClipboard) {
+    argv.push_back(const_cast<char *>("--primary"));
+  }
+  argv.push_back(const_cast<char *>(s_watch));
+  argv.push_back(const_cast<char *>("echo"));
+  argv.push_back(nullptr);
+
+  posix_spawn_file_actions_t actions;
+  posix_spawn_file_actions_init(&actions);
+  posix_spawn_file_actions_adddup2(&actions, out[1], STDOUT_FILENO);
+  pid_t pid = -1;
+  const auto result = posix_spawnp(&pid, argv[0], &actions, nullptr, argv.data(), environ);
+  posix_spawn_file_actions_destroy(&actions);
+  close(out[1]);
+  if (result != 0) {
+    close(out[0]);
+    LOG_DEBUG("failed to start %s: %s", argv[0], strerror(result));
+    return false;
+  }
+
+  bool stopped = false;
+  int consecutiveErrors = 0;
+  pollfd pfds[2] = {{out[0], POLLIN, 0}, {m_stopPipe[0], POLLIN, 0}};
+  while (!m_stopMonitoring) {
+    if (poll(pfds, 2, -1) < 0) {
+      if (errno == EINTR) {
+        continue;
       }
+      break;
+    }
+    WakeupStats::add(WakeupSource::Clipboard);
+
+    if (pfds[1].revents != 0) {
+      stopped = true;
+      break;
+    }
+
+    // drain the notifications, one check covers them all
+    char buffer[256];
+    if (read(out[0], buffer, sizeof(buffer)) <= 0) {
+      LOG_DEBUG("%s stopped watching the clipboard", argv[0]);
+      break;
+    }
+
+    if (!checkClipboard(lastTypes, consecutiveErrors)) {
+      stopped = true;
+      break;
+    }
+  }
+
+  kill(pid, SIGTERM);
+  waitpid(pid, nullptr, 0);
+  close(out[0]);
+  return stopped || m_stopMonitoring;
+}
+
+bool WlClipboard::checkClipboard(QStringList &lastTypes, int &consecutiveErrors)
+{
+  try {
+    // Check if clipboard content has changed by comparing available types
+    const auto currentTypes = getAvailableMimeTypes();
+
+    // Reset error counter on successful operation
+    consecutiveErrors = 0;
+
+    if (currentTypes != lastTypes) {
+      m_hasChanged = true;
+      lastTypes = currentTypes;
+
+      // Clear cache when clipboard changes
+      std::scoped_lock<std::mutex> lock(m_cacheMutex);
+      invalidateCache();
+      updateOwnership(false);
+    }
+  } catch (const std::exception &e) {
+    LOG_WARN("clipboard monitoring error: %s", e.what());
+    if (++consecutiveErrors >= kMaxConsecutiveErrors) {
+      LOG_ERR("too many consecutive errors in clipboard monitoring, stopping");
+      return false;
+    }
+  } catch (...) {
+    LOG_WARN("clipboard monitoring unknown error");
+    if (++consecutiveErrors >= kMaxConsecutiveErrors) {
+      LOG_ERR("too many consecutive errors in clipboard monitoring, stopping");
+      return false;
     }
   }
+  return true;
 }
 
 IClipboard::Time WlClipboard::getCurrentTime() const
@@ -80,6 +80,12 @@ private:
   //! Monitor clipboard changes in background thread
   void monitorClipboard();
 
+  //! Wait for wl-paste to report changes, returns false if it could not be used
+  bool watchClipboard(QStringList &lastTypes);
+
+  //! Compare the available types with \p lastTypes, returns false on too many errors
+  bool checkClipboard(QStringList &lastTypes, int &consecutiveErrors);
+
   //! Get current clipboard serial/timestamp
   Time getCurrentTime() const;
 
@@ -110,6 +116,7 @@ private:
   std::unique_ptr<std::thread> m_monitorThread;
   std::atomic<bool> m_monitoring = false;
   std::atomic<bool> m_stopMonitoring = false;
+  int m_stopPipe[2] = {-1, -1};
 
   // Clipboard selection type (true = clipboard, false = primary)
   bool m_useClipboard;
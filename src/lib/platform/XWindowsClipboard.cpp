@@ -19,6 +19,7 @@
 
 #include <X11/Xatom.h>
 #include <algorithm>
+#include <array>
 #include <cstring>
 
 #if HAVE_FORMAT
@@ -27,6 +28,65 @@
 
 #include <vector>
 
+namespace {
+
+//! Indexes into s_atomNames
+enum InternedAtom
+{
+  kTargets,
+  kMultiple,
+  kTimestamp,
+  kInteger,
+  kAtomAtom,
+  kAtomPair,
+  kData,
+  kIncr,
+  kMotifClipLock,
+  kMotifClipHeader,
+  kMotifClipAccess,
+  kGDKSelection,
+  kClipboard,
+  kHtml,
+  kMozHtml,
+  kBmp,
+  kPlainUtf8Upper,
+  kPlainUtf8Lower,
+  kUtf8String,
+  kPlainUcs2,
+  kUnicode,
+  kPlain,
+  kString
+};
+
+const char *s_atomNames[] = {
+    "TARGETS",
+    "MULTIPLE",
+    "TIMESTAMP",
+    "INTEGER",
+    "ATOM",
+    "ATOM_PAIR",
+    "CLIP_TEMPORARY",
+    "INCR",
+    "_MOTIF_CLIP_LOCK",
+    "_MOTIF_CLIP_HEADER",
+    "_MOTIF_CLIP_LOCK_ACCESS_VALID",
+    "GDK_SELECTION",
+    "CLIPBOARD",
+    "text/html",
+    "application/x-moz-nativehtml",
+    "image/bmp",
+    "text/plain;charset=UTF-8",
+    "text/plain;charset=utf-8",
+    "UTF8_STRING",
+    "text/plain;charset=ISO-10646-UCS-2",
+    "text/unicode",
+    "text/plain",
+    "STRING",
+};
+static_assert(std::size(s_atomNames) == kString + 1, "every interned atom needs a name");
+
+} // namespace
+
 //
 // XWindowsClipboard
 //
@@ -36,38 +96,43 @@ XWindowsClipboard::XWindowsClipboard(Display *display, Window window, ClipboardI
       m_window(window),
       m_id(id)
 {
-  // get some atoms
-  m_atomTargets = XInternAtom(m_display, "TARGETS", False);
-  m_atomMultiple = XInternAtom(m_display, "MULTIPLE", False);
-  m_atomTimestamp = XInternAtom(m_display, "TIMESTAMP", False);
-  m_atomInteger = XInternAtom(m_display, "INTEGER", False);
-  m_atomAtom = XInternAtom(m_display, "ATOM", False);
-  m_atomAtomPair = XInternAtom(m_display, "ATOM_PAIR", False);
-  m_atomData = XInternAtom(m_display, "CLIP_TEMPORARY", False);
-  m_atomINCR = XInternAtom(m_display, "INCR", False);
-  m_atomMotifClipLock = XInternAtom(m_display, "_MOTIF_CLIP_LOCK", False);
-  m_atomMotifClipHeader = XInternAtom(m_display, "_MOTIF_CLIP_HEADER", False);
-  m_atomMotifClipAccess = XInternAtom(m_display, "_MOTIF_CLIP_LOCK_ACCESS_VALID", False);
-  m_atomGDKSelection = XInternAtom(m_display, "GDK_SELECTION", False);
+  // get all our atoms in one round trip to the server, rather than one each
+  std::array<Atom, std::size(s_atomNames)> atoms{};
+  XInternAtoms(
+      m_display, const_cast<char **>(s_atomNames), static_cast<int>(std::size(s_atomNames)), False, atoms.data()
+  );
+
+  m_atomTargets = atoms[kTargets];
+  m_atomMultiple = atoms[kMultiple];
+  m_atomTimestamp = atoms[kTimestamp];
+  m_atomInteger = atoms[kInteger];
+  m_atomAtom = atoms[kAtomAtom];
+  m_atomAtomPair = atoms[kAtomPair];
+  m_atomData = atoms[kData];
+  m_atomINCR = atoms[kIncr];
+  m_atomMotifClipLock = atoms[kMotifClipLock];
+  m_atomMotifClipHeader = atoms[kMotifClipHeader];
+  m_atomMotifClipAccess = atoms[kMotifClipAccess];
+  m_atomGDKSelection = atoms[kGDKSelection];
 
   // set selection atom based on clipboard id
   if (id == kClipboardClipboard) {
-    m_selection = XInternAtom(m_display, "CLIPBOARD", False);
+    m_selection = atoms[kClipboard];
   } else {
     m_selection = XA_PRIMARY;
   }
 
   // add converters, most desired first
-  m_converters.push_back(new XWindowsClipboardHTMLConverter(m_display, "text/html"));
-  m_converters.push_back(new XWindowsClipboardHTMLConverter(m_display, "application/x-moz-nativehtml"));
-  m_converters.push_back(new XWindowsClipboardBMPConverter(m_display));
-  m_converters.push_back(new XWindowsClipboardUTF8Converter(m_display, "text/plain;charset=UTF-8", true));
-  m_converters.push_back(new XWindowsClipboardUTF8Converter(m_display, "text/plain;charset=utf-8", true));
-  m_converters.push_back(new XWindowsClipboardUTF8Converter(m_display, "UTF8_STRING"));
-  m_converters.push_back(new XWindowsClipboardUCS2Converter(m_display, "text/plain;charset=ISO-10646-UCS-2"));
-  m_converters.push_back(new XWindowsClipboardUCS2Converter(m_display, "text/unicode"));
-  m_converters.push_back(new XWindowsClipboardTextConverter(m_display, "text/plain"));
-  m_converters.push_back(new XWindowsClipboardTextConverter(m_display, "STRING"));
+  m_converters.push_back(new XWindowsClipboardHTMLConverter(atoms[kHtml]));
+  m_converters.push_back(new XWindowsClipboardHTMLConverter(atoms[kMozHtml]));
+  m_converters.push_back(new XWindowsClipboardBMPConverter(atoms[kBmp]));
+  m_converters.push_back(new XWindowsClipboardUTF8Converter(atoms[kPlainUtf8Upper], true));
+  m_converters.push_back(new XWindowsClipboardUTF8Converter(atoms[kPlainUtf8Lower], true));
+  m_converters.push_back(new XWindowsClipboardUTF8Converter(atoms[kUtf8String]));
+  m_converters.push_back(new XWindowsClipboardUCS2Converter(atoms[kPlainUcs2]));
+  m_converters.push_back(new XWindowsClipboardUCS2Converter(atoms[kUnicode]));
+  m_converters.push_back(new XWindowsClipboardTextConverter(atoms[kPlain]));
+  m_converters.push_back(new XWindowsClipboardTextConverter(atoms[kString]));
 
   // we have no data
   clearCache();
@@ -1205,7 +1270,9 @@ bool XWindowsClipboard::CICCCMGetClipboard::readClipboard(
   // by badly behaved selection owners.
   XEvent xevent;
   std::vector<XEvent> events;
-  Stopwatch timeout(false);             // timer not stopped, not triggered
+  // timer not stopped, not triggered.  the coarse clock is plenty for a
+  // quarter second timeout and it's read on every pending event.
+  Stopwatch timeout(false, Stopwatch::Clock::Coarse);
   static const double s_timeout = 0.25; // FIXME -- is this too short?
   bool noWait = false;
   while (!m_done && !m_failed) {
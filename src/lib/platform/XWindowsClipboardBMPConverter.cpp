@@ -51,8 +51,7 @@ static void toLE(uint8_t *&dst, uint32_t src)
 // XWindowsClipboardBMPConverter
 //
 
-XWindowsClipboardBMPConverter::XWindowsClipboardBMPConverter(Display *display)
-    : m_atom(XInternAtom(display, "image/bmp", False))
+XWindowsClipboardBMPConverter::XWindowsClipboardBMPConverter(Atom atom) : m_atom(atom)
 {
   // do nothing
 }
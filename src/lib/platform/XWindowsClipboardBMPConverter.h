@@ -13,7 +13,10 @@
 class XWindowsClipboardBMPConverter : public IXWindowsClipboardConverter
 {
 public:
-  explicit XWindowsClipboardBMPConverter(Display *display);
+  /*!
+  \c atom is the \c image/bmp target, reported by getAtom().
+  */
+  explicit XWindowsClipboardBMPConverter(Atom atom);
   ~XWindowsClipboardBMPConverter() override = default;
 
   // IXWindowsClipboardConverter overrides
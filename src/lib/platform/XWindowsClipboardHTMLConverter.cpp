@@ -13,8 +13,7 @@
 // XWindowsClipboardHTMLConverter
 //
 
-XWindowsClipboardHTMLConverter::XWindowsClipboardHTMLConverter(Display *display, const char *name)
-    : m_atom(XInternAtom(display, name, False))
+XWindowsClipboardHTMLConverter::XWindowsClipboardHTMLConverter(Atom atom) : m_atom(atom)
 {
   // do nothing
 }
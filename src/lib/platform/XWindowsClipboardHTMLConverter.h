@@ -14,9 +14,9 @@ class XWindowsClipboardHTMLConverter : public IXWindowsClipboardConverter
 {
 public:
   /*!
-  \c name is converted to an atom and that is reported by getAtom().
+  \c atom is the target this converter handles, reported by getAtom().
   */
-  XWindowsClipboardHTMLConverter(Display *display, const char *name);
+  explicit XWindowsClipboardHTMLConverter(Atom atom);
   ~XWindowsClipboardHTMLConverter() override = default;
 
   // IXWindowsClipboardConverter overrides
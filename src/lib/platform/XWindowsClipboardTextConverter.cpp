@@ -13,8 +13,7 @@
 // XWindowsClipboardTextConverter
 //
 
-XWindowsClipboardTextConverter::XWindowsClipboardTextConverter(Display *display, const char *name)
-    : m_atom(XInternAtom(display, name, False))
+XWindowsClipboardTextConverter::XWindowsClipboardTextConverter(Atom atom) : m_atom(atom)
 {
   // do nothing
 }
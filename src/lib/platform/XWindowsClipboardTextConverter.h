@@ -14,9 +14,9 @@ class XWindowsClipboardTextConverter : public IXWindowsClipboardConverter
 {
 public:
   /*!
-  \c name is converted to an atom and that is reported by getAtom().
+  \c atom is the target this converter handles, reported by getAtom().
   */
-  XWindowsClipboardTextConverter(Display *display, const char *name);
+  explicit XWindowsClipboardTextConverter(Atom atom);
   ~XWindowsClipboardTextConverter() override = default;
 
   // IXWindowsClipboardConverter overrides
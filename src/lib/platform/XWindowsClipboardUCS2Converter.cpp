@@ -13,8 +13,7 @@
 // XWindowsClipboardUCS2Converter
 //
 
-XWindowsClipboardUCS2Converter::XWindowsClipboardUCS2Converter(Display *display, const char *name)
-    : m_atom(XInternAtom(display, name, False))
+XWindowsClipboardUCS2Converter::XWindowsClipboardUCS2Converter(Atom atom) : m_atom(atom)
 {
   // do nothing
 }
@@ -14,9 +14,9 @@ class XWindowsClipboardUCS2Converter : public IXWindowsClipboardConverter
 {
 public:
   /*!
-  \c name is converted to an atom and that is reported by getAtom().
+  \c atom is the target this converter handles, reported by getAtom().
   */
-  XWindowsClipboardUCS2Converter(Display *display, const char *name);
+  explicit XWindowsClipboardUCS2Converter(Atom atom);
   ~XWindowsClipboardUCS2Converter() override = default;
 
   // IXWindowsClipboardConverter overrides
@@ -13,8 +13,8 @@
 // XWindowsClipboardUTF8Converter
 //
 
-XWindowsClipboardUTF8Converter::XWindowsClipboardUTF8Converter(Display *display, const char *name, bool normalize)
-    : m_atom(XInternAtom(display, name, False)),
+XWindowsClipboardUTF8Converter::XWindowsClipboardUTF8Converter(Atom atom, bool normalize)
+    : m_atom(atom),
       m_normalize(normalize)
 {
   // do nothing
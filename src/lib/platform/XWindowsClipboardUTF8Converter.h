@@ -14,9 +14,9 @@ class XWindowsClipboardUTF8Converter : public IXWindowsClipboardConverter
 {
 public:
   /*!
-  \c name is converted to an atom and that is reported by getAtom().
+  \c atom is the target this converter handles, reported by getAtom().
   */
-  XWindowsClipboardUTF8Converter(Display *display, const char *name, bool normalize = false);
+  explicit XWindowsClipboardUTF8Converter(Atom atom, bool normalize = false);
   ~XWindowsClipboardUTF8Converter() override = default;
 
   // IXWindowsClipboardConverter overrides
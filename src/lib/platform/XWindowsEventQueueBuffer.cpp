@@ -8,10 +8,14 @@
 
 #include "platform/XWindowsEventQueueBuffer.h"
 
+#include "arch/Arch.h"
 #include "base/Event.h"
 #include "base/IEventQueue.h"
+#include "base/WakeupStats.h"
 #include "mt/Thread.h"
 
+#include <cerrno>
+#include <cmath>
 #include <fcntl.h>
 #include <poll.h>
 #include <unistd.h>
@@ -76,32 +80,30 @@ void XWindowsEventQueueBuffer::waitForEvent(double dtimeout)
 
   // use poll() to wait for a message from the X server or for timeout.
   // this is a good deal more efficient than polling and sleeping.
-  struct pollfd pfds[2];
+  // poll() ignores the timer fd while it is -1.
+  struct pollfd pfds[3];
   pfds[0].fd = ConnectionNumber(m_display);
   pfds[0].events = POLLIN;
   pfds[1].fd = m_pipefd[0];
   pfds[1].events = POLLIN;
-  int timeout = (dtimeout < 0.0) ? -1 : static_cast<int>(1000.0 * dtimeout);
+  pfds[2].fd = m_timerFd;
+  pfds[2].events = POLLIN;
+  pfds[2].revents = 0;
+
+  // round up, waking before the timeout only to wait again for the
+  // fraction of a millisecond left would spin
+  const int timeout = (dtimeout < 0.0) ? -1 : static_cast<int>(std::ceil(1000.0 * dtimeout));
+
+  // xlib may read events into its own buffer without them showing on the
+  // fd.  that only happens on this thread, checked by XPending() below,
+  // or in addEvent() which writes to the pipe afterwards, so a single
+  // poll for the whole timeout can't miss them.
+  const auto start = Arch::nanoTime();
   int remaining = timeout;
-  int retval = 0;
-
-  // It's possible that the X server has queued events locally
-  // in xlib's event buffer and not pushed on to the fd. Hence we
-  // can't simply monitor the fd as we may never be woken up.
-  // ie addEvent calls flush, XFlush may not send via the fd hence
-  // there is an event waiting to be sent but we must exit the poll
-  // before it can.
-  // Instead we poll for a brief period of time (so if events
-  // queued locally in the xlib buffer can be processed)
-  // and continue doing this until timeout is reached.
-  // The human eye can notice 60hz (ansi) which is 16ms, however
-  // we want to give the cpu a chance s owe up this to 25ms
-  static const int s_timeoutDelay = 25;
-
-  while (((dtimeout < 0.0) || (remaining > 0)) && getPendingCountLocked() == 0 && retval == 0) {
-
-    retval = poll(pfds, 2, s_timeoutDelay); // 16ms = 60hz, but we make it > to
-                                            // play nicely with the cpu
+  while (getPendingCountLocked() == 0) {
+    const int retval = poll(pfds, 3, remaining);
+    WakeupStats::add(WakeupSource::Display);
+
     if (pfds[1].revents & POLLIN) {
       ssize_t read_response = read(m_pipefd[0], buf, 15);
 
@@ -110,7 +112,20 @@ void XWindowsEventQueueBuffer::waitForEvent(double dtimeout)
         // todo: handle read response
       }
     }
-    remaining -= s_timeoutDelay;
+
+    // the event queue reads the clock itself, a timer expiry only has to
+    // end the wait
+    if (retval == 0 || (retval < 0 && errno != EINTR) || (pfds[2].revents & POLLIN)) {
+      break;
+    }
+
+    // a posted event may take a trip to the server before it is pending
+    if (timeout >= 0) {
+      remaining = timeout - static_cast<int>((Arch::nanoTime() - start) / 1'000'000);
+      if (remaining <= 0) {
+        break;
+      }
+    }
   }
 
   {
@@ -142,6 +157,32 @@ IEventQueueBuffer::Type XWindowsEventQueueBuffer::getEvent(Event &event, uint32_
   }
 }
 
+size_t XWindowsEventQueueBuffer::getEvents(std::vector<Entry> &entries, size_t max)
+{
+  std::scoped_lock lock{m_mutex};
+
+  // push out pending events
+  flush();
+
+  // handlers of system events read ahead in the X queue, for key repeats
+  // and selection replies, so the batch ends after the first one.  it is
+  // also the only one that can use m_event.
+  size_t count = 0;
+  for (auto pending = XPending(m_display); count < max && pending > 0; --pending) {
+    XNextEvent(m_display, &m_event);
+    ++count;
+    if (m_event.xany.type == ClientMessage && m_event.xclient.message_type == m_userEvent) {
+      entries.push_back({IEventQueueBuffer::Type::User, Event(), static_cast<uint32_t>(m_event.xclient.data.l[0])});
+    } else {
+      entries.push_back(
+          {IEventQueueBuffer::Type::System, Event(EventTypes::System, m_events->getSystemTarget(), &m_event), 0}
+      );
+      break;
+    }
+  }
+  return count;
+}
+
 bool XWindowsEventQueueBuffer::addEvent(uint32_t dataID)
 {
   // prepare a message
@@ -177,6 +218,12 @@ bool XWindowsEventQueueBuffer::addEvent(uint32_t dataID)
   return true;
 }
 
+bool XWindowsEventQueueBuffer::watchTimerFd(int fd)
+{
+  m_timerFd = fd;
+  return true;
+}
+
 bool XWindowsEventQueueBuffer::isEmpty() const
 {
   std::scoped_lock lock{m_mutex};
@@ -36,7 +36,9 @@ public:
   }
   void waitForEvent(double timeout) override;
   Type getEvent(Event &event, uint32_t &dataID) override;
+  size_t getEvents(std::vector<Entry> &entries, size_t max) override;
   bool addEvent(uint32_t dataID) override;
+  bool watchTimerFd(int fd) override;
   bool isEmpty() const override;
 
 private:
@@ -55,5 +57,6 @@ private:
   EventList m_postedEvents;
   bool m_waiting = false;
   int m_pipefd[2];
+  int m_timerFd = -1;
   IEventQueue *m_events;
 };
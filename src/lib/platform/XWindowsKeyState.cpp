@@ -35,9 +35,7 @@
 static const size_t ModifiersFromXDefaultSize = 32;
 
 XWindowsKeyState::XWindowsKeyState(Display *display, bool useXKB, IEventQueue *events)
-    : KeyState(
-          events, AppUtil::instance().getKeyboardLayoutList(), Settings::value(Settings::Client::LanguageSync).toBool()
-      ),
+    : KeyState(events, AppUtil::instance().getKeyboardLayoutList(), Settings::snapshot()->languageSync),
       m_display(display),
       m_modifierFromX(ModifiersFromXDefaultSize)
 {
@@ -45,10 +43,7 @@ XWindowsKeyState::XWindowsKeyState(Display *display, bool useXKB, IEventQueue *e
 }
 
 XWindowsKeyState::XWindowsKeyState(Display *display, bool useXKB, IEventQueue *events, deskflow::KeyMap &keyMap)
-    : KeyState(
-          events, keyMap, AppUtil::instance().getKeyboardLayoutList(),
-          Settings::value(Settings::Client::LanguageSync).toBool()
-      ),
+    : KeyState(events, keyMap, AppUtil::instance().getKeyboardLayoutList(), Settings::snapshot()->languageSync),
       m_display(display),
       m_modifierFromX(ModifiersFromXDefaultSize)
 {
@@ -73,6 +68,13 @@ void XWindowsKeyState::init(bool useXKB)
   } else {
     m_xkb = nullptr;
   }
+
+  // poll once, the screen keeps the group current from XkbStateNotify so
+  // faking a key doesn't cost two round trips to the server
+  if (m_xkb != nullptr) {
+    setActiveGroup(s_groupPollAndSet);
+    return;
+  }
 #endif
   setActiveGroup(s_groupPoll);
 }
@@ -297,6 +299,9 @@ void XWindowsKeyState::fakeKey(const Keystroke &keystroke)
       if (m_xkb != nullptr) {
         if (XkbLockGroup(m_display, XkbUseCoreKbd, keystroke.m_data.m_group.m_group) == False) {
           LOG_DEBUG1("xkb lock group request not sent");
+        } else if (m_group >= 0) {
+          // don't wait for the state notify before mapping the next key
+          m_group = keystroke.m_data.m_group.m_group;
         }
       } else
 #endif
@@ -312,10 +317,11 @@ void XWindowsKeyState::fakeKey(const Keystroke &keystroke)
 #endif
 #if HAVE_XKB_EXTENSION
       if (m_xkb != nullptr) {
-        if (XkbLockGroup(
-                m_display, XkbUseCoreKbd, getEffectiveGroup(pollActiveGroup(), keystroke.m_data.m_group.m_group)
-            ) == False) {
+        const auto group = getEffectiveGroup(pollActiveGroup(), keystroke.m_data.m_group.m_group);
+        if (XkbLockGroup(m_display, XkbUseCoreKbd, group) == False) {
           LOG_DEBUG1("xkb lock group request not sent");
+        } else if (m_group >= 0) {
+          m_group = group;
         }
       } else
 #endif
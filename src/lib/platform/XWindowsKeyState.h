@@ -50,6 +50,8 @@ public:
   \c pollActiveGroup() will really poll, but that's a slow operation
   on X11.  If \p group is \c s_groupPollAndSet then this will poll the
   active group now and use it for future calls to \c pollActiveGroup().
+  With XKB the group is polled once when created and the screen passes
+  on each \c XkbStateNotify, so it only needs polling again to resync.
   */
   void setActiveGroup(int32_t group);
 
@@ -141,7 +141,7 @@ XWindowsScreen::XWindowsScreen(
   }
 
   // disable sleep if the flag is set
-  if (Settings::value(Settings::Core::PreventSleep).toBool()) {
+  if (Settings::snapshot()->preventSleep) {
     m_powerManager.disableSleep();
   }
 
@@ -876,6 +876,15 @@ Display *XWindowsScreen::openDisplay(const char *displayName)
         m_xkb = true;
         XkbSelectEvents(display, XkbUseCoreKbd, XkbMapNotifyMask, XkbMapNotifyMask);
         XkbSelectEventDetails(display, XkbUseCoreKbd, XkbStateNotifyMask, XkbGroupStateMask, XkbGroupStateMask);
+
+        // lets a key release be handled without searching the queue for
+        // the press that would follow it if it were a repeat
+        if (m_isPrimary) {
+          Bool supported = False;
+          XkbSetDetectableAutoRepeat(display, True, &supported);
+          m_detectableAutoRepeat = (supported == True);
+          LOG_DEBUG("detectable auto-repeat %s", m_detectableAutoRepeat ? "enabled" : "not supported");
+        }
       }
     }
   }
@@ -1101,7 +1110,11 @@ void XWindowsScreen::handleSystemEvent(const Event &event)
   // update key state
   bool isRepeat = false;
   if (m_isPrimary) {
-    if (xevent->type == KeyRelease) {
+    if (m_detectableAutoRepeat) {
+      // a press for a key that is already down is a repeat, onHotKey()
+      // tracks hot keys itself as they don't reach the key state
+      isRepeat = xevent->type == KeyPress && m_keyState->isKeyDown(static_cast<KeyButton>(xevent->xkey.keycode));
+    } else if (xevent->type == KeyRelease) {
       // check if this is a key repeat by getting the next
       // KeyPress event that has the same key and time as
       // this release event, if any.  first prepare the
@@ -1176,6 +1189,13 @@ void XWindowsScreen::handleSystemEvent(const Event &event)
     auto *cookie = &xevent->xcookie;
     if (XGetEventData(m_display, cookie) && cookie->type == GenericEvent && cookie->extension == xi_opcode) {
       if (cookie->evtype == XI_RawMotion) {
+        // the position comes from the pointer, not the event, so only the
+        // last of a burst needs the round trip to query it
+        if (isMotionQueued()) {
+          XFreeEventData(m_display, cookie);
+          return;
+        }
+
         // Get current pointer's position
         XMotionEvent xmotion;
         xmotion.type = MotionNotify;
@@ -1265,7 +1285,9 @@ void XWindowsScreen::handleSystemEvent(const Event &event)
     break;
 
   case KeyPress:
-    if (m_isPrimary) {
+    if (m_isPrimary && isRepeat) {
+      onKeyRepeat(xevent->xkey);
+    } else if (m_isPrimary) {
       onKeyPress(xevent->xkey);
     }
     return;
@@ -1290,6 +1312,7 @@ void XWindowsScreen::handleSystemEvent(const Event &event)
 
   case MotionNotify:
     if (m_isPrimary) {
+      compressMotion(xevent->xmotion);
       onMouseMove(xevent->xmotion);
     }
     return;
@@ -1423,8 +1446,31 @@ void XWindowsScreen::onKeyRelease(XKeyEvent &xkey, bool isRepeat)
   }
 }
 
+void XWindowsScreen::onKeyRepeat(XKeyEvent &xkey)
+{
+  const KeyModifierMask mask = m_keyState->mapModifiersFromX(xkey.state);
+  const KeyID key = mapKeyFromX(&xkey);
+  if (key == kKeyNone) {
+    return;
+  }
+
+  // ignore autorepeat of ctrl+alt+del emulation
+  if ((key == kKeyPause || key == kKeyBreak) &&
+      (mask & (KeyModifierControl | KeyModifierAlt)) == (KeyModifierControl | KeyModifierAlt)) {
+    return;
+  }
+
+  auto keycode = static_cast<KeyButton>(xkey.keycode);
+  LOG_DEBUG1("event: repeat code=%d, state=0x%04x", keycode, xkey.state);
+  m_keyState->sendKeyEvent(getEventTarget(), false, true, key, mask, 1, keycode);
+}
+
 bool XWindowsScreen::onHotKey(const XKeyEvent &xkey, bool isRepeat)
 {
+  if (xkey.type == KeyRelease && !isRepeat) {
+    m_hotKeysDown.erase(xkey.keycode);
+  }
+
   // find the hot key id
   HotKeyToIDMap::const_iterator i = m_hotKeyToIDMap.find(HotKeyItem(xkey.keycode, xkey.state));
   if (i == m_hotKeyToIDMap.end()) {
@@ -1441,6 +1487,11 @@ bool XWindowsScreen::onHotKey(const XKeyEvent &xkey, bool isRepeat)
     return false;
   }
 
+  // a press of a hot key that is already down is an auto-repeat
+  if (xkey.type == KeyPress && !m_hotKeysDown.insert(xkey.keycode).second) {
+    isRepeat = true;
+  }
+
   // generate event (ignore key repeats)
   if (!isRepeat) {
     m_events->addEvent(Event(type, getEventTarget(), HotKeyInfo::alloc(i->second)));
@@ -1539,6 +1590,62 @@ void XWindowsScreen::onMouseMove(const XMotionEvent &xmotion)
   }
 }
 
+#ifdef HAVE_XI2
+static bool isRawMotion(const XEvent &xevent)
+{
+  return xevent.xcookie.type == GenericEvent && xevent.xcookie.extension == xi_opcode &&
+         xevent.xcookie.evtype == XI_RawMotion;
+}
+#endif
+
+void XWindowsScreen::compressMotion(XMotionEvent &xmotion) const
+{
+  // the markers around a warp must reach onMouseMove() one by one
+  if (xmotion.send_event) {
+    return;
+  }
+
+  // only take motion directly behind this one so nothing is reordered.
+  // the delta to the last position is the sum of the skipped deltas.
+  int compressed = 0;
+  XEvent next;
+  while (XEventsQueued(m_display, QueuedAfterReading) > 0) {
+    XPeekEvent(m_display, &next);
+#ifdef HAVE_XI2
+    // while the pointer is grabbed raw motion for the same moves comes in
+    // between, the core events already carry the position it would query
+    if (m_xi2detected && isRawMotion(next)) {
+      XNextEvent(m_display, &next);
+      continue;
+    }
+#endif
+    if (next.type != MotionNotify || next.xmotion.send_event || next.xmotion.window != xmotion.window) {
+      break;
+    }
+    XNextEvent(m_display, &next);
+    xmotion = next.xmotion;
+    ++compressed;
+  }
+
+  if (compressed > 0) {
+    LOG_DEBUG2("compressed %d motion events", compressed);
+  }
+}
+
+#ifdef HAVE_XI2
+bool XWindowsScreen::isMotionQueued() const
+{
+  if (XEventsQueued(m_display, QueuedAfterReading) == 0) {
+    return false;
+  }
+
+  // core motion has the position too, but the warp markers don't count
+  XEvent next;
+  XPeekEvent(m_display, &next);
+  return isRawMotion(next) || (next.type == MotionNotify && !next.xmotion.send_event);
+}
+#endif
+
 Cursor XWindowsScreen::createBlankCursor() const
 {
   // this seems just a bit more complicated than really necessary
@@ -1864,7 +1971,7 @@ bool XWindowsScreen::grabMouseAndKeyboard()
   // and wait before retrying.  give up after s_timeout seconds.
   static const double s_timeout = 1.0;
   int result;
-  Stopwatch timer;
+  Stopwatch timer(false, Stopwatch::Clock::Coarse);
   do {
     // keyboard first
     do {
@@ -1924,6 +2031,8 @@ void XWindowsScreen::refreshKeyboard(XEvent *event)
   }
 #endif
     m_keyState->updateKeyMap();
+  // resync, the server clamps the group when the layout count changes
+  m_keyState->setActiveGroup(XWindowsKeyState::s_groupPollAndSet);
   m_keyState->updateKeyState();
 }
 
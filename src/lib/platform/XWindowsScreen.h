@@ -125,11 +125,19 @@ private:
   bool grabMouseAndKeyboard();
   void onKeyPress(XKeyEvent &);
   void onKeyRelease(XKeyEvent &, bool isRepeat);
+  void onKeyRepeat(XKeyEvent &);
   bool onHotKey(const XKeyEvent &, bool isRepeat);
   void onMousePress(const XButtonEvent &);
   void onMouseRelease(const XButtonEvent &);
   void onMouseMove(const XMotionEvent &);
 
+  //! Replace \p xmotion with the last of the motion events queued directly behind it
+  void compressMotion(XMotionEvent &xmotion) const;
+#ifdef HAVE_XI2
+  //! Test if motion that reports the pointer position is queued next
+  bool isMotionQueued() const;
+#endif
+
   bool detectXI2();
 #ifdef HAVE_XI2
   void selectXIRawMotion();
@@ -197,6 +205,10 @@ private:
   HotKeyIDList m_oldHotKeyIDs;
   HotKeyToIDMap m_hotKeyToIDMap;
 
+  // hot keys that are down, they never reach the key state so its
+  // record of held keys can't tell a repeat from a new press
+  std::set<KeyCode> m_hotKeysDown;
+
   // input focus stuff
   Window m_lastFocus = None;
   int m_lastFocusRevert = RevertToNone;
@@ -237,6 +249,9 @@ private:
   bool m_xkb = false;
   int m_xkbEventBase;
 
+  // the server reports auto-repeat as presses without releases
+  bool m_detectableAutoRepeat = false;
+
   bool m_xi2detected = false;
 
   // XRandR extension stuff
@@ -12,6 +12,7 @@
 
 #include "base/Event.h"
 #include "base/IEventQueue.h"
+#include "base/WakeupStats.h"
 #include "platform/XWindowsConfig.h"
 #include "platform/XWindowsUtil.h"
 
@@ -317,6 +318,9 @@ void XWindowsScreenSaver::setXScreenSaver(Window window)
     // start watching for xscreensaver
     watchForXScreenSaver();
   }
+
+  // only xscreensaver needs the disable timer
+  updateDisableTimer();
 }
 
 bool XWindowsScreenSaver::isXScreenSaver(Window w) const
@@ -438,10 +442,14 @@ void XWindowsScreenSaver::addWatchXScreenSaver(Window window)
 
 void XWindowsScreenSaver::updateDisableTimer()
 {
-  if (m_disabled && !m_suppressDisable && m_disableTimer == nullptr) {
+  // the built-in screen saver and DPMS are turned off in disable(), only
+  // xscreensaver has to be poked.  without it the timer would just wake
+  // us every few seconds for nothing.
+  const bool needed = m_disabled && !m_suppressDisable && m_xscreensaver != None;
+  if (needed && m_disableTimer == nullptr) {
     // 5 seconds should be plenty often to suppress the screen saver
     m_disableTimer = m_events->newTimer(5.0, this);
-  } else if ((!m_disabled || m_suppressDisable) && m_disableTimer != nullptr) {
+  } else if (!needed && m_disableTimer != nullptr) {
     m_events->deleteTimer(m_disableTimer);
     m_disableTimer = nullptr;
   }
@@ -449,6 +457,8 @@ void XWindowsScreenSaver::updateDisableTimer()
 
 void XWindowsScreenSaver::handleDisableTimer()
 {
+  WakeupStats::add(WakeupSource::ScreenSaver);
+
   // send fake mouse motion directly to xscreensaver
   if (m_xscreensaver != None) {
     XEvent event;
@@ -9,6 +9,9 @@
 
 #include "deskflow/IClient.h"
 
+#include <string>
+#include <vector>
+
 namespace deskflow {
 class IStream;
 }
@@ -76,8 +79,8 @@ public:
   void screensaver(bool activate) override = 0;
   void resetOptions() override = 0;
   void setOptions(const OptionsList &options) override = 0;
-  virtual void sendDragInfo(uint32_t fileCount, const char *info, size_t size) = 0;
-  virtual void fileChunkSending(uint8_t mark, char *data, size_t dataSize) = 0;
+  //! Send files to the client, returns false if it can't receive them
+  virtual bool sendFiles(const std::vector<std::string> &paths) = 0;
   virtual std::string getSecureInputApp() const = 0;
   virtual void secureInputNotification(const std::string &app) const = 0;
   std::string getName() const override;
@@ -182,6 +182,9 @@ void ClientListener::handleUnknownClient(ClientProxyUnknown *unknownClient)
     m_events->addHandler(EventTypes::ClientProxyDisconnected, client, [this, client](const auto &) {
       handleClientDisconnected(client);
     });
+  } else if (auto *socket = unknownClient->orphanBulkSocket(); socket) {
+    // the bulk stream owns its socket now
+    m_clientSockets.erase(static_cast<IDataSocket *>(socket));
   } else {
     auto *stream = unknownClient->getStream();
     if (stream) {
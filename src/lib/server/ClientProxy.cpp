@@ -34,6 +34,16 @@ void ClientProxy::close(const char *msg) const
   getStream()->flush();
 }
 
+bool ClientProxy::attachBulkStream(const std::string &, deskflow::IStream *)
+{
+  return false;
+}
+
+void ClientProxy::setBulkRate(double)
+{
+  // do nothing
+}
+
 deskflow::IStream *ClientProxy::getStream() const
 {
   return m_stream;
@@ -37,6 +37,17 @@ public:
   */
   void close(const char *msg) const;
 
+  //! Carry clipboards and files on a second connection
+  /*!
+  Takes \p adoptedStream as the client's bulk data connection if \p token
+  is the one it was offered.  Returns false, leaving the stream to the
+  caller, if the client has no such offer.
+  */
+  virtual bool attachBulkStream(const std::string &token, deskflow::IStream *adoptedStream);
+
+  //! Limit clipboards and files sent to the client to \p rate bytes per second, 0 for none
+  virtual void setBulkRate(double rate);
+
   //@}
   //! @name accessors
   //@{
@@ -47,6 +58,16 @@ public:
   */
   deskflow::IStream *getStream() const override;
 
+  //! Get the last keep alive round trip
+  /*!
+  Returns the time in nanoseconds between the last keep alive sent to the
+  client and its echo, or -1 if it is not known.
+  */
+  virtual int64_t getRoundTripTime() const
+  {
+    return -1;
+  }
+
   //@}
 
   // IScreen
@@ -72,8 +93,7 @@ public:
   void screensaver(bool activate) override = 0;
   void resetOptions() override = 0;
   void setOptions(const OptionsList &options) override = 0;
-  void sendDragInfo(uint32_t fileCount, const char *info, size_t size) override = 0;
-  void fileChunkSending(uint8_t mark, char *data, size_t dataSize) override = 0;
+  bool sendFiles(const std::vector<std::string> &paths) override = 0;
   void secureInputNotification(const std::string &app) const override = 0;
 
 private:
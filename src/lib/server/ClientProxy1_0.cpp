@@ -10,6 +10,7 @@
 
 #include "base/IEventQueue.h"
 #include "base/Log.h"
+#include "base/Trace.h"
 #include "deskflow/DeskflowException.h"
 #include "deskflow/ProtocolUtil.h"
 #include "io/IStream.h"
@@ -121,6 +122,7 @@ void ClientProxy1_0::handleData()
     // parse message
     try {
       LOG_DEBUG2("msg from \"%s\": %c%c%c%c", getName().c_str(), code[0], code[1], code[2], code[3]);
+      TRACE(TracePoint::MessageParsed, this, Trace::packCode(code));
       if (!(this->*m_parser)(code)) {
         LOG(
             (CLOG_ERR "invalid message from client \"%s\": %c%c%c%c", getName().c_str(), code[0], code[1], code[2],
@@ -305,16 +307,11 @@ void ClientProxy1_0::mouseWheel(int32_t, int32_t yDelta)
   ProtocolUtil::writef(getStream(), kMsgDMouseWheel1_0, yDelta);
 }
 
-void ClientProxy1_0::sendDragInfo(uint32_t, const char *, size_t)
+bool ClientProxy1_0::sendFiles(const std::vector<std::string> &)
 {
-  // ignore -- not supported in protocol 1.0
-  LOG_DEBUG("draggingInfoSending not supported");
-}
-
-void ClientProxy1_0::fileChunkSending(uint8_t, char *, size_t)
-{
-  // ignore -- not supported in protocol 1.0
-  LOG_DEBUG("fileChunkSending not supported");
+  // ignore -- not supported before protocol 1.5
+  LOG_WARN("\"%s\" can't receive files, protocol too old", getName().c_str());
+  return false;
 }
 
 std::string ClientProxy1_0::getSecureInputApp() const
@@ -50,8 +50,7 @@ public:
   void screensaver(bool activate) override;
   void resetOptions() override;
   void setOptions(const OptionsList &options) override;
-  void sendDragInfo(uint32_t fileCount, const char *info, size_t size) override;
-  void fileChunkSending(uint8_t mark, char *data, size_t dataSize) override;
+  bool sendFiles(const std::vector<std::string> &paths) override;
   std::string getSecureInputApp() const override;
   void secureInputNotification(const std::string &app) const override;
 
@@ -8,8 +8,10 @@
 
 #include "server/ClientProxy1_3.h"
 
+#include "arch/Arch.h"
 #include "base/IEventQueue.h"
 #include "base/Log.h"
+#include "base/WakeupStats.h"
 #include "deskflow/ProtocolUtil.h"
 
 #include <cstring>
@@ -41,6 +43,12 @@ bool ClientProxy1_3::parseMessage(const uint8_t *code)
 {
   // process message
   if (memcmp(code, kMsgCKeepAlive, 4) == 0) {
+    // the client echoes our keep alives
+    if (m_keepAliveSentAt != 0) {
+      m_roundTripTime = Arch::nanoTime() - m_keepAliveSentAt;
+      m_keepAliveSentAt = 0;
+    }
+
     // reset alarm
     resetHeartbeatTimer();
     return true;
@@ -94,5 +102,7 @@ void ClientProxy1_3::removeHeartbeatTimer()
 
 void ClientProxy1_3::keepAlive()
 {
+  WakeupStats::add(WakeupSource::KeepAlive);
+  m_keepAliveSentAt = Arch::nanoTime();
   ProtocolUtil::writef(getStream(), kMsgCKeepAlive);
 }
@@ -25,6 +25,12 @@ public:
   // IClient overrides
   void mouseWheel(int32_t xDelta, int32_t yDelta) override;
 
+  // ClientProxy overrides
+  int64_t getRoundTripTime() const override
+  {
+    return m_roundTripTime;
+  }
+
 protected:
   // ClientProxy overrides
   bool parseMessage(const uint8_t *code) override;
@@ -39,4 +45,6 @@ private:
   double m_keepAliveRate = kKeepAliveRate;
   EventQueueTimer *m_keepAliveTimer = nullptr;
   IEventQueue *m_events = nullptr;
+  int64_t m_keepAliveSentAt = 0;
+  int64_t m_roundTripTime = -1;
 };
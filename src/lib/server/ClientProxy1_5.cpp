@@ -6,8 +6,11 @@
 
 #include "server/ClientProxy1_5.h"
 
-#include "deskflow/ProtocolUtil.h"
-#include "deskflow/StreamChunker.h"
+#include "base/Log.h"
+#include "common/Settings.h"
+#include "deskflow/BulkShaper.h"
+#include "deskflow/FileTransfer.h"
+#include "deskflow/ProtocolTypes.h"
 #include "io/IStream.h"
 #include "server/Server.h"
 
@@ -18,40 +21,35 @@
 //
 
 ClientProxy1_5::ClientProxy1_5(const std::string &name, deskflow::IStream *stream, Server *server, IEventQueue *events)
-    : ClientProxy1_4(name, stream, server, events)
+    : ClientProxy1_4(name, stream, server, events),
+      m_shaper(std::make_unique<BulkShaper>(Settings::snapshot()->bulkRateLimit * 1024)),
+      m_fileTransfer(std::make_unique<FileTransfer>(events, stream, Settings::snapshot()->fileTransferDir))
 {
-  // do nothing
+  m_fileTransfer->setShaper(m_shaper.get());
 }
 
-void ClientProxy1_5::sendDragInfo(uint32_t fileCount, const char *info, size_t size)
+ClientProxy1_5::~ClientProxy1_5() = default;
+
+bool ClientProxy1_5::sendFiles(const std::vector<std::string> &)
 {
-  // do nothing
+  LOG_WARN("client \"%s\" is too old to receive files", getName().c_str());
+  return false;
 }
 
-void ClientProxy1_5::fileChunkSending(uint8_t mark, char *data, size_t dataSize)
+void ClientProxy1_5::setBulkRate(double rate)
 {
-  // do nothing
+  m_shaper->setRate(rate);
 }
 
 bool ClientProxy1_5::parseMessage(const uint8_t *code)
 {
   if (memcmp(code, kMsgDFileTransfer, 4) == 0) {
-    fileChunkReceived();
+    m_fileTransfer->readFileTransfer();
   } else if (memcmp(code, kMsgDDragInfo, 4) == 0) {
-    dragInfoReceived();
+    m_fileTransfer->readDragInfo();
   } else {
     return ClientProxy1_4::parseMessage(code);
   }
 
   return true;
 }
-
-void ClientProxy1_5::fileChunkReceived() const
-{
-  // do nothing
-}
-
-void ClientProxy1_5::dragInfoReceived() const
-{
-  // do nothing
-}
@@ -8,6 +8,10 @@
 
 #include "server/ClientProxy1_4.h"
 
+#include <memory>
+
+class BulkShaper;
+class FileTransfer;
 class Server;
 class IEventQueue;
 
@@ -18,14 +22,30 @@ public:
   ClientProxy1_5(const std::string &name, deskflow::IStream *adoptedStream, Server *server, IEventQueue *events);
   ClientProxy1_5(ClientProxy1_5 const &) = delete;
   ClientProxy1_5(ClientProxy1_5 &&) = delete;
-  ~ClientProxy1_5() override = default;
+  ~ClientProxy1_5() override;
 
   ClientProxy1_5 &operator=(ClientProxy1_5 const &) = delete;
   ClientProxy1_5 &operator=(ClientProxy1_5 &&) = delete;
 
-  void sendDragInfo(uint32_t fileCount, const char *info, size_t size) override;
-  void fileChunkSending(uint8_t mark, char *data, size_t dataSize) override;
+  //! Clients before 1.9 have no reply to the start of a file, so this fails
+  bool sendFiles(const std::vector<std::string> &paths) override;
+  void setBulkRate(double rate) override;
   bool parseMessage(const uint8_t *code) override;
-  void fileChunkReceived() const;
-  void dragInfoReceived() const;
+
+protected:
+  //! Get the shaper pacing clipboards and files sent to this client
+  BulkShaper *getShaper() const
+  {
+    return m_shaper.get();
+  }
+
+  //! Get the file transfer on the main connection
+  FileTransfer *getFileTransfer() const
+  {
+    return m_fileTransfer.get();
+  }
+
+private:
+  std::unique_ptr<BulkShaper> m_shaper;
+  std::unique_ptr<FileTransfer> m_fileTransfer;
 };
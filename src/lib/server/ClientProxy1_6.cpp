@@ -6,13 +6,17 @@
 
 #include "server/ClientProxy1_6.h"
 
+#include "base/IEventQueue.h"
 #include "base/Log.h"
+#include "deskflow/BulkShaper.h"
 #include "deskflow/ClipboardChunk.h"
 #include "deskflow/ProtocolUtil.h"
 #include "deskflow/StreamChunker.h"
 #include "io/IStream.h"
 #include "server/Server.h"
 
+#include <cstring>
+
 //
 // ClientProxy1_6
 //
@@ -22,10 +26,15 @@ ClientProxy1_6::ClientProxy1_6(const std::string &name, deskflow::IStream *strea
       m_events(events)
 {
   m_events->addHandler(EventTypes::ClipboardSending, this, [this](const auto &e) {
-    ClipboardChunk::send(getStream(), e.getDataObject());
+    sendClipboardChunk(static_cast<ClipboardChunk *>(e.getDataObject()));
   });
 }
 
+ClientProxy1_6::~ClientProxy1_6()
+{
+  stopShapingTimer();
+}
+
 void ClientProxy1_6::setClipboard(ClipboardID id, const IClipboard *clipboard)
 {
   // ignore if this clipboard is already clean
@@ -44,22 +53,27 @@ void ClientProxy1_6::setClipboard(ClipboardID id, const IClipboard *clipboard)
 }
 
 bool ClientProxy1_6::recvClipboard()
+{
+  readClipboard(getStream());
+  return true;
+}
+
+void ClientProxy1_6::readClipboard(deskflow::IStream *stream)
 {
   // parse message
-  static std::string dataCached;
   ClipboardID id;
   uint32_t seq;
 
-  if (auto r = ClipboardChunk::assemble(getStream(), dataCached, id, seq); r == TransferState::Started) {
-    size_t size = ClipboardChunk::getExpectedSize();
+  if (auto r = ClipboardChunk::assemble(stream, m_clipboardData, id, seq); r == TransferState::Started) {
+    size_t size = ClipboardChunk::getExpectedSize(id);
     LOG_DEBUG("receiving clipboard %d size=%d", id, size);
   } else if (r == TransferState::Finished) {
     LOG(
         (CLOG_DEBUG "received client \"%s\" clipboard %d seqnum=%d, size=%d", getName().c_str(), id, seq,
-         dataCached.size())
+         m_clipboardData[id].size())
     );
     // save clipboard
-    m_clipboard[id].m_clipboard.unmarshall(dataCached, 0);
+    m_clipboard[id].m_clipboard.unmarshall(m_clipboardData[id], 0);
     m_clipboard[id].m_sequenceNumber = seq;
 
     // notify
@@ -68,6 +82,93 @@ bool ClientProxy1_6::recvClipboard()
     info->m_sequenceNumber = seq;
     m_events->addEvent(Event(EventTypes::ClipboardChanged, getEventTarget(), info));
   }
+}
 
-  return true;
+void ClientProxy1_6::sendClipboardChunk(ClipboardChunk *chunk)
+{
+  if (const auto id = chunk->getID(); chunk->isStart() && m_clipboardStreams[id] != nullptr) {
+    // the older clipboard is stale, the rest of it is still queued; the new
+    // one follows on the same stream so the client starts it over
+    LOG_DEBUG("dropped stale clipboard %d to \"%s\"", id, getName().c_str());
+    std::erase_if(m_clipboardQueue, [id](const auto &queued) { return queued->getID() == id; });
+  } else if (chunk->isStart()) {
+    const auto isSmall = chunk->getStartSize() <= s_smallClipboardSize;
+    m_clipboardStreams[id] = isSmall ? getStream() : getClipboardStream();
+  } else if (m_clipboardStreams[id] == nullptr) {
+    // the rest of a clipboard whose stream closed
+    return;
+  }
+
+  double wait = 0.0;
+  if (m_clipboardQueue.empty()) {
+    wait = getShaper()->take(static_cast<uint32_t>(chunk->m_dataSize));
+    if (wait <= 0.0) {
+      writeClipboardChunk(chunk);
+      return;
+    }
+  }
+
+  // the event frees its chunk once handled
+  const auto size = chunk->m_dataSize + s_clipboardChunkMetaSize;
+  auto copy = std::make_unique<ClipboardChunk>(size);
+  std::memcpy(copy->m_chunk, chunk->m_chunk, size);
+  m_clipboardQueue.push_back(std::move(copy));
+
+  if (m_shapingTimer == nullptr) {
+    startShapingTimer(wait);
+  }
+}
+
+void ClientProxy1_6::sendQueuedClipboard()
+{
+  while (!m_clipboardQueue.empty()) {
+    const auto &chunk = m_clipboardQueue.front();
+    if (const auto wait = getShaper()->take(static_cast<uint32_t>(chunk->m_dataSize)); wait > 0.0) {
+      startShapingTimer(wait);
+      return;
+    }
+    writeClipboardChunk(chunk.get());
+    m_clipboardQueue.pop_front();
+  }
+}
+
+void ClientProxy1_6::writeClipboardChunk(ClipboardChunk *chunk)
+{
+  auto &stream = m_clipboardStreams[chunk->getID()];
+  ClipboardChunk::send(stream, chunk);
+  if (chunk->isEnd()) {
+    stream = nullptr;
+  }
+}
+
+void ClientProxy1_6::dropClipboards(const deskflow::IStream *stream)
+{
+  for (ClipboardID id = 0; id < kClipboardEnd; ++id) {
+    if (m_clipboardStreams[id] == stream) {
+      LOG_DEBUG("dropped clipboard %d to \"%s\", sending it again on enter", id, getName().c_str());
+      m_clipboardStreams[id] = nullptr;
+      m_clipboard[id].m_dirty = true;
+    }
+  }
+  std::erase_if(m_clipboardQueue, [this](const auto &chunk) {
+    return m_clipboardStreams[chunk->getID()] == nullptr;
+  });
+}
+
+void ClientProxy1_6::startShapingTimer(double wait)
+{
+  m_shapingTimer = m_events->newOneShotTimer(wait, nullptr);
+  m_events->addHandler(EventTypes::Timer, m_shapingTimer, [this](const auto &) {
+    stopShapingTimer();
+    sendQueuedClipboard();
+  });
+}
+
+void ClientProxy1_6::stopShapingTimer()
+{
+  if (m_shapingTimer != nullptr) {
+    m_events->removeHandler(EventTypes::Timer, m_shapingTimer);
+    m_events->deleteTimer(m_shapingTimer);
+    m_shapingTimer = nullptr;
+  }
 }
@@ -8,19 +8,63 @@
 
 #include "server/ClientProxy1_5.h"
 
+#include <array>
+#include <deque>
+#include <memory>
+
+class ClipboardChunk;
+class EventQueueTimer;
 class Server;
 class IEventQueue;
 
 //! Proxy for client implementing protocol version 1.6
+/*!
+Clipboard chunks the shaper holds back are copied to a queue and sent in
+order as it allows them.  Each clipboard is sent on the stream chosen for
+it at its start, so its chunks don't change connection part way.  A new
+clipboard drops the queued chunks of an older one with the same id.
+*/
 class ClientProxy1_6 : public ClientProxy1_5
 {
 public:
   ClientProxy1_6(const std::string &name, deskflow::IStream *adoptedStream, Server *server, IEventQueue *events);
-  ~ClientProxy1_6() override = default;
+  ClientProxy1_6(ClientProxy1_6 const &) = delete;
+  ClientProxy1_6(ClientProxy1_6 &&) = delete;
+  ~ClientProxy1_6() override;
+
+  ClientProxy1_6 &operator=(ClientProxy1_6 const &) = delete;
+  ClientProxy1_6 &operator=(ClientProxy1_6 &&) = delete;
 
   void setClipboard(ClipboardID id, const IClipboard *clipboard) override;
   bool recvClipboard() override;
 
+protected:
+  //! Read a clipboard chunk from \p stream, after its code
+  void readClipboard(deskflow::IStream *stream);
+
+  //! Get the stream clipboards larger than \c s_smallClipboardSize are sent on
+  virtual deskflow::IStream *getClipboardStream() const
+  {
+    return getStream();
+  }
+
+  //! Drop the clipboards being sent on \p stream, which is closing
+  /*!
+  They are marked dirty so the client gets them again on its next enter.
+  */
+  void dropClipboards(const deskflow::IStream *stream);
+
+private:
+  void sendClipboardChunk(ClipboardChunk *chunk);
+  void writeClipboardChunk(ClipboardChunk *chunk);
+  void sendQueuedClipboard();
+  void startShapingTimer(double wait);
+  void stopShapingTimer();
+
 private:
   IEventQueue *m_events;
+  std::deque<std::unique_ptr<ClipboardChunk>> m_clipboardQueue;
+  std::array<deskflow::IStream *, kClipboardEnd> m_clipboardStreams{};
+  std::array<std::string, kClipboardEnd> m_clipboardData;
+  EventQueueTimer *m_shapingTimer = nullptr;
 };
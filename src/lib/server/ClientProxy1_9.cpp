@@ -0,0 +1,89 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "server/ClientProxy1_9.h"
+
+#include "base/IEventQueue.h"
+#include "base/Log.h"
+#include "common/Settings.h"
+#include "deskflow/BulkChannel.h"
+#include "deskflow/FileTransfer.h"
+#include "deskflow/ProtocolTypes.h"
+#include "deskflow/ProtocolUtil.h"
+
+//
+// ClientProxy1_9
+//
+
+ClientProxy1_9::ClientProxy1_9(const std::string &name, deskflow::IStream *stream, Server *server, IEventQueue *events)
+    : ClientProxy1_8(name, stream, server, events),
+      m_events(events)
+{
+  // do nothing
+}
+
+ClientProxy1_9::~ClientProxy1_9()
+{
+  detachBulkStream();
+}
+
+bool ClientProxy1_9::attachBulkStream(const std::string &token, deskflow::IStream *adoptedStream)
+{
+  if (m_bulk != nullptr || !BulkChannel::isToken(token, m_bulkToken)) {
+    return false;
+  }
+  if (!BulkChannel::isSamePeer(getStream(), adoptedStream)) {
+    LOG_WARN("bulk connection for \"%s\" is from a different peer", getName().c_str());
+    return false;
+  }
+
+  LOG_DEBUG("client \"%s\" opened its bulk connection", getName().c_str());
+  m_bulk = std::make_unique<BulkChannel>(
+      m_events, adoptedStream, Settings::snapshot()->fileTransferDir,
+      [this](deskflow::IStream *stream) { readClipboard(stream); }
+  );
+  m_bulk->setShaper(getShaper());
+  m_events->addHandler(EventTypes::BulkChannelClosed, m_bulk.get(), [this](const auto &) {
+    LOG_NOTE("bulk connection to \"%s\" closed, using the main connection", getName().c_str());
+    detachBulkStream();
+  });
+  return true;
+}
+
+void ClientProxy1_9::setOptions(const OptionsList &options)
+{
+  ClientProxy1_8::setOptions(options);
+
+  // the client takes other messages after its first options
+  if (m_bulkToken.empty()) {
+    m_bulkToken = BulkChannel::newToken();
+    LOG_DEBUG1("send bulk connection offer to \"%s\"", getName().c_str());
+    ProtocolUtil::writef(getStream(), kMsgDBulkChannel, &m_bulkToken);
+  }
+}
+
+bool ClientProxy1_9::sendFiles(const std::vector<std::string> &paths)
+{
+  QStringList files;
+  for (const auto &path : paths) {
+    files.append(QString::fromStdString(path));
+  }
+  return m_bulk != nullptr ? m_bulk->sendFiles(files) : getFileTransfer()->sendFiles(files);
+}
+
+deskflow::IStream *ClientProxy1_9::getClipboardStream() const
+{
+  return m_bulk != nullptr ? m_bulk->getStream() : getStream();
+}
+
+void ClientProxy1_9::detachBulkStream()
+{
+  if (m_bulk != nullptr) {
+    dropClipboards(m_bulk->getStream());
+    m_events->removeHandler(EventTypes::BulkChannelClosed, m_bulk.get());
+    m_bulk.reset();
+  }
+}
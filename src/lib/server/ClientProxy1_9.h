@@ -0,0 +1,46 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "server/ClientProxy1_8.h"
+
+#include <memory>
+
+class BulkChannel;
+
+//! Proxy for client implementing protocol version 1.9
+/*!
+Offers the client a bulk data connection with its first options and,
+once the client opens it, sends clipboards and files over that instead
+of the main connection.
+*/
+class ClientProxy1_9 : public ClientProxy1_8
+{
+public:
+  ClientProxy1_9(const std::string &name, deskflow::IStream *adoptedStream, Server *server, IEventQueue *events);
+  ClientProxy1_9(ClientProxy1_9 const &) = delete;
+  ClientProxy1_9(ClientProxy1_9 &&) = delete;
+  ~ClientProxy1_9() override;
+
+  ClientProxy1_9 &operator=(ClientProxy1_9 const &) = delete;
+  ClientProxy1_9 &operator=(ClientProxy1_9 &&) = delete;
+
+  bool attachBulkStream(const std::string &token, deskflow::IStream *adoptedStream) override;
+  void setOptions(const OptionsList &options) override;
+  bool sendFiles(const std::vector<std::string> &paths) override;
+
+protected:
+  deskflow::IStream *getClipboardStream() const override;
+
+private:
+  void detachBulkStream();
+
+private:
+  IEventQueue *m_events;
+  std::string m_bulkToken;
+  std::unique_ptr<BulkChannel> m_bulk;
+};
@@ -14,6 +14,7 @@
 #include "deskflow/ProtocolTypes.h"
 #include "deskflow/ProtocolUtil.h"
 #include "io/IStream.h"
+#include "io/StreamFilter.h"
 #include "server/ClientProxy1_0.h"
 #include "server/ClientProxy1_1.h"
 #include "server/ClientProxy1_2.h"
@@ -23,6 +24,7 @@
 #include "server/ClientProxy1_6.h"
 #include "server/ClientProxy1_7.h"
 #include "server/ClientProxy1_8.h"
+#include "server/ClientProxy1_9.h"
 #include "server/Server.h"
 
 //
@@ -67,6 +69,13 @@ ClientProxy *ClientProxyUnknown::orphanClientProxy()
   }
 }
 
+deskflow::IStream *ClientProxyUnknown::orphanBulkSocket()
+{
+  auto *socket = m_bulkSocket;
+  m_bulkSocket = nullptr;
+  return socket;
+}
+
 void ClientProxyUnknown::sendSuccess()
 {
   m_ready = true;
@@ -177,6 +186,10 @@ void ClientProxyUnknown::initProxy(const std::string &name, int major, int minor
       m_proxy = new ClientProxy1_8(name, m_stream, m_server, m_events);
       break;
 
+    case 9:
+      m_proxy = new ClientProxy1_9(name, m_stream, m_server, m_events);
+      break;
+
     default:
       break;
     }
@@ -218,6 +231,25 @@ void ClientProxyUnknown::handleData()
     // remove those later.
     removeHandlers();
 
+    // a token after the name makes this the bulk data connection of a
+    // client that is already connected
+    if (m_stream->getSize() > 0) {
+      std::string token;
+      if (!ProtocolUtil::readf(m_stream, "%s", &token) || !m_server->attachBulkStream(name, token, m_stream)) {
+        throw BadClientException();
+      }
+
+      // the client proxy now owns the stream, which must take the socket
+      // with it when the bulk channel goes
+      auto *filter = static_cast<StreamFilter *>(m_stream);
+      filter->adoptStream();
+      LOG_DEBUG1("attached bulk connection of client \"%s\"", name.c_str());
+      m_bulkSocket = filter->getStream();
+      m_stream = nullptr;
+      sendSuccess();
+      return;
+    }
+
     // create client proxy for highest version supported by the client
     initProxy(name, major, minor);
 
@@ -36,10 +36,21 @@ public:
   /*!
   Returns the client proxy created after a successful handshake
   (i.e. when this object sends a success event).  Returns nullptr
-  if the handshake is unsuccessful or incomplete.
+  if the handshake is unsuccessful or incomplete, or if the connection
+  was handed to a connected client as its bulk data connection.
   */
   ClientProxy *orphanClientProxy();
 
+  //! Get the bulk socket
+  /*!
+  Returns the socket under the stream handed to a connected client as
+  its bulk data connection (i.e. when this object sends a success event
+  without a client proxy).  That stream owns the socket now and may
+  already have deleted it, so the caller must only forget it.  Returns
+  nullptr otherwise.
+  */
+  deskflow::IStream *orphanBulkSocket();
+
   //! Get the stream
   deskflow::IStream *getStream()
   {
@@ -65,6 +76,7 @@ private:
   deskflow::IStream *m_stream = nullptr;
   EventQueueTimer *m_timer = nullptr;
   ClientProxy *m_proxy = nullptr;
+  deskflow::IStream *m_bulkSocket = nullptr;
   bool m_ready = false;
   Server *m_server = nullptr;
   IEventQueue *m_events = nullptr;
@@ -196,14 +196,10 @@ void PrimaryClient::screensaver(bool)
   // ignore
 }
 
-void PrimaryClient::sendDragInfo(uint32_t fileCount, const char *info, size_t size)
+bool PrimaryClient::sendFiles(const std::vector<std::string> &)
 {
-  // ignore
-}
-
-void PrimaryClient::fileChunkSending(uint8_t mark, char *data, size_t dataSize)
-{
-  // ignore
+  // the files are already here
+  return false;
 }
 
 std::string PrimaryClient::getSecureInputApp() const
@@ -8,8 +8,10 @@
 
 #include "server/Server.h"
 
+#include "base/CoreStatus.h"
 #include "base/IEventQueue.h"
 #include "base/Log.h"
+#include "base/Trace.h"
 #include "deskflow/AppUtil.h"
 #include "deskflow/DeskflowException.h"
 #include "deskflow/IPlatformScreen.h"
@@ -287,6 +289,36 @@ uint32_t Server::getNumClients() const
   return (int32_t)m_clients.size();
 }
 
+bool Server::sendFiles(const std::string &name, const std::vector<std::string> &paths)
+{
+  const auto index = m_clients.find(m_config->getCanonicalName(name));
+  if (index == m_clients.end()) {
+    LOG_WARN("can't send files to \"%s\", not connected", name.c_str());
+    return false;
+  }
+  return index->second->sendFiles(paths);
+}
+
+bool Server::attachBulkStream(const std::string &name, const std::string &token, deskflow::IStream *adoptedStream)
+{
+  const auto index = m_clients.find(m_config->getCanonicalName(name));
+  if (index == m_clients.end()) {
+    LOG_WARN("bulk connection for \"%s\", which is not connected", name.c_str());
+    return false;
+  }
+  auto *proxy = dynamic_cast<ClientProxy *>(index->second);
+  return proxy != nullptr && proxy->attachBulkStream(token, adoptedStream);
+}
+
+void Server::setBulkRate(double rate)
+{
+  for (const auto &[name, client] : m_clients) {
+    if (auto *proxy = dynamic_cast<ClientProxy *>(client); proxy != nullptr) {
+      proxy->setBulkRate(rate);
+    }
+  }
+}
+
 void Server::getClients(std::vector<std::string> &list) const
 {
   list.clear();
@@ -295,6 +327,28 @@ void Server::getClients(std::vector<std::string> &list) const
   }
 }
 
+void Server::getClientStats(std::vector<ClientStats> &stats) const
+{
+  stats.clear();
+  for (const auto &[name, client] : m_clients) {
+    const auto *proxy = dynamic_cast<const ClientProxy *>(client);
+    if (proxy == nullptr) {
+      continue;
+    }
+
+    ClientStats &clientStats = stats.emplace_back();
+    clientStats.name = name;
+    clientStats.roundTripTime = proxy->getRoundTripTime();
+    if (const auto *packets = dynamic_cast<const PacketStreamFilter *>(proxy->getStream()); packets != nullptr) {
+      const auto counters = packets->getCounters();
+      clientStats.messagesIn = counters.packetsIn;
+      clientStats.messagesOut = counters.packetsOut;
+      clientStats.bytesIn = counters.bytesIn;
+      clientStats.bytesOut = counters.bytesOut;
+    }
+  }
+}
+
 std::string Server::getName(const BaseClientProxy *client) const
 {
   std::string name = m_config->getCanonicalName(client->getName());
@@ -1265,6 +1319,8 @@ void Server::handleMotionPrimaryEvent(const Event &event)
 void Server::handleMotionSecondaryEvent(const Event &event)
 {
   const auto *info = static_cast<IPlatformScreen::MotionInfo *>(event.getData());
+  // follow the motion to the socket write that sends it to the client
+  const TraceFlow flow(this);
   onMouseMoveSecondary(info->m_x, info->m_y);
 }
 
@@ -1916,6 +1972,7 @@ bool Server::addClient(BaseClientProxy *client)
   // tell primary client about the active sides
   m_primaryClient->reconfigure(getActivePrimarySides());
 
+  publishClients();
   return true;
 }
 
@@ -1937,9 +1994,21 @@ bool Server::removeClient(BaseClientProxy *client)
   m_clients.erase(getName(client));
   m_clientSet.erase(i);
 
+  publishClients();
   return true;
 }
 
+void Server::publishClients() const
+{
+  std::vector<std::string> names;
+  for (const auto &[name, client] : m_clients) {
+    if (client != m_primaryClient) {
+      names.push_back(name);
+    }
+  }
+  CoreStatus::setClients(names);
+}
+
 void Server::closeClient(BaseClientProxy *client, const char *msg)
 {
   assert(client != m_primaryClient);
@@ -27,6 +27,7 @@ class EventQueueTimer;
 class PrimaryClient;
 class InputFilter;
 namespace deskflow {
+class IStream;
 class Screen;
 }
 class IEventQueue;
@@ -42,6 +43,17 @@ class Server
   using ServerConfig = deskflow::server::Config;
 
 public:
+  //! Traffic statistics for a connected client
+  struct ClientStats
+  {
+    std::string name;
+    uint64_t messagesIn = 0;
+    uint64_t messagesOut = 0;
+    uint64_t bytesIn = 0;
+    uint64_t bytesOut = 0;
+    int64_t roundTripTime = -1; //!< Nanoseconds, -1 if not known
+  };
+
   //! Lock cursor to screen data
   class LockCursorToScreenInfo
   {
@@ -152,6 +164,24 @@ public:
   */
   void disconnect();
 
+  //! Send files to a client
+  /*!
+  Sends the files at \p paths to the client named \p name.  Returns
+  false if there is no such client or it can't receive files.
+  */
+  bool sendFiles(const std::string &name, const std::vector<std::string> &paths);
+
+  //! Attach a bulk data connection to a client
+  /*!
+  Hands \p adoptedStream to the client named \p name as its bulk data
+  connection if \p token is the one it was offered.  Returns false,
+  leaving the stream to the caller, otherwise.
+  */
+  bool attachBulkStream(const std::string &name, const std::string &token, deskflow::IStream *adoptedStream);
+
+  //! Limit clipboards and files sent to each client to \p rate bytes per second, 0 for none
+  void setBulkRate(double rate);
+
   //! Store ClientListener pointer
   void setListener(ClientListener *p)
   {
@@ -180,6 +210,13 @@ public:
   */
   void getClients(std::vector<std::string> &list) const;
 
+  //! Get traffic statistics
+  /*!
+  Set \c stats to the traffic statistics of each connected client,
+  excluding the server itself.
+  */
+  void getClientStats(std::vector<ClientStats> &stats) const;
+
   //@}
 
 private:
@@ -322,6 +359,9 @@ private:
   // remove client from list and detach event handlers for client
   bool removeClient(BaseClientProxy *);
 
+  // publish the connected secondary screens to the gui
+  void publishClients() const;
+
   // close a client
   void closeClient(BaseClientProxy *, const char *msg);
 
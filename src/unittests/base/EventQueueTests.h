@@ -0,0 +1,25 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "arch/Arch.h"
+#include "base/Log.h"
+
+#include <QTest>
+
+class EventQueueTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void oneShotTimerAtOneMillisecond();
+  void repeatingTimerDoesNotDrift();
+  void timerFdReplacesTimeout();
+  void timerFdAccurateUnderLoad();
+  void loopTakesEventsInBatches();
+
+private:
+  Arch m_arch;
+  Log m_log;
+};
@@ -0,0 +1,101 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "FileLogOutputterTests.h"
+
+#include "base/LogOutputters.h"
+
+#include <QFile>
+#include <QFileInfo>
+
+void FileLogOutputterTests::init()
+{
+  static int count = 0;
+  QVERIFY(m_dir.isValid());
+  m_fileName = m_dir.filePath(QStringLiteral("test%1.log").arg(++count));
+}
+
+QString FileLogOutputterTests::readFile(const QString &name) const
+{
+  QFile file(name);
+  if (!file.open(QFile::ReadOnly)) {
+    return {};
+  }
+  return QString::fromUtf8(file.readAll());
+}
+
+void FileLogOutputterTests::writesLines()
+{
+  FileLogOutputter outputter(m_fileName);
+  outputter.open({});
+  QVERIFY(outputter.write(LogLevel::Info, QStringLiteral("first")));
+  QVERIFY(outputter.write(LogLevel::Info, QStringLiteral("second")));
+  outputter.flush();
+
+  QCOMPARE(readFile(m_fileName), QStringLiteral("first\nsecond\n"));
+}
+
+void FileLogOutputterTests::errorsAreWrittenImmediately()
+{
+  FileLogOutputter outputter(m_fileName);
+  outputter.setFlushInterval(3600);
+  outputter.open({});
+  outputter.write(LogLevel::Info, QStringLiteral("buffered"));
+  outputter.write(LogLevel::Error, QStringLiteral("error"));
+
+  // no flush, the error pushes out everything before it
+  QCOMPARE(readFile(m_fileName), QStringLiteral("buffered\nerror\n"));
+}
+
+void FileLogOutputterTests::keepsAppending()
+{
+  {
+    FileLogOutputter outputter(m_fileName);
+    outputter.write(LogLevel::Info, QStringLiteral("one"));
+  }
+  {
+    FileLogOutputter outputter(m_fileName);
+    outputter.write(LogLevel::Info, QStringLiteral("two"));
+  }
+
+  QCOMPARE(readFile(m_fileName), QStringLiteral("one\ntwo\n"));
+}
+
+void FileLogOutputterTests::rotatesKeepingGenerations()
+{
+  FileLogOutputter outputter(m_fileName);
+  outputter.setMaxSize(100);
+  outputter.setGenerations(2);
+
+  // 10 bytes per line, so each file holds 10 lines
+  for (int i = 0; i < 50; ++i) {
+    outputter.write(LogLevel::Info, QStringLiteral("line %1").arg(i, 4, 10, QChar('0')));
+  }
+  outputter.close();
+
+  QCOMPARE(QFileInfo(m_fileName).size(), qint64{100});
+  QCOMPARE(QFileInfo(m_fileName + ".1").size(), qint64{100});
+  QCOMPARE(QFileInfo(m_fileName + ".2").size(), qint64{100});
+  QVERIFY(!QFile::exists(m_fileName + ".3"));
+
+  QVERIFY(readFile(m_fileName).startsWith(QStringLiteral("line 0040\n")));
+  QVERIFY(readFile(m_fileName + ".1").startsWith(QStringLiteral("line 0030\n")));
+  QVERIFY(readFile(m_fileName + ".2").startsWith(QStringLiteral("line 0020\n")));
+}
+
+void FileLogOutputterTests::benchmarkWrite()
+{
+  // cost per line, the inverse is the lines per second the file log sustains
+  FileLogOutputter outputter(m_fileName);
+  outputter.setMaxSize(64 * 1024 * 1024);
+  outputter.open({});
+  const auto line = QStringLiteral("[2026-01-01T00:00:00.000] DEBUG2: writef(kMsgDMouseMove) 1920,1080");
+  QBENCHMARK {
+    outputter.write(LogLevel::Debug2, line);
+  }
+}
+
+QTEST_MAIN(FileLogOutputterTests)
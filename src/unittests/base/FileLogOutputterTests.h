@@ -0,0 +1,26 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include <QTemporaryDir>
+#include <QTest>
+
+class FileLogOutputterTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void init();
+  void writesLines();
+  void errorsAreWrittenImmediately();
+  void keepsAppending();
+  void rotatesKeepingGenerations();
+  void benchmarkWrite();
+
+private:
+  QString readFile(const QString &name) const;
+
+  QTemporaryDir m_dir;
+  QString m_fileName;
+};
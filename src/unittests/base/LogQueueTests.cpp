@@ -0,0 +1,305 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "LogQueueTests.h"
+
+#include "base/ILogOutputter.h"
+#include "base/Log.h"
+#include "base/LogQueue.h"
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define LEVEL_FATAL "%z\060"
+#define LEVEL_WARN "%z\062"
+#define LEVEL_NOTE "%z\063"
+#define LEVEL_INFO "%z\064"
+#define LEVEL_DEBUG2 "%z\067"
+
+namespace {
+
+class CaptureLogOutputter : public ILogOutputter
+{
+public:
+  void open(const QString &) override
+  {
+    // do nothing
+  }
+  void close() override
+  {
+    // do nothing
+  }
+  bool write(LogLevel, const QString &message) override
+  {
+    std::scoped_lock lock{m_mutex};
+    m_messages.append(message);
+    return true;
+  }
+
+  QStringList messages()
+  {
+    std::scoped_lock lock{m_mutex};
+    return m_messages;
+  }
+
+private:
+  std::mutex m_mutex;
+  QStringList m_messages;
+};
+
+class NullLogOutputter : public ILogOutputter
+{
+public:
+  void open(const QString &) override
+  {
+    // do nothing
+  }
+  void close() override
+  {
+    // do nothing
+  }
+  bool write(LogLevel, const QString &) override
+  {
+    return true;
+  }
+};
+
+// replaces the default console outputter so tests can see what is written
+template <typename Outputter> Outputter *useOutputter(Log &log)
+{
+  log.pop_front();
+  auto *outputter = new Outputter; // NOSONAR - Adopted by `Log`
+  log.insert(outputter);
+  return outputter;
+}
+
+} // namespace
+
+void LogQueueTests::popsInOrder()
+{
+  LogQueue queue(8);
+  for (int i = 0; i < 5; ++i) {
+    std::string message = std::to_string(i);
+    QVERIFY(queue.tryPush(LogLevel::Info, message));
+  }
+
+  LogLevel level;
+  std::string message;
+  for (int i = 0; i < 5; ++i) {
+    QVERIFY(queue.tryPop(level, message));
+    QVERIFY(level == LogLevel::Info);
+    QCOMPARE(message, std::to_string(i));
+  }
+  QVERIFY(!queue.tryPop(level, message));
+  QVERIFY(queue.isEmpty());
+}
+
+void LogQueueTests::rejectsWhenFull()
+{
+  LogQueue queue(3);
+  QCOMPARE(queue.capacity(), size_t{4});
+
+  for (size_t i = 0; i < queue.capacity(); ++i) {
+    std::string message = "fill";
+    QVERIFY(queue.tryPush(LogLevel::Info, message));
+  }
+
+  std::string rejected = "rejected";
+  QVERIFY(!queue.tryPush(LogLevel::Info, rejected));
+  QCOMPARE(rejected, std::string("rejected"));
+
+  LogLevel level;
+  std::string message;
+  QVERIFY(queue.tryPop(level, message));
+  QVERIFY(queue.tryPush(LogLevel::Info, rejected));
+}
+
+void LogQueueTests::multipleProducers()
+{
+  const int producers = 4;
+  const int perProducer = 10000;
+  LogQueue queue(64);
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back([&queue, p] {
+      for (int i = 0; i < perProducer; ++i) {
+        std::string message = std::to_string(p) + ":" + std::to_string(i);
+        while (!queue.tryPush(LogLevel::Info, message)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  std::vector<int> next(producers, 0);
+  int received = 0;
+  LogLevel level;
+  std::string message;
+  while (received < producers * perProducer) {
+    if (!queue.tryPop(level, message)) {
+      std::this_thread::yield();
+      continue;
+    }
+    const auto colon = message.find(':');
+    const int p = std::stoi(message.substr(0, colon));
+    const int i = std::stoi(message.substr(colon + 1));
+    QCOMPARE(i, next[p]);
+    ++next[p];
+    ++received;
+  }
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  QVERIFY(queue.isEmpty());
+}
+
+void LogQueueTests::writerKeepsOrder()
+{
+  Log log(false);
+  log.setFilter(LogLevel::Debug2);
+  auto *capture = useOutputter<CaptureLogOutputter>(log);
+
+  log.startWriter(16, LogQueue::Overflow::Block);
+  for (int i = 0; i < 1000; ++i) {
+    log.print(nullptr, 0, LEVEL_INFO "message %d", i);
+  }
+  log.flush();
+
+  const auto messages = capture->messages();
+  QCOMPARE(messages.size(), 1000);
+  for (int i = 0; i < messages.size(); ++i) {
+    QVERIFY(messages.at(i).endsWith(QStringLiteral("INFO: message %1").arg(i)));
+  }
+  QCOMPARE(log.getDroppedCount(), uint64_t{0});
+  log.stopWriter();
+}
+
+void LogQueueTests::writerCountsDropped()
+{
+  Log log(false);
+  log.setFilter(LogLevel::Debug2);
+  auto *capture = useOutputter<CaptureLogOutputter>(log);
+
+  log.startWriter(2, LogQueue::Overflow::Drop);
+  for (int i = 0; i < 10000; ++i) {
+    log.print(nullptr, 0, LEVEL_INFO "message %d", i);
+  }
+  log.stopWriter();
+
+  const auto dropped = log.getDroppedCount();
+  QVERIFY(dropped > 0);
+
+  // every message is either written or counted, and the loss is reported
+  const auto messages = capture->messages();
+  const auto reports = messages.filter(QStringLiteral("dropped, queue full"));
+  QVERIFY(!reports.isEmpty());
+  QCOMPARE(static_cast<uint64_t>(messages.size() - reports.size()) + dropped, uint64_t{10000});
+}
+
+void LogQueueTests::writerKeepsWarnings()
+{
+  Log log(false);
+  log.setFilter(LogLevel::Debug2);
+  auto *capture = useOutputter<CaptureLogOutputter>(log);
+
+  log.startWriter(2, LogQueue::Overflow::Drop);
+  for (int i = 0; i < 1000; ++i) {
+    log.print(nullptr, 0, i % 2 == 0 ? LEVEL_WARN "message %d" : LEVEL_NOTE "message %d", i);
+  }
+  log.stopWriter();
+
+  QCOMPARE(log.getDroppedCount(), uint64_t{0});
+  QCOMPARE(capture->messages().size(), 1000);
+}
+
+void LogQueueTests::stopWhilePrinting()
+{
+  Log log(false);
+  log.setFilter(LogLevel::Debug2);
+  auto *capture = useOutputter<CaptureLogOutputter>(log);
+
+  // the writer stops part way through, every message must still be written
+  const int perThread = 2000;
+  std::vector<std::thread> threads;
+  log.startWriter(64, LogQueue::Overflow::Block);
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&log] {
+      for (int i = 0; i < perThread; ++i) {
+        log.print(nullptr, 0, LEVEL_INFO "message %d", i);
+      }
+    });
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  log.stopWriter();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  QCOMPARE(log.getDroppedCount(), uint64_t{0});
+  QCOMPARE(capture->messages().size(), 4 * perThread);
+}
+
+void LogQueueTests::fatalIsWrittenDirectly()
+{
+  Log log(false);
+  log.setFilter(LogLevel::Debug2);
+  auto *capture = useOutputter<CaptureLogOutputter>(log);
+
+  log.startWriter(1024, LogQueue::Overflow::Block);
+  log.print(nullptr, 0, LEVEL_INFO "queued");
+  log.print(nullptr, 0, LEVEL_FATAL "fatal");
+
+  // no flush, the fatal message must already be out, after the queued one
+  const auto messages = capture->messages();
+  QCOMPARE(messages.size(), 2);
+  QVERIFY(messages.at(0).endsWith(QStringLiteral("INFO: queued")));
+  QVERIFY(messages.at(1).endsWith(QStringLiteral("FATAL: fatal")));
+  log.stopWriter();
+}
+
+void LogQueueTests::benchmarkPrint_data()
+{
+  QTest::addColumn<bool>("async");
+  QTest::addColumn<bool>("debug2");
+
+  QTest::newRow("sync INFO") << false << false;
+  QTest::newRow("sync DEBUG2") << false << true;
+  QTest::newRow("async INFO") << true << false;
+  QTest::newRow("async DEBUG2") << true << true;
+}
+
+void LogQueueTests::benchmarkPrint()
+{
+  QFETCH(bool, async);
+  QFETCH(bool, debug2);
+
+  Log log(false);
+  log.setFilter(LogLevel::Debug2);
+  useOutputter<NullLogOutputter>(log);
+  if (async) {
+    log.startWriter(4096, LogQueue::Overflow::Block);
+  }
+
+  // cost per call as seen by the logging thread, formatting included
+  int i = 0;
+  if (debug2) {
+    QBENCHMARK {
+      log.print(__FILE__, __LINE__, LEVEL_DEBUG2 "key down id=%d mask=0x%04x button=%d", ++i, 0x2000, 0);
+    }
+  } else {
+    QBENCHMARK {
+      log.print(nullptr, 0, LEVEL_INFO "switch from \"%s\" to \"%s\" at %d,%d", "server", "client", ++i, 0);
+    }
+  }
+
+  log.stopWriter();
+}
+
+QTEST_MAIN(LogQueueTests)
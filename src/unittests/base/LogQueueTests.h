@@ -0,0 +1,23 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include <QTest>
+
+class LogQueueTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void popsInOrder();
+  void rejectsWhenFull();
+  void multipleProducers();
+  void writerKeepsOrder();
+  void writerCountsDropped();
+  void writerKeepsWarnings();
+  void stopWhilePrinting();
+  void fatalIsWrittenDirectly();
+  void benchmarkPrint_data();
+  void benchmarkPrint();
+};
@@ -119,4 +119,51 @@ void LogTests::printErrWithFileAndLine()
   QCOMPARE(string, "ERROR: test message test file:123");
 }
 
+void LogTests::disabledStatementSkipsArguments()
+{
+  int evaluated = 0;
+  auto argument = [&evaluated] { return ++evaluated; };
+
+  m_log.setFilter(LogLevel::Info);
+  LOG_DEBUG2("not logged %d", argument());
+  QCOMPARE(evaluated, 0);
+
+  std::stringstream buffer;
+  std::streambuf *old = std::cout.rdbuf(buffer.rdbuf());
+  LOG_INFO("logged %d", argument());
+  std::cout.rdbuf(old);
+  QCOMPARE(evaluated, 1);
+
+  m_log.setFilter(LogLevel::Debug2);
+}
+
+void LogTests::benchmarkDisabledStatement_data()
+{
+  QTest::addColumn<bool>("viaPrint");
+
+  QTest::newRow("LOG_DEBUG2") << false;
+  QTest::newRow("Log::print") << true;
+}
+
+void LogTests::benchmarkDisabledStatement()
+{
+  QFETCH(bool, viaPrint);
+
+  // a filtered statement from a hot path should cost about as much as the
+  // empty loop, calling print() directly shows what the macro saves
+  m_log.setFilter(LogLevel::Info);
+  const char *message = "kMsgDMouseMove";
+  int i = 0;
+  if (viaPrint) {
+    QBENCHMARK {
+      m_log.print(CLOG_DEBUG2 "writef(%s) %d", message, ++i);
+    }
+  } else {
+    QBENCHMARK {
+      LOG_DEBUG2("writef(%s) %d", message, ++i);
+    }
+  }
+  m_log.setFilter(LogLevel::Debug2);
+}
+
 QTEST_MAIN(LogTests)
@@ -21,6 +21,9 @@ private Q_SLOTS:
   void printLevelToHigh();
   void printInfoWithFileAndLine();
   void printErrWithFileAndLine();
+  void disabledStatementSkipsArguments();
+  void benchmarkDisabledStatement_data();
+  void benchmarkDisabledStatement();
 
 private:
   Log m_log;
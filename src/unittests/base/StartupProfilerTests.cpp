@@ -0,0 +1,92 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "StartupProfilerTests.h"
+
+#include "arch/Arch.h"
+#include "base/StartupProfiler.h"
+
+void StartupProfilerTests::notStartedIsIgnored()
+{
+  StartupProfiler::mark("ignored");
+
+  QVERIFY(StartupProfiler::finish("ignored"));
+  QVERIFY(StartupProfiler::phases().empty());
+  QVERIFY(!StartupProfiler::isFinished());
+  QCOMPARE(StartupProfiler::totalMs(), 0.0);
+}
+
+void StartupProfilerTests::marksPhasesInOrder()
+{
+  StartupProfiler::start();
+  StartupProfiler::mark("config");
+  StartupProfiler::mark("screen");
+  StartupProfiler::finish("listening", 60'000);
+
+  const auto phases = StartupProfiler::phases();
+  QCOMPARE(phases.size(), size_t{3});
+  QCOMPARE(phases[0].name, std::string("config"));
+  QCOMPARE(phases[1].name, std::string("screen"));
+  QCOMPARE(phases[2].name, std::string("listening"));
+  QVERIFY(StartupProfiler::isFinished());
+}
+
+void StartupProfilerTests::finishesOnce()
+{
+  StartupProfiler::start();
+  StartupProfiler::finish("listening", 60'000);
+  const auto total = StartupProfiler::totalMs();
+
+  // a server restart must not add to the first start-up
+  StartupProfiler::mark("screen");
+  QVERIFY(StartupProfiler::finish("listening", 0));
+
+  QCOMPARE(StartupProfiler::phases().size(), size_t{1});
+  QCOMPARE(StartupProfiler::totalMs(), total);
+}
+
+void StartupProfilerTests::measuresPhases()
+{
+  StartupProfiler::start();
+  Arch::sleep(0.02);
+  StartupProfiler::mark("slow");
+  StartupProfiler::mark("fast");
+  StartupProfiler::finish("listening", 60'000);
+
+  const auto phases = StartupProfiler::phases();
+  QCOMPARE(phases.size(), size_t{3});
+  QVERIFY(phases[0].nanos >= 20'000'000);
+  QVERIFY(phases[1].nanos < phases[0].nanos);
+
+  int64_t sum = 0;
+  for (const auto &phase : phases) {
+    sum += phase.nanos;
+  }
+  QCOMPARE(static_cast<double>(sum) / 1e6, StartupProfiler::totalMs());
+}
+
+void StartupProfilerTests::checksBudget()
+{
+  StartupProfiler::start();
+  Arch::sleep(0.01);
+  QVERIFY(!StartupProfiler::finish("listening", 1.0));
+
+  StartupProfiler::start();
+  QVERIFY(StartupProfiler::finish("listening", 60'000));
+}
+
+void StartupProfilerTests::startResets()
+{
+  StartupProfiler::start();
+  StartupProfiler::mark("config");
+  StartupProfiler::finish("listening", 60'000);
+
+  StartupProfiler::start();
+  QVERIFY(!StartupProfiler::isFinished());
+  QVERIFY(StartupProfiler::phases().empty());
+}
+
+QTEST_MAIN(StartupProfilerTests)
@@ -0,0 +1,25 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "base/Log.h"
+
+#include <QTest>
+
+class StartupProfilerTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  // Test are run in order top to bottom
+  void notStartedIsIgnored();
+  void marksPhasesInOrder();
+  void finishesOnce();
+  void measuresPhases();
+  void checksBudget();
+  void startResets();
+
+private:
+  Log m_log;
+};
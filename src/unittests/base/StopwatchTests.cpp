@@ -0,0 +1,67 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "StopwatchTests.h"
+
+#include "base/Stopwatch.h"
+
+#include <thread>
+
+using namespace std::chrono_literals;
+
+void StopwatchTests::measuresMilliseconds()
+{
+  Stopwatch timer;
+  std::this_thread::sleep_for(1ms);
+  const auto elapsed = timer.getTimeNs();
+
+  QVERIFY(elapsed >= 1'000'000);
+  QVERIFY(elapsed < 1'000'000'000);
+  QVERIFY(timer.getTime() >= 0.001);
+}
+
+void StopwatchTests::stoppedDoesNotTick()
+{
+  Stopwatch timer;
+  std::this_thread::sleep_for(1ms);
+  timer.stop();
+  const auto atStop = timer.getTimeNs();
+  std::this_thread::sleep_for(2ms);
+
+  QVERIFY(timer.isStopped());
+  QCOMPARE(timer.getTimeNs(), atStop);
+  QCOMPARE(timer.resetNs(), atStop);
+  QCOMPARE(timer.getTimeNs(), int64_t{0});
+}
+
+void StopwatchTests::triggerStartsOnFirstRead()
+{
+  Stopwatch timer(true);
+  std::this_thread::sleep_for(2ms);
+
+  QCOMPARE(timer.getTimeNs(), int64_t{0});
+  QVERIFY(!timer.isStopped());
+  std::this_thread::sleep_for(1ms);
+  QVERIFY(timer.getTimeNs() >= 1'000'000);
+}
+
+void StopwatchTests::coarseClock()
+{
+  Stopwatch timer(false, Stopwatch::Clock::Coarse);
+  std::this_thread::sleep_for(20ms);
+
+  // coarse resolution is a few milliseconds at worst
+  QVERIFY(timer.getTimeNs() >= 10'000'000);
+}
+
+void StopwatchTests::conversions()
+{
+  QCOMPARE(Stopwatch::toNanoseconds(0.001), int64_t{1'000'000});
+  QCOMPARE(Stopwatch::toNanoseconds(3.0), int64_t{3'000'000'000});
+  QCOMPARE(Stopwatch::toSeconds(1'500'000), 0.0015);
+}
+
+QTEST_MAIN(StopwatchTests)
@@ -0,0 +1,18 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include <QTest>
+
+class StopwatchTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void measuresMilliseconds();
+  void stoppedDoesNotTick();
+  void triggerStartsOnFirstRead();
+  void coarseClock();
+  void conversions();
+};
@@ -0,0 +1,246 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "TraceTests.h"
+
+#include "arch/Arch.h"
+#include "base/Trace.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <thread>
+
+namespace {
+// the ring size is fixed by the first start, so every test uses the same
+const size_t kRecords = 16;
+} // namespace
+
+void TraceTests::init()
+{
+  Trace::start(kRecords);
+}
+
+void TraceTests::cleanup()
+{
+  Trace::stop();
+}
+
+void TraceTests::disabledRecordsNothing()
+{
+  Trace::stop();
+  int evaluated = 0;
+  TRACE(TracePoint::SocketRead, this, ++evaluated);
+
+  QCOMPARE(evaluated, 0);
+  QVERIFY(Trace::collect().empty());
+}
+
+void TraceTests::collectsInTimeOrder()
+{
+  TRACE(TracePoint::SocketRead, this, 1);
+  std::thread([this] { TRACE(TracePoint::MessageParsed, this, 2); }).join();
+  TRACE(TracePoint::FakeInput, this, 3);
+  Trace::stop();
+
+  const auto records = Trace::collect();
+  QCOMPARE(records.size(), 3);
+  QCOMPARE(records.at(0).point, TracePoint::SocketRead);
+  QCOMPARE(records.at(1).point, TracePoint::MessageParsed);
+  QCOMPARE(records.at(2).point, TracePoint::FakeInput);
+  QCOMPARE_NE(records.at(0).thread, records.at(1).thread);
+  QCOMPARE(records.at(0).thread, records.at(2).thread);
+  QCOMPARE(records.at(2).a, 3);
+}
+
+void TraceTests::keepsNewestWhenFull()
+{
+  for (int i = 0; i < 40; ++i) {
+    TRACE(TracePoint::SocketWrite, this, i);
+  }
+  Trace::stop();
+
+  const auto records = Trace::collect();
+  QCOMPARE(records.size(), kRecords);
+  QCOMPARE(records.front().a, 40 - int(kRecords));
+  QCOMPARE(records.back().a, 39);
+}
+
+void TraceTests::savesAndLoads()
+{
+  TRACE(TracePoint::MessageParsed, this, Trace::packCode(reinterpret_cast<const uint8_t *>("DMMV")));
+  TRACE(TracePoint::FakeInput, this, int64_t(TraceInput::MouseMove), Trace::packPair(-5, 7));
+  Trace::stop();
+
+  const auto fileName = m_dir.filePath(QStringLiteral("test.trace")).toStdString();
+  const auto records = Trace::collect();
+  QVERIFY(Trace::save(fileName, records));
+
+  std::vector<TraceRecord> loaded;
+  QVERIFY(Trace::load(fileName, loaded));
+  QCOMPARE(loaded.size(), 2);
+  QCOMPARE(loaded.at(0).a, (int64_t{'D'} << 24) | (int64_t{'M'} << 16) | (int64_t{'M'} << 8) | 'V');
+  QCOMPARE(loaded.at(1).b, records.at(1).b);
+  QCOMPARE(loaded.at(1).time, records.at(1).time);
+}
+
+void TraceTests::rejectsOtherFiles()
+{
+  const auto fileName = m_dir.filePath(QStringLiteral("other.trace"));
+  QFile file(fileName);
+  QVERIFY(file.open(QFile::WriteOnly));
+  file.write("not a trace file, just some text");
+  file.close();
+
+  std::vector<TraceRecord> records;
+  QVERIFY(!Trace::load(fileName.toStdString(), records));
+  QVERIFY(!Trace::load(m_dir.filePath(QStringLiteral("missing")).toStdString(), records));
+}
+
+void TraceTests::rejectsTruncatedFiles()
+{
+  TRACE(TracePoint::SocketRead, this, 1);
+  TRACE(TracePoint::SocketRead, this, 2);
+  Trace::stop();
+
+  const auto fileName = m_dir.filePath(QStringLiteral("truncated.trace"));
+  QVERIFY(Trace::save(fileName.toStdString(), Trace::collect()));
+
+  // the header still promises two records
+  QFile file(fileName);
+  QVERIFY(file.resize(file.size() - qint64(sizeof(TraceRecord))));
+
+  std::vector<TraceRecord> records;
+  QVERIFY(!Trace::load(fileName.toStdString(), records));
+}
+
+void TraceTests::pairsLatencies()
+{
+  const int first = 0;
+  const int second = 0;
+  std::vector<TraceRecord> records = {
+      {100, 0, TracePoint::EventAdded, 0, uint64_t(&first), 7, 0},
+      {150, 0, TracePoint::EventAdded, 0, uint64_t(&second), 7, 0},
+      {200, 0, TracePoint::EventAdded, 0, uint64_t(&first), 7, 0},
+      {400, 0, TracePoint::EventDispatched, 0, uint64_t(&first), 7, 0},
+      {450, 0, TracePoint::EventDispatched, 0, uint64_t(&second), 7, 0},
+      {500, 0, TracePoint::EventDispatched, 0, uint64_t(&first), 7, 0},
+      {1000, 1, TracePoint::SocketRead, 0, 0, 64, 0},
+      {1030, 0, TracePoint::MessageParsed, 0, 0, 0, 0},
+      {1040, 0, TracePoint::MessageParsed, 0, 0, 0, 0},
+      {1100, 0, TracePoint::FakeInput, 0, 0, 0, 0},
+      {1200, 0, TracePoint::FakeInput, 0, 0, 0, 0},
+  };
+
+  const auto latencies = Trace::latencies(records);
+  QCOMPARE(latencies.size(), 3);
+  QCOMPARE(latencies.at(0).samples, (std::vector<int64_t>{300, 300, 300}));
+  QCOMPARE(latencies.at(1).samples, (std::vector<int64_t>{30}));
+  QCOMPARE(latencies.at(2).samples, (std::vector<int64_t>{60}));
+}
+
+void TraceTests::scopeRecordsSpan()
+{
+  {
+    const TraceScope outer(TraceSpan::Dispatch, this, 12);
+    const TraceScope inner(TraceSpan::Inject, this);
+  }
+  Trace::stop();
+
+  const auto records = Trace::collect();
+  QCOMPARE(records.size(), 4);
+  QCOMPARE(records.at(0).point, TracePoint::SpanBegin);
+  QCOMPARE(records.at(0).a, int64_t(TraceSpan::Dispatch));
+  QCOMPARE(records.at(0).b, 12);
+  QCOMPARE(records.at(1).a, int64_t(TraceSpan::Inject));
+  QCOMPARE(records.at(2).point, TracePoint::SpanEnd);
+  QCOMPARE(records.at(2).a, int64_t(TraceSpan::Inject));
+  QCOMPARE(records.at(3).a, int64_t(TraceSpan::Dispatch));
+}
+
+void TraceTests::flowIsTakenOnce()
+{
+  uint64_t flow = 0;
+  {
+    const TraceFlow scope(this);
+    flow = Trace::takeFlow();
+    QCOMPARE_NE(flow, 0);
+    QCOMPARE(Trace::takeFlow(), 0);
+  }
+  {
+    // an unclaimed flow does not leak into the next write
+    const TraceFlow scope(this);
+  }
+  QCOMPARE(Trace::takeFlow(), 0);
+
+  std::thread([this, flow] { Trace::endFlow(flow, this); }).join();
+  Trace::stop();
+
+  const auto records = Trace::collect();
+  QCOMPARE(records.size(), 3);
+  QCOMPARE(records.at(0).point, TracePoint::FlowBegin);
+  QCOMPARE(records.at(0).a, int64_t(flow));
+  QCOMPARE(records.at(2).point, TracePoint::FlowEnd);
+  QCOMPARE(records.at(2).a, int64_t(flow));
+}
+
+void TraceTests::restartWhileRecording()
+{
+  std::jthread writer([this](std::stop_token stop) {
+    for (int64_t i = 0; !stop.stop_requested(); ++i) {
+      TRACE(TracePoint::SocketWrite, this, i);
+    }
+  });
+
+  // however a record lines up with the restart, only newer ones are collected
+  for (int i = 0; i < 100; ++i) {
+    const auto restartedAt = Arch::nanoTime();
+    Trace::start(kRecords);
+    std::this_thread::yield();
+    Trace::stop();
+    for (const auto &record : Trace::collect()) {
+      QVERIFY(record.time >= restartedAt);
+    }
+  }
+}
+
+void TraceTests::savesJson()
+{
+  const auto flow = Trace::beginFlow(this);
+  {
+    const TraceScope scope(TraceSpan::SocketJob, this);
+    Trace::endFlow(flow, this);
+    TRACE(TracePoint::SocketWrite, this, 16);
+  }
+  Trace::stop();
+
+  const auto fileName = m_dir.filePath(QStringLiteral("test.json"));
+  QVERIFY(Trace::saveJson(fileName.toStdString(), Trace::collect()));
+
+  QFile file(fileName);
+  QVERIFY(file.open(QFile::ReadOnly));
+  QJsonParseError error;
+  const auto document = QJsonDocument::fromJson(file.readAll(), &error);
+  QCOMPARE(error.error, QJsonParseError::NoError);
+
+  QStringList phases;
+  for (const auto &value : document.object().value(QStringLiteral("traceEvents")).toArray()) {
+    phases.append(value.toObject().value(QStringLiteral("ph")).toString());
+  }
+  QCOMPARE(phases, QStringList({"s", "B", "f", "i", "E", "M"}));
+}
+
+void TraceTests::benchmarkRecord()
+{
+  int64_t i = 0;
+  QBENCHMARK {
+    TRACE(TracePoint::SocketRead, this, ++i);
+  }
+}
+
+QTEST_MAIN(TraceTests)
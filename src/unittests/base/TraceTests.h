@@ -0,0 +1,31 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include <QTemporaryDir>
+#include <QTest>
+
+class TraceTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void init();
+  void cleanup();
+  void disabledRecordsNothing();
+  void collectsInTimeOrder();
+  void keepsNewestWhenFull();
+  void savesAndLoads();
+  void rejectsOtherFiles();
+  void rejectsTruncatedFiles();
+  void pairsLatencies();
+  void scopeRecordsSpan();
+  void flowIsTakenOnce();
+  void restartWhileRecording();
+  void savesJson();
+  void benchmarkRecord();
+
+private:
+  QTemporaryDir m_dir;
+};
@@ -0,0 +1,79 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "WakeupStatsTests.h"
+
+#include "base/EventQueue.h"
+#include "base/WakeupStats.h"
+
+#include <cstring>
+
+void WakeupStatsTests::countsPerSource()
+{
+  WakeupStats::reset();
+  WakeupStats::add(WakeupSource::Socket);
+  WakeupStats::add(WakeupSource::Socket);
+  WakeupStats::add(WakeupSource::KeepAlive);
+
+  QCOMPARE(WakeupStats::count(WakeupSource::Socket), uint64_t{2});
+  QCOMPARE(WakeupStats::count(WakeupSource::KeepAlive), uint64_t{1});
+  QCOMPARE(WakeupStats::count(WakeupSource::Display), uint64_t{0});
+}
+
+void WakeupStatsTests::resetClears()
+{
+  WakeupStats::add(WakeupSource::Clipboard);
+  WakeupStats::reset();
+
+  for (std::size_t i = 0; i < WakeupStats::kSourceCount; ++i) {
+    QCOMPARE(WakeupStats::count(static_cast<WakeupSource>(i)), uint64_t{0});
+  }
+}
+
+void WakeupStatsTests::namesAreUnique()
+{
+  for (std::size_t i = 0; i < WakeupStats::kSourceCount; ++i) {
+    const auto *name = WakeupStats::name(static_cast<WakeupSource>(i));
+    QVERIFY(std::strcmp(name, "unknown") != 0);
+    for (std::size_t j = 0; j < i; ++j) {
+      QVERIFY(std::strcmp(name, WakeupStats::name(static_cast<WakeupSource>(j))) != 0);
+    }
+  }
+}
+
+void WakeupStatsTests::idleQueueSleeps()
+{
+  EventQueue events;
+  WakeupStats::reset();
+
+  // with nothing to do the queue must sleep through the whole timeout,
+  // an idle core should wake less than once a second
+  Event event;
+  QVERIFY(!events.getEvent(event, 2.0));
+
+  const auto wakeups = WakeupStats::count(WakeupSource::EventQueue);
+  QVERIFY2(wakeups <= 2, qPrintable(QString::number(wakeups)));
+  QCOMPARE(WakeupStats::count(WakeupSource::Timer), uint64_t{0});
+}
+
+void WakeupStatsTests::timerWakesOnce()
+{
+  EventQueue events;
+  auto *timer = events.newOneShotTimer(0.01, nullptr);
+  WakeupStats::reset();
+
+  Event event;
+  QVERIFY(events.getEvent(event, 1.0));
+  QVERIFY(event.getType() == EventTypes::Timer);
+
+  // one wait until the timer is due, then the expiry itself
+  QCOMPARE(WakeupStats::count(WakeupSource::Timer), uint64_t{1});
+  QVERIFY(WakeupStats::count(WakeupSource::EventQueue) <= 2);
+
+  events.deleteTimer(timer);
+}
+
+QTEST_MAIN(WakeupStatsTests)
@@ -0,0 +1,23 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "base/Log.h"
+
+#include <QTest>
+
+class WakeupStatsTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void countsPerSource();
+  void resetClears();
+  void namesAreUnique();
+  void idleQueueSleeps();
+  void timerWakesOnce();
+
+private:
+  Log m_log;
+};
@@ -0,0 +1,102 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "IpcFrameTests.h"
+
+#include "common/IpcFrame.h"
+
+using namespace deskflow::ipc;
+
+void IpcFrameTests::encode()
+{
+  const auto frame = encodeFrame("abc");
+
+  QCOMPARE(frame.size(), qsizetype(7));
+  QCOMPARE(frame.left(4), QByteArray("\x00\x00\x00\x03", 4));
+  QCOMPARE(frame.mid(4), QByteArray("abc"));
+}
+
+void IpcFrameTests::singleFrame()
+{
+  FrameReader reader;
+  reader.append(encodeFrame(R"({"id":1,"command":"hello"})"));
+
+  const auto payload = reader.next();
+  QVERIFY(payload.has_value());
+  QCOMPARE(*payload, QByteArray(R"({"id":1,"command":"hello"})"));
+  QVERIFY(!reader.next().has_value());
+}
+
+void IpcFrameTests::fragmented()
+{
+  FrameReader reader;
+  const auto frame = encodeFrame("fragmented payload");
+
+  // one byte at a time, including splitting the length prefix
+  for (qsizetype i = 0; i < frame.size() - 1; ++i) {
+    reader.append(frame.mid(i, 1));
+    QVERIFY(!reader.next().has_value());
+  }
+  reader.append(frame.right(1));
+
+  const auto payload = reader.next();
+  QVERIFY(payload.has_value());
+  QCOMPARE(*payload, QByteArray("fragmented payload"));
+  QVERIFY(!reader.hasError());
+}
+
+void IpcFrameTests::coalesced()
+{
+  FrameReader reader;
+  reader.append(encodeFrame("one") + encodeFrame("two") + encodeFrame("three"));
+
+  QCOMPARE(reader.next().value_or(""), QByteArray("one"));
+  QCOMPARE(reader.next().value_or(""), QByteArray("two"));
+  QCOMPARE(reader.next().value_or(""), QByteArray("three"));
+  QVERIFY(!reader.next().has_value());
+}
+
+void IpcFrameTests::coalescedWithPartialTail()
+{
+  FrameReader reader;
+  const auto second = encodeFrame("second");
+  reader.append(encodeFrame("first") + second.left(6));
+
+  QCOMPARE(reader.next().value_or(""), QByteArray("first"));
+  QVERIFY(!reader.next().has_value());
+
+  reader.append(second.mid(6) + encodeFrame("third"));
+  QCOMPARE(reader.next().value_or(""), QByteArray("second"));
+  QCOMPARE(reader.next().value_or(""), QByteArray("third"));
+  QVERIFY(!reader.next().has_value());
+}
+
+void IpcFrameTests::emptyPayload()
+{
+  FrameReader reader;
+  reader.append(encodeFrame({}) + encodeFrame("after"));
+
+  const auto empty = reader.next();
+  QVERIFY(empty.has_value());
+  QVERIFY(empty->isEmpty());
+  QCOMPARE(reader.next().value_or(""), QByteArray("after"));
+}
+
+void IpcFrameTests::oversized()
+{
+  FrameReader reader;
+  QByteArray header(4, '\xff');
+  reader.append(header + encodeFrame("ignored"));
+
+  QVERIFY(!reader.next().has_value());
+  QVERIFY(reader.hasError());
+
+  // nothing is read once the stream is out of sync
+  reader.append(encodeFrame("still ignored"));
+  QVERIFY(!reader.next().has_value());
+}
+
+QTEST_MAIN(IpcFrameTests)
@@ -101,6 +101,55 @@ void SettingsTests::checkCleanScreenName_LongName()
   QCOMPARE(Settings::value(Settings::Core::ScreenName).toString(), expected);
 }
 
+void SettingsTests::snapshot_Values()
+{
+  const auto snapshot = Settings::snapshot();
+  QVERIFY(snapshot);
+  QCOMPARE(snapshot->screenName, Settings::value(Settings::Core::ScreenName).toString());
+  QCOMPARE(snapshot->certificate, Settings::value(Settings::Security::Certificate).toString());
+  QCOMPARE(snapshot->tlsEnabled, Settings::value(Settings::Security::TlsEnabled).toBool());
+  QCOMPARE(snapshot->languageSync, Settings::value(Settings::Client::LanguageSync).toBool());
+  QCOMPARE(snapshot->scrollSpeed, Settings::value(Settings::Client::ScrollSpeed).toInt());
+  QCOMPARE(snapshot->fileTransferDir, Settings::value(Settings::Core::FileTransferDir).toString());
+  QCOMPARE(snapshot->fileTransferMaxSize, Settings::value(Settings::Core::FileTransferMaxSize).toULongLong());
+  QCOMPARE(snapshot->bulkRateLimit, Settings::value(Settings::Server::BulkRateLimit).toDouble());
+}
+
+void SettingsTests::snapshot_ReplacedOnChange()
+{
+  QSignalSpy spy(Settings::instance(), &Settings::snapshotChanged);
+  QVERIFY(spy.isValid());
+
+  const auto before = Settings::snapshot();
+  Settings::setValue(Settings::Core::UseWlClipboard, !before->useWlClipboard);
+  QCOMPARE(spy.count(), 1);
+
+  const auto after = Settings::snapshot();
+  QVERIFY(before != after);
+  QCOMPARE(after->useWlClipboard, !before->useWlClipboard);
+
+  // old readers keep the values they started with
+  QCOMPARE(before->useWlClipboard, !after->useWlClipboard);
+
+  Settings::setValue(Settings::Core::UseWlClipboard, QVariant());
+  QCOMPARE(spy.count(), 2);
+  QCOMPARE(Settings::snapshot()->useWlClipboard, before->useWlClipboard);
+}
+
+void SettingsTests::snapshot_KeptWhenUnrelated()
+{
+  QSignalSpy spy(Settings::instance(), &Settings::snapshotChanged);
+  QVERIFY(spy.isValid());
+
+  const auto before = Settings::snapshot();
+  Settings::setValue(Settings::Gui::LogExpanded, false);
+  Settings::reload();
+  QCOMPARE(spy.count(), 0);
+  QVERIFY(Settings::snapshot() == before);
+
+  Settings::setValue(Settings::Gui::LogExpanded, QVariant());
+}
+
 void SettingsTests::checkLogLevels_Valid()
 {
   QCOMPARE(Settings::logLevelToInt(QStringLiteral("Fatal")), 0);
@@ -24,6 +24,9 @@ private Q_SLOTS:
   void checkValidSettings();
   void checkCleanScreenName();
   void checkCleanScreenName_LongName();
+  void snapshot_Values();
+  void snapshot_ReplacedOnChange();
+  void snapshot_KeptWhenUnrelated();
   void checkLogLevels_Valid();
   void checkLogLevels_Invalid();
 
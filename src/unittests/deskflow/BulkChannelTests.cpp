@@ -0,0 +1,357 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "BulkChannelTests.h"
+#include "../net/Loopback.h"
+
+#include "base/EventQueue.h"
+#include "deskflow/BulkChannel.h"
+#include "deskflow/ClipboardChunk.h"
+#include "deskflow/PacketStreamFilter.h"
+#include "deskflow/ProtocolTypes.h"
+#include "deskflow/ProtocolUtil.h"
+#include "deskflow/StreamChunker.h"
+#include "net/NetworkAddress.h"
+#include "net/SocketMultiplexer.h"
+#include "net/TCPListenSocket.h"
+#include "net/TCPSocket.h"
+
+#include <QTemporaryDir>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace {
+
+const size_t kClipboardSize = 16 * 1024 * 1024;
+
+// a link slower than loopback, so the clipboard takes a while to cross
+const double kLinkRate = 100e6;
+const double kLinkInterval = 0.001;
+const double kLinkBurst = 0.01;
+
+// a key press every this often while the clipboard is sent
+const double kKeyInterval = 0.01;
+
+// the slowest 95% of key presses may arrive with the bulk connection, in
+// milliseconds unless the environment names another, 0 to only report it
+const auto kMaxLatencyVariable = "DESKFLOW_TEST_MAX_LATENCY_MS";
+const int kDefaultMaxLatencyMs = 50;
+
+struct Arrivals
+{
+  bool finished = false;
+  std::vector<uint16_t> keys;  //!< Key presses that came before the clipboard finished
+  std::vector<double> latency; //!< Seconds each of those took to arrive
+
+  double percentile(double fraction) const
+  {
+    if (latency.empty()) {
+      return 0.0;
+    }
+    auto sorted = latency;
+    std::ranges::sort(sorted);
+    return sorted[std::min(sorted.size() - 1, static_cast<size_t>(fraction * static_cast<double>(sorted.size())))];
+  }
+
+  bool inOrder() const
+  {
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (keys[i] != i) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+// forwards between two sockets at kLinkRate each way, like a slow network
+class Relay
+{
+public:
+  Relay(IEventQueue *events, SocketMultiplexer *multiplexer, std::unique_ptr<IDataSocket> accepted)
+      : m_events(events),
+        m_accepted(std::move(accepted)),
+        m_upstream(std::make_unique<TCPSocket>(events, multiplexer)),
+        m_pipes{Pipe{m_accepted.get(), m_upstream.get()}, Pipe{m_upstream.get(), m_accepted.get()}}
+  {
+    for (auto &pipe : m_pipes) {
+      m_events->addHandler(EventTypes::StreamInputReady, pipe.from->getEventTarget(), [&pipe](const auto &) {
+        pipe.read();
+      });
+    }
+    m_events->addHandler(EventTypes::DataSocketConnected, m_upstream->getEventTarget(), [this](const auto &) {
+      m_connected = true;
+    });
+  }
+
+  ~Relay()
+  {
+    m_events->removeHandlers(m_accepted->getEventTarget());
+    m_events->removeHandlers(m_upstream->getEventTarget());
+  }
+
+  void connect(const NetworkAddress &address)
+  {
+    m_upstream->connect(address);
+  }
+
+  void forward(double seconds)
+  {
+    if (m_connected) {
+      for (auto &pipe : m_pipes) {
+        pipe.write(kLinkRate * seconds);
+      }
+    }
+  }
+
+private:
+  struct Pipe
+  {
+    IDataSocket *from;
+    IDataSocket *to;
+    QByteArray pending;
+    qsizetype offset = 0;
+    double credit = 0.0;
+
+    void read()
+    {
+      std::array<char, 64 * 1024> buffer;
+      while (const auto n = from->read(buffer.data(), buffer.size())) {
+        pending.append(buffer.data(), n);
+      }
+    }
+
+    void write(double bytes)
+    {
+      credit = std::min(credit + bytes, kLinkRate * kLinkBurst);
+      const auto n = std::min(pending.size() - offset, static_cast<qsizetype>(credit));
+      if (n > 0) {
+        to->write(pending.constData() + offset, static_cast<uint32_t>(n));
+        offset += n;
+        credit -= static_cast<double>(n);
+      }
+      if (offset == pending.size() || offset > pending.size() / 2) {
+        pending.remove(0, offset);
+        offset = 0;
+      }
+    }
+  };
+
+  IEventQueue *m_events;
+  std::unique_ptr<IDataSocket> m_accepted;
+  std::unique_ptr<IDataSocket> m_upstream;
+  std::array<Pipe, 2> m_pipes;
+  bool m_connected = false;
+};
+
+// a server sends a clipboard and key presses to a client through a relay,
+// with the clipboard on the bulk connection when \p bulk is set, and
+// returns the key presses that arrived before the clipboard did and how
+// long each took
+Arrivals measure(bool bulk, const std::string &content)
+{
+  EventQueue events;
+  SocketMultiplexer multiplexer;
+  QTemporaryDir directory;
+  TCPListenSocket serverListen(&events, &multiplexer, IArchNetwork::AddressFamily::INet);
+  TCPListenSocket relayListen(&events, &multiplexer, IArchNetwork::AddressFamily::INet);
+  std::vector<std::unique_ptr<Relay>> relays;
+  std::vector<std::unique_ptr<IDataSocket>> serverSockets;
+  std::unique_ptr<PacketStreamFilter> serverMain;
+  std::unique_ptr<PacketStreamFilter> serverHello;
+  std::unique_ptr<BulkChannel> serverBulk;
+  std::unique_ptr<PacketStreamFilter> clientMain;
+  std::unique_ptr<PacketStreamFilter> clientHello;
+  std::unique_ptr<BulkChannel> clientBulk;
+  Arrivals arrivals;
+
+  NetworkAddress serverAddress;
+  NetworkAddress relayAddress;
+  if (!bindLoopback(serverListen, 49352, serverAddress) || !bindLoopback(relayListen, 49452, relayAddress)) {
+    return arrivals;
+  }
+
+  // the link
+  double lastForward = Arch::time();
+  auto *linkTimer = events.newTimer(kLinkInterval, nullptr);
+  events.addHandler(EventTypes::Timer, linkTimer, [&](const auto &) {
+    const auto now = Arch::time();
+    for (const auto &relay : relays) {
+      relay->forward(now - lastForward);
+    }
+    lastForward = now;
+  });
+  events.addHandler(EventTypes::ListenSocketConnecting, relayListen.getEventTarget(), [&](const auto &) {
+    auto &relay = relays.emplace_back(std::make_unique<Relay>(&events, &multiplexer, relayListen.accept()));
+    relay->connect(serverAddress);
+  });
+
+  // the server
+  std::vector<double> sentAt;
+  EventQueueTimer *keyTimer = nullptr;
+  int clipboardTarget = 0;
+  std::string token;
+  const auto start = [&] {
+    auto *stream = serverBulk != nullptr ? serverBulk->getStream() : serverMain.get();
+    events.addHandler(EventTypes::ClipboardSending, &clipboardTarget, [stream](const auto &e) {
+      ClipboardChunk::send(stream, e.getDataObject());
+    });
+    StreamChunker::sendClipboard(content, content.size(), kClipboardClipboard, 0, &events, &clipboardTarget);
+
+    keyTimer = events.newTimer(kKeyInterval, nullptr);
+    events.addHandler(EventTypes::Timer, keyTimer, [&](const auto &) {
+      const auto id = static_cast<uint16_t>(sentAt.size());
+      sentAt.push_back(Arch::time());
+      ProtocolUtil::writef(serverMain.get(), kMsgDKeyDown, id, 0, 0);
+    });
+  };
+  events.addHandler(EventTypes::ListenSocketConnecting, serverListen.getEventTarget(), [&](const auto &) {
+    auto *socket = serverSockets.emplace_back(serverListen.accept()).get();
+    if (serverMain == nullptr) {
+      serverMain = std::make_unique<PacketStreamFilter>(&events, socket, false);
+      if (!bulk) {
+        start();
+        return;
+      }
+      token = BulkChannel::newToken();
+      ProtocolUtil::writef(serverMain.get(), kMsgDBulkChannel, &token);
+      return;
+    }
+
+    // the bulk connection says hello like a new client, with the token
+    serverHello = std::make_unique<PacketStreamFilter>(&events, socket, false);
+    const auto hello = std::string(kSynergyProtocolName) + kMsgHelloArgs;
+    ProtocolUtil::writef(serverHello.get(), hello.c_str(), kProtocolMajorVersion, kProtocolMinorVersion);
+    events.addHandler(EventTypes::StreamInputReady, serverHello->getEventTarget(), [&](const auto &) {
+      std::string protocolName;
+      int16_t major;
+      int16_t minor;
+      std::string name;
+      std::string offered;
+      if (!ProtocolUtil::readf(serverHello.get(), kMsgHelloBack, &protocolName, &major, &minor, &name) ||
+          !ProtocolUtil::readf(serverHello.get(), "%s", &offered) || !BulkChannel::isToken(offered, token)) {
+        return;
+      }
+      events.removeHandler(EventTypes::StreamInputReady, serverHello->getEventTarget());
+      serverBulk = std::make_unique<BulkChannel>(&events, serverHello.release(), directory.path(), [](auto *) {});
+      start();
+    });
+  });
+
+  // the client
+  std::array<std::string, kClipboardEnd> clipboards;
+  const auto readClipboard = [&](deskflow::IStream *stream) {
+    ClipboardID id;
+    uint32_t sequence;
+    if (ClipboardChunk::assemble(stream, clipboards, id, sequence) == TransferState::Finished) {
+      arrivals.finished = clipboards[id] == content;
+      events.addEvent(Event(EventTypes::Quit));
+    }
+  };
+  const auto openBulk = [&](const std::string &offered) {
+    auto *socket = new TCPSocket(&events, &multiplexer);
+    clientHello = std::make_unique<PacketStreamFilter>(&events, socket, true);
+    events.addHandler(EventTypes::StreamInputReady, clientHello->getEventTarget(), [&, offered](const auto &) {
+      events.removeHandler(EventTypes::StreamInputReady, clientHello->getEventTarget());
+      if (BulkChannel::helloBack(clientHello.get(), "client", offered)) {
+        clientBulk = std::make_unique<BulkChannel>(&events, clientHello.release(), directory.path(), readClipboard);
+      }
+    });
+    socket->connect(relayAddress);
+  };
+  auto *socket = new TCPSocket(&events, &multiplexer);
+  clientMain = std::make_unique<PacketStreamFilter>(&events, socket, true);
+  events.addHandler(EventTypes::StreamInputReady, clientMain->getEventTarget(), [&](const auto &) {
+    uint8_t code[4];
+    while (clientMain->read(code, 4) == 4) {
+      if (memcmp(code, kMsgDKeyDown, 4) == 0) {
+        uint16_t id = 0;
+        uint16_t mask = 0;
+        uint16_t button = 0;
+        ProtocolUtil::readf(clientMain.get(), kMsgDKeyDown + 4, &id, &mask, &button);
+        if (!arrivals.finished && id < sentAt.size()) {
+          arrivals.keys.push_back(id);
+          arrivals.latency.push_back(Arch::time() - sentAt[id]);
+        }
+      } else if (memcmp(code, kMsgDClipboard, 4) == 0) {
+        readClipboard(clientMain.get());
+      } else if (memcmp(code, kMsgDBulkChannel, 4) == 0) {
+        std::string offered;
+        ProtocolUtil::readf(clientMain.get(), kMsgDBulkChannel + 4, &offered);
+        openBulk(offered);
+      }
+    }
+  });
+  socket->connect(relayAddress);
+
+  auto *timeout = events.newOneShotTimer(30.0, nullptr);
+  events.addHandler(EventTypes::Timer, timeout, [&events](const auto &) { events.addEvent(Event(EventTypes::Quit)); });
+
+  events.loop();
+
+  for (auto *timer : {linkTimer, keyTimer, timeout}) {
+    if (timer != nullptr) {
+      events.removeHandler(EventTypes::Timer, timer);
+      events.deleteTimer(timer);
+    }
+  }
+  events.removeHandler(EventTypes::ClipboardSending, &clipboardTarget);
+  return arrivals;
+}
+
+} // namespace
+
+void BulkChannelTests::matchesTokens()
+{
+  const auto token = BulkChannel::newToken();
+  QCOMPARE(token.size(), size_t(32));
+  QVERIFY(token != BulkChannel::newToken());
+
+  QVERIFY(BulkChannel::isToken(token, token));
+  QVERIFY(!BulkChannel::isToken(token.substr(1), token));
+  QVERIFY(!BulkChannel::isToken(BulkChannel::newToken(), token));
+  QVERIFY(!BulkChannel::isToken("", ""));
+}
+
+void BulkChannelTests::keysOvertakeClipboard()
+{
+  std::string content(kClipboardSize, '\0');
+  for (size_t i = 0; i < content.size(); ++i) {
+    content[i] = static_cast<char>(i * 131);
+  }
+
+  const auto shared = measure(false, content);
+  QVERIFY(shared.finished);
+  QVERIFY(shared.inOrder());
+
+  const auto bulk = measure(true, content);
+  QVERIFY(bulk.finished);
+  QVERIFY(bulk.inOrder());
+
+  // on a shared connection key presses queue behind the clipboard, on the
+  // bulk connection they go ahead of it
+  qInfo(
+      "key presses ahead of a %d MB clipboard, shared connection: %d, bulk connection: %d", //
+      static_cast<int>(kClipboardSize >> 20), static_cast<int>(shared.keys.size()), static_cast<int>(bulk.keys.size())
+  );
+  QVERIFY(!bulk.keys.empty());
+  QVERIFY(bulk.keys.size() > shared.keys.size());
+
+  bool isSet = false;
+  const auto maxLatencyMs = qEnvironmentVariableIntValue(kMaxLatencyVariable, &isSet);
+  const auto maxLatency = (isSet ? maxLatencyMs : kDefaultMaxLatencyMs) / 1000.0;
+  const auto latency = bulk.percentile(0.95);
+  qInfo("p95 key latency with the bulk connection: %.1f ms", latency * 1000);
+  if (maxLatency > 0.0) {
+    QVERIFY(latency < maxLatency);
+  }
+}
+
+QTEST_MAIN(BulkChannelTests)
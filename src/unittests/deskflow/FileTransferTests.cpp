@@ -0,0 +1,369 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "FileTransferTests.h"
+#include "../net/Loopback.h"
+
+#include "base/EventQueue.h"
+#include "deskflow/BulkShaper.h"
+#include "deskflow/FileTransfer.h"
+#include "deskflow/PacketStreamFilter.h"
+#include "deskflow/ProtocolTypes.h"
+#include "deskflow/ProtocolUtil.h"
+#include "net/NetworkAddress.h"
+#include "net/SocketMultiplexer.h"
+#include "net/TCPListenSocket.h"
+#include "net/TCPSocket.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QScopeGuard>
+#include <QTemporaryDir>
+
+#include <cstring>
+#include <functional>
+#include <memory>
+
+namespace {
+
+// well under loopback throughput, so the shaper is all that limits it
+const double kShapedRate = 16.0 * 1024 * 1024;
+
+// how late a sender's timer fires after each wait the shaper asks for
+const int64_t kTimerLateness = 1000000;
+
+// link the transfer must fill 90% of, gigabit ethernet unless the environment
+// names another in Mbit/s, 0 to only report the rate on a slow machine
+const auto kLinkVariable = "DESKFLOW_TEST_LINK_MBPS";
+const int kDefaultLinkMbps = 1000;
+
+using Start = std::function<void(FileTransfer &sender, deskflow::IStream &stream)>;
+
+QByteArray makeContent(qsizetype size)
+{
+  QByteArray content(size, Qt::Uninitialized);
+  for (qsizetype i = 0; i < size; ++i) {
+    content[i] = static_cast<char>((i * 131) ^ (i >> 12));
+  }
+  return content;
+}
+
+QString writeFile(const QString &path, const QByteArray &content)
+{
+  QFile file(path);
+  if (!file.open(QFile::WriteOnly) || file.write(content) != content.size()) {
+    return {};
+  }
+  return path;
+}
+
+QByteArray readFile(const QString &path)
+{
+  QFile file(path);
+  return file.open(QFile::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+// reads messages like the proxies do
+void readMessages(deskflow::IStream *stream, FileTransfer *transfer)
+{
+  uint8_t code[4];
+  while (stream->read(code, 4) == 4) {
+    if (memcmp(code, kMsgDFileTransfer, 4) == 0) {
+      transfer->readFileTransfer();
+    } else if (memcmp(code, kMsgDDragInfo, 4) == 0) {
+      transfer->readDragInfo();
+    } else {
+      while (stream->read(nullptr, 4) != 0) {
+        // discard the rest
+      }
+    }
+  }
+}
+
+// connects a sender and a receiver over loopback, as a server and client are, runs
+// \p start once both are up and returns the path of the first file received
+bool transfer(
+    const QString &directory, const Start &start, QString &received, uint64_t receiveLimit = UINT64_MAX,
+    double timeout = 10.0
+)
+{
+  EventQueue events;
+  SocketMultiplexer multiplexer;
+  TCPListenSocket listen(&events, &multiplexer, IArchNetwork::AddressFamily::INet);
+  std::unique_ptr<IDataSocket> accepted;
+  std::unique_ptr<PacketStreamFilter> senderStream;
+  std::unique_ptr<PacketStreamFilter> receiverStream;
+  std::unique_ptr<FileTransfer> sender;
+  std::unique_ptr<FileTransfer> receiver;
+
+  NetworkAddress address;
+  if (!bindLoopback(listen, 49152, address)) {
+    return false;
+  }
+
+  const auto startWhenConnected = [&] {
+    if (sender != nullptr && receiver != nullptr) {
+      start(*sender, *senderStream);
+    }
+  };
+
+  events.addHandler(EventTypes::ListenSocketConnecting, listen.getEventTarget(), [&](const auto &) {
+    accepted = listen.accept();
+    receiverStream = std::make_unique<PacketStreamFilter>(&events, accepted.get(), false);
+    receiver = std::make_unique<FileTransfer>(&events, receiverStream.get(), directory);
+    receiver->setReceiveLimit(receiveLimit);
+    events.addHandler(EventTypes::StreamInputReady, receiverStream->getEventTarget(), [&](const auto &) {
+      readMessages(receiverStream.get(), receiver.get());
+    });
+    events.addHandler(EventTypes::FileReceived, receiver.get(), [&](const auto &) {
+      received = receiver->lastReceived();
+      events.addEvent(Event(EventTypes::Quit));
+    });
+    startWhenConnected();
+  });
+
+  auto *socket = new TCPSocket(&events, &multiplexer);
+  senderStream = std::make_unique<PacketStreamFilter>(&events, socket, true);
+  events.addHandler(EventTypes::DataSocketConnected, senderStream->getEventTarget(), [&](const auto &) {
+    sender = std::make_unique<FileTransfer>(&events, senderStream.get(), directory);
+    events.addHandler(EventTypes::StreamInputReady, senderStream->getEventTarget(), [&](const auto &) {
+      readMessages(senderStream.get(), sender.get());
+    });
+    startWhenConnected();
+  });
+  socket->connect(address);
+
+  bool timedOut = false;
+  auto *timer = events.newOneShotTimer(timeout, nullptr);
+  events.addHandler(EventTypes::Timer, timer, [&events, &timedOut](const Event &) {
+    timedOut = true;
+    events.addEvent(Event(EventTypes::Quit));
+  });
+
+  events.loop();
+
+  events.removeHandler(EventTypes::Timer, timer);
+  events.deleteTimer(timer);
+  return !timedOut;
+}
+
+} // namespace
+
+void FileTransferTests::transfersFiles()
+{
+  QTemporaryDir source;
+  QTemporaryDir target;
+  const auto content = makeContent(3 * FileTransfer::kWindowSize + 12345);
+  const auto path = writeFile(source.filePath("report.pdf"), content);
+  QVERIFY(!path.isEmpty());
+
+  // a file of the same name is already there
+  QVERIFY(!writeFile(target.filePath("report.pdf"), "old").isEmpty());
+
+  QString received;
+  QVERIFY(transfer(target.path(), [&path](FileTransfer &sender, auto &) { sender.sendFiles({path}); }, received));
+
+  QCOMPARE(received, target.filePath("report (2).pdf"));
+  QVERIFY(readFile(received) == content);
+  QCOMPARE(readFile(target.filePath("report.pdf")), QByteArray("old"));
+}
+
+void FileTransferTests::resumesPartialFile()
+{
+  QTemporaryDir source;
+  QTemporaryDir target;
+  // large enough that the partial file takes more than one hashing step
+  const auto content = makeContent(3 * FileTransfer::kHashStepSize);
+  const auto path = writeFile(source.filePath("image.iso"), content);
+  QVERIFY(!path.isEmpty());
+
+  // as left by an interrupted transfer
+  const auto digest = QCryptographicHash::hash(content, QCryptographicHash::Sha256);
+  const auto half = content.size() / 2;
+  QVERIFY(!writeFile(FileTransfer::partPath(target.path(), digest), content.left(half)).isEmpty());
+
+  const auto resumed = FileTransfer::getProgress().resumed;
+  QString received;
+  QVERIFY(transfer(target.path(), [&path](FileTransfer &sender, auto &) { sender.sendFiles({path}); }, received));
+
+  QCOMPARE(received, target.filePath("image.iso"));
+  QVERIFY(readFile(received) == content);
+  QCOMPARE(FileTransfer::getProgress().resumed - resumed, static_cast<uint64_t>(half));
+  QVERIFY(!QFile::exists(FileTransfer::partPath(target.path(), digest)));
+}
+
+void FileTransferTests::rejectsCorruptData()
+{
+  QTemporaryDir target;
+  const auto content = makeContent(4096);
+  auto corrupt = content;
+  corrupt[100] = static_cast<char>(corrupt[100] ^ 1);
+  const auto digest = QCryptographicHash::hash(content, QCryptographicHash::Sha256);
+
+  // announces the digest of the content, then sends the corrupt data
+  const auto start = [&](FileTransfer &, deskflow::IStream &stream) {
+    std::string names("notes.txt", 10);
+    ProtocolUtil::writef(&stream, kMsgDDragInfo, 1, &names);
+
+    std::string header(8, '\0');
+    header[6] = static_cast<char>(content.size() >> 8);
+    header[7] = static_cast<char>(content.size() & 0xff);
+    header.append(digest.constData(), digest.size());
+    ProtocolUtil::writef(&stream, kMsgDFileTransfer, ChunkType::DataStart, &header);
+
+    std::string data(corrupt.constData(), corrupt.size());
+    ProtocolUtil::writef(&stream, kMsgDFileTransfer, ChunkType::DataChunk, &data);
+
+    std::string end;
+    ProtocolUtil::writef(&stream, kMsgDFileTransfer, ChunkType::DataEnd, &end);
+  };
+
+  const auto failed = FileTransfer::getProgress().filesFailed;
+  QString received = "unset";
+  QVERIFY(transfer(target.path(), start, received));
+
+  QVERIFY(received.isEmpty());
+  QCOMPARE(FileTransfer::getProgress().filesFailed, failed + 1);
+  QVERIFY(QDir(target.path()).entryList(QDir::Files | QDir::Hidden).isEmpty());
+}
+
+void FileTransferTests::refusesFiles()
+{
+  QTemporaryDir source;
+  QTemporaryDir target;
+  const auto content = makeContent(FileTransfer::kWindowSize);
+  const auto path = writeFile(source.filePath("unwanted.bin"), content);
+  QVERIFY(!path.isEmpty());
+
+  // receiving turned off, then a file over the limit
+  for (const uint64_t limit : {uint64_t{0}, static_cast<uint64_t>(content.size() - 1)}) {
+    QString received = "unset";
+    QVERIFY(transfer(
+        target.path(), [&path](FileTransfer &sender, auto &) { sender.sendFiles({path}); }, received, limit
+    ));
+    QVERIFY(received.isEmpty());
+    QVERIFY(QDir(target.path()).entryList(QDir::Files | QDir::Hidden).isEmpty());
+  }
+}
+
+void FileTransferTests::skipsUnansweredFile()
+{
+  QTemporaryDir source;
+  const auto path = writeFile(source.filePath("ignored.bin"), makeContent(4096));
+  QVERIFY(!path.isEmpty());
+
+  EventQueue events;
+  SocketMultiplexer multiplexer;
+  TCPListenSocket listen(&events, &multiplexer, IArchNetwork::AddressFamily::INet);
+  NetworkAddress address;
+  QVERIFY(bindLoopback(listen, 49152, address));
+
+  // like a peer before 1.9, it takes the messages and never replies
+  std::unique_ptr<IDataSocket> accepted;
+  events.addHandler(EventTypes::ListenSocketConnecting, listen.getEventTarget(), [&](const auto &) {
+    accepted = listen.accept();
+  });
+
+  auto *socket = new TCPSocket(&events, &multiplexer);
+  PacketStreamFilter stream(&events, socket, true);
+  FileTransfer sender(&events, &stream, source.path());
+  sender.setResumeTimeout(0.2);
+  events.addHandler(EventTypes::DataSocketConnected, stream.getEventTarget(), [&](const auto &) {
+    sender.sendFiles({path});
+  });
+  const auto failed = FileTransfer::getProgress().filesFailed;
+  socket->connect(address);
+
+  auto *timer = events.newOneShotTimer(2.0, nullptr);
+  events.addHandler(EventTypes::Timer, timer, [&events](const Event &) { events.addEvent(Event(EventTypes::Quit)); });
+  events.loop();
+
+  events.removeHandler(EventTypes::Timer, timer);
+  events.deleteTimer(timer);
+  events.removeHandler(EventTypes::DataSocketConnected, stream.getEventTarget());
+  events.removeHandler(EventTypes::ListenSocketConnecting, listen.getEventTarget());
+
+  QVERIFY(accepted != nullptr);
+  QCOMPARE(FileTransfer::getProgress().filesFailed, failed + 1);
+}
+
+void FileTransferTests::transfersLargeFile()
+{
+  QTemporaryDir source;
+  QTemporaryDir target;
+  const auto content = makeContent(128 * 1024 * 1024);
+  const auto path = writeFile(source.filePath("large.bin"), content);
+  QVERIFY(!path.isEmpty());
+
+  QString received;
+  QVERIFY(transfer(
+      target.path(), [&path](FileTransfer &sender, auto &) { sender.sendFiles({path}); }, received, UINT64_MAX, 60.0
+  ));
+  QVERIFY(readFile(received) == content);
+
+  bool isSet = false;
+  const auto linkMbps = qEnvironmentVariableIntValue(kLinkVariable, &isSet);
+  const auto minRate = 0.9 * (isSet ? linkMbps : kDefaultLinkMbps) * 1e6 / 8;
+  const auto rate = FileTransfer::getProgress().receiveRate;
+  qInfo("received at %.1f MB/s, %.1f MB/s needed", rate / 1e6, minRate / 1e6);
+  QVERIFY(rate >= minRate);
+}
+
+void FileTransferTests::shapesToRate()
+{
+  QTemporaryDir source;
+  QTemporaryDir target;
+  const auto content = makeContent(static_cast<qsizetype>(2 * kShapedRate));
+  const auto path = writeFile(source.filePath("shaped.bin"), content);
+  QVERIFY(!path.isEmpty());
+
+  // limited by the sender's bucket, then by the one shared by every sender
+  for (const bool global : {false, true}) {
+    BulkShaper shaper;
+    const auto delays = BulkShaper::getStats().delays;
+
+    // other tests must not inherit the global limit, even when this one fails
+    const auto resetGlobal = qScopeGuard([] { BulkShaper::setGlobalRate(0.0); });
+
+    QString received;
+    const auto start = [&](FileTransfer &sender, auto &) {
+      // from now, so the buckets don't fill while connecting
+      shaper.setRate(global ? 0.0 : kShapedRate);
+      BulkShaper::setGlobalRate(global ? kShapedRate : 0.0);
+      sender.setShaper(&shaper);
+      sender.sendFiles({path});
+    };
+    QVERIFY(transfer(target.path(), start, received));
+    QVERIFY(readFile(received) == content);
+
+    qInfo(
+        "%s limit: received at %.2f MiB/s", global ? "global" : "client",
+        FileTransfer::getProgress().receiveRate / (1024 * 1024)
+    );
+    QVERIFY(BulkShaper::getStats().delays > delays);
+
+    // the rate itself, on a clock that only moves while the sender waits
+    int64_t now = 0;
+    BulkShaper::setClock([&now] { return now; });
+    const auto resetClock = qScopeGuard([] { BulkShaper::setClock({}); });
+    shaper.setRate(global ? 0.0 : kShapedRate);
+    BulkShaper::setGlobalRate(global ? kShapedRate : 0.0);
+
+    uint64_t sent = 0;
+    while (sent < static_cast<uint64_t>(content.size())) {
+      if (const auto wait = shaper.take(FileTransfer::kChunkSize); wait > 0.0) {
+        now += static_cast<int64_t>(wait * 1e9) + kTimerLateness;
+      } else {
+        sent += FileTransfer::kChunkSize;
+      }
+    }
+    const auto rate = static_cast<double>(sent) * 1e9 / static_cast<double>(now);
+    QVERIFY(rate >= 0.95 * kShapedRate);
+    QVERIFY(rate <= 1.05 * kShapedRate);
+  }
+}
+
+QTEST_MAIN(FileTransferTests)
@@ -0,0 +1,27 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "arch/Arch.h"
+#include "base/Log.h"
+
+#include <QTest>
+
+class FileTransferTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void transfersFiles();
+  void resumesPartialFile();
+  void rejectsCorruptData();
+  void refusesFiles();
+  void skipsUnansweredFile();
+  void transfersLargeFile();
+  void shapesToRate();
+
+private:
+  Arch m_arch;
+  Log m_log;
+};
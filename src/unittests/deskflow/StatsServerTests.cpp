@@ -0,0 +1,172 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "StatsServerTests.h"
+#include "../net/Loopback.h"
+
+#include "base/EventQueue.h"
+#include "deskflow/StatsServer.h"
+#include "net/NetworkAddress.h"
+#include "net/SocketMultiplexer.h"
+#include "net/TCPListenSocket.h"
+#include "net/TCPSocket.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTemporaryDir>
+
+namespace {
+
+// a port nothing listens on right now
+int freePort(IEventQueue &events, SocketMultiplexer &multiplexer)
+{
+  TCPListenSocket listen(&events, &multiplexer, IArchNetwork::AddressFamily::INet);
+  NetworkAddress address;
+  return bindLoopback(listen, 49552, address) ? address.getPort() : 0;
+}
+
+// sends \p request and returns what comes back until \p lines replies or the server hangs up
+QByteArray exchange(EventQueue &events, SocketMultiplexer &multiplexer, int port, const QByteArray &request, int lines)
+{
+  TCPSocket socket(&events, &multiplexer);
+  QByteArray received;
+  const auto quit = [&events] { events.addEvent(Event(EventTypes::Quit)); };
+
+  events.addHandler(EventTypes::DataSocketConnected, socket.getEventTarget(), [&](const auto &) {
+    socket.write(request.constData(), static_cast<uint32_t>(request.size()));
+  });
+  events.addHandler(EventTypes::StreamInputReady, socket.getEventTarget(), [&](const auto &) {
+    char data[1024];
+    for (uint32_t n = socket.read(data, sizeof(data)); n > 0; n = socket.read(data, sizeof(data))) {
+      received.append(data, n);
+    }
+    if (received.count('\n') >= lines) {
+      quit();
+    }
+  });
+  events.addHandler(EventTypes::StreamInputShutdown, socket.getEventTarget(), [&](const auto &) { quit(); });
+  events.addHandler(EventTypes::SocketDisconnected, socket.getEventTarget(), [&](const auto &) { quit(); });
+
+  NetworkAddress address("127.0.0.1", port);
+  address.resolve();
+  socket.connect(address);
+
+  auto *timer = events.newOneShotTimer(5.0, nullptr);
+  events.addHandler(EventTypes::Timer, timer, [&](const auto &) { quit(); });
+  events.loop();
+
+  events.removeHandler(EventTypes::Timer, timer);
+  events.deleteTimer(timer);
+  events.removeHandlers(socket.getEventTarget());
+  return received;
+}
+
+} // namespace
+
+void StatsServerTests::statsHaveBuiltInSections()
+{
+  EventQueue events;
+  StatsServer server(&events, nullptr, 0);
+
+  const auto document = QJsonDocument::fromJson(server.handleRequest("stats\n"));
+  QVERIFY(document.isObject());
+
+  const auto stats = document.object();
+  QVERIFY(stats.contains("uptimeMs"));
+  QVERIFY(stats.value("eventQueue").isObject());
+  QVERIFY(stats.value("log").isObject());
+  QVERIFY(stats.value("clipboard").isObject());
+  QVERIFY(stats.value("files").isObject());
+  QVERIFY(stats.value("threads").isArray());
+#if defined(__linux__)
+  QVERIFY(!stats.value("threads").toArray().isEmpty());
+#endif
+}
+
+void StatsServerTests::sourcesAreAddedAndReplaced()
+{
+  EventQueue events;
+  StatsServer server(&events, nullptr, 0);
+
+  server.addSource("clients", [] { return QJsonValue(1); });
+  QCOMPARE(server.collect().value("clients").toInt(), 1);
+
+  server.addSource("clients", [] { return QJsonValue(2); });
+  QCOMPARE(server.collect().value("clients").toInt(), 2);
+}
+
+void StatsServerTests::eventQueueCounts()
+{
+  EventQueue events;
+  StatsServer server(&events, nullptr, 0);
+  auto *timer = events.newTimer(60.0, nullptr);
+
+  int target = 0;
+  events.addHandler(EventTypes::Quit, &target, [](const auto &) {});
+  events.addEvent(Event(EventTypes::Quit, &target, nullptr, Event::EventFlags::DeliverImmediately));
+
+  const auto queue = server.collect().value("eventQueue").toObject();
+  QCOMPARE(queue.value("added").toInt(), 1);
+  QCOMPARE(queue.value("dispatched").toInt(), 1);
+  QCOMPARE(queue.value("timers").toInt(), 1);
+
+  events.removeHandler(EventTypes::Quit, &target);
+  events.deleteTimer(timer);
+}
+
+void StatsServerTests::changesLogLevel()
+{
+  EventQueue events;
+  StatsServer server(&events, nullptr, 0);
+  const auto previous = QByteArray(CLOG->getFilterName());
+
+  QCOMPARE(server.handleRequest("logLevel=DEBUG2"), QByteArray("ok"));
+  QCOMPARE(server.handleRequest("logLevel"), QByteArray("DEBUG2"));
+  QCOMPARE(server.handleRequest("logLevel=LOUD"), QByteArray("error"));
+  QCOMPARE(server.handleRequest("logLevel"), QByteArray("DEBUG2"));
+
+  QCOMPARE(server.handleRequest("logLevel=" + previous), QByteArray("ok"));
+}
+
+void StatsServerTests::rejectsUnknownRequests()
+{
+  EventQueue events;
+  StatsServer server(&events, nullptr, 0);
+
+  QCOMPARE(server.handleRequest("reboot"), QByteArray("error"));
+  QCOMPARE(server.handleRequest(""), QByteArray("error"));
+}
+
+void StatsServerTests::requiresToken()
+{
+  EventQueue events;
+  SocketMultiplexer multiplexer;
+  QTemporaryDir directory;
+  const auto tokenFile = directory.filePath("stats.token");
+  const auto port = freePort(events, multiplexer);
+  QVERIFY(port > 0);
+
+  {
+    StatsServer server(&events, &multiplexer, port, tokenFile);
+    QFile file(tokenFile);
+    QVERIFY(file.open(QFile::ReadOnly));
+    QCOMPARE(file.permissions() & (QFile::ReadGroup | QFile::ReadOther), QFileDevice::Permissions());
+    const auto token = file.readAll();
+    QVERIFY(!token.isEmpty());
+
+    QCOMPARE(exchange(events, multiplexer, port, "logLevel=DEBUG2\n", 1), QByteArray());
+    QCOMPARE(exchange(events, multiplexer, port, "auth=wrong\nlogLevel\n", 1), QByteArray());
+    QCOMPARE(
+        exchange(events, multiplexer, port, "auth=" + token + "\nlogLevel\n", 2),
+        "ok\n" + QByteArray(CLOG->getFilterName()) + "\n"
+    );
+  }
+
+  QVERIFY(!QFile::exists(tokenFile));
+}
+
+QTEST_MAIN(StatsServerTests)
@@ -0,0 +1,26 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "arch/Arch.h"
+#include "base/Log.h"
+
+#include <QTest>
+
+class StatsServerTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void statsHaveBuiltInSections();
+  void sourcesAreAddedAndReplaced();
+  void eventQueueCounts();
+  void changesLogLevel();
+  void rejectsUnknownRequests();
+  void requiresToken();
+
+private:
+  Arch m_arch;
+  Log m_log;
+};
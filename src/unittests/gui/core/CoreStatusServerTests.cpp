@@ -0,0 +1,192 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "CoreStatusServerTests.h"
+
+#include "common/IpcFrame.h"
+#include "gui/core/CoreStatusServer.h"
+
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSignalSpy>
+#include <QTcpSocket>
+#include <QTemporaryDir>
+
+using namespace deskflow::gui;
+using deskflow::ipc::encodeFrame;
+
+namespace {
+
+QByteArray hello(const QString &token)
+{
+  return encodeFrame(QStringLiteral(R"({"type":"hello","token":"%1"})").arg(token).toUtf8());
+}
+
+} // namespace
+
+void CoreStatusServerTests::handleMessage_connection()
+{
+  CoreStatusServer server;
+  QSignalSpy spy(&server, &CoreStatusServer::connectionStateChanged);
+
+  server.handleMessage(R"({"type":"connection","state":"listening"})");
+
+  QCOMPARE(spy.count(), 1);
+  QCOMPARE(spy.first().first().toString(), QStringLiteral("listening"));
+}
+
+void CoreStatusServerTests::handleMessage_clients()
+{
+  CoreStatusServer server;
+  QSignalSpy spy(&server, &CoreStatusServer::clientsChanged);
+
+  server.handleMessage(R"({"type":"clients","names":["laptop","desk"]})");
+
+  QCOMPARE(spy.count(), 1);
+  QCOMPARE(spy.first().first().toStringList(), QStringList({"laptop", "desk"}));
+}
+
+void CoreStatusServerTests::handleMessage_fingerprint()
+{
+  CoreStatusServer server;
+  QSignalSpy spy(&server, &CoreStatusServer::peerFingerprint);
+  QSignalSpy tlsSpy(&server, &CoreStatusServer::tlsProtocolChanged);
+
+  server.handleMessage(R"({"type":"fingerprint","sha256":"AB:CD"})");
+  server.handleMessage(R"({"type":"tls","protocol":"TLSv1.3"})");
+  server.handleMessage(R"({"type":"unknown"})");
+
+  QCOMPARE(spy.count(), 1);
+  QCOMPARE(spy.first().first().toString(), QStringLiteral("AB:CD"));
+  QCOMPARE(tlsSpy.count(), 1);
+  QCOMPARE(tlsSpy.first().first().toString(), QStringLiteral("TLSv1.3"));
+}
+
+void CoreStatusServerTests::socket_splitFrames()
+{
+  CoreStatusServer server;
+  const auto port = server.listen();
+  QVERIFY(port != 0);
+  QSignalSpy stateSpy(&server, &CoreStatusServer::connectionStateChanged);
+  QSignalSpy clientsSpy(&server, &CoreStatusServer::clientsChanged);
+
+  QTcpSocket socket;
+  socket.connectToHost(QHostAddress::LocalHost, port);
+  QVERIFY(socket.waitForConnected());
+
+  // three frames, written across three packets
+  const auto data = hello(server.token()) + encodeFrame(R"({"type":"connection","state":"connecting"})") +
+                    encodeFrame(R"({"type":"clients","names":[]})");
+  socket.write(data.left(2));
+  socket.flush();
+  QTest::qWait(20);
+  socket.write(data.mid(2, 80));
+  socket.flush();
+  QTest::qWait(20);
+  socket.write(data.mid(82));
+  socket.flush();
+
+  QTRY_COMPARE(clientsSpy.count(), 1);
+  QCOMPARE(stateSpy.count(), 1);
+  QCOMPARE(stateSpy.first().first().toString(), QStringLiteral("connecting"));
+}
+
+void CoreStatusServerTests::socket_disconnect()
+{
+  CoreStatusServer server;
+  const auto port = server.listen();
+  QSignalSpy spy(&server, &CoreStatusServer::coreDisconnected);
+
+  QTcpSocket socket;
+  socket.connectToHost(QHostAddress::LocalHost, port);
+  QVERIFY(socket.waitForConnected());
+  socket.write(hello(server.token()) + encodeFrame(R"({"type":"connection","state":"connected"})"));
+  socket.flush();
+  socket.disconnectFromHost();
+
+  QTRY_COMPARE(spy.count(), 1);
+}
+
+void CoreStatusServerTests::socket_wrongToken()
+{
+  CoreStatusServer server;
+  const auto port = server.listen();
+  QVERIFY(port != 0);
+  QVERIFY(server.token().size() >= 32);
+  QSignalSpy stateSpy(&server, &CoreStatusServer::connectionStateChanged);
+  QSignalSpy fingerprintSpy(&server, &CoreStatusServer::peerFingerprint);
+
+  QString wrong = server.token();
+  wrong[0] = wrong[0] == QLatin1Char('0') ? QLatin1Char('1') : QLatin1Char('0');
+
+  // neither a wrong token nor no hello at all is let through
+  for (const auto &first : {hello(wrong), encodeFrame(R"({"type":"connection","state":"connected"})")}) {
+    QTcpSocket socket;
+    socket.connectToHost(QHostAddress::LocalHost, port);
+    QVERIFY(socket.waitForConnected());
+    socket.write(first + encodeFrame(R"({"type":"fingerprint","sha256":"AB:CD"})"));
+    socket.flush();
+    QTRY_COMPARE(socket.state(), QAbstractSocket::UnconnectedState);
+  }
+
+  // a rejected connection doesn't replace the core
+  QTcpSocket core;
+  core.connectToHost(QHostAddress::LocalHost, port);
+  QVERIFY(core.waitForConnected());
+  core.write(hello(server.token()) + encodeFrame(R"({"type":"connection","state":"listening"})"));
+  core.flush();
+
+  QTRY_COMPARE(stateSpy.count(), 1);
+  QCOMPARE(stateSpy.first().first().toString(), QStringLiteral("listening"));
+  QCOMPARE(fingerprintSpy.count(), 0);
+}
+
+void CoreStatusServerTests::socket_sendFiles()
+{
+  CoreStatusServer server;
+  const auto port = server.listen();
+  QVERIFY(port != 0);
+  QVERIFY(!server.sendFiles({"/tmp/a.txt"}));
+
+  QTcpSocket socket;
+  socket.connectToHost(QHostAddress::LocalHost, port);
+  QVERIFY(socket.waitForConnected());
+  socket.write(hello(server.token()));
+  socket.flush();
+
+  // accepted once the hello is read
+  QTRY_VERIFY(server.sendFiles({"/tmp/a.txt", "/tmp/b.txt"}, "laptop"));
+
+  deskflow::ipc::FrameReader reader;
+  std::optional<QByteArray> payload;
+  const auto receive = [&socket, &reader, &payload] {
+    reader.append(socket.readAll());
+    payload = reader.next();
+    return payload.has_value();
+  };
+  QTRY_VERIFY(receive());
+
+  const auto message = QJsonDocument::fromJson(*payload).object();
+  QCOMPARE(message.value("type").toString(), QStringLiteral("sendFiles"));
+  QCOMPARE(message.value("screen").toString(), QStringLiteral("laptop"));
+  QCOMPARE(message.value("paths").toVariant().toStringList(), QStringList({"/tmp/a.txt", "/tmp/b.txt"}));
+}
+
+void CoreStatusServerTests::writeTokenFile()
+{
+  QTemporaryDir dir;
+  const auto fileName = dir.filePath(QStringLiteral("status.token"));
+  CoreStatusServer server;
+  QVERIFY(server.writeTokenFile(fileName));
+
+  QFile file(fileName);
+  QVERIFY(file.open(QFile::ReadOnly));
+  QCOMPARE(QString::fromUtf8(file.readAll()), server.token());
+  QCOMPARE(file.permissions() & (QFile::ReadOther | QFile::ReadGroup), QFile::Permissions{});
+}
+
+QTEST_MAIN(CoreStatusServerTests)
@@ -0,0 +1,21 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include <QTest>
+
+class CoreStatusServerTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void handleMessage_connection();
+  void handleMessage_clients();
+  void handleMessage_fingerprint();
+  void socket_splitFrames();
+  void socket_disconnect();
+  void socket_wrongToken();
+  void socket_sendFiles();
+  void writeTokenFile();
+};
@@ -0,0 +1,114 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "LogModelTests.h"
+
+#include "gui/widgets/LogModel.h"
+
+#include <QSignalSpy>
+
+namespace {
+
+QStringList rows(const LogModel &model)
+{
+  QStringList result;
+  for (int row = 0; row < model.rowCount(); ++row) {
+    result.append(model.index(row).data().toString());
+  }
+  return result;
+}
+
+} // namespace
+
+void LogModelTests::appendIsBatched()
+{
+  LogModel model;
+  QSignalSpy inserted(&model, &LogModel::rowsInserted);
+
+  for (int i = 0; i < 100; ++i) {
+    model.appendLine(QString::number(i));
+  }
+  QCOMPARE(model.rowCount(), 0);
+
+  QTRY_COMPARE(model.rowCount(), 100);
+  QCOMPARE(inserted.count(), 1);
+  QCOMPARE(model.index(99).data().toString(), QStringLiteral("99"));
+}
+
+void LogModelTests::multiLineEntrySplits()
+{
+  LogModel model;
+  model.appendLines({QStringLiteral("first\n\tsecond"), QStringLiteral("third")});
+  model.flush();
+
+  QCOMPARE(rows(model), QStringList({"first", "\tsecond", "third"}));
+}
+
+void LogModelTests::dropsOldestWhenFull()
+{
+  LogModel model(nullptr, 4);
+  model.appendLines({"a", "b", "c"});
+  model.flush();
+  model.appendLines({"d", "e", "f"});
+  model.flush();
+  QCOMPARE(rows(model), QStringList({"c", "d", "e", "f"}));
+
+  // a burst larger than the buffer keeps only its newest lines
+  model.appendLines({"1", "2", "3", "4", "5", "6"});
+  model.flush();
+  QCOMPARE(rows(model), QStringList({"3", "4", "5", "6"}));
+}
+
+void LogModelTests::filterMatchesOffThread()
+{
+  LogModel model;
+  model.appendLines({"INFO: one", "ERROR: two", "INFO: three", "error: four"});
+  model.flush();
+
+  QSignalSpy applied(&model, &LogModel::filterApplied);
+  model.setFilter(QStringLiteral("error"));
+  QVERIFY(model.isFiltering());
+
+  QTRY_COMPARE(applied.count(), 1);
+  QVERIFY(!model.isFiltering());
+  QCOMPARE(rows(model), QStringList({"ERROR: two", "error: four"}));
+}
+
+void LogModelTests::filterFollowsNewLines()
+{
+  LogModel model(nullptr, 3);
+  model.appendLines({"keep 1", "skip", "keep 2"});
+  model.flush();
+
+  QSignalSpy applied(&model, &LogModel::filterApplied);
+  model.setFilter(QStringLiteral("keep"));
+  QTRY_COMPARE(applied.count(), 1);
+
+  // evicts "keep 1" and "skip"
+  model.appendLines({"keep 3", "skip"});
+  model.flush();
+  QCOMPARE(rows(model), QStringList({"keep 2", "keep 3"}));
+}
+
+void LogModelTests::clearFilterShowsAll()
+{
+  LogModel model;
+  model.appendLines({"a", "b"});
+  model.flush();
+
+  QSignalSpy applied(&model, &LogModel::filterApplied);
+  model.setFilter(QStringLiteral("a"));
+  model.setFilter(QString());
+
+  // the cleared filter applies at once and the stale result is ignored
+  QCOMPARE(applied.count(), 1);
+  QCOMPARE(rows(model), QStringList({"a", "b"}));
+  QTest::qWait(50);
+  QCOMPARE(applied.count(), 1);
+  QCOMPARE(rows(model), QStringList({"a", "b"}));
+}
+
+QTEST_MAIN(LogModelTests)
@@ -0,0 +1,19 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include <QTest>
+
+class LogModelTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void appendIsBatched();
+  void multiLineEntrySplits();
+  void dropsOldestWhenFull();
+  void filterMatchesOffThread();
+  void filterFollowsNewLines();
+  void clearFilterShowsAll();
+};
@@ -0,0 +1,103 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "ThreadTests.h"
+
+#include "base/FunctionJob.h"
+#include "mt/Thread.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct LatencyProbe
+{
+  std::vector<std::chrono::microseconds> overshoots;
+  bool realTime = false;
+};
+
+void measureWakeLatency(void *arg)
+{
+  using namespace std::chrono;
+  auto *probe = static_cast<LatencyProbe *>(arg);
+
+  // real-time is usually refused in CI
+  auto self = Thread::getCurrentThread();
+  probe->realTime = self.setScheduling(IArchMultithread::SchedulingPolicy::Fifo, 10);
+
+  const auto period = milliseconds(1);
+  for (int i = 0; i < 500; ++i) {
+    const auto start = steady_clock::now();
+    std::this_thread::sleep_for(period);
+    probe->overshoots.push_back(duration_cast<microseconds>(steady_clock::now() - start - period));
+  }
+}
+
+} // namespace
+
+void ThreadTests::schedulingDescription()
+{
+  const auto thread = Thread::getCurrentThread();
+  QVERIFY(!thread.getScheduling().empty());
+}
+
+void ThreadTests::normalScheduling()
+{
+  auto thread = Thread::getCurrentThread();
+  QVERIFY(thread.setScheduling(IArchMultithread::SchedulingPolicy::Normal, 0));
+
+#if SYSAPI_UNIX
+  QVERIFY(thread.getScheduling().starts_with("SCHED_OTHER"));
+#endif
+}
+
+void ThreadTests::affinityAllCpus()
+{
+  auto thread = Thread::getCurrentThread();
+  QVERIFY(thread.setAffinity({}));
+}
+
+void ThreadTests::wakeLatencyWithCpuHog()
+{
+  std::atomic<bool> stop = false;
+  std::vector<std::thread> hogs;
+  for (unsigned i = 0; i < std::max(1u, std::thread::hardware_concurrency()); ++i) {
+    hogs.emplace_back([&stop] {
+      volatile unsigned long spin = 0;
+      while (!stop.load(std::memory_order_relaxed)) {
+        spin = spin + 1;
+      }
+    });
+  }
+
+  LatencyProbe probe;
+  Thread thread(new FunctionJob(&measureWakeLatency, &probe));
+  thread.wait();
+
+  stop = true;
+  for (auto &hog : hogs) {
+    hog.join();
+  }
+
+  QVERIFY(!probe.overshoots.empty());
+  std::ranges::sort(probe.overshoots);
+  const auto p99 = probe.overshoots[probe.overshoots.size() * 99 / 100];
+  qInfo(
+      "wake latency p99 with %zu cpu hogs, %s: %lld us", hogs.size(), probe.realTime ? "real-time" : "time-sharing",
+      static_cast<long long>(p99.count())
+  );
+
+  // the hiccups we are trying to prevent are 20 - 50 ms, when real-time is
+  // refused the time-sharing scheduler must still not starve the thread
+  const auto limit = probe.realTime ? std::chrono::milliseconds(20) : std::chrono::milliseconds(100);
+  QVERIFY(p99 < limit);
+}
+
+QTEST_MAIN(ThreadTests)
@@ -0,0 +1,196 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "AsyncSocketTests.h"
+#include "Loopback.h"
+
+#include "base/EventQueue.h"
+#include "base/Task.h"
+#include "io/IOException.h"
+#include "net/AsyncSocket.h"
+#include "net/NetworkAddress.h"
+#include "net/SocketMultiplexer.h"
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+deskflow::Task<int> answer()
+{
+  co_return 42;
+}
+
+deskflow::Task<int> doubled()
+{
+  co_return 2 * co_await answer();
+}
+
+deskflow::Task<> fail()
+{
+  throw std::runtime_error("expected");
+  co_return;
+}
+
+deskflow::Task<> catchFailure(bool &caught)
+{
+  try {
+    co_await fail();
+  } catch (const std::runtime_error &) {
+    caught = true;
+  }
+}
+
+deskflow::Task<> serve(
+    IEventQueue &events, SocketMultiplexer &multiplexer, AsyncSocket &listener, std::vector<uint8_t> &received
+)
+{
+  AsyncSocket peer(&events, &multiplexer, co_await listener.accept());
+  std::vector<uint8_t> buffer(64 * 1024);
+  for (auto result = co_await peer.read(buffer); !result.eof; result = co_await peer.read(buffer)) {
+    received.insert(received.end(), buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(result.size));
+  }
+  events.addEvent(Event(EventTypes::Quit));
+}
+
+deskflow::Task<> acceptUntilClosed(IEventQueue &events, AsyncSocket &listener, bool &closed)
+{
+  try {
+    co_await listener.accept();
+  } catch (const IOClosedException &) {
+    closed = true;
+  }
+  events.addEvent(Event(EventTypes::Quit));
+}
+
+// sets \p destroyed when its frame goes, finished or not
+deskflow::Task<> acceptForever(AsyncSocket &listener, bool &destroyed)
+{
+  struct Guard
+  {
+    bool &destroyed;
+    ~Guard()
+    {
+      destroyed = true;
+    }
+  } guard{destroyed};
+  co_await listener.accept();
+}
+
+deskflow::Task<> send(AsyncSocket &client, const NetworkAddress &address, const std::vector<uint8_t> &payload)
+{
+  co_await client.connect(address);
+  co_await client.write(payload);
+  client.close();
+}
+
+} // namespace
+
+void AsyncSocketTests::taskReturnsValue()
+{
+  int result = 0;
+  [](int &out) -> deskflow::Task<> { out = co_await doubled(); }(result).detach();
+  QCOMPARE(result, 84);
+}
+
+void AsyncSocketTests::taskRethrows()
+{
+  bool caught = false;
+  catchFailure(caught).detach();
+  QVERIFY(caught);
+}
+
+void AsyncSocketTests::loopbackTransfer()
+{
+  EventQueue events;
+  SocketMultiplexer multiplexer;
+
+  AsyncSocket listener(&events, &multiplexer);
+  NetworkAddress address;
+  QVERIFY(bindLoopback(listener, 49152, address));
+  listener.listen();
+
+  // large enough to fill the socket buffers, so the writer has to wait
+  std::vector<uint8_t> payload(1024 * 1024);
+  for (size_t i = 0; i < payload.size(); ++i) {
+    payload[i] = static_cast<uint8_t>(i * 31);
+  }
+
+  std::vector<uint8_t> received;
+  AsyncSocket client(&events, &multiplexer);
+  serve(events, multiplexer, listener, received).detach(&events);
+  send(client, address, payload).detach(&events);
+
+  bool timedOut = false;
+  auto *timer = events.newOneShotTimer(10.0, nullptr);
+  events.addHandler(EventTypes::Timer, timer, [&events, &timedOut](const Event &) {
+    timedOut = true;
+    events.addEvent(Event(EventTypes::Quit));
+  });
+
+  events.loop();
+
+  events.removeHandler(EventTypes::Timer, timer);
+  events.deleteTimer(timer);
+
+  QVERIFY(!timedOut);
+  QCOMPARE(received.size(), payload.size());
+  QVERIFY(received == payload);
+}
+
+void AsyncSocketTests::closeResumesWaiter()
+{
+  EventQueue events;
+  SocketMultiplexer multiplexer;
+
+  AsyncSocket listener(&events, &multiplexer);
+  NetworkAddress address;
+  QVERIFY(bindLoopback(listener, 49152, address));
+  listener.listen();
+
+  // nobody connects, so the coroutine waits until the listener closes
+  bool closed = false;
+  acceptUntilClosed(events, listener, closed).detach(&events);
+  auto *timer = events.newOneShotTimer(0.1, nullptr);
+  events.addHandler(EventTypes::Timer, timer, [&listener](const Event &) { listener.close(); });
+
+  events.loop();
+
+  events.removeHandler(EventTypes::Timer, timer);
+  events.deleteTimer(timer);
+  QVERIFY(closed);
+}
+
+void AsyncSocketTests::queueDestroysWaiter()
+{
+  // the listener must outlive the queue that destroys the task waiting on it
+  SocketMultiplexer multiplexer;
+  auto events = std::make_unique<EventQueue>();
+  AsyncSocket listener(events.get(), &multiplexer);
+  NetworkAddress address;
+  QVERIFY(bindLoopback(listener, 49152, address));
+  listener.listen();
+
+  bool destroyed = false;
+  acceptForever(listener, destroyed).detach(events.get());
+  auto *timer = events->newOneShotTimer(0.1, nullptr);
+  events->addHandler(EventTypes::Timer, timer, [&events](const Event &) {
+    events->addEvent(Event(EventTypes::Quit));
+  });
+
+  events->loop();
+
+  events->removeHandler(EventTypes::Timer, timer);
+  events->deleteTimer(timer);
+  QVERIFY(!destroyed);
+
+  // nobody connected, so the task is still waiting when the queue goes
+  events.reset();
+  QVERIFY(destroyed);
+}
+
+QTEST_MAIN(AsyncSocketTests)
@@ -0,0 +1,25 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "arch/Arch.h"
+#include "base/Log.h"
+
+#include <QTest>
+
+class AsyncSocketTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void taskReturnsValue();
+  void taskRethrows();
+  void loopbackTransfer();
+  void closeResumesWaiter();
+  void queueDestroysWaiter();
+
+private:
+  Arch m_arch;
+  Log m_log;
+};
@@ -0,0 +1,30 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "net/NetworkAddress.h"
+#include "net/SocketException.h"
+
+//! Bind \p socket to the first free loopback port from \p firstPort
+/*!
+Tries a hundred ports so tests running side by side don't collide.
+Returns false if none was free, otherwise \p address is the one bound.
+*/
+template <typename Socket> bool bindLoopback(Socket &socket, int firstPort, NetworkAddress &address)
+{
+  for (int port = firstPort; port < firstPort + 100; ++port) {
+    try {
+      address = NetworkAddress("127.0.0.1", port);
+      address.resolve();
+      socket.bind(address);
+      return true;
+    } catch (const SocketAddressInUseException &) {
+      // try the next port
+    }
+  }
+  return false;
+}
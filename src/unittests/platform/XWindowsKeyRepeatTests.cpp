@@ -0,0 +1,197 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "XWindowsKeyRepeatTests.h"
+
+#include <X11/XKBlib.h>
+#include <X11/extensions/XTest.h>
+#include <X11/keysym.h>
+
+void XWindowsKeyRepeatTests::initTestCase()
+{
+  m_display = XOpenDisplay(nullptr);
+  if (m_display == nullptr) {
+    QSKIP("no X display");
+  }
+
+  int event;
+  int error;
+  int major;
+  int minor;
+  if (!XTestQueryExtension(m_display, &event, &error, &major, &minor)) {
+    QSKIP("no XTest extension");
+  }
+
+  m_keycode = XKeysymToKeycode(m_display, XK_a);
+  QVERIFY(m_keycode != 0);
+
+  m_window = XCreateSimpleWindow(m_display, DefaultRootWindow(m_display), 0, 0, 10, 10, 0, 0, 0);
+  XSelectInput(m_display, m_window, KeyPressMask | KeyReleaseMask | StructureNotifyMask);
+  XMapWindow(m_display, m_window);
+
+  XEvent xevent;
+  do {
+    XNextEvent(m_display, &xevent);
+  } while (xevent.type != MapNotify);
+
+  XSetInputFocus(m_display, m_window, RevertToParent, CurrentTime);
+  XSync(m_display, True);
+}
+
+void XWindowsKeyRepeatTests::cleanupTestCase()
+{
+  if (m_display == nullptr) {
+    return;
+  }
+  if (m_window != None) {
+    XDestroyWindow(m_display, m_window);
+  }
+  XCloseDisplay(m_display);
+}
+
+void XWindowsKeyRepeatTests::detectable()
+{
+  Bool supported = False;
+  XkbSetDetectableAutoRepeat(m_display, True, &supported);
+  if (supported != True) {
+    QSKIP("detectable auto-repeat not supported");
+  }
+
+  // repeats are presses only, so a release never needs a look ahead
+  const QList<int> expected = {KeyPress, KeyPress, KeyPress, KeyPress, KeyRelease};
+  QCOMPARE(fakeRepeats(4), expected);
+}
+
+void XWindowsKeyRepeatTests::notDetectable()
+{
+  Bool supported = False;
+  XkbSetDetectableAutoRepeat(m_display, False, &supported);
+
+  // each repeat is a release and press pair, only the last release is real
+  const auto types = fakeRepeats(4);
+  QCOMPARE(types.count(KeyPress), 4);
+  QCOMPARE(types.last(), KeyRelease);
+}
+
+void XWindowsKeyRepeatTests::screenSendsRepeats()
+{
+  // the setting is per connection, this only asks if the server has it
+  Bool supported = False;
+  XkbSetDetectableAutoRepeat(m_display, False, &supported);
+  if (supported != True) {
+    QSKIP("detectable auto-repeat not supported");
+  }
+
+  EventQueue events;
+  XWindowsScreen screen(nullptr, true, 0, &events);
+  screen.enable();
+
+  // off screen the primary grabs the keyboard, so the faked keys reach it
+  screen.leave();
+
+  const auto keyTypes = {EventTypes::KeyStateKeyDown, EventTypes::KeyStateKeyRepeat, EventTypes::KeyStateKeyUp};
+  QList<EventTypes> received;
+  for (const auto type : keyTypes) {
+    events.addHandler(type, screen.getEventTarget(), [&events, &received, type](const Event &) {
+      received.append(type);
+      if (type == EventTypes::KeyStateKeyUp) {
+        events.addEvent(Event(EventTypes::Quit));
+      }
+    });
+  }
+
+  auto *timer = events.newOneShotTimer(5.0, nullptr);
+  events.addHandler(EventTypes::Timer, timer, [&events](const Event &) { events.addEvent(Event(EventTypes::Quit)); });
+
+  fakeKeys(m_keycode, 4);
+  events.loop();
+
+  events.removeHandler(EventTypes::Timer, timer);
+  events.deleteTimer(timer);
+  for (const auto type : keyTypes) {
+    events.removeHandler(type, screen.getEventTarget());
+  }
+  screen.enter();
+  screen.disable();
+
+  // the screen asked for detectable auto-repeat on its own connection
+  using enum EventTypes;
+  const QList<EventTypes> expected = {KeyStateKeyDown, KeyStateKeyRepeat, KeyStateKeyRepeat, KeyStateKeyRepeat,
+                                      KeyStateKeyUp};
+  QCOMPARE(received, expected);
+}
+
+void XWindowsKeyRepeatTests::screenIgnoresHotKeyRepeats()
+{
+  Bool supported = False;
+  XkbSetDetectableAutoRepeat(m_display, False, &supported);
+  if (supported != True) {
+    QSKIP("detectable auto-repeat not supported");
+  }
+
+  const auto keycode = XKeysymToKeycode(m_display, XK_F12);
+  QVERIFY(keycode != 0);
+
+  EventQueue events;
+  XWindowsScreen screen(nullptr, true, 0, &events);
+  screen.enable();
+  const auto id = screen.registerHotKey(kKeyF12, 0);
+  QVERIFY(id != 0);
+
+  // hot keys never reach the key state, so only the screen knows it is held
+  QList<EventTypes> received;
+  using enum EventTypes;
+  for (const auto type : {PrimaryScreenHotkeyDown, PrimaryScreenHotkeyUp}) {
+    events.addHandler(type, screen.getEventTarget(), [&events, &received, type](const Event &) {
+      received.append(type);
+      if (type == PrimaryScreenHotkeyUp) {
+        events.addEvent(Event(Quit));
+      }
+    });
+  }
+
+  auto *timer = events.newOneShotTimer(5.0, nullptr);
+  events.addHandler(Timer, timer, [&events](const Event &) { events.addEvent(Event(Quit)); });
+
+  fakeKeys(keycode, 4);
+  events.loop();
+
+  events.removeHandler(Timer, timer);
+  events.deleteTimer(timer);
+  events.removeHandler(PrimaryScreenHotkeyDown, screen.getEventTarget());
+  events.removeHandler(PrimaryScreenHotkeyUp, screen.getEventTarget());
+  screen.unregisterHotKey(id);
+  screen.disable();
+
+  const QList<EventTypes> expected = {PrimaryScreenHotkeyDown, PrimaryScreenHotkeyUp};
+  QCOMPARE(received, expected);
+}
+
+void XWindowsKeyRepeatTests::fakeKeys(KeyCode keycode, int presses)
+{
+  for (int i = 0; i < presses; ++i) {
+    XTestFakeKeyEvent(m_display, keycode, True, CurrentTime);
+  }
+  XTestFakeKeyEvent(m_display, keycode, False, CurrentTime);
+  XSync(m_display, False);
+}
+
+QList<int> XWindowsKeyRepeatTests::fakeRepeats(int presses)
+{
+  fakeKeys(m_keycode, presses);
+
+  QList<int> types;
+  while (XPending(m_display) > 0) {
+    XEvent xevent;
+    XNextEvent(m_display, &xevent);
+    if ((xevent.type == KeyPress || xevent.type == KeyRelease) && xevent.xkey.keycode == m_keycode) {
+      types.append(xevent.type);
+    }
+  }
+  return types;
+}
+
+QTEST_MAIN(XWindowsKeyRepeatTests)
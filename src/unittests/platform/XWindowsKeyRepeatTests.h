@@ -0,0 +1,40 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "arch/Arch.h"
+#include "base/EventQueue.h"
+#include "base/Log.h"
+
+#include <QList>
+#include <QTest>
+
+// X11 defines macros that clash with Qt, so it comes last
+#include "platform/XWindowsScreen.h"
+
+class XWindowsKeyRepeatTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void initTestCase();
+  void cleanupTestCase();
+  void detectable();
+  void notDetectable();
+  void screenSendsRepeats();
+  void screenIgnoresHotKeyRepeats();
+
+private:
+  //! Fake \p presses of \p keycode through XTest then release it
+  void fakeKeys(KeyCode keycode, int presses);
+
+  //! Fake \p presses of one key then release it, returns the event types received
+  QList<int> fakeRepeats(int presses);
+
+  Arch m_arch;
+  Log m_log;
+  Display *m_display = nullptr;
+  Window m_window = None;
+  KeyCode m_keycode = 0;
+};
@@ -0,0 +1,203 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "XWindowsScreenTests.h"
+#include "../net/Loopback.h"
+
+#include "base/WakeupStats.h"
+#include "deskflow/IPrimaryScreen.h"
+#include "deskflow/KeyTypes.h"
+#include "deskflow/Screen.h"
+#include "net/IDataSocket.h"
+#include "net/SocketMultiplexer.h"
+#include "net/TCPListenSocket.h"
+#include "net/TCPSocket.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <X11/extensions/XTest.h>
+#include <X11/keysym.h>
+#include <poll.h>
+
+using namespace std::chrono_literals;
+
+void XWindowsScreenTests::initTestCase()
+{
+  m_display = XOpenDisplay(nullptr);
+  if (m_display == nullptr) {
+    QSKIP("no X display");
+  }
+
+  int event;
+  int error;
+  int major;
+  int minor;
+  if (!XTestQueryExtension(m_display, &event, &error, &major, &minor)) {
+    QSKIP("no XTest extension");
+  }
+
+  m_window = XCreateSimpleWindow(m_display, DefaultRootWindow(m_display), 0, 0, 100, 100, 0, 0, 0);
+  XSelectInput(m_display, m_window, KeyPressMask | KeyReleaseMask | StructureNotifyMask);
+  XMapWindow(m_display, m_window);
+
+  XEvent xevent;
+  do {
+    XNextEvent(m_display, &xevent);
+  } while (xevent.type != MapNotify);
+
+  XSetInputFocus(m_display, m_window, RevertToParent, CurrentTime);
+  XSync(m_display, True);
+}
+
+void XWindowsScreenTests::cleanupTestCase()
+{
+  if (m_display == nullptr) {
+    return;
+  }
+  if (m_window != None) {
+    XDestroyWindow(m_display, m_window);
+  }
+  XCloseDisplay(m_display);
+}
+
+void XWindowsScreenTests::injectionLatency()
+{
+  EventQueue events;
+  deskflow::Screen screen(new XWindowsScreen(nullptr, false, 0, &events), &events);
+  screen.enable();
+  screen.enter(0);
+
+  // from the client being told about a key to the focused window getting it
+  const KeyButton button = XKeysymToKeycode(m_display, XK_a);
+  std::vector<std::chrono::steady_clock::duration> latencies;
+  for (int i = 0; i < 200; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    screen.keyDown('a', 0, button, "");
+    QVERIFY(waitForEvent(KeyPress));
+    latencies.push_back(std::chrono::steady_clock::now() - start);
+    screen.keyUp('a', 0, button);
+    QVERIFY(waitForEvent(KeyRelease));
+  }
+
+  screen.leave();
+  screen.disable();
+
+  std::ranges::sort(latencies);
+  const auto median = latencies[latencies.size() / 2];
+  const auto p99 = latencies[latencies.size() * 99 / 100];
+  qInfo(
+      "per key injection median %.3f ms, p99 %.3f ms", std::chrono::duration<double, std::milli>(median).count(),
+      std::chrono::duration<double, std::milli>(p99).count()
+  );
+
+  // one trip to the server, polling the group per key would double it
+  QVERIFY(median < 1ms);
+}
+
+void XWindowsScreenTests::motionCompressed()
+{
+  EventQueue events;
+  XWindowsScreen screen(nullptr, true, 0, &events);
+  screen.enable();
+
+  // off screen the primary grabs the pointer and sends deltas
+  screen.leave();
+
+  std::vector<std::pair<int32_t, int32_t>> moves;
+  events.addHandler(EventTypes::PrimaryScreenMotionOnSecondary, screen.getEventTarget(), [&moves](const Event &e) {
+    const auto *info = static_cast<const IPrimaryScreen::MotionInfo *>(e.getData());
+    moves.emplace_back(info->m_x, info->m_y);
+  });
+
+  // let the warp to the center settle before the burst
+  runFor(events, 0.2);
+  moves.clear();
+
+  // all of it is queued on the screen's connection before it reads any
+  for (int i = 0; i < 10; ++i) {
+    XTestFakeRelativeMotionEvent(m_display, 2, 1, CurrentTime);
+  }
+  XSync(m_display, False);
+  runFor(events, 0.5);
+
+  events.removeHandler(EventTypes::PrimaryScreenMotionOnSecondary, screen.getEventTarget());
+  screen.enter();
+  screen.disable();
+
+  QCOMPARE(moves.size(), size_t{1});
+  QCOMPARE(moves.front(), std::make_pair(20, 10));
+}
+
+void XWindowsScreenTests::idleWakeups()
+{
+  EventQueue events;
+  SocketMultiplexer multiplexer;
+  XWindowsScreen screen(nullptr, true, 0, &events);
+  screen.enable();
+
+  // a connected peer with nothing to say, as a client is between inputs
+  TCPListenSocket listen(&events, &multiplexer, IArchNetwork::AddressFamily::INet);
+  NetworkAddress address;
+  QVERIFY(bindLoopback(listen, 49152, address));
+  std::unique_ptr<IDataSocket> accepted;
+  events.addHandler(EventTypes::ListenSocketConnecting, listen.getEventTarget(), [&](const auto &) {
+    accepted = listen.accept();
+    events.addEvent(Event(EventTypes::Quit));
+  });
+  TCPSocket client(&events, &multiplexer);
+  client.connect(address);
+  runFor(events, 5.0);
+  events.removeHandler(EventTypes::ListenSocketConnecting, listen.getEventTarget());
+  QVERIFY(accepted != nullptr);
+
+  // let the start-up work settle, then count everything that wakes us
+  runFor(events, 1.0);
+  WakeupStats::reset();
+  const double seconds = 10.0;
+  runFor(events, seconds);
+
+  uint64_t wakeups = 0;
+  for (std::size_t i = 0; i < WakeupStats::kSourceCount; ++i) {
+    const auto source = static_cast<WakeupSource>(i);
+    wakeups += WakeupStats::count(source);
+    qInfo("%s: %llu", WakeupStats::name(source), static_cast<unsigned long long>(WakeupStats::count(source)));
+  }
+  screen.disable();
+
+  // this includes the timer that ends the wait
+  QVERIFY2(static_cast<double>(wakeups) < seconds, qPrintable(QString("%1 wakeups").arg(wakeups)));
+}
+
+bool XWindowsScreenTests::waitForEvent(int type)
+{
+  const auto deadline = std::chrono::steady_clock::now() + 1s;
+  XEvent xevent;
+  while (!XCheckTypedWindowEvent(m_display, m_window, type, &xevent)) {
+    using std::chrono::milliseconds;
+    const auto left = std::chrono::duration_cast<milliseconds>(deadline - std::chrono::steady_clock::now());
+    if (left <= 0ms) {
+      return false;
+    }
+    pollfd pfd = {ConnectionNumber(m_display), POLLIN, 0};
+    poll(&pfd, 1, static_cast<int>(left.count()));
+  }
+  return true;
+}
+
+void XWindowsScreenTests::runFor(EventQueue &events, double seconds)
+{
+  auto *timer = events.newOneShotTimer(seconds, nullptr);
+  events.addHandler(EventTypes::Timer, timer, [&events](const Event &) { events.addEvent(Event(EventTypes::Quit)); });
+  events.loop();
+  events.removeHandler(EventTypes::Timer, timer);
+  events.deleteTimer(timer);
+}
+
+QTEST_MAIN(XWindowsScreenTests)
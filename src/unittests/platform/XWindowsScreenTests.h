@@ -0,0 +1,37 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "arch/Arch.h"
+#include "base/EventQueue.h"
+#include "base/Log.h"
+
+#include <QTest>
+
+// X11 defines macros that clash with Qt, so it comes last
+#include "platform/XWindowsScreen.h"
+
+class XWindowsScreenTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void initTestCase();
+  void cleanupTestCase();
+  void injectionLatency();
+  void motionCompressed();
+  void idleWakeups();
+
+private:
+  //! Wait up to a second for an event of \p type on the test window
+  bool waitForEvent(int type);
+
+  //! Dispatch events for \p seconds
+  static void runFor(EventQueue &events, double seconds);
+
+  Arch m_arch;
+  Log m_log;
+  Display *m_display = nullptr;
+  Window m_window = None;
+};
@@ -0,0 +1,80 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "ServerStartupTests.h"
+
+#include "base/EventQueue.h"
+#include "base/StartupProfiler.h"
+#include "deskflow/Screen.h"
+#include "net/NetworkAddress.h"
+#include "net/SocketException.h"
+#include "net/SocketMultiplexer.h"
+#include "net/TCPSocketFactory.h"
+#include "server/ClientListener.h"
+#include "server/Config.h"
+#include "server/PrimaryClient.h"
+#include "server/Server.h"
+
+#include <memory>
+
+// X11 defines macros that clash with Qt, so it comes last
+#include "platform/XWindowsScreen.h"
+
+void ServerStartupTests::initTestCase()
+{
+  Display *display = XOpenDisplay(nullptr);
+  if (display == nullptr) {
+    QSKIP("no X display");
+  }
+  XCloseDisplay(display);
+}
+
+void ServerStartupTests::listensWithinBudget()
+{
+  EventQueue events;
+  SocketMultiplexer multiplexer;
+  deskflow::server::Config config(&events);
+  config.addScreen("server");
+
+  // the same steps as the server app from opening the screen to listening,
+  // config loading is left out as it depends on the file
+  StartupProfiler::start();
+  auto screen = std::make_unique<deskflow::Screen>(new XWindowsScreen(nullptr, true, 0, &events), &events);
+  StartupProfiler::mark("screen");
+  auto primaryClient = std::make_unique<PrimaryClient>("server", screen.get());
+  StartupProfiler::mark("primary client");
+
+  std::unique_ptr<ClientListener> listener;
+  for (int port = 24900; listener == nullptr && port < 25000; ++port) {
+    try {
+      NetworkAddress address("127.0.0.1", port);
+      address.resolve();
+      listener = std::make_unique<ClientListener>(
+          address, std::make_unique<TCPSocketFactory>(&events, &multiplexer), &events, SecurityLevel::PlainText
+      );
+    } catch (const SocketAddressInUseException &) {
+      // try the next port
+    }
+  }
+  QVERIFY(listener != nullptr);
+  StartupProfiler::mark("listen");
+
+  auto server = std::make_unique<Server>(config, primaryClient.get(), screen.get(), &events);
+  StartupProfiler::mark("server");
+  listener->setServer(server.get());
+  server->setListener(listener.get());
+  const auto withinBudget = StartupProfiler::finish("listening");
+
+  for (const auto &phase : StartupProfiler::phases()) {
+    qInfo("%s: %.1f ms", phase.name.c_str(), phase.nanos / 1e6);
+  }
+  QVERIFY2(withinBudget, qPrintable(QString("took %1 ms").arg(StartupProfiler::totalMs())));
+
+  server.reset();
+  listener.reset();
+}
+
+QTEST_MAIN(ServerStartupTests)